@@ -9,8 +9,10 @@
  */
 #pragma once
 #include <string>
+#include <memory>
 
 #include "../Includes/WTSTypes.h"
+#include "../Includes/WTSStruct.h"
 
 NS_WTP_BEGIN
 class WTSVariant;
@@ -49,6 +51,15 @@ public:
 	virtual bool read_raw_order_queues(const char* exchg, const char* code, uint32_t uDate, std::string& buffer) { return false; }
 	virtual bool read_raw_transactions(const char* exchg, const char* code, uint32_t uDate, std::string& buffer) { return false; }
 
+	/*
+	 *	tickֱӳ䵽ڴ棬طŵʱҪٽѹ͸
+	 *	@holder	ӳ󣬳ڼЧ
+	 *	@ticks	tickݵĵַ
+	 *	@count	tick
+	 *	֧ӳʵַfalseɣ÷˻صread_raw_ticks
+	 */
+	virtual bool map_raw_ticks(const char* exchg, const char* code, uint32_t uDate, std::shared_ptr<void>& holder, WTSTickStruct*& ticks, std::size_t& count) { return false; }
+
 protected:
 	IBtDtReaderSink*	_sink;
 };
@@ -23,6 +23,19 @@ class IBaseDataMgr;
 class IHotMgr;
 class WTSVariant;
 
+/*
+ *	@brief ݻͳϢ
+ */
+typedef struct _RdmCacheStats
+{
+	uint64_t	_hits;		//д
+	uint64_t	_misses;	//δд
+	uint64_t	_evictions;	//̭
+	uint64_t	_bytes;		//ǰֽ
+	uint64_t	_budget;	//ֽԤ, 0Ϊ
+	uint32_t	_entries;	//
+	uint32_t	_pinned;	//ƬõĻ
+} RdmCacheStats;
 
 /*
  *	@brief ݶȡģصӿ
@@ -83,6 +96,12 @@ public:
 
 	virtual void		clearCache(){}
 
+	/*
+	 *	@brief	ȡݻͳϢ
+	 *	@return	ֵ֧Ļfalse
+	 */
+	virtual bool		getCacheStats(RdmCacheStats& stats) { return false; }
+
 protected:
 	IRdmDtReaderSink*	_sink;
 };
@@ -581,6 +581,11 @@ public:
 	 */
 	inline uint32_t size() const{return (uint32_t)_map.size();}
 
+	/*
+	 *	Ԥ, ֪Ԫظʱⷴrehash
+	 */
+	inline void reserve(uint32_t count){ _map.reserve(count); }
+
 	/*
 	 *	ȡָkeyӦ
 	 *	ݵü
@@ -184,8 +184,15 @@ public:
 	inline void setCommInfo(WTSCommodityInfo* commInfo) { m_commInfo = commInfo; }
 	inline WTSCommodityInfo* getCommInfo() const { return m_commInfo; }
 
+	/*
+	 *	ԼIDغԼʱɻݹ˳䣬1ʼ0ʾûз
+	 *	Ҫڲ±ҶıԺԼϣ
+	 */
+	inline void setSymbolID(uint32_t sid) { m_uSymbolID = sid; }
+	inline uint32_t getSymbolID() const { return m_uSymbolID; }
+
 protected:
-	WTSContractInfo():m_commInfo(NULL), m_openDate(0), m_expireDate(0), m_lMarginRatio(0), m_sMarginRatio(0) {}
+	WTSContractInfo():m_commInfo(NULL), m_openDate(0), m_expireDate(0), m_lMarginRatio(0), m_sMarginRatio(0), m_uSymbolID(0) {}
 	virtual ~WTSContractInfo(){}
 
 private:
@@ -206,6 +213,7 @@ private:
 	uint32_t	m_expireDate;	//
 	double		m_lMarginRatio;	//ͷ֤
 	double		m_sMarginRatio;	//ͷ֤
+	uint32_t	m_uSymbolID;	//ԼID
 
 	WTSCommodityInfo*	m_commInfo;
 };
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <vector>
 #include <deque>
+#include <memory>
 #include <string.h>
 #include <chrono>
 
@@ -21,6 +22,8 @@
 #include "WTSStruct.h"
 #include "WTSCollection.hpp"
 
+#include "../Share/SimdKernels.hpp"
+
 using namespace std;
 
 #pragma warning(disable:4267)
@@ -208,6 +211,7 @@ private:
 	typedef std::pair<WTSBarStruct*, uint32_t> BarBlock;
 	std::vector<BarBlock> _blocks;
 	uint32_t		_count;
+	std::vector<std::shared_ptr<void>>	_holders;	//切片引用的数据块的持有者
 
 protected:
 	WTSKlineSlice()
@@ -229,8 +233,33 @@ protected:
 		return idx;
 	}
 
-
 public:
+	/*
+	 *	按数据块遍历指定范围内的K线，不用每根K线都从第一个数据块开始查找
+	 *	@begin	起始位置，已经转换过的
+	 *	@end	结束位置，已经转换过的，包含在内
+	 *	@cb		回调函数，参数为数据块内的起始地址和连续的K线条数
+	 */
+	template<typename Fn>
+	inline void	visitRange(int32_t begin, int32_t end, Fn cb) const
+	{
+		int32_t offset = 0;
+		for (auto& item : _blocks)
+		{
+			int32_t blkEnd = offset + (int32_t)item.second - 1;
+			if (blkEnd >= begin && offset <= end)
+			{
+				int32_t from = max(begin, offset);
+				int32_t to = min(end, blkEnd);
+				cb(item.first + (from - offset), (uint32_t)(to - from + 1));
+			}
+
+			offset += item.second;
+			if (offset > end)
+				break;
+		}
+	}
+
 	static WTSKlineSlice* create(const char* code, WTSKlinePeriod period, uint32_t times, WTSBarStruct* bars = NULL, int32_t count = 0)
 	{
 		WTSKlineSlice *pRet = new WTSKlineSlice;
@@ -244,6 +273,15 @@ public:
 		return pRet;
 	}
 
+	/*
+	 *	持有切片引用的数据块, 切片释放之前数据块不会被缓存淘汰
+	 */
+	inline void pinData(const std::shared_ptr<void>& holder)
+	{
+		if (holder)
+			_holders.emplace_back(holder);
+	}
+
 	inline bool appendBlock(WTSBarStruct* bars, uint32_t count)
 	{
 		if (bars == NULL || count == 0)
@@ -323,6 +361,9 @@ public:
 	*/
 	double		maxprice(int32_t head, int32_t tail) const
 	{
+		if (_count == 0)
+			return INVALID_DOUBLE;
+
 		head = translateIdx(head);
 		tail = translateIdx(tail);
 
@@ -330,10 +371,10 @@ public:
 		int32_t end = min(max(head, tail), size() - 1);
 
 		double maxValue = this->at(begin)->high;
-		for (int32_t i = begin; i <= end; i++)
-		{
-			maxValue = max(maxValue, at(i)->high);
-		}
+		visitRange(begin, end, [&maxValue](const WTSBarStruct* bars, uint32_t cnt) {
+			for (uint32_t i = 0; i < cnt; i++)
+				maxValue = max(maxValue, bars[i].high);
+		});
 		return maxValue;
 	}
 
@@ -345,6 +386,9 @@ public:
 	*/
 	double		minprice(int32_t head, int32_t tail) const
 	{
+		if (_count == 0)
+			return INVALID_DOUBLE;
+
 		head = translateIdx(head);
 		tail = translateIdx(tail);
 
@@ -352,10 +396,10 @@ public:
 		int32_t end = min(max(head, tail), size() - 1);
 
 		double minValue = at(begin)->low;
-		for (int32_t i = begin; i <= end; i++)
-		{
-			minValue = min(minValue, at(i)->low);
-		}
+		visitRange(begin, end, [&minValue](const WTSBarStruct* bars, uint32_t cnt) {
+			for (uint32_t i = 0; i < cnt; i++)
+				minValue = min(minValue, bars[i].low);
+		});
 
 		return minValue;
 	}
@@ -393,41 +437,241 @@ public:
 		WTSValueArray *vArray = NULL;
 
 		vArray = WTSValueArray::create();
+		vArray->getDataRef().reserve(end - begin + 1);
+
+		visitRange(begin, end, [vArray, type](const WTSBarStruct* bars, uint32_t cnt) {
+			for (uint32_t i = 0; i < cnt; i++)
+			{
+				const WTSBarStruct& day = bars[i];
+				switch (type)
+				{
+				case KFT_OPEN:
+					vArray->append(day.open);
+					break;
+				case KFT_HIGH:
+					vArray->append(day.high);
+					break;
+				case KFT_LOW:
+					vArray->append(day.low);
+					break;
+				case KFT_CLOSE:
+					vArray->append(day.close);
+					break;
+				case KFT_VOLUME:
+					vArray->append(day.vol);
+					break;
+				case KFT_SVOLUME:
+					if (day.vol > INT_MAX)
+						vArray->append(1 * ((day.close > day.open) ? 1 : -1));
+					else
+						vArray->append((int32_t)day.vol * ((day.close > day.open) ? 1 : -1));
+					break;
+				case KFT_DATE:
+					vArray->append(day.date);
+					break;
+				case KFT_TIME:
+					vArray->append((double)day.time);
+				}
+			}
+		});
+
+		return vArray;
+	}
+};
+
+/*
+ *	K线数据的列式视图
+ *	把K线切片里的开高低收和成交量分别拷贝到连续的数组里，只在创建的时候拷贝一次
+ *	策略可以直接拿到数组地址，也可以调用向量化的统计函数，不用每次都抽取数据
+ */
+class WTSKlineColumns : public WTSObject
+{
+protected:
+	char				_code[MAX_INSTRUMENT_LENGTH];
+	std::vector<double>	_opens;
+	std::vector<double>	_highs;
+	std::vector<double>	_lows;
+	std::vector<double>	_closes;
+	std::vector<double>	_volumes;
 
-		for (int32_t i = begin; i <= end; i++)
+protected:
+	WTSKlineColumns() {}
+
+	inline int32_t		translateIdx(int32_t idx) const
+	{
+		int32_t totalCnt = (int32_t)_closes.size();
+		if (idx < 0)
 		{
-			const WTSBarStruct& day = *at(i);
-			switch (type)
+			return max(0, totalCnt + idx);
+		}
+
+		return idx;
+	}
+
+	/*
+	 *	把首尾位置转换成数组地址和长度
+	 *	超出范围的话返回NULL
+	 */
+	inline const double*	range(WTSKlineFieldType type, int32_t head, int32_t tail, std::size_t& count) const
+	{
+		const double* data = column(type);
+		if (data == NULL || _closes.empty())
+			return NULL;
+
+		head = translateIdx(head);
+		tail = translateIdx(tail);
+
+		int32_t begin = max(0, min(head, tail));
+		int32_t end = min(max(head, tail), size() - 1);
+		if (begin > end)
+			return NULL;
+
+		count = end - begin + 1;
+		return data + begin;
+	}
+
+public:
+	/*
+	 *	从K线切片创建列式视图
+	 *	@slice	K线切片
+	 *	@head	起始位置
+	 *	@tail	结束位置
+	 */
+	static WTSKlineColumns* create(const WTSKlineSlice* slice, int32_t head = 0, int32_t tail = -1)
+	{
+		WTSKlineColumns* pRet = new WTSKlineColumns;
+		wt_strcpy(pRet->_code, slice->code());
+		if (slice->empty())
+			return pRet;
+
+		int32_t count = slice->size();
+		head = (head < 0) ? max(0, count + head) : head;
+		tail = (tail < 0) ? max(0, count + tail) : tail;
+
+		int32_t begin = max(0, min(head, tail));
+		int32_t end = min(max(head, tail), count - 1);
+		if (begin > end)
+			return pRet;
+
+		std::size_t total = end - begin + 1;
+		pRet->_opens.resize(total);
+		pRet->_highs.resize(total);
+		pRet->_lows.resize(total);
+		pRet->_closes.resize(total);
+		pRet->_volumes.resize(total);
+
+		double* opens = pRet->_opens.data();
+		double* highs = pRet->_highs.data();
+		double* lows = pRet->_lows.data();
+		double* closes = pRet->_closes.data();
+		double* volumes = pRet->_volumes.data();
+		std::size_t pos = 0;
+		slice->visitRange(begin, end, [&](const WTSBarStruct* bars, uint32_t cnt) {
+			for (uint32_t i = 0; i < cnt; i++, pos++)
 			{
-			case KFT_OPEN:
-				vArray->append(day.open);
-				break;
-			case KFT_HIGH:
-				vArray->append(day.high);
-				break;
-			case KFT_LOW:
-				vArray->append(day.low);
-				break;
-			case KFT_CLOSE:
-				vArray->append(day.close);
-				break;
-			case KFT_VOLUME:
-				vArray->append(day.vol);
-				break;
-			case KFT_SVOLUME:
-				if (day.vol > INT_MAX)
-					vArray->append(1 * ((day.close > day.open) ? 1 : -1));
-				else
-					vArray->append((int32_t)day.vol * ((day.close > day.open) ? 1 : -1));
-				break;
-			case KFT_DATE:
-				vArray->append(day.date);
-				break;
-			case KFT_TIME:
-				vArray->append((double)day.time);
+				const WTSBarStruct& bar = bars[i];
+				opens[pos] = bar.open;
+				highs[pos] = bar.high;
+				lows[pos] = bar.low;
+				closes[pos] = bar.close;
+				volumes[pos] = bar.vol;
 			}
+		});
+
+		return pRet;
+	}
+
+	inline int32_t	size() const { return (int32_t)_closes.size(); }
+	inline bool		empty() const { return _closes.empty(); }
+	inline const char*	code() const { return _code; }
+
+	/*
+	 *	获取某一列的数组地址
+	 *	@type 支持的类型有KFT_OPEN、KFT_HIGH、KFT_LOW、KFT_CLOSE、KFT_VOLUME，其他的返回NULL
+	 */
+	inline const double*	column(WTSKlineFieldType type) const
+	{
+		switch (type)
+		{
+		case KFT_OPEN:	return _opens.data();
+		case KFT_HIGH:	return _highs.data();
+		case KFT_LOW:	return _lows.data();
+		case KFT_CLOSE:	return _closes.data();
+		case KFT_VOLUME:return _volumes.data();
+		default:		return NULL;
 		}
+	}
+
+	inline const double*	opens() const { return _opens.data(); }
+	inline const double*	highs() const { return _highs.data(); }
+	inline const double*	lows() const { return _lows.data(); }
+	inline const double*	closes() const { return _closes.data(); }
+	inline const double*	volumes() const { return _volumes.data(); }
+
+	/*
+	 *	指定范围内的统计值
+	 *	如果超出范围或者字段不支持，返回INVALID_DOUBLE
+	 */
+	inline double	maxvalue(WTSKlineFieldType type, int32_t head = 0, int32_t tail = -1) const
+	{
+		std::size_t count = 0;
+		const double* data = range(type, head, tail, count);
+		return data ? SimdKernels::max_value(data, count) : INVALID_DOUBLE;
+	}
+
+	inline double	minvalue(WTSKlineFieldType type, int32_t head = 0, int32_t tail = -1) const
+	{
+		std::size_t count = 0;
+		const double* data = range(type, head, tail, count);
+		return data ? SimdKernels::min_value(data, count) : INVALID_DOUBLE;
+	}
+
+	inline double	sum(WTSKlineFieldType type, int32_t head = 0, int32_t tail = -1) const
+	{
+		std::size_t count = 0;
+		const double* data = range(type, head, tail, count);
+		return data ? SimdKernels::sum(data, count) : INVALID_DOUBLE;
+	}
+
+	inline double	mean(WTSKlineFieldType type, int32_t head = 0, int32_t tail = -1) const
+	{
+		std::size_t count = 0;
+		const double* data = range(type, head, tail, count);
+		return data ? SimdKernels::mean(data, count) : INVALID_DOUBLE;
+	}
+
+	inline double	stddev(WTSKlineFieldType type, int32_t head = 0, int32_t tail = -1) const
+	{
+		std::size_t count = 0;
+		const double* data = range(type, head, tail, count);
+		return data ? SimdKernels::stddev(data, count) : INVALID_DOUBLE;
+	}
+
+	/*
+	 *	滚动窗口统计，结果和K线一一对应，前window-1个位置为INVALID_DOUBLE
+	 *	@type	字段类型
+	 *	@window	窗口大小
+	 *	如果字段不支持，返回NULL
+	 */
+	WTSValueArray*	rollingMax(WTSKlineFieldType type, uint32_t window) const { return rolling(type, window, SimdKernels::rolling_max); }
+	WTSValueArray*	rollingMin(WTSKlineFieldType type, uint32_t window) const { return rolling(type, window, SimdKernels::rolling_min); }
+	WTSValueArray*	rollingSum(WTSKlineFieldType type, uint32_t window) const { return rolling(type, window, SimdKernels::rolling_sum); }
+	WTSValueArray*	rollingMean(WTSKlineFieldType type, uint32_t window) const { return rolling(type, window, SimdKernels::rolling_mean); }
+	WTSValueArray*	rollingStd(WTSKlineFieldType type, uint32_t window) const { return rolling(type, window, SimdKernels::rolling_stddev); }
+
+private:
+	typedef void(*RollingFunc)(const double*, std::size_t, std::size_t, double*, double);
 
+	WTSValueArray*	rolling(WTSKlineFieldType type, uint32_t window, RollingFunc func) const
+	{
+		const double* data = column(type);
+		if (data == NULL)
+			return NULL;
+
+		WTSValueArray* vArray = WTSValueArray::create();
+		vArray->resize(_closes.size());
+		if (!_closes.empty())
+			func(data, _closes.size(), window, vArray->getDataRef().data(), INVALID_DOUBLE);
 		return vArray;
 	}
 };
@@ -1017,19 +1261,19 @@ private:
 	WTSContractInfo*	m_pContract;
 };
 
-class WTSOrdQueData : public WTSObject
+class WTSOrdQueData : public WTSPoolObject<WTSOrdQueData>
 {
 public:
 	static inline WTSOrdQueData* create(const char* code)
 	{
-		WTSOrdQueData* pRet = new WTSOrdQueData;
+		WTSOrdQueData* pRet = WTSOrdQueData::allocate();
 		wt_strcpy(pRet->m_oqStruct.code, code);
 		return pRet;
 	}
 
 	static inline WTSOrdQueData* create(WTSOrdQueStruct& ordQueData)
 	{
-		WTSOrdQueData* pRet = new WTSOrdQueData;
+		WTSOrdQueData* pRet = WTSOrdQueData::allocate();
 		memcpy(&pRet->m_oqStruct, &ordQueData, sizeof(WTSOrdQueStruct));
 
 		return pRet;
@@ -1053,19 +1297,19 @@ private:
 	WTSContractInfo*	m_pContract;
 };
 
-class WTSOrdDtlData : public WTSObject
+class WTSOrdDtlData : public WTSPoolObject<WTSOrdDtlData>
 {
 public:
 	static inline WTSOrdDtlData* create(const char* code)
 	{
-		WTSOrdDtlData* pRet = new WTSOrdDtlData;
+		WTSOrdDtlData* pRet = WTSOrdDtlData::allocate();
 		wt_strcpy(pRet->m_odStruct.code, code);
 		return pRet;
 	}
 
 	static inline WTSOrdDtlData* create(WTSOrdDtlStruct& odData)
 	{
-		WTSOrdDtlData* pRet = new WTSOrdDtlData;
+		WTSOrdDtlData* pRet = WTSOrdDtlData::allocate();
 		memcpy(&pRet->m_odStruct, &odData, sizeof(WTSOrdDtlStruct));
 
 		return pRet;
@@ -1090,19 +1334,19 @@ private:
 	WTSContractInfo*	m_pContract;
 };
 
-class WTSTransData : public WTSObject
+class WTSTransData : public WTSPoolObject<WTSTransData>
 {
 public:
 	static inline WTSTransData* create(const char* code)
 	{
-		WTSTransData* pRet = new WTSTransData;
+		WTSTransData* pRet = WTSTransData::allocate();
 		wt_strcpy(pRet->m_tsStruct.code, code);
 		return pRet;
 	}
 
 	static inline WTSTransData* create(WTSTransStruct& transData)
 	{
-		WTSTransData* pRet = new WTSTransData;
+		WTSTransData* pRet = WTSTransData::allocate();
 		memcpy(&pRet->m_tsStruct, &transData, sizeof(WTSTransStruct));
 
 		return pRet;
@@ -1225,6 +1469,7 @@ private:
 	typedef std::pair<WTSTickStruct*, uint32_t> TickBlock;
 	std::vector<TickBlock> _blocks;
 	uint32_t		_count;
+	std::vector<std::shared_ptr<void>>	_holders;	//切片引用的数据块的持有者
 
 protected:
 	WTSTickSlice() { _blocks.clear(); }
@@ -1255,6 +1500,12 @@ public:
 		return slice;
 	}
 
+	inline void pinData(const std::shared_ptr<void>& holder)
+	{
+		if (holder)
+			_holders.emplace_back(holder);
+	}
+
 	inline bool appendBlock(WTSTickStruct* ticks, uint32_t count)
 	{
 		if (ticks == NULL || count == 0)
@@ -1332,6 +1583,7 @@ private:
 	char				m_strCode[MAX_INSTRUMENT_LENGTH];
 	WTSOrdDtlStruct*	m_ptrBegin;
 	uint32_t			m_uCount;
+	std::vector<std::shared_ptr<void>>	_holders;
 
 protected:
 	WTSOrdDtlSlice() :m_ptrBegin(NULL), m_uCount(0) {}
@@ -1363,6 +1615,12 @@ public:
 
 	inline bool empty() const { return (m_uCount == 0) || (m_ptrBegin == NULL); }
 
+	inline void pinData(const std::shared_ptr<void>& holder)
+	{
+		if (holder)
+			_holders.emplace_back(holder);
+	}
+
 	inline const WTSOrdDtlStruct* at(int32_t idx)
 	{
 		if (m_ptrBegin == NULL)
@@ -1384,6 +1642,7 @@ private:
 	char				m_strCode[MAX_INSTRUMENT_LENGTH];
 	WTSOrdQueStruct*	m_ptrBegin;
 	uint32_t			m_uCount;
+	std::vector<std::shared_ptr<void>>	_holders;
 
 protected:
 	WTSOrdQueSlice() :m_ptrBegin(NULL), m_uCount(0) {}
@@ -1415,6 +1674,12 @@ public:
 
 	inline bool empty() const { return (m_uCount == 0) || (m_ptrBegin == NULL); }
 
+	inline void pinData(const std::shared_ptr<void>& holder)
+	{
+		if (holder)
+			_holders.emplace_back(holder);
+	}
+
 	inline const WTSOrdQueStruct* at(int32_t idx)
 	{
 		if (m_ptrBegin == NULL)
@@ -1436,6 +1701,7 @@ private:
 	char			m_strCode[MAX_INSTRUMENT_LENGTH];
 	WTSTransStruct*	m_ptrBegin;
 	uint32_t		m_uCount;
+	std::vector<std::shared_ptr<void>>	_holders;
 
 protected:
 	WTSTransSlice() :m_ptrBegin(NULL), m_uCount(0) {}
@@ -1467,6 +1733,12 @@ public:
 
 	inline bool empty() const { return (m_uCount == 0) || (m_ptrBegin == NULL); }
 
+	inline void pinData(const std::shared_ptr<void>& holder)
+	{
+		if (holder)
+			_holders.emplace_back(holder);
+	}
+
 	inline const WTSTransStruct* at(int32_t idx)
 	{
 		if (m_ptrBegin == NULL)
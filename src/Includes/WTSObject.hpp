@@ -13,7 +13,7 @@
 #include <boost/smart_ptr/detail/spinlock.hpp>
 
 #include "WTSMarcos.h"
-#include "../Share/ObjectPool.hpp"
+#include "../Share/MagazinePool.hpp"
 #include "../Share/SpinMutex.hpp"
 
 NS_WTP_BEGIN
@@ -53,39 +53,34 @@ protected:
 	volatile std::atomic<uint32_t>	m_uRefs;
 };
 
+/*
+ *	ػĳMagazinePool
+ *	ԭÿ߳һboost::pool, ߳ͷŵʱҪס̵߳ĳ
+ *	ҷ߳˳ԺӾ, ûͷŵĶͳҰָ
+ *	ڶĸ߳ͷžͻصĸ̵߳Ļ, ڴҲ߳˳
+ */
 template<typename T>
 class WTSPoolObject : public WTSObject
 {
 private:
-	typedef ObjectPool<T> MyPool;
-	MyPool*			_pool;
-	SpinMutex*	_mutex;
+	typedef MagazinePool<T> MyPool;
 
 public:
-	WTSPoolObject():_pool(NULL){}
+	WTSPoolObject(){}
 	virtual ~WTSPoolObject() {}
 
 public:
 	static T*	allocate()
 	{
-		/*
-		 *	By Wesley @ 2022.06.14
-		 *	ûʹthread_local߳ٵĻڴҲ
-		 *	ûTrader︴bugTraderײһAPIʵ
-		 *	ôڴؾѾˣϵͳд洢retainTraderĶWTSOrderInfoȣַԽ
-		 *	ȥthread_localĳɴ̬ģ̲ܶ߳ĳҲһЩ
-		 *	֮ҪװȫôҪһУܿ
-		 *	עһ£ĿԲοһ
-		 */
-		thread_local static MyPool		pool;
-		thread_local static SpinMutex	mtx;
-
-		mtx.lock();
-		T* ret = pool.construct();
-		mtx.unlock();
-		ret->_pool = &pool;
-		ret->_mutex = &mtx;
-		return ret;
+		return MyPool::construct();
+	}
+
+	/*
+	 *	صķͳ
+	 */
+	static PoolStats	poolStats()
+	{
+		return MyPool::stats();
 	}
 
 public:
@@ -99,9 +94,7 @@ public:
 			uint32_t cnt = m_uRefs.fetch_sub(1);
 			if (cnt == 1)
 			{
-				_mutex->lock();
-				_pool->destroy((T*)this);
-				_mutex->unlock();
+				MyPool::destroy((T*)this);
 			}
 		}
 		catch (...)
@@ -35,6 +35,21 @@ protected:
 	TradingTimes	m_auctionTimes;
 	int32_t			m_uOffsetMins;
 
+	/*
+	 *	ʱͷ֮Ļÿtick϶Ҫúü
+	 *	ʱԺֱɲұ, ֻҪһ
+	 *	m_minsOfTime	ԭʼʱķ(h*60+m)ķ, ǰ1440Զ, 1440Զ
+	 *	m_timeOfMins	շʱ, ǰm_uTableMins+1Ϊβ, Ϊͷ
+	 *	m_secsOfTime	ԭʼʱķ, Ϊ01ÿĲ
+	 *	ʱζӵ, ͬһڵֻԵĻ߳(Ͼ)
+	 */
+	std::vector<uint32_t>	m_minsOfTime;
+	std::vector<uint32_t>	m_timeOfMins;
+	std::vector<uint32_t>	m_secsOfTime;
+	std::vector<uint32_t>	m_secMinList;
+	uint32_t		m_uTradingMins;
+	uint32_t		m_uTableMins;	//Сʵʵķ֮
+
 	std::string		m_strID;
 	std::string		m_strName;
 
@@ -42,6 +57,7 @@ protected:
 	WTSSessionInfo(int32_t offset)
 	{
 		m_uOffsetMins = offset;
+		buildTables();
 	}
 	virtual ~WTSSessionInfo(){}
 
@@ -65,6 +81,7 @@ public:
 		sTime = offsetTime(sTime, true);
 		eTime = offsetTime(eTime, false);
 		m_tradingTimes.emplace_back(TradingSection(sTime, eTime));
+		buildTables();
 	}
 
 	void setAuctionTime(uint32_t sTime, uint32_t eTime)
@@ -81,6 +98,7 @@ public:
 			m_auctionTimes[0].first = sTime;
 			m_auctionTimes[0].second = eTime;
 		}
+		buildTables();
 	}
 
 	void addAuctionTime(uint32_t sTime, uint32_t eTime)
@@ -89,9 +107,25 @@ public:
 		eTime = offsetTime(eTime, false);
 
 		m_auctionTimes.emplace_back(TradingSection(sTime, eTime));
+		buildTables();
+	}
+
+	void setOffsetMins(int32_t offset)
+	{
+		m_uOffsetMins = offset;
+		buildTables();
 	}
 
-	void setOffsetMins(int32_t offset){m_uOffsetMins = offset;}
+	/*
+	 *	ֱѾƫƹĽʱκͼϾʱ, ֻһβұ
+	 *	ӻݿջָʱ
+	 */
+	void setSections(const TradingTimes& tradingTimes, const TradingTimes& auctionTimes)
+	{
+		m_tradingTimes = tradingTimes;
+		m_auctionTimes = auctionTimes;
+		buildTables();
+	}
 
 	const TradingTimes&		getTradingSections() const{ return m_tradingTimes; }
 	const TradingTimes&		getAuctionSections() const{ return m_auctionTimes; }
@@ -132,7 +166,65 @@ public:
 	 *				᲻бӰ,ʱ޷ȷ,Ҫǵķǽʱյ
 	 *				нʱ,Ӧû
 	 */
-	uint32_t timeToMinutes(uint32_t uTime, bool autoAdjust = false)
+	uint32_t timeToMinutes(uint32_t uTime, bool autoAdjust = false) const
+	{
+		uint32_t idx = minuteIndex(uTime);
+		if (idx == INVALID_UINT32 || m_minsOfTime.empty())
+			return calcTimeToMinutes(uTime, autoAdjust);
+
+		return m_minsOfTime[autoAdjust ? (1440 + idx) : idx];
+	}
+
+	uint32_t minuteToTime(uint32_t uMinutes, bool bHeadFirst = false) const
+	{
+		if (m_timeOfMins.empty())
+			return calcMinuteToTime(uMinutes, bHeadFirst);
+
+		//׷Ķʱ
+		if (uMinutes > m_uTableMins)
+			return getCloseTime();
+
+		return m_timeOfMins[bHeadFirst ? (m_uTableMins + 1 + uMinutes) : uMinutes];
+	}
+
+	uint32_t timeToSeconds(uint32_t uTime) const
+	{
+		uint32_t sec = uTime % 100;
+		uint32_t idx = minuteIndex(uTime / 100);
+		if (idx == INVALID_UINT32 || sec >= 60 || m_secsOfTime.empty())
+			return calcTimeToSeconds(uTime);
+
+		const uint32_t* item = &m_secsOfTime[idx * 3];
+		if (sec == 0)
+			return item[0];
+
+		if (item[1] == INVALID_UINT32)
+			return INVALID_UINT32;
+
+		return item[1] + (sec - 1)*item[2];
+	}
+
+	uint32_t secondsToTime(uint32_t seconds) const
+	{
+		if (m_timeOfMins.empty())
+			return calcSecondsToTime(seconds);
+
+		if (seconds > m_uTableMins * 60)
+			return INVALID_UINT32;
+
+		//ӵβ, պСڽҪСڵĽʱ, ӵľͷ
+		uint32_t uMinutes = seconds / 60;
+		uint32_t sec = seconds % 60;
+		if (sec == 0)
+			return m_timeOfMins[uMinutes] * 100;
+		else
+			return m_timeOfMins[m_uTableMins + 1 + uMinutes] * 100 + sec;
+	}
+
+	/*
+	 *	ΪĻ, ɲұ, Լұǲ
+	 */
+	uint32_t calcTimeToMinutes(uint32_t uTime, bool autoAdjust = false) const
 	{
 		if(m_tradingTimes.empty())
 			return INVALID_UINT32;
@@ -147,7 +239,7 @@ public:
 		auto it = m_tradingTimes.begin();
 		for(; it != m_tradingTimes.end(); it++)
 		{
-			TradingSection &section = *it;
+			const TradingSection &section = *it;
 			if (section.first <= offTime && offTime <= section.second)
 			{
 				int32_t hour = offTime / 100 - section.first / 100;
@@ -179,16 +271,16 @@ public:
 		return offset;
 	}
 
-	uint32_t minuteToTime(uint32_t uMinutes, bool bHeadFirst = false)
+	uint32_t calcMinuteToTime(uint32_t uMinutes, bool bHeadFirst = false) const
 	{
 		if(m_tradingTimes.empty())
 			return INVALID_UINT32;
 
 		uint32_t offset = uMinutes;
-		TradingTimes::iterator it = m_tradingTimes.begin();
+		TradingTimes::const_iterator it = m_tradingTimes.begin();
 		for(; it != m_tradingTimes.end(); it++)
 		{
-			TradingSection &section = *it;
+			const TradingSection &section = *it;
 			uint32_t startMin = section.first/100*60 + section.first%100;
 			uint32_t stopMin = section.second/100*60 + section.second%100;
 
@@ -233,7 +325,7 @@ public:
 		return getCloseTime();
 	}
 
-	uint32_t timeToSeconds(uint32_t uTime)
+	uint32_t calcTimeToSeconds(uint32_t uTime) const
 	{
 		if(m_tradingTimes.empty())
 			return INVALID_UINT32;
@@ -252,10 +344,10 @@ public:
 
 		uint32_t offset = 0;
 		bool bFound = false;
-		TradingTimes::iterator it = m_tradingTimes.begin();
+		TradingTimes::const_iterator it = m_tradingTimes.begin();
 		for(; it != m_tradingTimes.end(); it++)
 		{
-			TradingSection &section = *it;
+			const TradingSection &section = *it;
 			uint32_t startSecs = (section.first/100*60 + section.first%100)*60;
 			uint32_t stopSecs = (section.second/100*60 + section.second%100)*60;
 			//uint32_t s = section.first;
@@ -283,16 +375,16 @@ public:
 		return offset;
 	}
 
-	uint32_t secondsToTime(uint32_t seconds)
+	uint32_t calcSecondsToTime(uint32_t seconds) const
 	{
 		if(m_tradingTimes.empty())
 			return INVALID_UINT32;
 
 		uint32_t offset = seconds;
-		TradingTimes::iterator it = m_tradingTimes.begin();
+		TradingTimes::const_iterator it = m_tradingTimes.begin();
 		for(; it != m_tradingTimes.end(); it++)
 		{
-			TradingSection &section = *it;
+			const TradingSection &section = *it;
 			uint32_t startSecs = (section.first/100*60 + section.first%100)*60;
 			uint32_t stopSecs = (section.second/100*60 + section.second%100)*60;
 
@@ -361,78 +453,26 @@ public:
 		return ret;
 	}
 
-	inline uint32_t getTradingSeconds()
+	inline uint32_t getTradingSeconds() const
 	{
-		uint32_t count = 0;
-		TradingTimes::iterator it = m_tradingTimes.begin();
-		for(; it != m_tradingTimes.end(); it++)
-		{
-			TradingSection &section = *it;
-			uint32_t s = section.first;
-			uint32_t e = section.second;
-
-			uint32_t hour = (e/100 - s/100);
-			uint32_t minute = (e%100 - s%100);
-			count += hour*60+minute;
-		}
-
-		//By Welsey @ 2021.12.25
-		//ֻȫʱ
-		if (count == 0) count = 1440;
-		return count*60;
+		return m_uTradingMins * 60;
 	}
 
 	/*
 	 *	ȡ׵ķ
 	 */
-	inline uint32_t getTradingMins()
+	inline uint32_t getTradingMins() const
 	{
-		uint32_t count = 0;
-		TradingTimes::iterator it = m_tradingTimes.begin();
-		for (; it != m_tradingTimes.end(); it++)
-		{
-			TradingSection &section = *it;
-			uint32_t s = section.first;
-			uint32_t e = section.second;
-
-			uint32_t hour = (e / 100 - s / 100);
-			uint32_t minute = (e % 100 - s % 100);
-			count += hour * 60 + minute;
-		}
-		//By Welsey @ 2021.12.25
-		//ֻȫʱ
-		if (count == 0) count = 1440;
-		return count;
+		return m_uTradingMins;
 	}
 
 	/*
 	 *	ȡСڷб
+	 *	ǰǺڵľ̬, нʱģ干һ, ĳÿģԼ
 	 */
-	inline const std::vector<uint32_t>& getSecMinList()
+	inline const std::vector<uint32_t>& getSecMinList() const
 	{
-		static std::vector<uint32_t> minutes;
-		if(minutes.empty())
-		{
-			uint32_t total = 0;
-			TradingTimes::iterator it = m_tradingTimes.begin();
-			for (; it != m_tradingTimes.end(); it++)
-			{
-				TradingSection &section = *it;
-				uint32_t s = section.first;
-				uint32_t e = section.second;
-
-				uint32_t hour = (e / 100 - s / 100);
-				uint32_t minute = (e % 100 - s % 100);
-
-				total += hour * 60 + minute;
-				minutes.emplace_back(total);
-			}
-			
-			if (minutes.empty())
-				minutes.emplace_back(1440);
-		}
-		
-		return minutes;
+		return m_secMinList;
 	}
 
 	/*
@@ -481,7 +521,7 @@ public:
 		return false;
 	}
 
-	inline bool	isInAuctionTime(uint32_t uTime)
+	inline bool	isInAuctionTime(uint32_t uTime) const
 	{
 		uint32_t offTime = offsetTime(uTime, true);
 		
@@ -535,6 +575,84 @@ public:
 
 		return (curMinute/60)*100 + curMinute%60;
 	}
+
+private:
+	/*
+	 *	hhmmʽʱתһеķ, Ϸʱ䷵INVALID_UINT32
+	 */
+	static inline uint32_t minuteIndex(uint32_t uTime)
+	{
+		uint32_t h = uTime / 100;
+		uint32_t m = uTime % 100;
+		if (h >= 24 || m >= 60)
+			return INVALID_UINT32;
+
+		return h * 60 + m;
+	}
+
+	/*
+	 *	ʱΡϾʱλƫƷıԺ, ɲұ
+	 *	ұȫɲĻ, Խǰȫһ
+	 */
+	void buildTables()
+	{
+		m_uTradingMins = 0;
+		m_secMinList.clear();
+		for (const TradingSection& section : m_tradingTimes)
+		{
+			uint32_t s = section.first;
+			uint32_t e = section.second;
+
+			uint32_t hour = (e / 100 - s / 100);
+			uint32_t minute = (e % 100 - s % 100);
+
+			m_uTradingMins += hour * 60 + minute;
+			m_secMinList.emplace_back(m_uTradingMins);
+		}
+
+		m_uTableMins = m_uTradingMins;
+		m_minsOfTime.clear();
+		m_timeOfMins.clear();
+		m_secsOfTime.clear();
+		if (m_tradingTimes.empty())
+		{
+			//By Welsey @ 2021.12.25
+			//ֻȫʱ
+			m_uTradingMins = 1440;
+			m_secMinList.emplace_back(1440);
+			return;
+		}
+
+		m_minsOfTime.resize(1440 * 2);
+		m_secsOfTime.resize(1440 * 3);
+		for (uint32_t idx = 0; idx < 1440; idx++)
+		{
+			uint32_t uTime = idx / 60 * 100 + idx % 60;
+			m_minsOfTime[idx] = calcTimeToMinutes(uTime, false);
+			m_minsOfTime[1440 + idx] = calcTimeToMinutes(uTime, true);
+
+			uint32_t first = calcTimeToSeconds(uTime * 100 + 1);
+			m_secsOfTime[idx * 3] = calcTimeToSeconds(uTime * 100);
+			m_secsOfTime[idx * 3 + 1] = first;
+			m_secsOfTime[idx * 3 + 2] = (first == INVALID_UINT32) ? 0 : (calcTimeToSeconds(uTime * 100 + 2) - first);
+		}
+
+		//ʱıֻʵʵĽ׷, С쳣ľͲ, ֱӼ
+		if (m_uTableMins > 2880)
+			return;
+
+		m_timeOfMins.resize((m_uTableMins + 1) * 2);
+		for (uint32_t uMinutes = 0; uMinutes <= m_uTableMins; uMinutes++)
+		{
+			m_timeOfMins[uMinutes] = calcMinuteToTime(uMinutes, false);
+			m_timeOfMins[m_uTableMins + 1 + uMinutes] = calcMinuteToTime(uMinutes, true);
+		}
+
+		//By Welsey @ 2021.12.25
+		//ֻȫʱ
+		if (m_uTradingMins == 0)
+			m_uTradingMins = 1440;
+	}
 };
 
 NS_WTP_END
\ No newline at end of file
@@ -371,5 +371,7 @@ typedef uint32_t WTSOrdDetailType;
 #define ODT_BestPrice	'U'	//
 #define ODT_AnyPrice	'1'	//м
 #define ODT_LimitPrice	'2'	//޼
+#define ODT_Add			'A'	//ί, Ͻ
+#define ODT_Delete		'D'	//ɾί, Ͻĳί
 
 NS_WTP_END
\ No newline at end of file
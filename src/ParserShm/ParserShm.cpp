@@ -0,0 +1,291 @@
+/*!
+ * \file ParserShm.cpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/16
+ * 
+ * \brief 
+ */
+#include "ParserShm.h"
+#include "../Includes/WTSVariant.hpp"
+#include "../Includes/WTSDataDef.hpp"
+
+#include "../Share/fmtlib.h"
+template<typename... Args>
+inline void write_log(IParserSpi* sink, WTSLogLevel ll, const char* format, const Args&... args)
+{
+	if (sink == NULL)
+		return;
+
+	static thread_local char buffer[512] = { 0 };
+	fmtutil::format_to(buffer, format, args...);
+
+	sink->handleParserLog(ll, buffer);
+}
+
+extern "C"
+{
+	EXPORT_FLAG IParserApi* createParser()
+	{
+		ParserShm* parser = new ParserShm();
+		return parser;
+	}
+
+	EXPORT_FLAG void deleteParser(IParserApi* &parser)
+	{
+		if (NULL != parser)
+		{
+			delete parser;
+			parser = NULL;
+		}
+	}
+};
+
+
+ParserShm::ParserShm()
+	: _spin(false)
+	, _gpsize(1000)
+	, _sink(NULL)
+	, _stopped(false)
+{
+}
+
+
+ParserShm::~ParserShm()
+{
+}
+
+bool ParserShm::init(WTSVariant* config)
+{
+	_name = config->getCString("name");
+	if (_name.empty())
+		_name = "WtTickBus";
+
+	_spin = config->getBoolean("spin");
+	_gpsize = config->getUInt32("gpsize");
+	if (_gpsize == 0)
+		_gpsize = 1000;
+
+	return true;
+}
+
+void ParserShm::release()
+{
+	disconnect();
+}
+
+bool ParserShm::connect()
+{
+	if (_thrd_parser)
+		return true;
+
+	_stopped = false;
+	_thrd_parser.reset(new StdThread([this]() {
+		read_loop();
+	}));
+
+	return true;
+}
+
+bool ParserShm::disconnect()
+{
+	_stopped = true;
+	if (_thrd_parser)
+	{
+		_thrd_parser->join();
+		_thrd_parser.reset();
+	}
+
+	return true;
+}
+
+bool ParserShm::isConnected()
+{
+	return _bus.valid();
+}
+
+void ParserShm::subscribe(const CodeSet &vecSymbols)
+{
+	SpinLock lock(_mtx_subs);
+	for (const auto& code : vecSymbols)
+		_set_subs.insert(code);
+}
+
+void ParserShm::unsubscribe(const CodeSet &setSymbols)
+{
+	SpinLock lock(_mtx_subs);
+	for (const auto& code : setSymbols)
+		_set_subs.erase(code);
+}
+
+bool ParserShm::is_subscribed(const char* exchg, const char* code)
+{
+	thread_local static char key[64] = { 0 };
+	fmtutil::format_to(key, "{}.{}", exchg, code);
+
+	SpinLock lock(_mtx_subs);
+	//ûжκκԼʱ, ϵȫת
+	if (_set_subs.empty())
+		return true;
+
+	return _set_subs.find(key) != _set_subs.end();
+}
+
+void ParserShm::registerSpi(IParserSpi* listener)
+{
+	bool bReplaced = (_sink != NULL);
+	_sink = listener;
+	if (bReplaced && _sink)
+	{
+		write_log(_sink, LL_WARN, "Listener is replaced");
+	}
+}
+
+void ParserShm::read_loop()
+{
+	bool bReopen = false;
+	while (!_stopped)
+	{
+		//QuoteFactoryܻû, ߴ򲻿һֱ
+		while (!_stopped)
+		{
+			if (_bus.open(_name.c_str()))
+				break;
+
+			write_log(_sink, LL_WARN, "[ParserShm] Opening tick bus {} failed, retry in 2 seconds", _name);
+			std::this_thread::sleep_for(std::chrono::seconds(2));
+		}
+
+		if (_stopped)
+			break;
+
+		write_log(_sink, LL_INFO, "[ParserShm] Tick bus {} opened, {} slots", _name, _bus.capacity());
+		if (_sink && !bReopen)
+		{
+			_sink->handleEvent(WPE_Connect, 0);
+			_sink->handleEvent(WPE_Login, 0);
+		}
+
+		//һδֻ֮д, ´򿪵ʱдǸ, ͷʼ
+		uint64_t cursor = bReopen ? 0 : _bus.tail();
+		bReopen = read_bus(cursor);
+		_bus.close();
+
+		if (bReopen)
+			write_log(_sink, LL_WARN, "[ParserShm] Tick bus {} has been recreated by the writer, reopening", _name);
+	}
+
+	if (_sink)
+		_sink->handleEvent(WPE_Close, 0);
+}
+
+bool ParserShm::read_bus(uint64_t cursor)
+{
+	const uint64_t CHECK_INTERVAL = 1000000000ULL;	//ʱÿһǷؽ
+
+	uint64_t epoch = _bus.epoch();
+	uint64_t lastCheck = ShmTickBus::now_nano();
+	char buffer[ShmTickBus::MAX_DATA_SIZE];
+	uint32_t type = 0;
+	uint64_t stamp = 0;
+	uint64_t lost = 0;
+	uint32_t idles = 0;
+	while (!_stopped)
+	{
+		ShmTickBus::ReadResult ret = _bus.read(cursor, type, buffer, stamp, lost);
+		if (ret == ShmTickBus::RR_Ok)
+		{
+			idles = 0;
+			extract_data(type, buffer);
+			continue;
+		}
+
+		if (ret == ShmTickBus::RR_Lost)
+		{
+			write_log(_sink, LL_ERROR, "[ParserShm] Reading too slow, {} items lost", lost);
+			continue;
+		}
+
+		idles++;
+		if (idles % 64 == 0)
+		{
+			//дɾɵĹڴؽ, ɵӳһֱЧ
+			uint64_t now = ShmTickBus::now_nano();
+			if (now - lastCheck >= CHECK_INTERVAL)
+			{
+				lastCheck = now;
+				uint64_t curEpoch = ShmTickBus::probe_epoch(_name.c_str());
+				if (curEpoch != 0 && curEpoch != epoch)
+					return true;
+			}
+		}
+
+		if (!_spin)
+		{
+			//Ļ, óʱƬ, û
+			if (idles < 64)
+				std::this_thread::yield();
+			else
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}
+
+	return false;
+}
+
+void ParserShm::extract_data(uint32_t type, char* data)
+{
+	if (type == SBT_Tick)
+	{
+		WTSTickStruct* ts = (WTSTickStruct*)data;
+		if (!is_subscribed(ts->exchg, ts->code))
+			return;
+
+		WTSTickData* curTick = WTSTickData::create(*ts);
+		if (_sink)
+			_sink->handleQuote(curTick, 0);
+
+		curTick->release();
+
+		static uint32_t recv_cnt = 0;
+		recv_cnt++;
+		if (recv_cnt % _gpsize == 0)
+			write_log(_sink, LL_DEBUG, "[ParserShm] {} ticks received in total", recv_cnt);
+	}
+	else if (type == SBT_OrdDtl)
+	{
+		WTSOrdDtlStruct* ds = (WTSOrdDtlStruct*)data;
+		if (!is_subscribed(ds->exchg, ds->code))
+			return;
+
+		WTSOrdDtlData* curData = WTSOrdDtlData::create(*ds);
+		if (_sink)
+			_sink->handleOrderDetail(curData);
+
+		curData->release();
+	}
+	else if (type == SBT_OrdQue)
+	{
+		WTSOrdQueStruct* qs = (WTSOrdQueStruct*)data;
+		if (!is_subscribed(qs->exchg, qs->code))
+			return;
+
+		WTSOrdQueData* curData = WTSOrdQueData::create(*qs);
+		if (_sink)
+			_sink->handleOrderQueue(curData);
+
+		curData->release();
+	}
+	else if (type == SBT_Trans)
+	{
+		WTSTransStruct* ts = (WTSTransStruct*)data;
+		if (!is_subscribed(ts->exchg, ts->code))
+			return;
+
+		WTSTransData* curData = WTSTransData::create(*ts);
+		if (_sink)
+			_sink->handleTransaction(curData);
+
+		curData->release();
+	}
+}
@@ -0,0 +1,68 @@
+/*!
+ * \file ParserShm.h
+ * \project	WonderTrader
+ *
+ * \date 2023/09/16
+ * 
+ * \brief ڴģ
+ *
+ * QuoteFactoryĹڴ϶ȡ飬ںQuoteFactoryͬһ̨ϵĽ׽
+ */
+#pragma once
+#include "../Includes/IParserApi.h"
+#include "../Share/StdUtils.hpp"
+#include "../Share/ShmTickBus.hpp"
+#include "../Share/SpinMutex.hpp"
+
+USING_NS_WTP;
+
+class ParserShm : public IParserApi
+{
+public:
+	ParserShm();
+	~ParserShm();
+
+	//IQuoteParser ӿ
+public:
+	virtual bool init(WTSVariant* config) override;
+
+	virtual void release() override;
+
+	virtual bool connect() override;
+
+	virtual bool disconnect() override;
+
+	virtual bool isConnected() override;
+
+	virtual void subscribe(const CodeSet &vecSymbols) override;
+	virtual void unsubscribe(const CodeSet &vecSymbols) override;
+
+	virtual void registerSpi(IParserSpi* listener) override;
+
+private:
+	void	read_loop();
+
+	/*
+	 *	ȡֱֹͣ, дؽ
+	 *	дؽ߷true, Ҫ´
+	 */
+	bool	read_bus(uint64_t cursor);
+
+	bool	is_subscribed(const char* exchg, const char* code);
+
+	void	extract_data(uint32_t type, char* data);
+
+private:
+	std::string		_name;
+	bool			_spin;		//ûʱǷȴ
+	uint32_t		_gpsize;
+
+	ShmTickBus		_bus;
+
+	IParserSpi*		_sink;
+	bool			_stopped;
+	StdThreadPtr	_thrd_parser;
+
+	SpinMutex		_mtx_subs;
+	CodeSet			_set_subs;
+};
@@ -32,6 +32,7 @@ inline void write_log(IParserSpi* sink, WTSLogLevel ll, const char* format, cons
 #define UDP_MSG_PUSHORDQUE	0x201	//ίж
 #define UDP_MSG_PUSHORDDTL	0x202	//ίϸ
 #define UDP_MSG_PUSHTRANS	0x203	//ʳɽ
+#define UDP_MSG_PUSHBATCH	0x2FF	//ϲݰ
 
 #pragma pack(push,1)
 
@@ -51,6 +52,12 @@ struct UDPDataPacket : UDPPacketHead
 {
 	T			_data;
 };
+
+//ϲݰİͷ_countUDPDataPacket
+typedef struct _UDPBatchHead : UDPPacketHead
+{
+	uint32_t	_count;
+} UDPBatchHead;
 #pragma pack(pop)
 typedef UDPDataPacket<WTSTickStruct>	UDPTickPacket;
 typedef UDPDataPacket<WTSOrdQueStruct>	UDPOrdQuePacket;
@@ -346,14 +353,44 @@ void ParserUDP::handle_read(const boost::system::error_code& e, std::size_t byte
 
 void ParserUDP::extract_buffer(uint32_t length, bool isBroad /* = true */)
 {
-	UDPPacketHead* header = NULL;
-	if(isBroad)
-		header = (UDPTickPacket*)_b_buffer.data();
-	else
-		header = (UDPTickPacket*)_s_buffer.data();
+	char* data = isBroad ? _b_buffer.data() : _s_buffer.data();
+	if (length < sizeof(UDPPacketHead))
+		return;
+
+	const UDPPacketHead* header = (const UDPPacketHead*)data;
+	if (header->_type != UDP_MSG_PUSHBATCH)
+	{
+		extract_packet(data, length);
+		return;
+	}
+
+	//ϲݰ
+	if (length < sizeof(UDPBatchHead))
+		return;
+
+	const UDPBatchHead* batch = (const UDPBatchHead*)data;
+	uint32_t offset = sizeof(UDPBatchHead);
+	for (uint32_t i = 0; i < batch->_count && offset < length; i++)
+	{
+		uint32_t pktLen = extract_packet(data + offset, length - offset);
+		if (pktLen == 0)
+		{
+			write_log(_sink, LL_ERROR, "[ParserUDP] Invalid batch packet, {} of {} extracted", i, batch->_count);
+			break;
+		}
 
+		offset += pktLen;
+	}
+}
+
+uint32_t ParserUDP::extract_packet(char* data, uint32_t length)
+{
+	UDPPacketHead* header = (UDPPacketHead*)data;
 	if (header->_type == UDP_MSG_PUSHTICK || header->_type == UDP_MSG_SUBSCRIBE)
 	{
+		if (length < sizeof(UDPTickPacket))
+			return 0;
+
 		UDPTickPacket* packet = (UDPTickPacket*)header;
 		WTSTickData* curTick = WTSTickData::create(packet->_data);
 		if (_sink)
@@ -365,9 +402,14 @@ void ParserUDP::extract_buffer(uint32_t length, bool isBroad /* = true */)
 		recv_cnt++;
 		if (recv_cnt % _gpsize == 0)
 			write_log(_sink, LL_DEBUG, "[ParserUDP] {} ticks received in total", recv_cnt);
+
+		return sizeof(UDPTickPacket);
 	}
 	else if (header->_type == UDP_MSG_PUSHORDDTL)
 	{
+		if (length < sizeof(UDPOrdDtlPacket))
+			return 0;
+
 		UDPOrdDtlPacket* packet = (UDPOrdDtlPacket*)header;
 		WTSOrdDtlData* curData = WTSOrdDtlData::create(packet->_data);
 		if (_sink)
@@ -379,9 +421,14 @@ void ParserUDP::extract_buffer(uint32_t length, bool isBroad /* = true */)
 		recv_cnt++;
 		if (recv_cnt % _gpsize == 0)
 			write_log(_sink, LL_DEBUG, "[ParserUDP] {} order details received in total", recv_cnt);
+
+		return sizeof(UDPOrdDtlPacket);
 	}
 	else if (header->_type == UDP_MSG_PUSHORDQUE)
 	{
+		if (length < sizeof(UDPOrdQuePacket))
+			return 0;
+
 		UDPOrdQuePacket* packet = (UDPOrdQuePacket*)header;
 		WTSOrdQueData* curData = WTSOrdQueData::create(packet->_data);
 		if (_sink)
@@ -393,9 +440,14 @@ void ParserUDP::extract_buffer(uint32_t length, bool isBroad /* = true */)
 		recv_cnt++;
 		if (recv_cnt % _gpsize == 0)
 			write_log(_sink, LL_DEBUG, "[ParserUDP] {} order queues received in total", recv_cnt);
+
+		return sizeof(UDPOrdQuePacket);
 	}
 	else if (header->_type == UDP_MSG_PUSHTRANS)
 	{
+		if (length < sizeof(UDPTransPacket))
+			return 0;
+
 		UDPTransPacket* packet = (UDPTransPacket*)header;
 		WTSTransData* curData = WTSTransData::create(packet->_data);
 		if (_sink)
@@ -407,7 +459,11 @@ void ParserUDP::extract_buffer(uint32_t length, bool isBroad /* = true */)
 		recv_cnt++;
 		if (recv_cnt % _gpsize == 0)
 			write_log(_sink, LL_DEBUG, "[ParserUDP] {} transactions received in total", recv_cnt);
+
+		return sizeof(UDPTransPacket);
 	}
+
+	return 0;
 }
 
 void ParserUDP::doOnConnected()
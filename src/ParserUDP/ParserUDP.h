@@ -54,6 +54,14 @@ private:
 
 	void	extract_buffer(uint32_t length, bool isBroad);
 
+	/*
+	 *	һݰ
+	 *	@data	ݰַ
+	 *	@length	õݳ
+	 *	@return	ݰʵʳȣݲ߲ʶݰ0
+	 */
+	uint32_t	extract_packet(char* data, uint32_t length);
+
 private:
 	void	doOnConnected();
 	void	doOnDisconnected();
@@ -76,7 +84,8 @@ private:
 	ip::udp::socket*	_s_socket;
 	bool				_s_inited;
 
-	boost::array<char, 1024> _b_buffer;
+	//㲥˿ܻϲͣ水UDPݰ󳤶ȷ
+	boost::array<char, 65536> _b_buffer;
 	boost::array<char, 1024> _s_buffer;
 
 	IParserSpi*				_sink;
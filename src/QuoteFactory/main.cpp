@@ -2,6 +2,7 @@
 #include "../WtDtCore/DataManager.h"
 #include "../WtDtCore/StateMonitor.h"
 #include "../WtDtCore/UDPCaster.h"
+#include "../WtDtCore/ShmCaster.h"
 #include "../WtDtCore/WtHelper.h"
 #include "../WtDtCore/IndexFactory.h"
 
@@ -21,6 +22,7 @@ WTSHotMgr		g_hotMgr;
 boost::asio::io_service g_asyncIO;
 StateMonitor	g_stateMon;
 UDPCaster		g_udpCaster;
+ShmCaster		g_shmCaster;
 DataManager		g_dataMgr;
 ParserAdapterMgr g_parsers;
 IndexFactory	g_idxFactory;
@@ -62,7 +64,7 @@ const char* getBinDir()
 void initDataMgr(WTSVariant* config, bool bAlldayMode = false)
 {
 	//ȫģʽ򲻴״̬DataManager
-	g_dataMgr.init(config, &g_baseDataMgr, bAlldayMode ? NULL : &g_stateMon, &g_udpCaster);
+	g_dataMgr.init(config, &g_baseDataMgr, bAlldayMode ? NULL : &g_stateMon, &g_udpCaster, &g_shmCaster);
 }
 
 void initParsers(WTSVariant* cfg)
@@ -112,49 +114,8 @@ void initialize()
 
 	//гϢ
 	WTSVariant* cfgBF = config->get("basefiles");
-	if (cfgBF->get("session"))
-	{
-		g_baseDataMgr.loadSessions(cfgBF->getCString("session"));
-		WTSLogger::info("Trading sessions loaded");
-	}
+	g_baseDataMgr.loadBaseFiles(cfgBF);
 
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			g_baseDataMgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				g_baseDataMgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			g_baseDataMgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				g_baseDataMgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	if (cfgBF->get("holiday"))
-	{
-		g_baseDataMgr.loadHolidays(cfgBF->getCString("holiday"));
-		WTSLogger::info("Holidays loaded");
-	}
 	if (cfgBF->get("hot"))
 	{
 		g_hotMgr.loadHots(cfgBF->getCString("hot"));
@@ -179,6 +140,10 @@ void initialize()
 	}
 
 	g_udpCaster.init(config->get("broadcaster"), &g_baseDataMgr, &g_dataMgr);
+
+	//ڴߣͬһ̨ϵĽ׽̿ͨParserShm
+	if (config->has("shmcaster"))
+		g_shmCaster.init(config->get("shmcaster"));
 
 	//By Wesley @ 2021.12.27
 	//ȫģʽҪʹ״̬
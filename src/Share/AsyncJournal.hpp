@@ -0,0 +1,310 @@
+/*!
+ * \file AsyncJournal.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/09
+ *
+ * \brief 첽дˮļ
+ *
+ * Եĳɽƽ֡źšʽˮԭڲԻصֱдļ
+ * һ, Իص͸ſ
+ * ĳȸʽÿļԼĻ, һĺ̶̨߳ʱд
+ * ֻ׷Ӻͽʱ, ȴ
+ */
+#pragma once
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include <condition_variable>
+
+#include "BoostFile.hpp"
+#include "SpinMutex.hpp"
+#include "StdUtils.hpp"
+#include "fmtlib.h"
+
+/*
+ *	̲
+ */
+typedef enum tagJournalSyncPolicy
+{
+	JSP_None = 0,	//, ϵͳ
+	JSP_Batch,		//ÿдԺ
+	JSP_Session		//ֻڽսʱ
+} JournalSyncPolicy;
+
+class JournalFile
+{
+public:
+	JournalFile() :_dirty(false){}
+
+	~JournalFile()
+	{
+		flush(false);
+		_file.close_file();
+	}
+
+	/*
+	 *	ļ, ļдͷ
+	 *	@filename	ļ
+	 *	@header		ͷ
+	 */
+	bool open(const char* filename, const char* header = "")
+	{
+		bool isNewFile = !BoostFile::exists(filename);
+		if (!_file.create_or_open_file(filename))
+			return false;
+
+		if (isNewFile)
+			_file.write_file(header, strlen(header));
+		else
+			_file.seek_to_end();
+
+		return true;
+	}
+
+	inline void append(const char* data, std::size_t len)
+	{
+		SpinLock lock(_mtx);
+		_buffer.append(data, len);
+		_dirty = true;
+	}
+
+	inline void append(const std::string& data)
+	{
+		append(data.data(), data.size());
+	}
+
+	/*
+	 *	ʽ׷, ʽ
+	 */
+	template<typename... Args>
+	inline void write(const char* format, const Args& ...args)
+	{
+		thread_local static fmt::memory_buffer buf;
+		buf.clear();
+		fmt::format_to(std::back_inserter(buf), format, args...);
+		append(buf.data(), buf.size());
+	}
+
+	inline bool dirty() const { return _dirty; }
+
+	/*
+	 *	ѻдļ
+	 *	@bSync	дԺǷ
+	 *	дֽ
+	 */
+	std::size_t flush(bool bSync)
+	{
+		StdUniqueLock ioLock(_io_mtx);
+		{
+			SpinLock lock(_mtx);
+			if (!_dirty)
+				return 0;
+
+			_writing.swap(_buffer);
+			_dirty = false;
+		}
+
+		std::size_t len = _writing.size();
+		_file.write_file(_writing);
+		_writing.clear();
+		if (bSync)
+			_file.sync_file();
+
+		return len;
+	}
+
+	inline void sync()
+	{
+		StdUniqueLock ioLock(_io_mtx);
+		_file.sync_file();
+	}
+
+private:
+	BoostFile			_file;
+	SpinMutex			_mtx;
+	std::atomic<bool>	_dirty;
+	std::string			_buffer;	//׷еĻ
+	std::string			_writing;	//дĻ
+
+	StdUniqueMutex		_io_mtx;	//̨̺߳flush֮Ļ
+};
+typedef std::shared_ptr<JournalFile> JournalFilePtr;
+
+/*
+ *	ĺ̨д߳
+ *	ļɸĳ, ֻ, ͷԺԶƳ
+ */
+class JournalWriter
+{
+private:
+	JournalWriter()
+		: _stopped(false)
+		, _interval(200)
+		, _policy(JSP_None)
+		, _timeout(1000)
+		, _rounds(0)
+		, _requested(0)
+	{
+	}
+
+public:
+	/*
+	 *	澲̬ͷ, DLLжصʱȴ߳
+	 *	˳ǰʽstop
+	 */
+	static JournalWriter& instance()
+	{
+		static JournalWriter* inst = new JournalWriter();
+		return *inst;
+	}
+
+	/*
+	 *	д
+	 *	@interval	дļ, λ
+	 *	@policy		̲
+	 *	@timeout	սʱȴдʱ, λ
+	 */
+	void configure(uint32_t interval, JournalSyncPolicy policy, uint32_t timeout = 1000)
+	{
+		StdUniqueLock lock(_mtx);
+		if (interval != 0)
+			_interval = interval;
+		_policy = policy;
+		_timeout = timeout;
+	}
+
+	inline JournalSyncPolicy policy() const { return _policy; }
+
+	/*
+	 *	һˮļ, ̨̹߳
+	 */
+	JournalFilePtr open_file(const char* filename, const char* header = "")
+	{
+		JournalFilePtr file(new JournalFile());
+		if (!file->open(filename, header))
+			return JournalFilePtr();
+
+		StdUniqueLock lock(_mtx);
+		_files.emplace_back(file);
+		if (_worker == NULL)
+		{
+			_stopped = false;
+			_worker.reset(new StdThread([this]() { run(); }));
+		}
+
+		return file;
+	}
+
+	/*
+	 *	̨֪ͨ߳д, ȴд
+	 *	@timeout	ȴʱ, λ, Ϊ0ʹõʱ, ʱfalse
+	 */
+	bool flush(uint32_t timeout = 0)
+	{
+		StdUniqueLock lock(_mtx);
+		if (_worker == NULL)
+			return true;
+
+		if (timeout == 0)
+			timeout = _timeout;
+
+		uint64_t target = ++_requested;
+		_cond.notify_all();
+		return _cond_done.wait_for(lock, std::chrono::milliseconds(timeout), [this, target]() {
+			return _rounds >= target || _stopped;
+		});
+	}
+
+	void stop()
+	{
+		{
+			StdUniqueLock lock(_mtx);
+			if (_worker == NULL)
+				return;
+
+			_stopped = true;
+			_cond.notify_all();
+		}
+
+		_worker->join();
+		_worker.reset();
+		flush_all(_policy == JSP_Batch, _policy == JSP_Session);
+	}
+
+private:
+	/*
+	 *	дļ, ˳Ѿͷŵļ
+	 *	@bSync		дļǷ
+	 *	@bSyncAll	ļ, ֮ǰд
+	 */
+	void flush_all(bool bSync, bool bSyncAll = false)
+	{
+		std::vector<JournalFilePtr> files;
+		{
+			StdUniqueLock lock(_mtx);
+			files.reserve(_files.size());
+			for (auto it = _files.begin(); it != _files.end();)
+			{
+				JournalFilePtr file = it->lock();
+				if (file)
+				{
+					files.emplace_back(file);
+					it++;
+				}
+				else
+				{
+					it = _files.erase(it);
+				}
+			}
+		}
+
+		for (JournalFilePtr& file : files)
+		{
+			std::size_t len = file->flush(bSync || bSyncAll);
+			if (len == 0 && bSyncAll)
+				file->sync();
+		}
+	}
+
+	void run()
+	{
+		StdUniqueLock lock(_mtx);
+		while (!_stopped)
+		{
+			_cond.wait_for(lock, std::chrono::milliseconds(_interval), [this]() {
+				return _stopped || _requested > _rounds;
+			});
+
+			uint64_t target = _requested;
+			bool bForced = (target > _rounds);
+			lock.unlock();
+
+			//flushʱ, sessionģʽҪļ
+			flush_all(_policy == JSP_Batch, bForced && _policy == JSP_Session);
+
+			lock.lock();
+			_rounds = target;
+			_cond_done.notify_all();
+		}
+	}
+
+private:
+	StdUniqueMutex			_mtx;
+	std::condition_variable	_cond;
+	std::condition_variable	_cond_done;
+	StdThreadPtr			_worker;
+	bool					_stopped;
+
+	uint32_t				_interval;
+	JournalSyncPolicy		_policy;
+	uint32_t				_timeout;
+
+	uint64_t				_rounds;	//Ѿɵflush
+	uint64_t				_requested;	//flush
+
+	std::vector<std::weak_ptr<JournalFile>>	_files;
+};
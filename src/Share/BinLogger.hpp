@@ -0,0 +1,981 @@
+/*!
+ * \file BinLogger.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/18
+ *
+ * \brief ӳٸʽĶ־
+ *
+ * ÿõһʱǼǸʽ, õһʽ
+ * ֻ֮߳Ѹʽšʱԭʼд̵߳Ļλ, κθʽ
+ * ̴̨߳Ӹ̵߳Ļȡ¼, ıģʽ¸ʽԺ󽻸ص, ģʽԭдļ, ý빤߻ԭ
+ * ֱӶ, ߳; ÿԵ, ɺ̶̨߳
+ */
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+
+#include "fmtlib.h"
+#include <spdlog/fmt/bundled/args.h>
+
+#include "../Includes/WTSTypes.h"
+
+//, ͬʱҲǩַ
+typedef enum tagBinArgType : char
+{
+	BAT_Int		= 'i',	//з, ͳһint64洢
+	BAT_UInt	= 'u',	//޷, ͳһuint64洢
+	BAT_Double	= 'd',	//, ͳһdouble洢
+	BAT_Bool	= 'b',
+	BAT_Char	= 'c',
+	BAT_String	= 's'	//ַ, uint32+, ʶȸʽַ
+} BinArgType;
+
+template<typename T>
+struct BinArgTraits
+{
+	typedef typename std::decay<T>::type Type;
+
+	static constexpr char type()
+	{
+		if constexpr (std::is_same<Type, bool>::value)
+			return BAT_Bool;
+		else if constexpr (std::is_same<Type, char>::value)
+			return BAT_Char;
+		else if constexpr (std::is_integral<Type>::value)
+			return std::is_signed<Type>::value ? BAT_Int : BAT_UInt;
+		else if constexpr (std::is_enum<Type>::value)
+			return BAT_Int;
+		else if constexpr (std::is_floating_point<Type>::value)
+			return BAT_Double;
+		else
+			return BAT_String;
+	}
+};
+
+/*
+ *	־õ, һǺڵľ̬, һʱǼ
+ */
+class BinLogLimiter;
+class BinLogSite
+{
+public:
+	BinLogSite(uint8_t level, const char* category, const char* format)
+		: _id(0), _level(level), _category(category == NULL ? "" : category), _format(format), _limiter(NULL) {}
+
+	std::atomic<uint32_t>	_id;		//ʽ, 0ʾûеǼ
+	uint8_t					_level;
+	const char*				_category;	//, ַʾ־
+	const char*				_format;
+	BinLogLimiter*			_limiter;
+};
+
+typedef struct _BinLogSiteInfo
+{
+	uint32_t	_id;
+	uint8_t		_level;
+	std::string	_category;
+	std::string	_format;
+	std::string	_sig;		//ǩ
+} BinLogSiteInfo;
+
+/*
+ *	, ̶ڼ
+ *	л˲ܶŹ, ־ٲҪôȷ
+ */
+class BinLogLimiter
+{
+public:
+	BinLogLimiter() :_limit(0), _window(0), _start(0), _count(0), _dropped(0) {}
+
+	/*
+	 *	@limit		ÿ, 0ʾ
+	 *	@window_ms	ڳ, λ
+	 */
+	void setup(uint32_t limit, uint32_t window_ms)
+	{
+		_window.store((uint64_t)window_ms * 1000000, std::memory_order_relaxed);
+		_limit.store(limit, std::memory_order_release);
+	}
+
+	inline bool allow(uint64_t now)
+	{
+		uint32_t limit = _limit.load(std::memory_order_acquire);
+		if (limit == 0)
+			return true;
+
+		uint64_t start = _start.load(std::memory_order_relaxed);
+		if (now - start >= _window.load(std::memory_order_relaxed))
+		{
+			if (_start.compare_exchange_strong(start, now, std::memory_order_relaxed))
+				_count.store(0, std::memory_order_relaxed);
+		}
+
+		if (_count.fetch_add(1, std::memory_order_relaxed) < limit)
+			return true;
+
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	inline uint64_t take_dropped() { return _dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+	std::atomic<uint32_t>	_limit;
+	std::atomic<uint64_t>	_window;
+	std::atomic<uint64_t>	_start;
+	std::atomic<uint32_t>	_count;
+	std::atomic<uint64_t>	_dropped;
+};
+
+/*
+ *	ߵߵֽڻλ
+ *	ÿ¼ǰuint32ĳ, 8ֽڶ, βŲµʱдһƱǴͷʼ
+ */
+class BinLogRing
+{
+public:
+	BinLogRing(uint32_t capacity) :_head(0), _tail(0), _retired(false)
+	{
+		uint32_t cap = 4096;
+		while (cap < capacity)
+			cap <<= 1;
+		_buffer.resize(cap);
+		_capacity = cap;
+	}
+
+	static const uint32_t WRAP_MARK = 0xFFFFFFFF;
+
+	bool push(const char* data, uint32_t len)
+	{
+		uint64_t total = align(sizeof(uint32_t) + len);
+		uint64_t head = _head.load(std::memory_order_relaxed);
+		uint64_t tail = _tail.load(std::memory_order_acquire);
+		uint64_t pos = head & (_capacity - 1);
+		uint64_t contiguous = _capacity - pos;
+		uint64_t need = (total > contiguous) ? (contiguous + total) : total;
+		if (total > _capacity / 2 || head + need - tail > _capacity)
+			return false;
+
+		if (total > contiguous)
+		{
+			memcpy(&_buffer[pos], &WRAP_MARK, sizeof(uint32_t));
+			head += contiguous;
+			pos = 0;
+		}
+
+		memcpy(&_buffer[pos], &len, sizeof(uint32_t));
+		memcpy(&_buffer[pos + sizeof(uint32_t)], data, len);
+		_head.store(head + total, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 *	ȡȫ¼, ȡ
+	 */
+	template<typename Callback>
+	uint32_t drain(Callback cb)
+	{
+		uint64_t tail = _tail.load(std::memory_order_relaxed);
+		uint64_t head = _head.load(std::memory_order_acquire);
+		uint32_t cnt = 0;
+		while (tail < head)
+		{
+			uint64_t pos = tail & (_capacity - 1);
+			uint32_t len;
+			memcpy(&len, &_buffer[pos], sizeof(uint32_t));
+			if (len == WRAP_MARK)
+			{
+				tail += _capacity - pos;
+				continue;
+			}
+
+			cb(&_buffer[pos + sizeof(uint32_t)], len);
+			tail += align(sizeof(uint32_t) + len);
+			cnt++;
+		}
+		_tail.store(tail, std::memory_order_release);
+		return cnt;
+	}
+
+	inline bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+
+	inline void retire() { _retired.store(true, std::memory_order_release); }
+	inline bool retired() const { return _retired.load(std::memory_order_acquire); }
+
+private:
+	static inline uint64_t align(uint64_t sz) { return (sz + 7) & ~(uint64_t)7; }
+
+private:
+	std::vector<char>		_buffer;
+	uint64_t				_capacity;
+	alignas(64) std::atomic<uint64_t>	_head;
+	alignas(64) std::atomic<uint64_t>	_tail;
+	std::atomic<bool>		_retired;
+};
+typedef std::shared_ptr<BinLogRing> BinLogRingPtr;
+
+/*
+ *	¼ʽ, ̵̨߳ıģʽͽ빤߹
+ *	¼: uint32ʽ | uint64ʱ() | 
+ */
+class BinLogDecoder
+{
+public:
+	static const uint32_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+
+	void add_site(const BinLogSiteInfo& info)
+	{
+		if (_sites.size() <= info._id)
+			_sites.resize(info._id + 1);
+		_sites[info._id] = info;
+	}
+
+	inline const BinLogSiteInfo* get_site(uint32_t id) const
+	{
+		if (id >= _sites.size() || _sites[id]._id == 0)
+			return NULL;
+
+		return &_sites[id];
+	}
+
+	/*
+	 *	һ¼
+	 *	@message	ʽԺ
+	 *	ضӦĵõ, ʽŲʶ߼¼NULL
+	 */
+	const BinLogSiteInfo* decode(const char* data, uint32_t len, uint64_t& stamp, std::string& message) const
+	{
+		if (len < HEADER_SIZE)
+			return NULL;
+
+		uint32_t id;
+		memcpy(&id, data, sizeof(uint32_t));
+		memcpy(&stamp, data + sizeof(uint32_t), sizeof(uint64_t));
+		const BinLogSiteInfo* site = get_site(id);
+		if (site == NULL)
+			return NULL;
+
+		const char* p = data + HEADER_SIZE;
+		const char* end = data + len;
+		fmt::dynamic_format_arg_store<fmt::format_context> store;
+		for (char t : site->_sig)
+		{
+			switch (t)
+			{
+			case BAT_Int:
+			{
+				int64_t v;
+				if (!read(p, end, &v, sizeof(v))) return NULL;
+				store.push_back(v);
+				break;
+			}
+			case BAT_UInt:
+			{
+				uint64_t v;
+				if (!read(p, end, &v, sizeof(v))) return NULL;
+				store.push_back(v);
+				break;
+			}
+			case BAT_Double:
+			{
+				double v;
+				if (!read(p, end, &v, sizeof(v))) return NULL;
+				store.push_back(v);
+				break;
+			}
+			case BAT_Bool:
+			{
+				char v;
+				if (!read(p, end, &v, sizeof(v))) return NULL;
+				store.push_back(v != 0);
+				break;
+			}
+			case BAT_Char:
+			{
+				char v;
+				if (!read(p, end, &v, sizeof(v))) return NULL;
+				store.push_back(v);
+				break;
+			}
+			case BAT_String:
+			{
+				uint32_t slen;
+				if (!read(p, end, &slen, sizeof(slen)) || p + slen > end) return NULL;
+				store.push_back(fmt::string_view(p, slen));
+				p += slen;
+				break;
+			}
+			default:
+				return NULL;
+			}
+		}
+
+		try
+		{
+			message = fmt::vformat(site->_format, store);
+		}
+		catch (const std::exception& e)
+		{
+			message = fmt::format("[format error: {}] {}", e.what(), site->_format);
+		}
+		return site;
+	}
+
+	/*
+	 *	־ļ
+	 *	ļ: 8ֽļͷ, ȻһĿ, 'S'ͷǵõǼ, 'R'ͷ־¼
+	 *	ÿstart_binary׷һļͷ, ʼһµĶ, õֻڶЧ, ļͷյõµǼ
+	 *	Ŀ(һǽ쳣˳µİ¼), һļͷ
+	 */
+	typedef std::function<void(const BinLogSiteInfo& site, uint64_t stamp, const std::string& message)> DecodeCallback;
+	static bool decode_file(const char* filename, DecodeCallback cb, uint64_t* corrupted = NULL)
+	{
+		FILE* f = fopen(filename, "rb");
+		if (f == NULL)
+			return false;
+
+		std::string content;
+		char buf[65536];
+		std::size_t rd;
+		while ((rd = fread(buf, 1, sizeof(buf), f)) > 0)
+			content.append(buf, rd);
+		fclose(f);
+
+		const char* end = content.data() + content.size();
+		if (!is_magic(content.data(), end))
+			return false;
+
+		BinLogDecoder decoder;
+		uint64_t bad = 0;
+		const char* p = content.data() + sizeof(FILE_MAGIC);
+		std::string message;
+		while (p < end)
+		{
+			const char* entry = p;
+			char kind = *p++;
+			bool bValid = true;
+			if (is_magic(entry, end))
+			{
+				decoder = BinLogDecoder();
+				p = entry + sizeof(FILE_MAGIC);
+			}
+			else if (kind == 'S')
+			{
+				BinLogSiteInfo info;
+				bValid = read_site(p, end, info) && find_magic(entry + 1, p) == p;
+				if (bValid)
+					decoder.add_site(info);
+			}
+			else if (kind == 'R')
+			{
+				//¼һεļͷ, ȿǡûԽ, Լ¼мļͷҲ
+				uint32_t len;
+				bValid = read(p, end, &len, sizeof(len)) && p + len <= end && find_magic(entry + 1, p + len) == p + len;
+				if (bValid)
+				{
+					uint64_t stamp = 0;
+					const BinLogSiteInfo* site = decoder.decode(p, len, stamp, message);
+					if (site == NULL)
+						bad++;
+					else
+						cb(*site, stamp, message);
+					p += len;
+				}
+			}
+			else
+			{
+				bValid = false;
+			}
+
+			if (!bValid)
+			{
+				bad++;
+				p = find_magic(entry + 1, end);
+			}
+		}
+
+		if (corrupted)
+			*corrupted = bad;
+		return true;
+	}
+
+	static constexpr char FILE_MAGIC[8] = { 'W', 'T', 'B', 'L', 'O', 'G', 0x01, 0x00 };
+
+private:
+	static inline bool read(const char*& p, const char* end, void* dst, std::size_t sz)
+	{
+		if (p + sz > end)
+			return false;
+
+		memcpy(dst, p, sz);
+		p += sz;
+		return true;
+	}
+
+	static inline bool is_magic(const char* p, const char* end)
+	{
+		return p + sizeof(FILE_MAGIC) <= end && memcmp(p, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0;
+	}
+
+	/*
+	 *	һļͷ, Ҳend
+	 */
+	static inline const char* find_magic(const char* p, const char* end)
+	{
+		for (; p < end; p++)
+		{
+			p = (const char*)memchr(p, FILE_MAGIC[0], end - p);
+			if (p == NULL)
+				return end;
+
+			if (is_magic(p, end))
+				return p;
+		}
+		return end;
+	}
+
+	static bool read_site(const char*& p, const char* end, BinLogSiteInfo& info)
+	{
+		uint16_t clen, flen;
+		uint8_t slen;
+		if (!read(p, end, &info._id, sizeof(uint32_t)) || !read(p, end, &info._level, sizeof(uint8_t)))
+			return false;
+		if (!read(p, end, &clen, sizeof(clen)) || p + clen > end)
+			return false;
+		info._category.assign(p, clen);
+		p += clen;
+		if (!read(p, end, &flen, sizeof(flen)) || p + flen > end)
+			return false;
+		info._format.assign(p, flen);
+		p += flen;
+		if (!read(p, end, &slen, sizeof(slen)) || p + slen > end)
+			return false;
+		info._sig.assign(p, slen);
+		p += slen;
+		return true;
+	}
+
+private:
+	std::vector<BinLogSiteInfo>	_sites;
+};
+
+typedef struct _BinLogStats
+{
+	uint64_t	_written;		//̨߳Ѿ
+	uint64_t	_ring_drops;	//
+	uint64_t	_limit_drops;	//ٶ
+	uint32_t	_sites;			//ѵǼǵĵõ
+	uint32_t	_rings;			//̻߳
+} BinLogStats;
+
+/*
+ *	ıģʽص, ں̨߳
+ */
+typedef std::function<void(uint8_t level, const char* category, uint64_t stamp, const char* message)> BinLogTextSink;
+
+class BinLogger
+{
+private:
+	static const uint32_t MAX_RECORD_SIZE = 4096;
+
+	typedef struct _Core
+	{
+		std::atomic<bool>	_running;
+		uint32_t			_ring_size;
+
+		//õǼ
+		std::mutex						_mtx_sites;
+		std::vector<BinLogSiteInfo>		_sites;			//±Ǹʽ, 0Ų
+		std::vector<std::pair<std::string, BinLogLimiter*>>	_limiters;
+
+		//̻߳
+		std::mutex					_mtx_rings;
+		std::vector<BinLogRingPtr>	_rings;
+
+		//̨߳
+		std::shared_ptr<std::thread>	_worker;
+		BinLogTextSink		_sink;
+		FILE*				_file;
+		std::size_t			_sites_dumped;
+		BinLogDecoder		_decoder;
+
+		std::atomic<uint64_t>	_written;
+		std::atomic<uint64_t>	_ring_drops;
+		std::atomic<uint64_t>	_limit_drops;
+
+		_Core() :_running(false), _ring_size(1024 * 1024), _file(NULL), _sites_dumped(1), _written(0), _ring_drops(0), _limit_drops(0)
+		{
+			_sites.resize(1);
+		}
+	} Core;
+
+	static inline Core& core()
+	{
+		//˳ʱܻ߳д־, Բͷ
+		static Core* _core = new Core();
+		return *_core;
+	}
+
+	/*
+	 *	̻߳ĳ, ߳˳ʱѻΪ, ̨߳ȡʣµļ¼Ժͷ
+	 */
+	class RingHolder
+	{
+	public:
+		~RingHolder()
+		{
+			if (_ring)
+				_ring->retire();
+		}
+
+		BinLogRingPtr	_ring;
+	};
+
+	static inline BinLogRing* local_ring()
+	{
+		thread_local static RingHolder holder;
+		if (!holder._ring)
+		{
+			Core& c = core();
+			holder._ring.reset(new BinLogRing(c._ring_size));
+			std::unique_lock<std::mutex> lock(c._mtx_rings);
+			c._rings.emplace_back(holder._ring);
+		}
+		return holder._ring.get();
+	}
+
+	static inline uint64_t now()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	//, ռ䲻ʱضַ
+	class Encoder
+	{
+	public:
+		Encoder(char* buf, std::size_t cap) :_buf(buf), _pos(0), _cap(cap) {}
+
+		inline void put(const void* data, std::size_t len)
+		{
+			if (_pos + len > _cap)
+				len = _cap - _pos;
+			memcpy(_buf + _pos, data, len);
+			_pos += len;
+		}
+
+		inline void put_str(const char* s, std::size_t len)
+		{
+			std::size_t left = (_pos + sizeof(uint32_t) > _cap) ? 0 : (_cap - _pos - sizeof(uint32_t));
+			uint32_t l = (uint32_t)((len > left) ? left : len);
+			put(&l, sizeof(l));
+			put(s, l);
+		}
+
+		inline std::size_t size() const { return _pos; }
+
+	private:
+		char*		_buf;
+		std::size_t	_pos;
+		std::size_t	_cap;
+	};
+
+	template<typename T>
+	static inline void encode_arg(Encoder& enc, const T& v)
+	{
+		typedef typename BinArgTraits<T>::Type Type;
+		constexpr char t = BinArgTraits<T>::type();
+		if constexpr (t == BAT_Bool || t == BAT_Char)
+		{
+			char c = (char)v;
+			enc.put(&c, sizeof(c));
+		}
+		else if constexpr (t == BAT_Int)
+		{
+			int64_t x = (int64_t)v;
+			enc.put(&x, sizeof(x));
+		}
+		else if constexpr (t == BAT_UInt)
+		{
+			uint64_t x = (uint64_t)v;
+			enc.put(&x, sizeof(x));
+		}
+		else if constexpr (t == BAT_Double)
+		{
+			double x = (double)v;
+			enc.put(&x, sizeof(x));
+		}
+		else if constexpr (std::is_same<Type, const char*>::value || std::is_same<Type, char*>::value)
+		{
+			const char* s = (v == NULL) ? "" : v;
+			enc.put_str(s, strlen(s));
+		}
+		else if constexpr (std::is_same<Type, std::string>::value)
+		{
+			enc.put_str(v.data(), v.size());
+		}
+		else
+		{
+			std::string s = fmt::format("{}", v);
+			enc.put_str(s.data(), s.size());
+		}
+	}
+
+	static uint32_t register_site(BinLogSite& site, const char* sig)
+	{
+		Core& c = core();
+		std::unique_lock<std::mutex> lock(c._mtx_sites);
+		uint32_t id = site._id.load(std::memory_order_acquire);
+		if (id != 0)
+			return id;
+
+		BinLogSiteInfo info;
+		info._id = (uint32_t)c._sites.size();
+		info._level = site._level;
+		info._category = site._category;
+		info._format = site._format;
+		info._sig = sig;
+		c._sites.emplace_back(info);
+
+		site._limiter = find_limiter(site._category);
+		site._id.store(info._id, std::memory_order_release);
+		return info._id;
+	}
+
+	//ǰҪ_mtx_sites
+	static BinLogLimiter* find_limiter(const char* category)
+	{
+		Core& c = core();
+		for (auto& item : c._limiters)
+		{
+			if (item.first == category)
+				return item.second;
+		}
+
+		BinLogLimiter* limiter = new BinLogLimiter();
+		c._limiters.emplace_back(std::make_pair(std::string(category), limiter));
+		return limiter;
+	}
+
+public:
+	/*
+	 *	ıģʽ, ̸̨߳ʽԺsink
+	 *	@ringsize	ÿֽ̻߳
+	 */
+	static bool start_text(BinLogTextSink sink, uint32_t ringsize = 1024 * 1024)
+	{
+		Core& c = core();
+		if (c._running)
+			return false;
+
+		c._sink = sink;
+		c._file = NULL;
+		return start(ringsize);
+	}
+
+	/*
+	 *	ģʽ, ̨̰߳ѵõԭʼ¼дļ, WtLogDecoderԭ
+	 */
+	static bool start_binary(const char* filename, uint32_t ringsize = 1024 * 1024)
+	{
+		Core& c = core();
+		if (c._running)
+			return false;
+
+		FILE* f = fopen(filename, "ab");
+		if (f == NULL)
+			return false;
+
+		//ÿδ򿪶дһļͷȫõ, ׷дļÿһζܶ
+		fwrite(BinLogDecoder::FILE_MAGIC, 1, sizeof(BinLogDecoder::FILE_MAGIC), f);
+		c._file = f;
+		c._sites_dumped = 1;
+		c._sink = nullptr;
+		return start(ringsize);
+	}
+
+	/*
+	 *	ֹ̨ͣ߳, ֹ֮ͣǰѻļ¼ȫ
+	 */
+	static void stop()
+	{
+		Core& c = core();
+		if (!c._running.exchange(false))
+			return;
+
+		if (c._worker)
+		{
+			c._worker->join();
+			c._worker.reset();
+		}
+
+		if (c._file)
+		{
+			fclose(c._file);
+			c._file = NULL;
+		}
+	}
+
+	static inline bool is_running() { return core()._running.load(std::memory_order_acquire); }
+
+	/*
+	 *	÷
+	 *	@limit		ÿ, 0ʾ
+	 *	@window_ms	ڳ, λ
+	 */
+	static void set_rate_limit(const char* category, uint32_t limit, uint32_t window_ms = 1000)
+	{
+		Core& c = core();
+		std::unique_lock<std::mutex> lock(c._mtx_sites);
+		find_limiter(category == NULL ? "" : category)->setup(limit, window_ms);
+	}
+
+	/*
+	 *	дһ־, ֻ
+	 *	ûʱ򷵻false, ɵ÷Լ; ٻ߻ʱ, Ȼtrue
+	 */
+	template<typename... Args>
+	static bool write(BinLogSite& site, const Args& ...args)
+	{
+		Core& c = core();
+		if (!c._running.load(std::memory_order_relaxed))
+			return false;
+
+		uint32_t id = site._id.load(std::memory_order_acquire);
+		if (id == 0)
+		{
+			static const char sig[] = { BinArgTraits<Args>::type()..., '\0' };
+			id = register_site(site, sig);
+		}
+
+		uint64_t stamp = now();
+		if (!site._limiter->allow(stamp))
+		{
+			c._limit_drops.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		thread_local static char buffer[MAX_RECORD_SIZE];
+		Encoder enc(buffer, MAX_RECORD_SIZE);
+		enc.put(&id, sizeof(id));
+		enc.put(&stamp, sizeof(stamp));
+		(void)std::initializer_list<int>{ (encode_arg(enc, args), 0)... };
+
+		if (!local_ring()->push(buffer, (uint32_t)enc.size()))
+			c._ring_drops.fetch_add(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	static BinLogStats stats()
+	{
+		Core& c = core();
+		BinLogStats ret;
+		ret._written = c._written.load(std::memory_order_relaxed);
+		ret._ring_drops = c._ring_drops.load(std::memory_order_relaxed);
+		ret._limit_drops = c._limit_drops.load(std::memory_order_relaxed);
+		{
+			std::unique_lock<std::mutex> lock(c._mtx_sites);
+			ret._sites = (uint32_t)c._sites.size() - 1;
+		}
+		{
+			std::unique_lock<std::mutex> lock(c._mtx_rings);
+			ret._rings = (uint32_t)c._rings.size();
+		}
+		return ret;
+	}
+
+private:
+	static bool start(uint32_t ringsize)
+	{
+		Core& c = core();
+		c._ring_size = ringsize;
+		c._written = 0;
+		c._running = true;
+		c._worker.reset(new std::thread([]() {
+			Core& c = core();
+			uint64_t lastReport = now();
+			while (c._running.load(std::memory_order_acquire))
+			{
+				if (drain_all() == 0)
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+				uint64_t curTime = now();
+				if (curTime - lastReport >= 1000000000ULL)
+				{
+					report_drops();
+					if (c._file)
+						fflush(c._file);
+					lastReport = curTime;
+				}
+			}
+
+			//˳֮ǰȫȡ
+			while (drain_all() > 0);
+			report_drops();
+			if (c._file)
+				fflush(c._file);
+		}));
+		return true;
+	}
+
+	static uint32_t drain_all()
+	{
+		Core& c = core();
+		std::vector<BinLogRingPtr> rings;
+		{
+			std::unique_lock<std::mutex> lock(c._mtx_rings);
+			rings = c._rings;
+		}
+
+		uint32_t cnt = 0;
+		for (BinLogRingPtr& ring : rings)
+		{
+			//жǷȡ, Ժ󲻻µд, ȡͿͷ
+			bool retired = ring->retired();
+			cnt += ring->drain([](const char* data, uint32_t len) {
+				process(data, len);
+			});
+
+			if (retired && ring->empty())
+			{
+				std::unique_lock<std::mutex> lock(c._mtx_rings);
+				for (auto it = c._rings.begin(); it != c._rings.end(); it++)
+				{
+					if (*it == ring)
+					{
+						c._rings.erase(it);
+						break;
+					}
+				}
+			}
+		}
+
+		c._written.fetch_add(cnt, std::memory_order_relaxed);
+		return cnt;
+	}
+
+	/*
+	 *	µǼǵĵõͬļ
+	 */
+	static void sync_sites(uint32_t id)
+	{
+		Core& c = core();
+		if (id < c._sites_dumped)
+			return;
+
+		std::vector<BinLogSiteInfo> sites;
+		{
+			std::unique_lock<std::mutex> lock(c._mtx_sites);
+			sites.assign(c._sites.begin() + c._sites_dumped, c._sites.end());
+		}
+
+		for (const BinLogSiteInfo& info : sites)
+		{
+			c._decoder.add_site(info);
+			if (c._file)
+			{
+				uint16_t clen = (uint16_t)info._category.size();
+				uint16_t flen = (uint16_t)info._format.size();
+				uint8_t slen = (uint8_t)info._sig.size();
+				fputc('S', c._file);
+				fwrite(&info._id, sizeof(uint32_t), 1, c._file);
+				fwrite(&info._level, sizeof(uint8_t), 1, c._file);
+				fwrite(&clen, sizeof(clen), 1, c._file);
+				fwrite(info._category.data(), 1, clen, c._file);
+				fwrite(&flen, sizeof(flen), 1, c._file);
+				fwrite(info._format.data(), 1, flen, c._file);
+				fwrite(&slen, sizeof(slen), 1, c._file);
+				fwrite(info._sig.data(), 1, slen, c._file);
+			}
+		}
+		c._sites_dumped += sites.size();
+	}
+
+	static void process(const char* data, uint32_t len)
+	{
+		Core& c = core();
+		uint32_t id;
+		memcpy(&id, data, sizeof(uint32_t));
+		sync_sites(id);
+
+		if (c._file)
+		{
+			fputc('R', c._file);
+			fwrite(&len, sizeof(len), 1, c._file);
+			fwrite(data, 1, len, c._file);
+		}
+		else if (c._sink)
+		{
+			thread_local static std::string message;
+			uint64_t stamp = 0;
+			const BinLogSiteInfo* site = c._decoder.decode(data, len, stamp, message);
+			if (site != NULL)
+				c._sink(site->_level, site->_category.c_str(), stamp, message.c_str());
+		}
+	}
+
+	/*
+	 *	ٺͻΪһ־
+	 */
+	static void report_drops()
+	{
+		Core& c = core();
+		std::vector<std::pair<std::string, uint64_t>> drops;
+		{
+			std::unique_lock<std::mutex> lock(c._mtx_sites);
+			for (auto& item : c._limiters)
+			{
+				uint64_t cnt = item.second->take_dropped();
+				if (cnt > 0)
+					drops.emplace_back(std::make_pair(item.first, cnt));
+			}
+		}
+
+		static BinLogSite limitSite(wtp::LL_WARN, "", "{} log messages of category [{}] dropped by rate limit");
+		for (auto& item : drops)
+			emit(limitSite, item.second, item.first);
+
+		static uint64_t lastRingDrops = 0;
+		uint64_t ringDrops = c._ring_drops.load(std::memory_order_relaxed);
+		if (ringDrops > lastRingDrops)
+		{
+			static BinLogSite ringSite(wtp::LL_WARN, "", "{} log messages dropped because the ring buffer is full");
+			emit(ringSite, ringDrops - lastRingDrops);
+			lastRingDrops = ringDrops;
+		}
+	}
+
+	/*
+	 *	̨߳Լ־, 
+	 */
+	template<typename... Args>
+	static void emit(BinLogSite& site, const Args& ...args)
+	{
+		uint32_t id = site._id.load(std::memory_order_acquire);
+		if (id == 0)
+		{
+			static const char sig[] = { BinArgTraits<Args>::type()..., '\0' };
+			id = register_site(site, sig);
+		}
+
+		char buffer[512];
+		Encoder enc(buffer, sizeof(buffer));
+		uint64_t stamp = now();
+		enc.put(&id, sizeof(id));
+		enc.put(&stamp, sizeof(stamp));
+		(void)std::initializer_list<int>{ (encode_arg(enc, args), 0)... };
+		process(buffer, (uint32_t)enc.size());
+	}
+};
@@ -0,0 +1,191 @@
+/*!
+ * \file LRUDataCache.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/13
+ *
+ * \brief ֽԤ̭LRUݻ
+ *
+ * shared_ptr, ʵʱŲͷ, ԤԺβʼ̭
+ * ⲿ(类Ƭ), Ϊס, ̭ʱ
+ * ԤΪ0ʾƴС
+ */
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "../Includes/FasterDefs.h"
+
+class LRUDataCache
+{
+public:
+	typedef struct _CacheStats
+	{
+		uint64_t	_hits;
+		uint64_t	_misses;
+		uint64_t	_evictions;
+		uint64_t	_bytes;		//ǰֽ
+		uint64_t	_budget;	//ֽԤ
+		uint32_t	_entries;
+		uint32_t	_pinned;	//ⲿõĻ
+
+		_CacheStats() { memset(this, 0, sizeof(_CacheStats)); }
+	} CacheStats;
+
+private:
+	typedef struct _CacheNode
+	{
+		std::string				_key;
+		std::shared_ptr<void>	_data;
+		uint64_t				_bytes;
+	} CacheNode;
+	typedef std::list<CacheNode>	NodeList;
+	typedef wtp::wt_hashmap<std::string, NodeList::iterator> NodeMap;
+
+public:
+	LRUDataCache(uint64_t budget = 0) :_budget(budget), _bytes(0), _hits(0), _misses(0), _evictions(0) {}
+
+	inline void set_budget(uint64_t budget)
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		_budget = budget;
+		evict();
+	}
+
+	/*
+	 *	һ, ҵĻŲͷ
+	 *	صָڳڼᶤס
+	 */
+	template<typename T>
+	std::shared_ptr<T> get(const std::string& key)
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		auto it = _index.find(key);
+		if (it == _index.end())
+		{
+			_misses++;
+			return std::shared_ptr<T>();
+		}
+
+		_hits++;
+		_nodes.splice(_nodes.begin(), _nodes, it->second);
+		return std::static_pointer_cast<T>(it->second->_data);
+	}
+
+	/*
+	 *	뻺, ͬĻᱻ滻
+	 *	@bytes	ռõֽ
+	 */
+	template<typename T>
+	void put(const std::string& key, const std::shared_ptr<T>& data, uint64_t bytes)
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		auto it = _index.find(key);
+		if (it != _index.end())
+		{
+			_bytes -= it->second->_bytes;
+			_nodes.erase(it->second);
+			_index.erase(it);
+		}
+
+		_nodes.push_front(CacheNode{ key, std::static_pointer_cast<void>(data), bytes });
+		_index[key] = _nodes.begin();
+		_bytes += bytes;
+		evict();
+	}
+
+	/*
+	 *	б仯ʱռõֽ
+	 */
+	void resize(const std::string& key, uint64_t bytes)
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		auto it = _index.find(key);
+		if (it == _index.end())
+			return;
+
+		_bytes = _bytes - it->second->_bytes + bytes;
+		it->second->_bytes = bytes;
+		evict();
+	}
+
+	void erase(const std::string& key)
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		auto it = _index.find(key);
+		if (it == _index.end())
+			return;
+
+		_bytes -= it->second->_bytes;
+		_nodes.erase(it->second);
+		_index.erase(it);
+	}
+
+	/*
+	 *	ȫ
+	 *	סⲿü, ͷԺŻ
+	 */
+	void clear()
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		_nodes.clear();
+		_index.clear();
+		_bytes = 0;
+	}
+
+	CacheStats stats()
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		CacheStats ret;
+		ret._hits = _hits;
+		ret._misses = _misses;
+		ret._evictions = _evictions;
+		ret._bytes = _bytes;
+		ret._budget = _budget;
+		ret._entries = (uint32_t)_nodes.size();
+		for (const CacheNode& node : _nodes)
+		{
+			if (node._data.use_count() > 1)
+				ret._pinned++;
+		}
+		return ret;
+	}
+
+private:
+	/*
+	 *	ûзʵĻʼ̭, ֱصԤ
+	 */
+	void evict()
+	{
+		if (_budget == 0 || _bytes <= _budget)
+			return;
+
+		auto it = _nodes.end();
+		while (it != _nodes.begin() && _bytes > _budget)
+		{
+			--it;
+			if (it->_data.use_count() > 1)
+				continue;
+
+			_bytes -= it->_bytes;
+			_index.erase(it->_key);
+			it = _nodes.erase(it);
+			_evictions++;
+		}
+	}
+
+private:
+	std::mutex	_mtx;
+	NodeList	_nodes;		//ͷʵ
+	NodeMap		_index;
+
+	uint64_t	_budget;
+	uint64_t	_bytes;
+	uint64_t	_hits;
+	uint64_t	_misses;
+	uint64_t	_evictions;
+};
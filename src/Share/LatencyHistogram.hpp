@@ -0,0 +1,361 @@
+/*!
+ * \file LatencyHistogram.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/19
+ *
+ * \brief ӳͳõʱӺֱͼ
+ *
+ * TscClockֱӶȡCPUʱʱsteady_clockԱȱ궨Ƶʣx86ƽ̨˻Ϊsteady_clock
+ * LatencyHistogramHDRĶ-ԷͰֱͼÿ2ݴپΪ2^SUB_BITSͰ
+ * ¼ʱֻмλ㣬ڴ棬1/2^SUB_BITS
+ * LatencyProbeӳٲԹõķֽ׶δ㣬׶εķֽ顢ԡغͽ׽ӿڸԴ
+ */
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "fmtlib.h"
+#include <chrono>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+class TscClock
+{
+public:
+	/*
+	 *	ȡԭʼ
+	 */
+	static inline uint64_t rdtsc()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	/*
+	 *	궨ƵʣλΪÿ
+	 *	@millisecs	궨ʱʱԽԽ׼
+	 */
+	static double calibrate(uint32_t millisecs = 100)
+	{
+		auto t0 = std::chrono::steady_clock::now();
+		uint64_t c0 = rdtsc();
+		std::this_thread::sleep_for(std::chrono::milliseconds(millisecs));
+		auto t1 = std::chrono::steady_clock::now();
+		uint64_t c1 = rdtsc();
+
+		double elapse = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+		ticks_per_ns() = (elapse > 0) ? (c1 - c0) / elapse : 1.0;
+		return ticks_per_ns();
+	}
+
+	static inline double& ticks_per_ns()
+	{
+		static double ratio = 1.0;
+		return ratio;
+	}
+
+	/*
+	 *	Ѽ
+	 */
+	static inline uint64_t to_nano(uint64_t ticks)
+	{
+		return (uint64_t)(ticks / ticks_per_ns());
+	}
+};
+
+class LatencyHistogram
+{
+public:
+	//ÿ2ݴͰλ7λ128Ͱ1%
+	static const uint32_t SUB_BITS = 7;
+	static const uint32_t SUB_COUNT = 1 << SUB_BITS;
+	//߼¼2^40룬18ӣٴֵ㵽һͰ
+	static const uint32_t MAX_BITS = 40;
+	static const uint32_t BUCKET_COUNT = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+public:
+	LatencyHistogram() { reset(); }
+
+	void reset()
+	{
+		memset(_counts, 0, sizeof(_counts));
+		_total = 0;
+		_sum = 0;
+		_min = UINT64_MAX;
+		_max = 0;
+	}
+
+	/*
+	 *	¼һֵλɵ÷һΪ
+	 */
+	inline void record(uint64_t value)
+	{
+		_counts[index_of(value)]++;
+		_total++;
+		_sum += value;
+		if (value < _min) _min = value;
+		if (value > _max) _max = value;
+	}
+
+	inline uint64_t count() const { return _total; }
+	inline uint64_t minimum() const { return _total == 0 ? 0 : _min; }
+	inline uint64_t maximum() const { return _max; }
+	inline double mean() const { return _total == 0 ? 0.0 : _sum*1.0 / _total; }
+
+	/*
+	 *	λ
+	 *	@percent	ٷֱȣ99.9
+	 *	صͰϽ磬ᳬʵʵֵ
+	 */
+	uint64_t percentile(double percent) const
+	{
+		if (_total == 0)
+			return 0;
+
+		uint64_t target = (uint64_t)(percent / 100.0 * _total + 0.5);
+		if (target < 1)
+			target = 1;
+		if (target > _total)
+			target = _total;
+
+		uint64_t acc = 0;
+		for (uint32_t i = 0; i < BUCKET_COUNT; i++)
+		{
+			acc += _counts[i];
+			if (acc >= target)
+			{
+				//һͰûϽ
+				if (i == BUCKET_COUNT - 1)
+					return _max;
+
+				uint64_t upper = upper_of(i);
+				return upper > _max ? _max : upper;
+			}
+		}
+
+		return _max;
+	}
+
+	/*
+	 *	ϲһֱͼڶ̸߳ͳԺ
+	 */
+	void merge(const LatencyHistogram& other)
+	{
+		for (uint32_t i = 0; i < BUCKET_COUNT; i++)
+			_counts[i] += other._counts[i];
+		_total += other._total;
+		_sum += other._sum;
+		if (other._total > 0)
+		{
+			if (other._min < _min) _min = other._min;
+			if (other._max > _max) _max = other._max;
+		}
+	}
+
+private:
+	static inline uint32_t highest_bit(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanReverse64(&idx, value);
+		return (uint32_t)idx;
+#else
+		return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+	}
+
+	/*
+	 *	СSUB_COUNTֱֵڵһͰÿֵһͰ
+	 *	ֵλȷ飬ȡλSUB_BITSλȷͰ
+	 */
+	static inline uint32_t index_of(uint64_t value)
+	{
+		if (value < SUB_COUNT)
+			return (uint32_t)value;
+
+		uint32_t hb = highest_bit(value);
+		if (hb >= MAX_BITS)
+			return BUCKET_COUNT - 1;
+
+		uint32_t group = hb - SUB_BITS + 1;
+		uint32_t sub = (uint32_t)(value >> (hb - SUB_BITS)) & (SUB_COUNT - 1);
+		return group * SUB_COUNT + sub;
+	}
+
+	static inline uint64_t upper_of(uint32_t idx)
+	{
+		uint32_t group = idx / SUB_COUNT;
+		uint64_t sub = idx % SUB_COUNT;
+		if (group == 0)
+			return sub;
+
+		uint32_t shift = group - 1;
+		return ((SUB_COUNT + sub + 1) << shift) - 1;
+	}
+
+private:
+	uint64_t	_counts[BUCKET_COUNT];
+	uint64_t	_total;
+	uint64_t	_sum;
+	uint64_t	_min;
+	uint64_t	_max;
+};
+
+//ֽ׶εӳͳ
+typedef enum tagLatencyStage
+{
+	LS_Parser = 0,	//յ鵽յ
+	LS_Engine,		//ַյ鵽Իص
+	LS_Strategy,	//Լ㣬ӲԻصʼµ
+	LS_Risk,		//ؼ飬ͨķؼ
+	LS_Send,		//ӿڷͣ׽ӿµñ
+	LS_Total,		//ọ̈̄յ鵽鴦
+	LS_Bus,			//ߣдߵֻshmģʽ
+	LS_Count
+} LatencyStage;
+
+//λ
+typedef enum tagLatencyMark
+{
+	LM_Recv = 0,	//յ
+	LM_Engine,		//յ
+	LM_Callback,	//Իص
+	LM_Order,		//Էµָ
+	LM_RiskIn,		//ʼؼ
+	LM_RiskOut,		//ؼ
+	LM_Api,			//ý׽ӿ
+	LM_Sent,		//׽ӿڷ
+	LM_Done,		//鴦
+	LM_Count
+} LatencyMark;
+
+class LatencyProbe
+{
+public:
+	LatencyProbe() { memset(_marks, 0, sizeof(_marks)); }
+
+	inline void mark(LatencyMark m) { _marks[m] = TscClock::rdtsc(); }
+
+	inline void record(LatencyStage s, uint64_t nanos) { _hists[s].record(nanos); }
+
+	void reset()
+	{
+		for (uint32_t i = 0; i < LS_Count; i++)
+			_hists[i].reset();
+	}
+
+	inline void begin()
+	{
+		memset(_marks, 0, sizeof(_marks));
+		mark(LM_Recv);
+	}
+
+	/*
+	 *	һִ㲢¼׶εĺʱ
+	 *	˴㲻ȫĽ׶β¼ûµûзؼ
+	 */
+	inline void end()
+	{
+		mark(LM_Done);
+		for (uint32_t i = 0; i < LS_Bus; i++)
+		{
+			uint64_t from = _marks[STAGE_BOUNDS[i][0]];
+			uint64_t to = _marks[STAGE_BOUNDS[i][1]];
+			if (from == 0 || to < from)
+				continue;
+
+			_hists[i].record(TscClock::to_nano(to - from));
+		}
+	}
+
+	inline const LatencyHistogram& histogram(LatencyStage s) const { return _hists[s]; }
+
+	static inline const char* stage_name(LatencyStage s)
+	{
+		static const char* STAGE_NAMES[LS_Count] = { "parser", "engine", "strategy", "risk", "send", "total", "bus" };
+		return STAGE_NAMES[s];
+	}
+
+	/*
+	 *	׶εӳٷֲ
+	 *	ÿݵĽ׶ͨprinterһժҪͬʱдjStages㲻ͬ汾֮Ա
+	 *	JsonValuerapidjsonValueͣﲻֱrapidjson
+	 */
+	template<typename JsonValue, typename Allocator, typename Printer>
+	void report(JsonValue& jStages, Allocator& allocator, Printer printer) const
+	{
+		static const double PERCENTS[] = { 50, 90, 99, 99.9, 99.99 };
+		static const char* PCT_NAMES[] = { "p50", "p90", "p99", "p999", "p9999" };
+
+		for (uint32_t i = 0; i < LS_Count; i++)
+		{
+			const LatencyHistogram& hist = _hists[i];
+			if (hist.count() == 0)
+				continue;
+
+			const char* name = stage_name((LatencyStage)i);
+			printer(fmt::format("[{:>8}] count: {}, min: {} ns, mean: {:.1f} ns, p50: {} ns, p90: {} ns, p99: {} ns, p99.9: {} ns, p99.99: {} ns, max: {} ns",
+				name, hist.count(), hist.minimum(), hist.mean(), hist.percentile(50), hist.percentile(90),
+				hist.percentile(99), hist.percentile(99.9), hist.percentile(99.99), hist.maximum()).c_str());
+
+			JsonValue jStage;
+			jStage.SetObject();
+			jStage.AddMember("count", hist.count(), allocator);
+			jStage.AddMember("min", hist.minimum(), allocator);
+			jStage.AddMember("mean", hist.mean(), allocator);
+			for (uint32_t j = 0; j < 5; j++)
+				jStage.AddMember(typename JsonValue::StringRefType(PCT_NAMES[j]), hist.percentile(PERCENTS[j]), allocator);
+			jStage.AddMember("max", hist.maximum(), allocator);
+
+			jStages.AddMember(typename JsonValue::StringRefType(name), jStage, allocator);
+		}
+	}
+
+private:
+	//׶ֹĴλãߵĺʱɵ÷ֱӼ¼
+	static constexpr LatencyMark STAGE_BOUNDS[LS_Bus][2] = {
+		{ LM_Recv, LM_Engine },
+		{ LM_Engine, LM_Callback },
+		{ LM_Callback, LM_Order },
+		{ LM_RiskIn, LM_RiskOut },
+		{ LM_Api, LM_Sent },
+		{ LM_Recv, LM_Done }
+	};
+
+	uint64_t			_marks[LM_Count];
+	LatencyHistogram	_hists[LS_Count];
+};
+
+/*
+ *	һ˴
+ *	̽Ϊʱʲôʱֻһж
+ */
+class LatencyScope
+{
+public:
+	LatencyScope(LatencyProbe* probe, LatencyMark enter, LatencyMark leave)
+		: _probe(probe), _leave(leave)
+	{
+		if (_probe)
+			_probe->mark(enter);
+	}
+
+	~LatencyScope()
+	{
+		if (_probe)
+			_probe->mark(_leave);
+	}
+
+private:
+	LatencyProbe*	_probe;
+	LatencyMark		_leave;
+};
@@ -0,0 +1,432 @@
+/*!
+ * \file MagazinePool.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/15
+ *
+ * \brief ̰߳ȫĶ
+ *
+ * ÿ̳߳ϻ(magazine), ÿϻɸж, ͷŶ̵ֻ߳ĵϻ
+ * ϻ˻, ٺȫֲֿ⽻ϻ, ȫֲֿջ
+ * ߳ͷ, ͷŵĶͷ̵߳ĵϻ, Ҫʷ̵߳
+ * ڴ水ԺͲٹ黹ϵͳ, ߳˳Ժ, ѾȥĶȻЧ
+ *
+ * ÿǰһͷ, ¼Ĳֿ
+ * WindowsÿDLLʵһģ, Ҳ͸һֿ, tickparserģ, WtCoreͷ
+ * ͷŵʱڱģĲֿ, ͹ҵֿԶͷ, ֿⲹ䵯ϻʱȻ
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+typedef struct _PoolStats
+{
+	uint64_t	_allocs;		//
+	uint64_t	_frees;			//ͷŴ
+	uint64_t	_capacity;		//ѾĶ
+	uint64_t	_depot_gets;	//ȫֲֿȡϻĴ
+	uint64_t	_depot_puts;	//ȫֲֿŵϻĴ
+	uint64_t	_remote_frees;	//ģͷŻĴ, Ѿ_frees
+
+	inline uint64_t in_use() const { return _allocs - _frees; }
+} PoolStats;
+
+/*
+ *	ͷԶͷ, ģ, ͬģʵĳӶܷ
+ */
+typedef struct _MagazineSlotHeader
+{
+	struct _MagazineOwner*		_owner;		//öĲֿ
+	_MagazineSlotHeader*		_next;		//Զͷһ
+} MagazineSlotHeader;
+
+typedef struct _MagazineOwner
+{
+	std::atomic<MagazineSlotHeader*>	_remote;		//ģͷŻĲ
+	std::atomic<uint64_t>				_remote_frees;
+
+	_MagazineOwner() :_remote(NULL), _remote_frees(0) {}
+
+	/*
+	 *	ģͷŵĲ۹ҵͷ
+	 *	ȡʱһժ, ABA
+	 */
+	inline void push_remote(MagazineSlotHeader* slot)
+	{
+		MagazineSlotHeader* head = _remote.load(std::memory_order_relaxed);
+		do
+		{
+			slot->_next = head;
+		} while (!_remote.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+		_remote_frees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	inline MagazineSlotHeader* take_remote()
+	{
+		if (_remote.load(std::memory_order_relaxed) == NULL)
+			return NULL;
+
+		return _remote.exchange(NULL, std::memory_order_acquire);
+	}
+} MagazineOwner;
+
+template<typename T, std::size_t MAG_SIZE = 64>
+class MagazinePool
+{
+private:
+	typedef struct _Slot
+	{
+		MagazineSlotHeader	_header;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type	_obj;
+	} Slot;
+
+	static inline Slot* to_slot(void* pobj)
+	{
+		return (Slot*)((char*)pobj - offsetof(Slot, _obj));
+	}
+
+	typedef struct _Magazine
+	{
+		std::atomic<_Magazine*>	_next;
+		uint32_t				_count;
+		void*					_items[MAG_SIZE];
+
+		_Magazine() :_next(NULL), _count(0) {}
+
+		inline bool full() const { return _count == MAG_SIZE; }
+		inline bool empty() const { return _count == 0; }
+	} Magazine;
+
+	/*
+	 *	汾ŵջ, 汾ABA
+	 *	ϻͷ, popʱѾȡߵĽڵҲǰȫ
+	 */
+	class MagazineStack
+	{
+	public:
+		MagazineStack() :_head(0) {}
+
+		void push(Magazine* mag)
+		{
+			uint64_t old = _head.load(std::memory_order_relaxed);
+			uint64_t now;
+			do
+			{
+				mag->_next.store(unpack(old), std::memory_order_relaxed);
+				now = pack(mag, tag(old) + 1);
+			} while (!_head.compare_exchange_weak(old, now, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		Magazine* pop()
+		{
+			uint64_t old = _head.load(std::memory_order_acquire);
+			uint64_t now;
+			Magazine* top = NULL;
+			do
+			{
+				top = unpack(old);
+				if (top == NULL)
+					return NULL;
+
+				now = pack(top->_next.load(std::memory_order_relaxed), tag(old) + 1);
+			} while (!_head.compare_exchange_weak(old, now, std::memory_order_acquire, std::memory_order_acquire));
+
+			return top;
+		}
+
+	private:
+		//64λϵͳûַֻ̬˵48λ, 16λŰ汾; 32λϵͳ32λŰ汾
+		static const int TAG_SHIFT = (sizeof(void*) == 8) ? 48 : 32;
+
+		static inline uint64_t pack(Magazine* mag, uint64_t tag)
+		{
+			return ((uint64_t)(uintptr_t)mag & ((1ULL << TAG_SHIFT) - 1)) | (tag << TAG_SHIFT);
+		}
+
+		static inline Magazine* unpack(uint64_t val)
+		{
+			return (Magazine*)(uintptr_t)(val & ((1ULL << TAG_SHIFT) - 1));
+		}
+
+		static inline uint64_t tag(uint64_t val)
+		{
+			return val >> TAG_SHIFT;
+		}
+
+	private:
+		std::atomic<uint64_t>	_head;
+	};
+
+	/*
+	 *	ȫֲֿ, ֻһ, Ҳ
+	 */
+	typedef struct _Depot : public MagazineOwner
+	{
+		MagazineStack	_full;		//װжĵϻ
+		MagazineStack	_empty;		//յϻ
+
+		std::atomic<uint64_t>	_allocs;
+		std::atomic<uint64_t>	_frees;
+		std::atomic<uint64_t>	_capacity;
+		std::atomic<uint64_t>	_depot_gets;
+		std::atomic<uint64_t>	_depot_puts;
+
+		_Depot() :_allocs(0), _frees(0), _capacity(0), _depot_gets(0), _depot_puts(0) {}
+
+		inline Magazine* get_empty()
+		{
+			Magazine* mag = _empty.pop();
+			return (mag != NULL) ? mag : new Magazine();
+		}
+
+		inline void put(Magazine* mag)
+		{
+			if (mag->empty())
+				_empty.push(mag);
+			else
+				_full.push(mag);
+		}
+
+		/*
+		 *	װһյϻ
+		 *	ȻģͷŻĶ, װµװϻŻزֿ
+		 *	ûпɻյ, һµڴ
+		 */
+		inline void fill(Magazine* mag)
+		{
+			MagazineSlotHeader* head = take_remote();
+			if (head != NULL)
+			{
+				for (; head != NULL && !mag->full(); head = head->_next)
+					mag->_items[mag->_count++] = &((Slot*)head)->_obj;
+
+				Magazine* extra = NULL;
+				for (; head != NULL; head = head->_next)
+				{
+					if (extra == NULL)
+						extra = get_empty();
+
+					extra->_items[extra->_count++] = &((Slot*)head)->_obj;
+					if (extra->full())
+					{
+						_full.push(extra);
+						extra = NULL;
+					}
+				}
+
+				if (extra != NULL)
+					_full.push(extra);
+				return;
+			}
+
+			Slot* slots = new Slot[MAG_SIZE];
+			for (std::size_t i = 0; i < MAG_SIZE; i++)
+			{
+				slots[i]._header._owner = this;
+				mag->_items[i] = &slots[i]._obj;
+			}
+			mag->_count = MAG_SIZE;
+			_capacity.fetch_add(MAG_SIZE, std::memory_order_relaxed);
+		}
+	} Depot;
+
+	static inline Depot& depot()
+	{
+		static Depot* _depot = new Depot();
+		return *_depot;
+	}
+
+	/*
+	 *	̻߳, ͳȼڱ, Ͳֿ⽻ϻʱٻ, ÿη䶼дļ
+	 */
+	class ThreadCache
+	{
+	public:
+		ThreadCache() :_allocs(0), _frees(0), _gets(0), _puts(0)
+		{
+			Depot& d = depot();
+			_loaded = d.get_empty();
+			_previous = d.get_empty();
+		}
+
+		~ThreadCache()
+		{
+			Depot& d = depot();
+			d.put(_loaded);
+			d.put(_previous);
+			_loaded = _previous = NULL;
+			flush_stats();
+			dead() = true;
+		}
+
+		inline void* pop()
+		{
+			_allocs++;
+			if (_loaded->empty())
+			{
+				if (!_previous->empty())
+				{
+					std::swap(_loaded, _previous);
+				}
+				else
+				{
+					Depot& d = depot();
+					Magazine* mag = d._full.pop();
+					if (mag != NULL)
+					{
+						_gets++;
+						d._empty.push(_previous);
+						_previous = _loaded;
+						_loaded = mag;
+					}
+					else
+					{
+						d.fill(_loaded);
+					}
+					flush_stats();
+				}
+			}
+
+			return _loaded->_items[--_loaded->_count];
+		}
+
+		inline void push(void* ptr)
+		{
+			_frees++;
+			if (_loaded->full())
+			{
+				if (!_previous->full())
+				{
+					std::swap(_loaded, _previous);
+				}
+				else
+				{
+					Depot& d = depot();
+					_puts++;
+					d._full.push(_previous);
+					_previous = _loaded;
+					_loaded = d.get_empty();
+					flush_stats();
+				}
+			}
+
+			_loaded->_items[_loaded->_count++] = ptr;
+		}
+
+		void flush_stats()
+		{
+			Depot& d = depot();
+			d._allocs.fetch_add(_allocs, std::memory_order_relaxed);
+			d._frees.fetch_add(_frees, std::memory_order_relaxed);
+			d._depot_gets.fetch_add(_gets, std::memory_order_relaxed);
+			d._depot_puts.fetch_add(_puts, std::memory_order_relaxed);
+			_allocs = _frees = _gets = _puts = 0;
+		}
+
+		//̻߳Ѿ, ֲ߳̾ʱͷ˳Ķ
+		static inline bool& dead()
+		{
+			thread_local static bool _dead = false;
+			return _dead;
+		}
+
+	private:
+		Magazine*	_loaded;
+		Magazine*	_previous;
+
+		uint64_t	_allocs;
+		uint64_t	_frees;
+		uint64_t	_gets;
+		uint64_t	_puts;
+	};
+
+	static inline ThreadCache& cache()
+	{
+		thread_local static ThreadCache _cache;
+		return _cache;
+	}
+
+	/*
+	 *	̻߳Ѿõʱ, ֱӺͲֿ⽻
+	 */
+	static void* pop_from_depot()
+	{
+		Depot& d = depot();
+		Magazine* mag = d._full.pop();
+		if (mag == NULL)
+		{
+			mag = d.get_empty();
+			d.fill(mag);
+		}
+
+		void* ptr = mag->_items[--mag->_count];
+		d.put(mag);
+		d._allocs.fetch_add(1, std::memory_order_relaxed);
+		return ptr;
+	}
+
+	static void push_to_depot(void* ptr)
+	{
+		Depot& d = depot();
+		Magazine* mag = d.get_empty();
+		mag->_items[mag->_count++] = ptr;
+		d._full.push(mag);
+		d._frees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+public:
+	static T* construct()
+	{
+		void* mem = ThreadCache::dead() ? pop_from_depot() : cache().pop();
+		return new(mem) T();
+	}
+
+	static void destroy(T* pobj)
+	{
+		pobj->~T();
+
+		//Ǳģֿ, Ĳֿ
+		MagazineSlotHeader* header = &to_slot(pobj)->_header;
+		if (header->_owner != &depot())
+		{
+			header->_owner->push_remote(header);
+			return;
+		}
+
+		if (ThreadCache::dead())
+			push_to_depot(pobj);
+		else
+			cache().push(pobj);
+	}
+
+	/*
+	 *	ͳ, ̱߳صļںͲֿ⽻ϻ߳˳ʱŻ
+	 *	Կǽֵ, ҪȷֵĻڸ߳flush_stats
+	 */
+	static PoolStats stats()
+	{
+		Depot& d = depot();
+		PoolStats ret;
+		ret._allocs = d._allocs.load(std::memory_order_relaxed);
+		ret._frees = d._frees.load(std::memory_order_relaxed);
+		ret._capacity = d._capacity.load(std::memory_order_relaxed);
+		ret._depot_gets = d._depot_gets.load(std::memory_order_relaxed);
+		ret._depot_puts = d._depot_puts.load(std::memory_order_relaxed);
+		ret._remote_frees = d._remote_frees.load(std::memory_order_relaxed);
+		ret._frees += ret._remote_frees;
+		return ret;
+	}
+
+	/*
+	 *	ѵǰ̵߳ıؼܵȫ
+	 */
+	static void flush_stats()
+	{
+		if (!ThreadCache::dead())
+			cache().flush_stats();
+	}
+};
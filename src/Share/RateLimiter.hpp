@@ -0,0 +1,156 @@
+/*!
+ * \file RateLimiter.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/07
+ *
+ * \brief 
+ *
+ * ÿֻ(+1)ʱ, θ
+ * Ժ, ϵһʱڴ, ˵ڵĴ
+ * ¼ͼ鶼O(1), ҲҪڵ
+ */
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+class SlidingWindow
+{
+public:
+	SlidingWindow() :_timespan(0), _limits(0), _head(0), _size(0) {}
+
+	/*
+	 *	ʼ
+	 *	@timespan	ڳ, λʱһ, һǺ
+	 *	@limits		
+	 */
+	void init(uint64_t timespan, uint32_t limits)
+	{
+		_timespan = timespan;
+		_limits = limits;
+		_stamps.assign(limits + 1, 0);
+		_head = 0;
+		_size = 0;
+	}
+
+	inline uint64_t	timespan() const { return _timespan; }
+	inline uint32_t	limits() const { return _limits; }
+
+	/*
+	 *	¼һ
+	 *	ʱܻ, ﱣ֤ʱǲ
+	 */
+	inline void record(uint64_t now)
+	{
+		if (_size > 0)
+		{
+			uint64_t last = _stamps[(_head + _stamps.size() - 1) % _stamps.size()];
+			if (now < last)
+				now = last;
+		}
+
+		_stamps[_head] = now;
+		_head = (_head + 1) % _stamps.size();
+		if (_size < _stamps.size())
+			_size++;
+	}
+
+	/*
+	 *	ڵĴǷѾ
+	 */
+	inline bool exceeded(uint64_t now) const
+	{
+		if (_size < _stamps.size())
+			return false;
+
+		//˵ʱ, _headָľϵʱ
+		return _stamps[_head] + _timespan >= now;
+	}
+
+	/*
+	 *	ڵĴ, ෵+1
+	 *	ʱ, öֲ, Ҫ־
+	 */
+	uint32_t count(uint64_t now) const
+	{
+		std::size_t cap = _stamps.size();
+		std::size_t tail = (_head + cap - _size) % cap;
+		uint32_t lo = 0;
+		uint32_t hi = _size;
+		while (lo < hi)
+		{
+			uint32_t mid = (lo + hi) / 2;
+			if (_stamps[(tail + mid) % cap] + _timespan >= now)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+
+		return _size - lo;
+	}
+
+	inline void clear()
+	{
+		_head = 0;
+		_size = 0;
+	}
+
+private:
+	uint64_t				_timespan;
+	uint32_t				_limits;
+	std::vector<uint64_t>	_stamps;
+	std::size_t				_head;
+	std::size_t				_size;
+};
+
+/*
+ *	രڵ, ÿ벻20, ÿӲ300
+ */
+class RateLimiter
+{
+public:
+	void add_window(uint64_t timespan, uint32_t limits)
+	{
+		if (timespan == 0 || limits == 0)
+			return;
+
+		_windows.emplace_back();
+		_windows.back().init(timespan, limits);
+	}
+
+	inline bool empty() const { return _windows.empty(); }
+
+	inline std::size_t size() const { return _windows.size(); }
+
+	inline const SlidingWindow& window(std::size_t idx) const { return _windows[idx]; }
+
+	inline void record(uint64_t now)
+	{
+		for (SlidingWindow& w : _windows)
+			w.record(now);
+	}
+
+	/*
+	 *	д
+	 *	صһ޵Ĵڵ±, ûг޷-1
+	 */
+	inline int32_t check(uint64_t now) const
+	{
+		for (std::size_t i = 0; i < _windows.size(); i++)
+		{
+			if (_windows[i].exceeded(now))
+				return (int32_t)i;
+		}
+
+		return -1;
+	}
+
+	inline void clear()
+	{
+		for (SlidingWindow& w : _windows)
+			w.clear();
+	}
+
+private:
+	std::vector<SlidingWindow>	_windows;
+};
@@ -0,0 +1,137 @@
+/*!
+ * \file RingQueue.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/08
+ *
+ * \brief нζ
+ *
+ * ʵֲοDmitry Vyukovbounded MPMC queue
+ * ÿλһţߺ߸ͨCASƽλãҪ
+ * ȡ2ݣԪǶļ򵥽ṹ
+ */
+#pragma once
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+template<typename T>
+class RingQueue
+{
+private:
+	typedef struct _Cell
+	{
+		std::atomic<std::size_t>	_seq;
+		T							_data;
+	} Cell;
+
+public:
+	/*
+	 *	캯
+	 *	@capacity	ȡ2
+	 */
+	RingQueue(std::size_t capacity = 65536)
+	{
+		std::size_t realCap = 2;
+		while (realCap < capacity)
+			realCap <<= 1;
+
+		_mask = realCap - 1;
+		_cells.reset(new Cell[realCap]);
+		for (std::size_t i = 0; i < realCap; i++)
+			_cells[i]._seq.store(i, std::memory_order_relaxed);
+
+		_write_pos.store(0, std::memory_order_relaxed);
+		_read_pos.store(0, std::memory_order_relaxed);
+	}
+
+	RingQueue(const RingQueue&) = delete;
+	RingQueue& operator=(const RingQueue&) = delete;
+
+public:
+	/*
+	 *	дһԪأ򷵻false
+	 */
+	inline bool try_push(const T& item)
+	{
+		Cell* cell;
+		std::size_t pos = _write_pos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &_cells[pos & _mask];
+			std::size_t seq = cell->_seq.load(std::memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+			if (dif == 0)
+			{
+				if (_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = _write_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->_data = item;
+		cell->_seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 *	ԶȡһԪأΪ򷵻false
+	 */
+	inline bool try_pop(T& item)
+	{
+		Cell* cell;
+		std::size_t pos = _read_pos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &_cells[pos & _mask];
+			std::size_t seq = cell->_seq.load(std::memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+			if (dif == 0)
+			{
+				if (_read_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = _read_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		item = cell->_data;
+		cell->_seq.store(pos + _mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 *	ǰеԪظֻ߳һֵ
+	 */
+	inline std::size_t size() const
+	{
+		std::size_t wpos = _write_pos.load(std::memory_order_relaxed);
+		std::size_t rpos = _read_pos.load(std::memory_order_relaxed);
+		return (wpos > rpos) ? (wpos - rpos) : 0;
+	}
+
+	inline bool empty() const { return size() == 0; }
+
+	inline std::size_t capacity() const { return _mask + 1; }
+
+private:
+	std::unique_ptr<Cell[]>	_cells;
+	std::size_t			_mask;
+
+	//дλ÷ֿڲͬĻϣα
+	alignas(64) std::atomic<std::size_t>	_write_pos;
+	alignas(64) std::atomic<std::size_t>	_read_pos;
+};
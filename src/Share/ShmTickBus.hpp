@@ -0,0 +1,272 @@
+/*!
+ * \file ShmTickBus.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/16
+ *
+ * \brief ڹڴ
+ *
+ * ڴһĻλÿλһ
+ * дͨԭӲȡλÿλseqlockд˲ᱻȡ
+ * ÿȡ˸άԼĶȡλãԶȫ
+ * ȡ˴̫дȦĻǵݣضʧ
+ */
+#pragma once
+#include "BoostShm.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#include <stdint.h>
+
+//ϵ
+typedef enum tagShmBusDataType
+{
+	SBT_Tick = 1,	//tick
+	SBT_OrdQue,		//ίж
+	SBT_OrdDtl,		//ίϸ
+	SBT_Trans		//ʳɽ
+} ShmBusDataType;
+
+class ShmTickBus
+{
+public:
+	//ݵ󳤶ȣԷWTSTickStruct
+	static const uint32_t MAX_DATA_SIZE = 512;
+
+	//ȡ
+	typedef enum tagReadResult
+	{
+		RR_None = 0,	//û
+		RR_Ok,			//һ
+		RR_Lost			//дȦȡλѾµ
+	} ReadResult;
+
+private:
+	static const uint64_t BUS_MAGIC = 0x5355424D48535457ULL;	//"WTSHMBUS"
+	static const uint32_t BUS_VERSION = 2;
+
+	typedef struct alignas(64) _BusHeader
+	{
+		uint64_t	_magic;
+		uint32_t	_version;
+		uint32_t	_capacity;
+		uint32_t	_slot_size;
+		uint32_t	_reserved;
+		uint64_t	_epoch;		//ʱд, дؽԺ仯
+
+		alignas(64) std::atomic<uint64_t>	_write_pos;
+	} BusHeader;
+
+	/*
+	 *	_seqΪ0ʾûд
+	 *	дposʱΪpos*2+1дԺΪpos*2+2
+	 */
+	typedef struct alignas(64) _BusSlot
+	{
+		std::atomic<uint64_t>	_seq;
+		uint64_t	_stamp;		//дʱʱλ룬ͳӳ
+		uint32_t	_type;
+		uint32_t	_length;
+		char		_data[MAX_DATA_SIZE];
+	} BusSlot;
+
+	static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic<uint64_t> is not plain in shared memory");
+
+public:
+	ShmTickBus() : _header(NULL), _slots(NULL), _mask(0) {}
+
+	/*
+	 *	ǰʱλ
+	 *	ʹõʱӣͬһ̨ϵĲ֮ͬԱȽ
+	 */
+	static inline uint64_t now_nano()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/*
+	 *	ߣд˵
+	 *	@name		ڴ
+	 *	@capacity	λȡ2
+	 */
+	bool create(const char* name, uint32_t capacity)
+	{
+		uint32_t realCap = 2;
+		while (realCap < capacity)
+			realCap <<= 1;
+
+		std::size_t size = sizeof(BusHeader) + sizeof(BusSlot)*realCap;
+		if (!_shm.create(name, size))
+			return false;
+
+		char* addr = (char*)_shm.addr();
+		memset(addr, 0, size);
+
+		_header = (BusHeader*)addr;
+		_header->_version = BUS_VERSION;
+		_header->_capacity = realCap;
+		_header->_slot_size = sizeof(BusSlot);
+		_header->_epoch = now_nano();
+		_header->_write_pos.store(0, std::memory_order_relaxed);
+		_slots = (BusSlot*)(addr + sizeof(BusHeader));
+		_mask = realCap - 1;
+
+		//дǣȡ˿ԺͿ
+		std::atomic_thread_fence(std::memory_order_release);
+		_header->_magic = BUS_MAGIC;
+		return true;
+	}
+
+	/*
+	 *	Ѿڵߣȡ˵
+	 */
+	bool open(const char* name)
+	{
+		if (!_shm.open(name))
+			return false;
+
+		if (_shm.size() < sizeof(BusHeader))
+		{
+			_shm.close();
+			return false;
+		}
+
+		BusHeader* header = (BusHeader*)_shm.addr();
+		if (header->_magic != BUS_MAGIC || header->_version != BUS_VERSION || header->_slot_size != sizeof(BusSlot)
+			|| _shm.size() < sizeof(BusHeader) + sizeof(BusSlot)*header->_capacity)
+		{
+			_shm.close();
+			return false;
+		}
+
+		_header = header;
+		_slots = (BusSlot*)((char*)_shm.addr() + sizeof(BusHeader));
+		_mask = header->_capacity - 1;
+		return true;
+	}
+
+	void close()
+	{
+		_shm.close();
+		_header = NULL;
+		_slots = NULL;
+		_mask = 0;
+	}
+
+	inline bool valid() const { return _header != NULL; }
+
+	inline uint32_t capacity() const { return _header ? _header->_capacity : 0; }
+
+	inline uint64_t epoch() const { return _header ? _header->_epoch : 0; }
+
+	/*
+	 *	ȡͬߵǰepoch, ֻӳļͷ
+	 *	дʱɾɵĹڴؽ, Ѿ򿪵Ķȡ˻ӳžɵڴ, Ҳᱨ
+	 *	ȡ˿Զڼ, Լʱepochһ¾˵Ҫ´
+	 *	߲ڻ߻ûгʼɷ0
+	 */
+	static uint64_t probe_epoch(const char* name)
+	{
+		try
+		{
+			boost::interprocess::shared_memory_object obj(boost::interprocess::open_only, name, boost::interprocess::read_only);
+			boost::interprocess::mapped_region region(obj, boost::interprocess::read_only, 0, sizeof(BusHeader));
+			const BusHeader* header = (const BusHeader*)region.get_address();
+			if (header->_magic != BUS_MAGIC || header->_version != BUS_VERSION)
+				return 0;
+
+			return header->_epoch;
+		}
+		catch (...)
+		{
+			return 0;
+		}
+	}
+
+	/*
+	 *	µдλãȡ˴￪ʼֻ֮д
+	 */
+	inline uint64_t tail() const
+	{
+		return _header->_write_pos.load(std::memory_order_acquire);
+	}
+
+	/*
+	 *	дһݣд˿ͬʱ
+	 *	@type	
+	 *	@data	ݵַ
+	 *	@len	ݳȣܳMAX_DATA_SIZE
+	 */
+	inline bool publish(uint32_t type, const void* data, uint32_t len)
+	{
+		if (len > MAX_DATA_SIZE)
+			return false;
+
+		uint64_t pos = _header->_write_pos.fetch_add(1, std::memory_order_acq_rel);
+		BusSlot& slot = _slots[pos & _mask];
+
+		slot._seq.store(pos * 2 + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot._stamp = now_nano();
+		slot._type = type;
+		slot._length = len;
+		memcpy(slot._data, data, len);
+
+		slot._seq.store(pos * 2 + 2, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 *	ȡһ
+	 *	@cursor	ȡλãȡɹԺԶ
+	 *	@type	
+	 *	@buf	ݻ棬ȲСMAX_DATA_SIZE
+	 *	@stamp	дʱʱ
+	 *	@lost	RR_LostʱΪʧ
+	 */
+	inline ReadResult read(uint64_t& cursor, uint32_t& type, void* buf, uint64_t& stamp, uint64_t& lost)
+	{
+		BusSlot& slot = _slots[cursor & _mask];
+		uint64_t expected = cursor * 2 + 2;
+
+		uint64_t seq = slot._seq.load(std::memory_order_acquire);
+		if (seq == expected)
+		{
+			type = slot._type;
+			stamp = slot._stamp;
+			uint32_t len = slot._length;
+			memcpy(buf, slot._data, len < MAX_DATA_SIZE ? len : MAX_DATA_SIZE);
+
+			//Ĺбˣ͵Ȧ
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot._seq.load(std::memory_order_relaxed) == seq)
+			{
+				cursor++;
+				return RR_Ok;
+			}
+		}
+		else if (seq < expected)
+		{
+			//ûдд
+			return RR_None;
+		}
+
+		//ȦˣûбǵλãȦ
+		uint64_t wpos = tail();
+		uint64_t newCursor = wpos - (_mask + 1) / 2;
+		if (newCursor <= cursor)
+			newCursor = cursor + 1;
+		lost = newCursor - cursor;
+		cursor = newCursor;
+		return RR_Lost;
+	}
+
+private:
+	BoostShm	_shm;
+	BusHeader*	_header;
+	BusSlot*	_slots;
+	uint64_t	_mask;
+};
@@ -0,0 +1,344 @@
+/*!
+ * \file SimdKernels.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/20
+ *
+ * \brief doubleϵͳƺ
+ *
+ * ʱAVX/AVX2-mavx2/arch:AVX2Ļʹ256λָһδ4
+ * ʹöۼıѭһҲԶSSE2
+ * ڵСֵʹvan Herk/Gil-Werman㷨ʹڴС޹أÿԪֻҪ3αȽ
+ */
+#pragma once
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX__)
+#include <immintrin.h>
+#define WT_SIMD_AVX
+#endif
+
+class SimdKernels
+{
+public:
+	static inline double max_value(const double* data, std::size_t count)
+	{
+		if (count == 0)
+			return 0.0;
+
+		std::size_t i = 0;
+		double ret = data[0];
+#ifdef WT_SIMD_AVX
+		if (count >= 4)
+		{
+			__m256d vMax = _mm256_loadu_pd(data);
+			for (i = 4; i + 4 <= count; i += 4)
+				vMax = _mm256_max_pd(vMax, _mm256_loadu_pd(data + i));
+
+			alignas(32) double tmp[4];
+			_mm256_store_pd(tmp, vMax);
+			ret = tmp[0];
+			for (int k = 1; k < 4; k++)
+				ret = tmp[k] > ret ? tmp[k] : ret;
+		}
+#else
+		if (count >= 4)
+		{
+			double m0 = data[0], m1 = data[1], m2 = data[2], m3 = data[3];
+			for (i = 4; i + 4 <= count; i += 4)
+			{
+				m0 = data[i] > m0 ? data[i] : m0;
+				m1 = data[i + 1] > m1 ? data[i + 1] : m1;
+				m2 = data[i + 2] > m2 ? data[i + 2] : m2;
+				m3 = data[i + 3] > m3 ? data[i + 3] : m3;
+			}
+			m0 = m1 > m0 ? m1 : m0;
+			m2 = m3 > m2 ? m3 : m2;
+			ret = m2 > m0 ? m2 : m0;
+		}
+#endif
+		for (; i < count; i++)
+			ret = data[i] > ret ? data[i] : ret;
+
+		return ret;
+	}
+
+	static inline double min_value(const double* data, std::size_t count)
+	{
+		if (count == 0)
+			return 0.0;
+
+		std::size_t i = 0;
+		double ret = data[0];
+#ifdef WT_SIMD_AVX
+		if (count >= 4)
+		{
+			__m256d vMin = _mm256_loadu_pd(data);
+			for (i = 4; i + 4 <= count; i += 4)
+				vMin = _mm256_min_pd(vMin, _mm256_loadu_pd(data + i));
+
+			alignas(32) double tmp[4];
+			_mm256_store_pd(tmp, vMin);
+			ret = tmp[0];
+			for (int k = 1; k < 4; k++)
+				ret = tmp[k] < ret ? tmp[k] : ret;
+		}
+#else
+		if (count >= 4)
+		{
+			double m0 = data[0], m1 = data[1], m2 = data[2], m3 = data[3];
+			for (i = 4; i + 4 <= count; i += 4)
+			{
+				m0 = data[i] < m0 ? data[i] : m0;
+				m1 = data[i + 1] < m1 ? data[i + 1] : m1;
+				m2 = data[i + 2] < m2 ? data[i + 2] : m2;
+				m3 = data[i + 3] < m3 ? data[i + 3] : m3;
+			}
+			m0 = m1 < m0 ? m1 : m0;
+			m2 = m3 < m2 ? m3 : m2;
+			ret = m2 < m0 ? m2 : m0;
+		}
+#endif
+		for (; i < count; i++)
+			ret = data[i] < ret ? data[i] : ret;
+
+		return ret;
+	}
+
+	static inline double sum(const double* data, std::size_t count)
+	{
+		std::size_t i = 0;
+		double ret = 0.0;
+#ifdef WT_SIMD_AVX
+		__m256d vSum = _mm256_setzero_pd();
+		for (; i + 4 <= count; i += 4)
+			vSum = _mm256_add_pd(vSum, _mm256_loadu_pd(data + i));
+
+		alignas(32) double tmp[4];
+		_mm256_store_pd(tmp, vSum);
+		ret = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+#else
+		double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			s0 += data[i];
+			s1 += data[i + 1];
+			s2 += data[i + 2];
+			s3 += data[i + 3];
+		}
+		ret = (s0 + s1) + (s2 + s3);
+#endif
+		for (; i < count; i++)
+			ret += data[i];
+
+		return ret;
+	}
+
+	static inline double mean(const double* data, std::size_t count)
+	{
+		if (count == 0)
+			return 0.0;
+
+		return sum(data, count) / count;
+	}
+
+	/*
+	 *	׼TA-LibSTDDEVһ
+	 *	ֵƽͣʧ
+	 */
+	static inline double stddev(const double* data, std::size_t count)
+	{
+		if (count == 0)
+			return 0.0;
+
+		double avg = mean(data, count);
+		std::size_t i = 0;
+		double ret = 0.0;
+#ifdef WT_SIMD_AVX
+		__m256d vAvg = _mm256_set1_pd(avg);
+		__m256d vSum = _mm256_setzero_pd();
+		for (; i + 4 <= count; i += 4)
+		{
+			__m256d d = _mm256_sub_pd(_mm256_loadu_pd(data + i), vAvg);
+			vSum = _mm256_add_pd(vSum, _mm256_mul_pd(d, d));
+		}
+
+		alignas(32) double tmp[4];
+		_mm256_store_pd(tmp, vSum);
+		ret = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+#else
+		double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			double d0 = data[i] - avg, d1 = data[i + 1] - avg, d2 = data[i + 2] - avg, d3 = data[i + 3] - avg;
+			s0 += d0 * d0;
+			s1 += d1 * d1;
+			s2 += d2 * d2;
+			s3 += d3 * d3;
+		}
+		ret = (s0 + s1) + (s2 + s3);
+#endif
+		for (; i < count; i++)
+		{
+			double d = data[i] - avg;
+			ret += d * d;
+		}
+
+		return sqrt(ret / count);
+	}
+
+	/*
+	 *	
+	 *	out[i]Ϊdata[i-window+1]data[i]ĺͣǰwindow-1λinvalid
+	 *	ÿһһκͣⳤۻ
+	 */
+	static void rolling_sum(const double* data, std::size_t count, std::size_t window, double* out, double invalid)
+	{
+		if (window == 0 || window > count)
+		{
+			for (std::size_t i = 0; i < count; i++)
+				out[i] = invalid;
+			return;
+		}
+
+		for (std::size_t i = 0; i + 1 < window; i++)
+			out[i] = invalid;
+
+		const std::size_t RESYNC = 4096;
+		double s = sum(data, window);
+		out[window - 1] = s;
+		for (std::size_t i = window; i < count; i++)
+		{
+			if ((i - window + 1) % RESYNC == 0)
+				s = sum(data + i - window + 1, window);
+			else
+				s += data[i] - data[i - window];
+			out[i] = s;
+		}
+	}
+
+	static void rolling_mean(const double* data, std::size_t count, std::size_t window, double* out, double invalid)
+	{
+		rolling_sum(data, count, window, out, invalid);
+		if (window == 0 || window > count)
+			return;
+
+		double ratio = 1.0 / window;
+		for (std::size_t i = window - 1; i < count; i++)
+			out[i] *= ratio;
+	}
+
+	/*
+	 *	׼
+	 *	ڵľֵƽͶµģÿRESYNC_STEPSԴ׸ֵΪ׼ȫһΣԽԽ
+	 *	кСĸҪضϵ0
+	 */
+	static void rolling_stddev(const double* data, std::size_t count, std::size_t window, double* out, double invalid)
+	{
+		if (window == 0 || window > count)
+		{
+			for (std::size_t i = 0; i < count; i++)
+				out[i] = invalid;
+			return;
+		}
+
+		for (std::size_t i = 0; i + 1 < window; i++)
+			out[i] = invalid;
+
+		const std::size_t RESYNC_STEPS = 1024;
+		double base = 0.0, s = 0.0, sq = 0.0;
+		for (std::size_t i = window - 1; i < count; i++)
+		{
+			if ((i + 1 - window) % RESYNC_STEPS == 0)
+			{
+				std::size_t head = i + 1 - window;
+				base = data[head];
+				s = 0.0;
+				sq = 0.0;
+				for (std::size_t j = head; j <= i; j++)
+				{
+					double d = data[j] - base;
+					s += d;
+					sq += d * d;
+				}
+			}
+			else
+			{
+				double dIn = data[i] - base;
+				double dOut = data[i - window] - base;
+				s += dIn - dOut;
+				sq += dIn * dIn - dOut * dOut;
+			}
+
+			double avg = s / window;
+			double var = sq / window - avg * avg;
+			out[i] = var > 0 ? sqrt(var) : 0.0;
+		}
+	}
+
+	/*
+	 *	ֵvan Herk/Gil-Werman㷨
+	 *	аڴСֶΣֱڵǰ׺ֵͺ׺ֵ
+	 *	һڶÿΣǰһεĺ׺ֵͺһεǰ׺ֵнϴһ
+	 */
+	static void rolling_max(const double* data, std::size_t count, std::size_t window, double* out, double invalid)
+	{
+		rolling_extreme<true>(data, count, window, out, invalid);
+	}
+
+	static void rolling_min(const double* data, std::size_t count, std::size_t window, double* out, double invalid)
+	{
+		rolling_extreme<false>(data, count, window, out, invalid);
+	}
+
+private:
+	template<bool isMax>
+	static inline double pick(double a, double b)
+	{
+		if (isMax)
+			return a > b ? a : b;
+		else
+			return a < b ? a : b;
+	}
+
+	template<bool isMax>
+	static void rolling_extreme(const double* data, std::size_t count, std::size_t window, double* out, double invalid)
+	{
+		if (window == 0 || window > count)
+		{
+			for (std::size_t i = 0; i < count; i++)
+				out[i] = invalid;
+			return;
+		}
+
+		thread_local static std::vector<double> prefix;
+		thread_local static std::vector<double> suffix;
+		prefix.resize(count);
+		suffix.resize(count);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			if (i % window == 0)
+				prefix[i] = data[i];
+			else
+				prefix[i] = pick<isMax>(prefix[i - 1], data[i]);
+		}
+
+		for (std::size_t i = count; i > 0; i--)
+		{
+			std::size_t idx = i - 1;
+			if (idx == count - 1 || (idx + 1) % window == 0)
+				suffix[idx] = data[idx];
+			else
+				suffix[idx] = pick<isMax>(suffix[idx + 1], data[idx]);
+		}
+
+		for (std::size_t i = 0; i + 1 < window; i++)
+			out[i] = invalid;
+
+		for (std::size_t i = window - 1; i < count; i++)
+			out[i] = pick<isMax>(suffix[i - window + 1], prefix[i]);
+	}
+};
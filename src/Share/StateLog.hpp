@@ -0,0 +1,390 @@
+/*!
+ * \file StateLog.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/11
+ *
+ * \brief ׷дĶ״̬־
+ *
+ * ״̬ռֵԱ, ÿύֻѷ仯ļ׷ӵļĩβ
+ * ļ = ļͷ + (ѹʱдȫ¼) + ֮׷ӵļ¼
+ * صʱ˳ط, ļ¼ǰļ¼, ĩβļ¼ᱻص
+ * ļСЧݵһԺ, дһݿ
+ */
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "BoostFile.hpp"
+#include "../Includes/FasterDefs.h"
+
+#pragma pack(push, 1)
+typedef struct _StateLogHeader
+{
+	char		_magic[4];
+	uint32_t	_version;
+	uint64_t	_reserved;
+} StateLogHeader;
+
+typedef struct _StateRecordHeader
+{
+	uint32_t	_length;	//¼ĳ
+	uint32_t	_checksum;	//¼У
+	uint8_t		_op;		//1-д, 2-ɾ
+	uint16_t	_keylen;
+} StateRecordHeader;
+#pragma pack(pop)
+
+/*
+ *	д
+ */
+class StateWriter
+{
+public:
+	StateWriter(std::string& buf) :_buf(buf) {}
+
+	template<typename T>
+	inline StateWriter& write(const T& val)
+	{
+		_buf.append((const char*)&val, sizeof(T));
+		return *this;
+	}
+
+	inline StateWriter& write_bytes(const void* data, std::size_t len)
+	{
+		_buf.append((const char*)data, len);
+		return *this;
+	}
+
+	inline StateWriter& write_str(const std::string& str)
+	{
+		write((uint32_t)str.size());
+		_buf.append(str);
+		return *this;
+	}
+
+private:
+	std::string&	_buf;
+};
+
+/*
+ *	ӻȡ, Խ緵false
+ */
+class StateReader
+{
+public:
+	StateReader(const std::string& buf) :_data(buf.data()), _left(buf.size()) {}
+
+	template<typename T>
+	inline bool read(T& val)
+	{
+		return read_bytes(&val, sizeof(T));
+	}
+
+	inline bool read_bytes(void* data, std::size_t len)
+	{
+		if (_left < len)
+			return false;
+
+		memcpy(data, _data, len);
+		_data += len;
+		_left -= len;
+		return true;
+	}
+
+	inline bool read_str(std::string& str)
+	{
+		uint32_t len = 0;
+		if (!read(len) || _left < len)
+			return false;
+
+		str.assign(_data, len);
+		_data += len;
+		_left -= len;
+		return true;
+	}
+
+private:
+	const char*	_data;
+	std::size_t	_left;
+};
+
+class StateLog
+{
+public:
+	typedef wtp::wt_hashmap<std::string, std::string> RecordMap;
+
+	StateLog() :_version(0), _file_size(0), _live_size(0), _compact_ratio(4), _min_compact_size(64 * 1024){}
+
+	~StateLog()
+	{
+		commit();
+	}
+
+	/*
+	 *	״̬־, ļڵĻطм¼
+	 *	@filename	ļ
+	 *	@version	ݰ汾, ļĲһµĻ, ԭļΪfilename.bad, ½һ
+	 */
+	bool open(const char* filename, uint32_t version)
+	{
+		_filename = filename;
+		_version = version;
+		_records.clear();
+		_pending.clear();
+		_live_size = 0;
+		_bad_file.clear();
+
+		std::string content;
+		if (BoostFile::exists(filename))
+			BoostFile::read_file_contents(filename, content);
+
+		std::size_t validLen = replay(content);
+		if (validLen == 0)
+		{
+			//ļͷԻ߰汾һµ, Ųһ, ֱӸ
+			if (!content.empty())
+			{
+				boost::system::error_code ec;
+				boost::filesystem::rename(_filename, _filename + ".bad", ec);
+				if (ec)
+					return false;
+
+				_bad_file = _filename + ".bad";
+			}
+
+			_records.clear();
+			_live_size = 0;
+			return rewrite();
+		}
+
+		if (!_file.create_or_open_file(filename))
+			return false;
+
+		//ĩβļ¼ص
+		if (validLen < content.size())
+			_file.truncate_file(validLen);
+		_file.seek_to_end();
+		_file_size = validLen;
+		return true;
+	}
+
+	inline const RecordMap& records() const { return _records; }
+
+	/*
+	 *	ʱŲߵЧļ, ûеĻΪ
+	 */
+	inline const std::string& bad_file() const { return _bad_file; }
+
+	inline bool empty() const { return _records.empty(); }
+
+	inline uint64_t file_size() const { return _file_size; }
+
+	/*
+	 *	ѹ
+	 *	@ratio		ļСЧݶٱʱѹ
+	 *	@minSize	ļССʱѹ
+	 */
+	inline void set_compact_policy(uint32_t ratio, uint64_t minSize)
+	{
+		_compact_ratio = ratio;
+		_min_compact_size = minSize;
+	}
+
+	/*
+	 *	дһ¼, ͵ǰֵһĻд
+	 */
+	void put(const std::string& key, const std::string& data)
+	{
+		auto it = _records.find(key);
+		if (it != _records.end())
+		{
+			if (it->second == data)
+				return;
+
+			_live_size -= record_size(key, it->second);
+			it->second = data;
+		}
+		else
+		{
+			_records[key] = data;
+		}
+
+		_live_size += record_size(key, data);
+		encode(_pending, 1, key, data);
+	}
+
+	void remove(const std::string& key)
+	{
+		auto it = _records.find(key);
+		if (it == _records.end())
+			return;
+
+		_live_size -= record_size(key, it->second);
+		_records.erase(it);
+		encode(_pending, 2, key, std::string());
+	}
+
+	/*
+	 *	ѱֵı仯һдļ, ҪĻ˳ѹ
+	 *	дֽ
+	 */
+	std::size_t commit()
+	{
+		if (_pending.empty() || !_file.valid())
+			return 0;
+
+		std::size_t len = _pending.size();
+		_file.write_file(_pending);
+		_file_size += len;
+		_pending.clear();
+
+		if (_file_size > _min_compact_size && _file_size > _live_size * _compact_ratio)
+			compact();
+
+		return len;
+	}
+
+	/*
+	 *	ѵǰȫ¼дһݿ
+	 */
+	inline bool compact()
+	{
+		_pending.clear();
+		return rewrite();
+	}
+
+private:
+	static inline uint32_t checksum(const char* data, std::size_t len)
+	{
+		//FNV-1a
+		uint32_t hash = 2166136261u;
+		for (std::size_t i = 0; i < len; i++)
+		{
+			hash ^= (uint8_t)data[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	static inline std::size_t record_size(const std::string& key, const std::string& data)
+	{
+		return sizeof(StateRecordHeader) + key.size() + data.size();
+	}
+
+	static void encode(std::string& buf, uint8_t op, const std::string& key, const std::string& data)
+	{
+		std::size_t pos = buf.size();
+		buf.resize(pos + sizeof(StateRecordHeader));
+		buf.append(key);
+		buf.append(data);
+
+		StateRecordHeader* header = (StateRecordHeader*)(buf.data() + pos);
+		header->_op = op;
+		header->_keylen = (uint16_t)key.size();
+		header->_length = (uint32_t)(sizeof(uint8_t) + sizeof(uint16_t) + key.size() + data.size());
+		header->_checksum = checksum((const char*)&header->_op, header->_length);
+	}
+
+	/*
+	 *	طļ, Чݵĳ, ļͷԷ0
+	 */
+	std::size_t replay(const std::string& content)
+	{
+		if (content.size() < sizeof(StateLogHeader))
+			return 0;
+
+		const StateLogHeader* fHeader = (const StateLogHeader*)content.data();
+		if (memcmp(fHeader->_magic, "WTSL", 4) != 0 || fHeader->_version != _version)
+			return 0;
+
+		const std::size_t fixedLen = sizeof(uint32_t) * 2;
+		std::size_t offset = sizeof(StateLogHeader);
+		while (offset + sizeof(StateRecordHeader) <= content.size())
+		{
+			const StateRecordHeader* header = (const StateRecordHeader*)(content.data() + offset);
+			std::size_t bodyLen = header->_length;
+			if (bodyLen < sizeof(uint8_t) + sizeof(uint16_t) + header->_keylen || offset + fixedLen + bodyLen > content.size())
+				break;
+
+			if (checksum((const char*)&header->_op, bodyLen) != header->_checksum)
+				break;
+
+			const char* key = content.data() + offset + sizeof(StateRecordHeader);
+			std::string strKey(key, header->_keylen);
+			if (header->_op == 1)
+			{
+				std::size_t dataLen = bodyLen - sizeof(uint8_t) - sizeof(uint16_t) - header->_keylen;
+				auto it = _records.find(strKey);
+				if (it != _records.end())
+					_live_size -= record_size(strKey, it->second);
+
+				std::string& data = _records[strKey];
+				data.assign(key + header->_keylen, dataLen);
+				_live_size += record_size(strKey, data);
+			}
+			else
+			{
+				auto it = _records.find(strKey);
+				if (it != _records.end())
+				{
+					_live_size -= record_size(strKey, it->second);
+					_records.erase(it);
+				}
+			}
+
+			offset += fixedLen + bodyLen;
+		}
+
+		return offset;
+	}
+
+	/*
+	 *	дʱļ, 滻ԭļ
+	 */
+	bool rewrite()
+	{
+		std::string content;
+		StateLogHeader fHeader;
+		memcpy(fHeader._magic, "WTSL", 4);
+		fHeader._version = _version;
+		fHeader._reserved = 0;
+		content.append((const char*)&fHeader, sizeof(StateLogHeader));
+		for (auto& m : _records)
+			encode(content, 1, m.first, m.second);
+
+		_file.close_file();
+
+		std::string tmpfile = _filename + ".tmp";
+		if (!BoostFile::write_file_contents(tmpfile.c_str(), content.data(), (uint32_t)content.size()))
+			return false;
+
+		boost::system::error_code ec;
+		boost::filesystem::rename(tmpfile, _filename, ec);
+		if (ec)
+			return false;
+
+		if (!_file.create_or_open_file(_filename.c_str()))
+			return false;
+
+		_file.seek_to_end();
+		_file_size = content.size();
+		return true;
+	}
+
+private:
+	std::string	_filename;
+	std::string	_bad_file;
+	uint32_t	_version;
+	BoostFile	_file;
+
+	RecordMap	_records;
+	std::string	_pending;		//ֻûдļ¼
+
+	uint64_t	_file_size;
+	uint64_t	_live_size;		//Ч¼ĴС
+	uint32_t	_compact_ratio;
+	uint64_t	_min_compact_size;
+};
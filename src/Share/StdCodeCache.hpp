@@ -0,0 +1,141 @@
+/*!
+ * \file StdCodeCache.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/28
+ *
+ * \brief ׼Ļ
+ *
+ * CodeHelper::extractStdCodeÿζҪ½ַ, Ȩ뻹Ҫ״ַ̬
+ * ÿ׼һνĽפ, ֱӷͬһ, (ģ)ڵַ
+ * Զ()ӳʵԼսջ, ձ仯ߵrefreshԺӳ
+ *
+ * ѯ̱߳ص, Ҫ, ֻĳ̵߳һĳʱŻȫֵı
+ */
+#pragma once
+#include <mutex>
+#include <atomic>
+
+#include "CodeHelper.hpp"
+#include "SpinMutex.hpp"
+#include "../Includes/FasterDefs.h"
+
+class StdCodeCache
+{
+public:
+	typedef struct _StdCodeItem
+	{
+		CodeHelper::CodeInfo	_info;
+
+		//ԶӳĻ
+		SpinMutex	_mtx;
+		uint32_t	_mapped_date;
+		uint32_t	_mapped_gen;
+		std::string	_raw_code;		//ʵԼԭʼ, rb2310
+		std::string	_real_code;		//ʵԼı׼, SHFE.rb.2310
+
+		_StdCodeItem() :_mapped_date(0), _mapped_gen(0) {}
+	} StdCodeItem;
+
+private:
+	typedef wt_hashmap<std::string, StdCodeItem*>	ItemMap;
+	typedef wt_hashmap<IHotMgr*, ItemMap>			HotItemMaps;
+
+	StdCodeCache() :_generation(1) {}
+
+	static StdCodeCache& instance()
+	{
+		static StdCodeCache inst;
+		return inst;
+	}
+
+	/*
+	 *	ȫֱв, ûоͽפ
+	 *	פĶ󲻻ͷ, ԿԷĵķָ
+	 */
+	StdCodeItem* intern(const std::string& stdCode, IHotMgr* hotMgr)
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		StdCodeItem*& item = _items[hotMgr][stdCode];
+		if (item == NULL)
+		{
+			item = new StdCodeItem();
+			item->_info = CodeHelper::extractStdCode(stdCode.c_str(), hotMgr);
+			//ǰƷID, ֻ
+			item->_info.stdCommID();
+		}
+
+		return item;
+	}
+
+public:
+	/*
+	 *	ȡ׼Ľ, صĶģЧ
+	 */
+	static const StdCodeItem* getItem(const char* stdCode, IHotMgr* hotMgr)
+	{
+		thread_local static HotItemMaps localItems;
+		thread_local static std::string key;
+
+		key.assign(stdCode);
+		ItemMap& items = localItems[hotMgr];
+		auto it = items.find(key);
+		if (it != items.end())
+			return it->second;
+
+		StdCodeItem* item = instance().intern(key, hotMgr);
+		items[key] = item;
+		return item;
+	}
+
+	static inline const CodeHelper::CodeInfo& extractStdCode(const char* stdCode, IHotMgr* hotMgr)
+	{
+		return getItem(stdCode, hotMgr)->_info;
+	}
+
+	/*
+	 *	ԶĴӳ䵽ָյʵԼ
+	 *	@stdCode	׼, SHFE.rb.HOT
+	 *	@rawCode	ʵԼԭʼ
+	 *	@realCode	ʵԼı׼
+	 *	ûйĴ뷵false
+	 */
+	static bool mapRuleCode(const char* stdCode, IHotMgr* hotMgr, uint32_t uDate, std::string& rawCode, std::string& realCode)
+	{
+		if (hotMgr == NULL)
+			return false;
+
+		StdCodeItem* item = (StdCodeItem*)getItem(stdCode, hotMgr);
+		const CodeHelper::CodeInfo& cInfo = item->_info;
+		if (!cInfo.hasRule())
+			return false;
+
+		uint32_t curGen = instance()._generation.load(std::memory_order_relaxed);
+
+		SpinLock lock(item->_mtx);
+		if (item->_mapped_date != uDate || item->_mapped_gen != curGen)
+		{
+			item->_raw_code = hotMgr->getCustomRawCode(cInfo._ruletag, cInfo._fullpid, uDate);
+			item->_real_code = CodeHelper::rawMonthCodeToStdCode(item->_raw_code.c_str(), cInfo._exchg);
+			item->_mapped_date = uDate;
+			item->_mapped_gen = curGen;
+		}
+
+		rawCode = item->_raw_code;
+		realCode = item->_real_code;
+		return true;
+	}
+
+	/*
+	 *	Լ¼ػ߻յʱ, ѾӳʵԼȫʧЧ
+	 */
+	static void refresh()
+	{
+		instance()._generation++;
+	}
+
+private:
+	std::mutex				_mtx;
+	HotItemMaps				_items;
+	std::atomic<uint32_t>	_generation;
+};
@@ -0,0 +1,207 @@
+#include "gtest/gtest/gtest.h"
+#include "../WTSTools/WTSBaseDataMgr.h"
+#include "../Includes/WTSContractInfo.hpp"
+#include "../Includes/WTSSessionInfo.hpp"
+#include "../Includes/WTSVariant.hpp"
+#include "../Share/BoostFile.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+USING_NS_WTP;
+
+static void write_file(const char* filename, const std::string& content)
+{
+	BoostFile::write_file_contents(filename, content.data(), (uint32_t)content.size());
+}
+
+/*
+ *	ɲõĻļ, ÿPRODUCTSƷ, ÿƷMONTHSԼ
+ */
+static void write_base_files(uint32_t PRODUCTS, uint32_t MONTHS)
+{
+	write_file("./test_bd_sessions.yaml",
+		"FN2300:\n"
+		"  name: ڻҹ2300\n"
+		"  offset: 300\n"
+		"  auction: {from: 2059, to: 2100}\n"
+		"  sections:\n"
+		"  - {from: 2100, to: 2300}\n"
+		"  - {from: 900, to: 1015}\n"
+		"  - {from: 1030, to: 1130}\n"
+		"  - {from: 1330, to: 1500}\n"
+		"SD0930:\n"
+		"  name: Ʊ0930\n"
+		"  offset: 0\n"
+		"  auction: {from: 915, to: 925}\n"
+		"  sections:\n"
+		"  - {from: 930, to: 1130}\n"
+		"  - {from: 1300, to: 1500}\n");
+
+	write_file("./test_bd_holidays.yaml", "CHINA: [20230101, 20231002, 20231003, 20231004]\n");
+
+	const char* EXCHGS[] = { "SHFE", "DCE", "CZCE" };
+	std::string comms, contracts;
+	for (const char* exchg : EXCHGS)
+	{
+		comms += fmt::format("{}:\n", exchg);
+		contracts += fmt::format("{}:\n", exchg);
+		for (uint32_t i = 0; i < PRODUCTS; i++)
+		{
+			std::string pid = fmt::format("{}{}", (char)('a' + i % 26), i);
+			comms += fmt::format("  {}:\n    name: Ʒ{}\n    session: FN2300\n    holiday: CHINA\n    pricetick: {}\n    volscale: {}\n    covermode: 1\n    pricemode: 0\n",
+				pid, i, 0.5 * (i % 4 + 1), 5 + i % 10);
+
+			for (uint32_t m = 1; m <= MONTHS; m++)
+			{
+				contracts += fmt::format("  {0}23{1:02d}:\n    name: Լ{0}23{1:02d}\n    code: {0}23{1:02d}\n    exchg: {2}\n    product: {0}\n    maxlimitqty: {3}\n    opendate: 20220{4}15\n    expiredate: 2023{1:02d}15\n    longmarginratio: 0.1\n    shortmarginratio: 0.12\n",
+					pid, m, exchg, 500 + m, m % 9 + 1);
+			}
+		}
+	}
+	write_file("./test_bd_commodities.yaml", comms);
+	write_file("./test_bd_contracts.yaml", contracts);
+}
+
+static uint32_t contract_count(WTSBaseDataMgr& mgr)
+{
+	WTSArray* ayCts = mgr.getContracts();
+	uint32_t ret = ayCts->size();
+	ayCts->release();
+	return ret;
+}
+
+static WTSVariant* make_config(const char* snapfile)
+{
+	WTSVariant* cfgBF = WTSVariant::createObject();
+	cfgBF->append("session", "./test_bd_sessions.yaml");
+	cfgBF->append("commodity", "./test_bd_commodities.yaml");
+	cfgBF->append("contract", "./test_bd_contracts.yaml");
+	cfgBF->append("holiday", "./test_bd_holidays.yaml");
+	if (snapfile != NULL)
+		cfgBF->append("snapshot", snapfile);
+	return cfgBF;
+}
+
+static void remove_files(const char* snapfile)
+{
+	BoostFile::delete_file("./test_bd_sessions.yaml");
+	BoostFile::delete_file("./test_bd_commodities.yaml");
+	BoostFile::delete_file("./test_bd_contracts.yaml");
+	BoostFile::delete_file("./test_bd_holidays.yaml");
+	BoostFile::delete_file(snapfile);
+}
+
+TEST(test_basedata, test_snapshot)
+{
+	const char* snapfile = "./test_bd_snapshot.dat";
+	BoostFile::delete_file(snapfile);
+	write_base_files(10, 12);
+
+	WTSVariant* cfgBF = make_config(snapfile);
+
+	//һδԴļ, ɿ
+	WTSBaseDataMgr src;
+	EXPECT_TRUE(src.loadBaseFiles(cfgBF));
+	EXPECT_TRUE(BoostFile::exists(snapfile));
+
+	//ڶδӿռ, ҪԴļصȫһ
+	WTSBaseDataMgr snap;
+	EXPECT_TRUE(snap.loadSnapshot(snapfile, { {BFT_Session, "./test_bd_sessions.yaml"}, {BFT_Commodity, "./test_bd_commodities.yaml"},
+		{BFT_Contract, "./test_bd_contracts.yaml"}, {BFT_Holiday, "./test_bd_holidays.yaml"} }));
+
+	EXPECT_EQ(contract_count(snap), contract_count(src));
+	EXPECT_EQ(contract_count(snap), 360);
+
+	WTSArray* ayCts = src.getContracts();
+	for (auto it = ayCts->begin(); it != ayCts->end(); it++)
+	{
+		WTSContractInfo* cInfo = (WTSContractInfo*)(*it);
+		WTSContractInfo* sInfo = snap.getContract(cInfo->getCode(), cInfo->getExchg());
+		ASSERT_TRUE(sInfo != NULL);
+		EXPECT_STREQ(sInfo->getName(), cInfo->getName());
+		EXPECT_STREQ(sInfo->getFullPid(), cInfo->getFullPid());
+		EXPECT_EQ(sInfo->getSymbolID(), cInfo->getSymbolID());
+		EXPECT_EQ(sInfo->getMaxLmtVol(), cInfo->getMaxLmtVol());
+		EXPECT_EQ(sInfo->getOpenDate(), cInfo->getOpenDate());
+		EXPECT_EQ(sInfo->getExpireDate(), cInfo->getExpireDate());
+		EXPECT_EQ(sInfo->getShortMarginRatio(), cInfo->getShortMarginRatio());
+
+		WTSCommodityInfo* commInfo = sInfo->getCommInfo();
+		ASSERT_TRUE(commInfo != NULL);
+		EXPECT_EQ(commInfo, snap.getCommodity(cInfo->getCommInfo()->getFullPid()));
+		EXPECT_EQ(commInfo->getPriceTick(), cInfo->getCommInfo()->getPriceTick());
+		EXPECT_EQ(commInfo->getVolScale(), cInfo->getCommInfo()->getVolScale());
+		EXPECT_EQ(commInfo->getCodes().size(), cInfo->getCommInfo()->getCodes().size());
+		EXPECT_EQ(commInfo->getSessionInfo(), snap.getSession("FN2300"));
+	}
+	ayCts->release();
+
+	WTSSessionInfo* sInfo = snap.getSession("FN2300");
+	WTSSessionInfo* oInfo = src.getSession("FN2300");
+	ASSERT_TRUE(sInfo != NULL);
+	EXPECT_EQ(sInfo->getOffsetMins(), oInfo->getOffsetMins());
+	EXPECT_EQ(sInfo->getOpenTime(), oInfo->getOpenTime());
+	EXPECT_EQ(sInfo->getCloseTime(), oInfo->getCloseTime());
+	EXPECT_EQ(sInfo->getAuctionStartTime(), oInfo->getAuctionStartTime());
+	EXPECT_EQ(sInfo->getTradingMins(), oInfo->getTradingMins());
+	EXPECT_EQ(sInfo->getSecMinList(), oInfo->getSecMinList());
+	EXPECT_EQ(snap.getSessionComms("FN2300")->size(), 30);
+
+	EXPECT_TRUE(snap.isHoliday("SHFE.a0", 20231002));
+	EXPECT_FALSE(snap.isHoliday("SHFE.a0", 20231009));
+	EXPECT_EQ(snap.getNextTDate("SHFE.a0", 20230929), src.getNextTDate("SHFE.a0", 20230929));
+
+	//Դļ޸Ժ, ʧЧ, ´Դļزˢ¿
+	write_base_files(10, 6);
+	WTSBaseDataMgr changed;
+	EXPECT_FALSE(changed.loadSnapshot(snapfile, { {BFT_Session, "./test_bd_sessions.yaml"}, {BFT_Commodity, "./test_bd_commodities.yaml"},
+		{BFT_Contract, "./test_bd_contracts.yaml"}, {BFT_Holiday, "./test_bd_holidays.yaml"} }));
+	EXPECT_TRUE(changed.loadBaseFiles(cfgBF));
+	EXPECT_EQ(contract_count(changed), 180);
+
+	WTSBaseDataMgr reloaded;
+	EXPECT_TRUE(reloaded.loadBaseFiles(cfgBF));
+	EXPECT_EQ(contract_count(reloaded), 180);
+
+	cfgBF->release();
+	remove_files(snapfile);
+}
+
+TEST(test_basedata, test_performance)
+{
+	const char* snapfile = "./test_bd_perf.dat";
+	BoostFile::delete_file(snapfile);
+	write_base_files(100, 36);
+
+	WTSVariant* cfgNoSnap = make_config(NULL);
+	WTSVariant* cfgBF = make_config(snapfile);
+
+	int64_t start = TimeUtils::getLocalTimeNow();
+	{
+		WTSBaseDataMgr mgr;
+		EXPECT_TRUE(mgr.loadBaseFiles(cfgNoSnap));
+		EXPECT_EQ(contract_count(mgr), 10800);
+	}
+	int64_t elapseFile = TimeUtils::getLocalTimeNow() - start;
+
+	{
+		WTSBaseDataMgr mgr;
+		EXPECT_TRUE(mgr.loadBaseFiles(cfgBF));
+	}
+	std::size_t snapSize = (std::size_t)boost::filesystem::file_size(snapfile);
+
+	start = TimeUtils::getLocalTimeNow();
+	{
+		WTSBaseDataMgr mgr;
+		EXPECT_TRUE(mgr.loadBaseFiles(cfgBF));
+		EXPECT_EQ(contract_count(mgr), 10800);
+	}
+	int64_t elapseSnap = TimeUtils::getLocalTimeNow() - start;
+
+	fmt::print("10800 contracts, load from config files: {} ms, load from snapshot ({} KB): {} ms\n",
+		elapseFile, snapSize / 1024, elapseSnap);
+
+	cfgNoSnap->release();
+	cfgBF->release();
+	remove_files(snapfile);
+}
@@ -0,0 +1,223 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/BinLogger.hpp"
+#include "../Share/StdUtils.hpp"
+#include "../Share/TimeUtils.hpp"
+
+#include <map>
+#include <vector>
+
+USING_NS_WTP;
+
+TEST(test_binlogger, test_ring)
+{
+	BinLogRing ring(4096);
+	char data[1000];
+	uint32_t pushed = 0, drained = 0;
+
+	//дȡ, βƵ
+	for (int round = 0; round < 100; round++)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			uint32_t len = 100 + (round * 7 + i * 13) % 700;
+			memset(data, (char)(pushed % 128), len);
+			EXPECT_TRUE(ring.push(data, len));
+			pushed++;
+		}
+
+		ring.drain([&drained](const char* buf, uint32_t len) {
+			EXPECT_EQ(buf[0], (char)(drained % 128));
+			EXPECT_EQ(buf[len - 1], (char)(drained % 128));
+			drained++;
+		});
+	}
+	EXPECT_EQ(pushed, drained);
+	EXPECT_TRUE(ring.empty());
+
+	//дԺ󷵻false
+	uint32_t cnt = 0;
+	while (ring.push(data, 1000))
+		cnt++;
+	EXPECT_GE(cnt, 3);
+	EXPECT_LE(cnt, 4);
+}
+
+TEST(test_binlogger, test_text)
+{
+	std::mutex mtx;
+	std::vector<std::string> messages;
+	std::map<std::string, uint32_t> cats;
+	EXPECT_TRUE(BinLogger::start_text([&](uint8_t ll, const char* catName, uint64_t stamp, const char* message) {
+		std::unique_lock<std::mutex> lock(mtx);
+		messages.emplace_back(message);
+		cats[catName]++;
+	}));
+
+	static BinLogSite site(LL_INFO, "", "order {} of {} canceled, left {:.1f}, buy {}, flag {}");
+	static BinLogSite catSite(LL_INFO, "trade", "trade {}");
+
+	const uint32_t THREADS = 4;
+	const uint32_t TIMES = 10000;
+	std::vector<StdThreadPtr> threads;
+	for (uint32_t t = 0; t < THREADS; t++)
+	{
+		threads.emplace_back(new StdThread([t, TIMES]() {
+			std::string code = "SHFE.rb2401";
+			for (uint32_t i = 0; i < TIMES; i++)
+			{
+				BinLogger::write(site, i, code, 1.25 * t, t % 2 == 0, 'x');
+				if (i % 10 == 0)
+					BinLogger::write(catSite, t * TIMES + i);
+			}
+		}));
+	}
+	for (auto& thrd : threads)
+		thrd->join();
+
+	BinLogger::stop();
+
+	BinLogStats stats = BinLogger::stats();
+	EXPECT_EQ(stats._ring_drops, 0);
+	EXPECT_EQ(messages.size(), THREADS * TIMES + THREADS * TIMES / 10);
+	EXPECT_EQ(cats["trade"], THREADS * TIMES / 10);
+	EXPECT_EQ(messages[0].find("order 0 of SHFE.rb2401 canceled, left "), 0);
+	EXPECT_TRUE(std::find(messages.begin(), messages.end(), "order 9999 of SHFE.rb2401 canceled, left 3.8, buy false, flag x") != messages.end());
+}
+
+TEST(test_binlogger, test_limit_and_file)
+{
+	const char* filename = "./test_binlog.blog";
+	remove(filename);
+
+	EXPECT_TRUE(BinLogger::start_binary(filename));
+	BinLogger::set_rate_limit("limited", 100, 60000);
+
+	static BinLogSite limited(LL_DEBUG, "limited", "limited message {}");
+	static BinLogSite normal(LL_WARN, "", "normal message {} {}");
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		BinLogger::write(limited, i);
+		BinLogger::write(normal, i, std::string("abc"));
+	}
+	BinLogger::stop();
+	BinLogger::set_rate_limit("limited", 0);
+
+	uint32_t cntLimited = 0, cntNormal = 0;
+	std::string lastNormal, dropNotice;
+	uint64_t corrupted = 0;
+	EXPECT_TRUE(BinLogDecoder::decode_file(filename, [&](const BinLogSiteInfo& site, uint64_t stamp, const std::string& message) {
+		if (site._category == "limited")
+		{
+			EXPECT_EQ(site._level, LL_DEBUG);
+			cntLimited++;
+		}
+		else if (message.find("normal message") == 0)
+		{
+			cntNormal++;
+			lastNormal = message;
+		}
+		else
+		{
+			dropNotice = message;
+		}
+	}, &corrupted));
+
+	EXPECT_EQ(corrupted, 0);
+	EXPECT_EQ(cntLimited, 100);
+	EXPECT_EQ(cntNormal, 1000);
+	EXPECT_EQ(lastNormal, "normal message 999 abc");
+	EXPECT_EQ(dropNotice, "900 log messages of category [limited] dropped by rate limit");
+}
+
+TEST(test_binlogger, test_append)
+{
+	const char* filename = "./test_binlog_append.blog";
+	remove(filename);
+
+	//ͬһļ, ڶεĵõǼ˳͵һβһ
+	static BinLogSite first(LL_INFO, "", "first run {}");
+	static BinLogSite second(LL_INFO, "", "second run {} {}");
+
+	EXPECT_TRUE(BinLogger::start_binary(filename));
+	for (uint32_t i = 0; i < 3; i++)
+		BinLogger::write(first, i);
+	BinLogger::stop();
+
+	EXPECT_TRUE(BinLogger::start_binary(filename));
+	for (uint32_t i = 0; i < 3; i++)
+		BinLogger::write(second, i, std::string("abc"));
+	BinLogger::write(first, 99);
+	BinLogger::stop();
+
+	std::vector<std::string> messages;
+	uint64_t corrupted = 0;
+	EXPECT_TRUE(BinLogDecoder::decode_file(filename, [&messages](const BinLogSiteInfo& site, uint64_t stamp, const std::string& message) {
+		messages.emplace_back(message);
+	}, &corrupted));
+	EXPECT_EQ(corrupted, 0);
+	ASSERT_EQ(messages.size(), 7);
+	EXPECT_EQ(messages[0], "first run 0");
+	EXPECT_EQ(messages[3], "second run 0 abc");
+	EXPECT_EQ(messages[6], "first run 99");
+
+	//ģһνβа¼, ڶȻԽ
+	std::string content;
+	FILE* f = fopen(filename, "rb");
+	char buf[4096];
+	std::size_t rd;
+	while ((rd = fread(buf, 1, sizeof(buf), f)) > 0)
+		content.append(buf, rd);
+	fclose(f);
+
+	std::size_t pos = content.find(std::string(BinLogDecoder::FILE_MAGIC, sizeof(BinLogDecoder::FILE_MAGIC)), 1);
+	ASSERT_NE(pos, std::string::npos);
+	content.insert(pos, "R\x40\x00\x00\x00\x01\x02", 7);
+	f = fopen(filename, "wb");
+	fwrite(content.data(), 1, content.size(), f);
+	fclose(f);
+
+	messages.clear();
+	EXPECT_TRUE(BinLogDecoder::decode_file(filename, [&messages](const BinLogSiteInfo& site, uint64_t stamp, const std::string& message) {
+		messages.emplace_back(message);
+	}, &corrupted));
+	EXPECT_EQ(corrupted, 1);
+	EXPECT_EQ(messages.size(), 7);
+
+	remove(filename);
+}
+
+TEST(test_binlogger, test_performance)
+{
+	//Աȵ߳ϵĺʱ: ԭֱӸʽ, ֻ
+	const uint32_t TIMES = 200000;
+	std::string code = "SHFE.rb2401";
+
+	thread_local static char buffer[2048];
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+		fmtutil::format_to(buffer, "KBar [{}] @ {} closed, price {:.2f}", code, 202310180930 + i, 3850.5 + i);
+	int64_t elapseFmt = TimeUtils::getLocalTimeNow() - start;
+
+	uint64_t total = 0;
+	EXPECT_TRUE(BinLogger::start_text([&total](uint8_t ll, const char* catName, uint64_t stamp, const char* message) {
+		total++;
+	}, 16 * 1024 * 1024));
+
+	//Сֻ߳Ч, ߳д
+	uint64_t drops = BinLogger::stats()._ring_drops;
+	int64_t elapseBin = 0;
+	StdThread worker([&elapseBin, &code, TIMES]() {
+		static BinLogSite site(LL_INFO, "", "KBar [{}] @ {} closed, price {:.2f}");
+		int64_t start = TimeUtils::getLocalTimeNow();
+		for (uint32_t i = 0; i < TIMES; i++)
+			BinLogger::write(site, code, 202310180930 + i, 3850.5 + i);
+		elapseBin = TimeUtils::getLocalTimeNow() - start;
+	});
+	worker.join();
+	BinLogger::stop();
+
+	drops = BinLogger::stats()._ring_drops - drops;
+	EXPECT_EQ(total + drops, TIMES);
+	fmt::print("{} messages on caller thread, format inline: {} ms, deferred: {} ms, {} written by background thread, {} dropped\n",
+		TIMES, elapseFmt, elapseBin, total, drops);
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest/gtest.h"
+#include "../WtBtCore/BtDataCache.hpp"
+#include "../Share/fmtlib.h"
+
+#include <atomic>
+
+TEST(test_btdatacache, test_shared_vector)
+{
+	SharedVector<int> v1;
+	v1.resize(4);
+	for (int i = 0; i < 4; i++)
+		v1[i] = i;
+
+	SharedVector<int> v2 = v1;
+	EXPECT_TRUE(v2.is_shared());
+	EXPECT_EQ(v1.data(), v2.data());
+
+	//ıСʱȸһݣӰһ
+	v2.emplace_back(4);
+	EXPECT_NE(v1.data(), v2.data());
+	EXPECT_EQ(v1.size(), 4);
+	EXPECT_EQ(v2.size(), 5);
+	EXPECT_EQ(v2[3], 3);
+
+	//clearֱӶԭ飬Ӱ칲һ
+	v2 = v1;
+	v2.clear();
+	EXPECT_EQ(v1.size(), 4);
+	EXPECT_TRUE(v2.empty());
+
+	//ⲿݿֻãıСʱƳ
+	std::shared_ptr<int> block(new int[3]{ 7, 8, 9 }, std::default_delete<int[]>());
+	SharedVector<int> v3;
+	v3.attach(block, block.get(), 3);
+	EXPECT_EQ(v3.data(), block.get());
+	EXPECT_EQ(v3[2], 9);
+	v3.resize(4);
+	EXPECT_NE(v3.data(), block.get());
+	EXPECT_EQ(v3[1], 8);
+	EXPECT_EQ(block.get()[2], 9);
+}
+
+TEST(test_btdatacache, test_publish)
+{
+	BtDataCache cache;
+
+	SharedVector<double> bars;
+	bars.resize(100);
+	{
+		BtDataCache::EntryPtr entry = cache.acquire("SHFE.rb.HOT#m#1");
+		StdUniqueLock lock(entry->mutex());
+		entry->publish(bars, 1.5);
+	}
+
+	SharedVector<double> other;
+	double factor = 0;
+	EXPECT_TRUE(cache.acquire("SHFE.rb.HOT#m#1")->fetch(other, &factor));
+	EXPECT_EQ(other.data(), bars.data());
+	EXPECT_DOUBLE_EQ(factor, 1.5);
+
+	//ǳפûԺʧЧ
+	{
+		SharedVector<double> ticks;
+		ticks.resize(10);
+		cache.acquire("SHFE.rb2310#ticks#20230921", false)->publish(ticks);
+		SharedVector<double> ref;
+		EXPECT_TRUE(cache.acquire("SHFE.rb2310#ticks#20230921", false)->fetch(ref));
+	}
+	SharedVector<double> expired;
+	EXPECT_FALSE(cache.acquire("SHFE.rb2310#ticks#20230921", false)->fetch(expired));
+}
+
+TEST(test_btdatacache, test_load_once)
+{
+	BtDataCache cache;
+	std::atomic<uint32_t> loads(0);
+	std::atomic<uint32_t> hits(0);
+
+	std::vector<StdThreadPtr> workers;
+	for (int i = 0; i < 8; i++)
+	{
+		workers.emplace_back(new StdThread([&cache, &loads, &hits]() {
+			SharedVector<int> data;
+			BtDataCache::EntryPtr entry = cache.acquire("SSE.600000#d#1");
+			StdUniqueLock lock(entry->mutex());
+			if (entry->fetch(data))
+			{
+				hits++;
+				return;
+			}
+
+			loads++;
+			data.resize(1000);
+			std::this_thread::yield();
+			entry->publish(data);
+		}));
+	}
+
+	for (StdThreadPtr& worker : workers)
+		worker->join();
+
+	EXPECT_EQ(loads, 1);
+	EXPECT_EQ(hits, 7);
+	fmt::print("8 replayers acquired one data block, loaded {} time(s)\n", loads.load());
+}
@@ -1,4 +1,7 @@
 #include "../Share/CodeHelper.hpp"
+#include "../Share/StdCodeCache.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/StdUtils.hpp"
 #include "gtest/gtest/gtest.h"
 
 TEST(test_codehelper, test_raw_to_std)
@@ -148,3 +151,50 @@ TEST(test_codehelper, test_extract)
 	EXPECT_STREQ(c._code, "si2309-P-11000");
 	EXPECT_STREQ(c._product, "si_o");
 }
+
+TEST(test_codehelper, test_stdcode_cache)
+{
+	const char* codes[] = { "CFFEX.IF.2112", "CZCE.MA.2112", "SSE.STK.600000", "SSE.STK.600000-", "CFFEX.IO2007.C.4000", "CZCE.TA308.P.4000", "BINANCE.DC.BTCUSDT", "OKEX.BTC-USDT" };
+
+	//ĽҪֱӽһ, ͬһÿõͬһ
+	for (const char* code : codes)
+	{
+		CodeHelper::CodeInfo c = CodeHelper::extractStdCode(code, NULL);
+		const CodeHelper::CodeInfo& cached = StdCodeCache::extractStdCode(code, NULL);
+		EXPECT_STREQ(c._exchg, cached._exchg);
+		EXPECT_STREQ(c._code, cached._code);
+		EXPECT_STREQ(c._product, cached._product);
+		EXPECT_EQ(c._exright, cached._exright);
+		EXPECT_STREQ(c.stdCommID(), cached._fullpid);
+		EXPECT_EQ(&cached, &StdCodeCache::extractStdCode(code, NULL));
+	}
+
+	//ͬ߳õҲͬһ
+	const CodeHelper::CodeInfo* ptr = NULL;
+	StdThread worker([&ptr]() {
+		ptr = &StdCodeCache::extractStdCode("CFFEX.IO2007.C.4000", NULL);
+	});
+	worker.join();
+	EXPECT_EQ(ptr, &StdCodeCache::extractStdCode("CFFEX.IO2007.C.4000", NULL));
+
+	const uint32_t ROUNDS = 200000;
+	uint64_t checksum1 = 0, checksum2 = 0;
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t r = 0; r < ROUNDS; r++)
+	{
+		for (const char* code : codes)
+			checksum1 += CodeHelper::extractStdCode(code, NULL)._code[0];
+	}
+	int64_t elapse1 = TimeUtils::getLocalTimeNow() - start;
+
+	start = TimeUtils::getLocalTimeNow();
+	for (uint32_t r = 0; r < ROUNDS; r++)
+	{
+		for (const char* code : codes)
+			checksum2 += StdCodeCache::extractStdCode(code, NULL)._code[0];
+	}
+	int64_t elapse2 = TimeUtils::getLocalTimeNow() - start;
+
+	EXPECT_EQ(checksum1, checksum2);
+	fmt::print("{} extractions, parsing: {} ms, cached: {} ms\n", ROUNDS * 8, elapse1, elapse2);
+}
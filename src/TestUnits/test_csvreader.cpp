@@ -0,0 +1,175 @@
+#include "gtest/gtest/gtest.h"
+#include "../WTSTools/CsvHelper.h"
+#include "../Share/BoostFile.hpp"
+#include "../Share/StrUtil.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+#include <mutex>
+
+USING_NS_WTP;
+
+static void write_bars_csv(const char* filename, uint32_t count)
+{
+	std::string content = "<Date>,<Time>,<Open>,<High>,<Low>,<Close>,<Volume>,<Turnover>,<Open_Interest>,<Diff_Interest>,<Settle>\r\n";
+	content.reserve(count * 96);
+	double price = 3850.0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t day = i / 240;
+		uint32_t date = 20230101 + (day / 28) * 100 + day % 28;
+		uint32_t minute = i % 240;
+		price += (i % 7 == 0) ? -1.5 : 0.5;
+		content += fmt::format("{}/{:02d}/{:02d},{:02d}:{:02d}:00,{:.1f},{:.1f},{:.1f},{:.1f},{},{:.2f},{},{},{:.3f}\r\n",
+			date / 10000, date % 10000 / 100, date % 100, 9 + minute / 60, minute % 60,
+			price, price + 2, price - 2, price + 0.5, 100 + i % 50, (100 + i % 50) * price * 10, 200000 + i, (int)(i % 11) - 5, price * 1.0001);
+	}
+	BoostFile::write_file_contents(filename, content.data(), (uint32_t)content.size());
+}
+
+TEST(test_csvreader, test_consistency)
+{
+	const char* filename = "./test_csvreader.csv";
+	write_bars_csv(filename, 5000);
+
+	//ҪԭCsvReaderжȡȫһ
+	CsvReader reader;
+	EXPECT_TRUE(reader.load_from_file(filename));
+
+	CsvFastReader fast;
+	EXPECT_TRUE(fast.load_from_file(filename));
+	EXPECT_EQ(fast.col_count(), 11);
+	EXPECT_STREQ(fast.fields(), "date,time,open,high,low,close,volume,turnover,open_interest,diff_interest,settle");
+
+	uint32_t rows = 0;
+	while (reader.next_row())
+	{
+		EXPECT_TRUE(fast.next_row());
+		std::string date = reader.get_string("date");
+		EXPECT_EQ(fast.get_string("date"), date);
+		EXPECT_EQ(fast.get_date("date"), strtoul(StrUtil::printf("%s%s%s", date.substr(0, 4).c_str(), date.substr(5, 2).c_str(), date.substr(8, 2).c_str()).c_str(), NULL, 10));
+		EXPECT_EQ(fast.get_double("open"), reader.get_double("open"));
+		EXPECT_EQ(fast.get_double("turnover"), reader.get_double("turnover"));
+		EXPECT_EQ(fast.get_double("settle"), reader.get_double("settle"));
+		EXPECT_EQ(fast.get_int32("diff_interest"), reader.get_int32("diff_interest"));
+		EXPECT_EQ(fast.get_uint64("open_interest"), reader.get_uint64("open_interest"));
+		rows++;
+	}
+	EXPECT_FALSE(fast.next_row());
+	EXPECT_EQ(rows, 5000);
+
+	std::vector<WTSBarStruct> bars;
+	EXPECT_TRUE(CsvBarLoader::load_bars(filename, false, bars));
+	EXPECT_EQ(bars.size(), 5000);
+	EXPECT_EQ(bars[0].date, 20230101);
+	EXPECT_EQ(bars[0].time, TimeUtils::timeToMinBar(20230101, 900));
+	EXPECT_EQ(bars[4999].time, TimeUtils::timeToMinBar(20230121, 1219));
+
+	BoostFile::delete_file(filename);
+}
+
+TEST(test_csvreader, test_format)
+{
+	const char* filename = "./test_csvreader_fmt.csv";
+
+	//BOMСûлнβյԪšѧͳС
+	std::string content = "\xEF\xBB\xBF" "date,time,close,volume\n"
+		"\n"
+		"2023-1-5 00:00:00,09:30,\"3850.5\",1e3\r\n"
+		"\r\n"
+		"20230106,093100,-0.1234567890123456789,\n"
+		"2023/01/09,9:32:00,,42";
+	BoostFile::write_file_contents(filename, content.data(), (uint32_t)content.size());
+
+	CsvFastReader reader;
+	EXPECT_TRUE(reader.load_from_file(filename));
+	EXPECT_EQ(reader.col_count(), 4);
+
+	EXPECT_TRUE(reader.next_row());
+	EXPECT_EQ(reader.get_date("date"), 20230105);
+	EXPECT_EQ(reader.get_time("time"), 930);
+	EXPECT_EQ(reader.get_double("close"), 3850.5);
+	EXPECT_EQ(reader.get_double("volume"), 1000.0);
+
+	EXPECT_TRUE(reader.next_row());
+	EXPECT_EQ(reader.get_date("date"), 20230106);
+	EXPECT_EQ(reader.get_time("time"), 931);
+	EXPECT_EQ(reader.get_time("time", true), 93100);
+	EXPECT_EQ(reader.get_double("close"), strtod("-0.1234567890123456789", NULL));
+	EXPECT_EQ(reader.get_double("volume"), 0.0);
+
+	EXPECT_TRUE(reader.next_row());
+	EXPECT_EQ(reader.get_date("date"), 20230109);
+	EXPECT_EQ(reader.get_time("time"), 932);
+	EXPECT_EQ(reader.get_double("close"), 0.0);
+	EXPECT_EQ(reader.get_int32("volume"), 42);
+	EXPECT_EQ(reader.get_double("nofield"), 0.0);
+	EXPECT_STREQ(reader.get_string("nofield"), "");
+
+	EXPECT_FALSE(reader.next_row());
+	reader.close();
+
+	BoostFile::delete_file(filename);
+}
+
+TEST(test_csvreader, test_performance)
+{
+	const uint32_t ROWS = 500000;
+	const uint32_t FILES = 4;
+	std::vector<std::string> files;
+	for (uint32_t i = 0; i < FILES; i++)
+	{
+		files.emplace_back(fmt::format("./test_csvreader_perf_{}.csv", i));
+		write_bars_csv(files.back().c_str(), ROWS);
+	}
+	double mb = (double)boost::filesystem::file_size(files[0]) / 1024 / 1024;
+
+	//ԭĶ: CsvReaderжȡ, ֶȡֵ
+	int64_t start = TimeUtils::getLocalTimeNow();
+	{
+		CsvReader reader;
+		reader.load_from_file(files[0].c_str());
+		std::vector<WTSBarStruct> bars;
+		while (reader.next_row())
+		{
+			WTSBarStruct bs;
+			bs.date = reader.get_uint32("date");
+			bs.open = reader.get_double("open");
+			bs.high = reader.get_double("high");
+			bs.low = reader.get_double("low");
+			bs.close = reader.get_double("close");
+			bs.vol = reader.get_double("volume");
+			bs.money = reader.get_double("turnover");
+			bs.hold = reader.get_double("open_interest");
+			bs.add = reader.get_double("diff_interest");
+			bs.settle = reader.get_double("settle");
+			bars.emplace_back(bs);
+		}
+		EXPECT_EQ(bars.size(), ROWS);
+	}
+	int64_t elapseOld = std::max<int64_t>(TimeUtils::getLocalTimeNow() - start, 1);
+
+	start = TimeUtils::getLocalTimeNow();
+	{
+		std::vector<WTSBarStruct> bars;
+		CsvBarLoader::load_bars(files[0].c_str(), false, bars);
+		EXPECT_EQ(bars.size(), ROWS);
+	}
+	int64_t elapseNew = std::max<int64_t>(TimeUtils::getLocalTimeNow() - start, 1);
+
+	std::mutex mtx;
+	std::size_t total = 0;
+	start = TimeUtils::getLocalTimeNow();
+	CsvBarLoader::load_files(files, false, [&mtx, &total](const std::string& filename, std::vector<WTSBarStruct>& bars, bool bSucc) {
+		std::unique_lock<std::mutex> lock(mtx);
+		total += bars.size();
+	});
+	int64_t elapsePara = std::max<int64_t>(TimeUtils::getLocalTimeNow() - start, 1);
+	EXPECT_EQ(total, ROWS * FILES);
+
+	fmt::print("{} rows, {:.1f} MB per file, CsvReader: {} ms ({:.1f} MB/s), CsvBarLoader: {} ms ({:.1f} MB/s), {} files in parallel: {} ms ({:.1f} MB/s)\n",
+		ROWS, mb, elapseOld, mb * 1000 / elapseOld, elapseNew, mb * 1000 / elapseNew, FILES, elapsePara, mb * FILES * 1000 / elapsePara);
+
+	for (const std::string& filename : files)
+		BoostFile::delete_file(filename.c_str());
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/LatencyHistogram.hpp"
+#include "../Share/fmtlib.h"
+
+TEST(test_histogram, test_percentile)
+{
+	LatencyHistogram hist;
+	EXPECT_EQ(hist.count(), 0);
+	EXPECT_EQ(hist.percentile(99), 0);
+
+	for (uint64_t i = 1; i <= 100000; i++)
+		hist.record(i);
+
+	EXPECT_EQ(hist.count(), 100000);
+	EXPECT_EQ(hist.minimum(), 1);
+	EXPECT_EQ(hist.maximum(), 100000);
+	EXPECT_DOUBLE_EQ(hist.mean(), 50000.5);
+
+	//λ1/SUB_COUNT
+	const double percents[] = { 50, 90, 99, 99.9, 99.99 };
+	for (double p : percents)
+	{
+		double expected = p * 1000;
+		double actual = (double)hist.percentile(p);
+		EXPECT_GE(actual, expected);
+		EXPECT_LE(actual, expected * (1 + 1.0 / LatencyHistogram::SUB_COUNT));
+	}
+	EXPECT_EQ(hist.percentile(100), 100000);
+
+	//СSUB_COUNTֵǾȷ
+	LatencyHistogram small;
+	for (uint64_t i = 0; i < LatencyHistogram::SUB_COUNT; i++)
+		small.record(i);
+	EXPECT_EQ(small.percentile(50), LatencyHistogram::SUB_COUNT / 2 - 1);
+
+	//Χֵ㵽һͰ
+	small.record(UINT64_MAX);
+	EXPECT_EQ(small.percentile(100), UINT64_MAX);
+}
+
+TEST(test_histogram, test_merge)
+{
+	LatencyHistogram h1, h2;
+	for (uint64_t i = 0; i < 1000; i++)
+	{
+		h1.record(100);
+		h2.record(10000);
+	}
+
+	h1.merge(h2);
+	EXPECT_EQ(h1.count(), 2000);
+	EXPECT_EQ(h1.minimum(), 100);
+	EXPECT_EQ(h1.maximum(), 10000);
+	EXPECT_EQ(h1.percentile(50), 100);
+	EXPECT_GE(h1.percentile(99), 10000);
+}
+
+TEST(test_histogram, test_tsc)
+{
+	double ratio = TscClock::calibrate(50);
+	EXPECT_GT(ratio, 0);
+
+	uint64_t t0 = TscClock::rdtsc();
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	uint64_t elapse = TscClock::to_nano(TscClock::rdtsc() - t0);
+	EXPECT_GE(elapse, 9000000);
+
+	fmt::print("tsc ratio: {:.3f} ticks/ns, 10ms sleep measured as {} ns\n", ratio, elapse);
+}
+
+TEST(test_histogram, test_probe)
+{
+	LatencyProbe probe;
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		probe.begin();
+		probe.mark(LM_Engine);
+		probe.mark(LM_Callback);
+		//ֻһµûµûвԺĽ׶
+		if (i % 2 == 0)
+		{
+			probe.mark(LM_Order);
+			LatencyScope scope(&probe, LM_Api, LM_Sent);
+		}
+		probe.end();
+	}
+
+	EXPECT_EQ(probe.histogram(LS_Parser).count(), 100);
+	EXPECT_EQ(probe.histogram(LS_Engine).count(), 100);
+	EXPECT_EQ(probe.histogram(LS_Strategy).count(), 50);
+	EXPECT_EQ(probe.histogram(LS_Risk).count(), 0);
+	EXPECT_EQ(probe.histogram(LS_Send).count(), 50);
+	EXPECT_EQ(probe.histogram(LS_Total).count(), 100);
+	EXPECT_EQ(probe.histogram(LS_Bus).count(), 0);
+
+	probe.record(LS_Bus, 1000);
+	EXPECT_EQ(probe.histogram(LS_Bus).count(), 1);
+	EXPECT_STREQ(LatencyProbe::stage_name(LS_Bus), "bus");
+
+	probe.reset();
+	EXPECT_EQ(probe.histogram(LS_Total).count(), 0);
+}
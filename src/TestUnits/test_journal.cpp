@@ -0,0 +1,77 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/AsyncJournal.hpp"
+#include "../Share/TimeUtils.hpp"
+
+#include <sstream>
+#include <algorithm>
+
+TEST(test_journal, test_async_write)
+{
+	const char* filename = "./test_journal.csv";
+	BoostFile::delete_file(filename);
+
+	{
+		JournalFilePtr journal = JournalWriter::instance().open_file(filename, "code,qty\n");
+		ASSERT_TRUE(journal != NULL);
+
+		std::vector<StdThreadPtr> workers;
+		for (int i = 0; i < 4; i++)
+		{
+			workers.emplace_back(new StdThread([journal, i]() {
+				for (int j = 0; j < 1000; j++)
+					journal->write("{},{}\n", "SHFE.rb.HOT", i * 1000 + j);
+			}));
+		}
+
+		for (StdThreadPtr& worker : workers)
+			worker->join();
+
+		EXPECT_TRUE(JournalWriter::instance().flush());
+		EXPECT_FALSE(journal->dirty());
+	}
+
+	std::string content;
+	BoostFile::read_file_contents(filename, content);
+	EXPECT_EQ(std::count(content.begin(), content.end(), '\n'), 4001);
+	EXPECT_EQ(content.find("code,qty\n"), 0);
+
+	//ٴδ򿪵ʱ׷, дͷ
+	{
+		JournalFilePtr journal = JournalWriter::instance().open_file(filename, "code,qty\n");
+		journal->write("{},{}\n", "SHFE.rb.HOT", 4000);
+	}
+	BoostFile::read_file_contents(filename, content);
+	EXPECT_EQ(std::count(content.begin(), content.end(), '\n'), 4002);
+	BoostFile::delete_file(filename);
+}
+
+TEST(test_journal, test_performance)
+{
+	const uint32_t TIMES = 200000;
+	const char* filename = "./test_journal_perf.csv";
+
+	BoostFile::delete_file(filename);
+	BoostFile direct;
+	direct.create_new_file(filename);
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+	{
+		std::stringstream ss;
+		ss << "SHFE.rb.HOT" << "," << 20231009093000000 + i << "," << "LONG" << "," << "OPEN" << "," << 3512.0 << "," << 1 << "," << "enter" << "\n";
+		direct.write_file(ss.str());
+	}
+	int64_t elapseDirect = TimeUtils::getLocalTimeNow() - start;
+	direct.close_file();
+
+	BoostFile::delete_file(filename);
+	JournalFilePtr journal = JournalWriter::instance().open_file(filename);
+	start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+		journal->write("{},{},{},{},{},{},{}\n", "SHFE.rb.HOT", 20231009093000000 + i, "LONG", "OPEN", 3512.0, 1, "enter");
+	int64_t elapseAsync = TimeUtils::getLocalTimeNow() - start;
+	JournalWriter::instance().flush();
+
+	fmt::print("{} journal lines, direct write: {} ms, async journal: {} ms on caller thread\n", TIMES, elapseDirect, elapseAsync);
+	journal.reset();
+	BoostFile::delete_file(filename);
+}
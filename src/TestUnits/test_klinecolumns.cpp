@@ -0,0 +1,160 @@
+#include "gtest/gtest/gtest.h"
+#include "../Includes/WTSDataDef.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+USING_NS_WTP;
+
+static void make_bars(std::vector<WTSBarStruct>& bars, uint32_t count)
+{
+	bars.resize(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		WTSBarStruct& bar = bars[i];
+		bar.open = 3000 + (i * 7919 % 101);
+		bar.close = 3000 + (i * 104729 % 97);
+		bar.high = max(bar.open, bar.close) + (i % 5);
+		bar.low = min(bar.open, bar.close) - (i % 3);
+		bar.vol = 100 + i % 1000;
+	}
+}
+
+TEST(test_klinecolumns, test_kernels)
+{
+	std::vector<WTSBarStruct> bars;
+	make_bars(bars, 1003);
+
+	//ݿ飬ģʷݺ͵ƴ
+	WTSKlineSlice* slice = WTSKlineSlice::create("SHFE.rb2305", KP_Minute1, 1, bars.data(), 600);
+	slice->appendBlock(bars.data() + 600, 403);
+
+	WTSKlineColumns* cols = WTSKlineColumns::create(slice);
+	EXPECT_EQ(cols->size(), 1003);
+	for (uint32_t i = 0; i < 1003; i++)
+	{
+		EXPECT_EQ(cols->closes()[i], bars[i].close);
+		EXPECT_EQ(cols->volumes()[i], bars[i].vol);
+	}
+
+	//ƬԭеĽӿڽһ
+	EXPECT_EQ(cols->maxvalue(KFT_HIGH, -500, -2), slice->maxprice(-500, -2));
+	EXPECT_EQ(cols->minvalue(KFT_LOW, -500, -2), slice->minprice(-500, -2));
+
+	WTSValueArray* closes = slice->extractData(KFT_CLOSE);
+	EXPECT_EQ(closes->size(), 1003);
+	EXPECT_EQ(cols->maxvalue(KFT_CLOSE), closes->maxvalue(0, -1));
+	EXPECT_EQ(cols->minvalue(KFT_CLOSE, 10, 20), closes->minvalue(10, 20));
+
+	double sum = 0;
+	for (uint32_t i = 0; i < 1003; i++)
+		sum += bars[i].close;
+	double avg = sum / 1003;
+	double sq = 0;
+	for (uint32_t i = 0; i < 1003; i++)
+		sq += (bars[i].close - avg)*(bars[i].close - avg);
+	EXPECT_NEAR(cols->sum(KFT_CLOSE), sum, 1e-6);
+	EXPECT_NEAR(cols->mean(KFT_CLOSE), avg, 1e-9);
+	EXPECT_NEAR(cols->stddev(KFT_CLOSE), sqrt(sq / 1003), 1e-9);
+	EXPECT_EQ(cols->maxvalue(KFT_DATE), INVALID_DOUBLE);
+
+	//ںڼĽһ
+	const uint32_t window = 20;
+	WTSValueArray* rMax = cols->rollingMax(KFT_CLOSE, window);
+	WTSValueArray* rMin = cols->rollingMin(KFT_CLOSE, window);
+	WTSValueArray* rMean = cols->rollingMean(KFT_CLOSE, window);
+	WTSValueArray* rStd = cols->rollingStd(KFT_CLOSE, window);
+	EXPECT_EQ(rMax->size(), 1003);
+	EXPECT_EQ((*rMax)[window - 2], INVALID_DOUBLE);
+	for (uint32_t i = window - 1; i < 1003; i++)
+	{
+		int32_t head = i - window + 1;
+		EXPECT_EQ((*rMax)[i], closes->maxvalue(head, i));
+		EXPECT_EQ((*rMin)[i], closes->minvalue(head, i));
+		EXPECT_NEAR((*rMean)[i], cols->mean(KFT_CLOSE, head, i), 1e-9);
+		EXPECT_NEAR((*rStd)[i], cols->stddev(KFT_CLOSE, head, i), 1e-6);
+	}
+
+	rMax->release();
+	rMin->release();
+	rMean->release();
+	rStd->release();
+	closes->release();
+	cols->release();
+	slice->release();
+}
+
+TEST(test_klinecolumns, test_rolling_stddev)
+{
+	//ǰֵܴ󣬺ǳһֱȥ
+	const std::size_t count = 5000;
+	const std::size_t window = 20;
+	std::vector<double> data(count), out(count);
+	for (std::size_t i = 0; i < count; i++)
+		data[i] = (i < 1000) ? 1e8 + (i * 7919 % 101) : 3000;
+
+	SimdKernels::rolling_stddev(data.data(), count, window, out.data(), INVALID_DOUBLE);
+	EXPECT_EQ(out[window - 2], INVALID_DOUBLE);
+	for (std::size_t i = window - 1; i < count; i += 97)
+	{
+		double sum = 0, sq = 0;
+		for (std::size_t j = i + 1 - window; j <= i; j++)
+			sum += data[j];
+		double avg = sum / window;
+		for (std::size_t j = i + 1 - window; j <= i; j++)
+			sq += (data[j] - avg) * (data[j] - avg);
+		EXPECT_NEAR(out[i], sqrt(sq / window), 1e-3);
+	}
+
+	//ȫԺ󣬳ڵı׼ҪȷΪ0
+	for (std::size_t i = 2100; i < count; i++)
+		EXPECT_EQ(out[i], 0.0);
+}
+
+/*
+ *	ԱÿγȡͳƺʽͼֱͳƵĺʱ
+ */
+TEST(test_klinecolumns, test_perform)
+{
+	const uint32_t count = 5000;
+	const uint32_t loops = 1000;
+	std::vector<WTSBarStruct> bars;
+	make_bars(bars, count);
+
+	WTSKlineSlice* slice = WTSKlineSlice::create("SHFE.rb2305", KP_Minute1, 1, bars.data(), count / 2);
+	slice->appendBlock(bars.data() + count / 2, count - count / 2);
+
+	double r1 = 0;
+	TimeUtils::Ticker ticker;
+	for (uint32_t i = 0; i < loops; i++)
+	{
+		WTSValueArray* closes = slice->extractData(KFT_CLOSE);
+		r1 += closes->maxvalue(0, -1) - closes->minvalue(0, -1);
+		closes->release();
+		r1 += slice->maxprice(0, -1) - slice->minprice(0, -1);
+	}
+	uint64_t t1 = ticker.nano_seconds();
+
+	double r2 = 0;
+	WTSKlineColumns* cols = WTSKlineColumns::create(slice);
+	ticker.reset();
+	for (uint32_t i = 0; i < loops; i++)
+	{
+		r2 += cols->maxvalue(KFT_CLOSE) - cols->minvalue(KFT_CLOSE);
+		r2 += cols->maxvalue(KFT_HIGH) - cols->minvalue(KFT_LOW);
+	}
+	uint64_t t2 = ticker.nano_seconds();
+	EXPECT_EQ(r1, r2);
+
+	ticker.reset();
+	for (uint32_t i = 0; i < loops; i++)
+	{
+		WTSKlineColumns* tmp = WTSKlineColumns::create(slice);
+		tmp->release();
+	}
+	uint64_t t3 = ticker.nano_seconds();
+
+	fmt::print("{} bars, slice: {} ns/loop - columns: {} ns/loop, building columns: {} ns\n", count, t1 / loops, t2 / loops, t3 / loops);
+
+	cols->release();
+	slice->release();
+}
@@ -0,0 +1,194 @@
+#include "gtest/gtest/gtest.h"
+#include "../WtBtCore/L2OrderBook.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+#include <map>
+#include <random>
+
+static WTSOrdDtlStruct make_order(uint64_t index, char side, double price, uint32_t volume, WTSOrdDetailType otype = ODT_LimitPrice)
+{
+	WTSOrdDtlStruct ordDtl;
+	ordDtl.index = index;
+	ordDtl.side = side;
+	ordDtl.price = price;
+	ordDtl.volume = volume;
+	ordDtl.otype = otype;
+	return ordDtl;
+}
+
+static WTSTransStruct make_trans(int64_t bidorder, int64_t askorder, char side, double price, uint32_t volume, WTSTransType ttype = TT_Match)
+{
+	WTSTransStruct trans;
+	trans.bidorder = bidorder;
+	trans.askorder = askorder;
+	trans.side = side;
+	trans.price = price;
+	trans.volume = volume;
+	trans.ttype = ttype;
+	return trans;
+}
+
+TEST(test_l2orderbook, test_queue_position)
+{
+	L2OrderBook book;
+	book.set_price_tick(0.01);
+
+	book.on_order_detail(make_order(1, BDT_Buy, 10.00, 300));
+	book.on_order_detail(make_order(2, BDT_Sell, 10.02, 500));
+
+	L2OrderBook::L2Fills fills;
+	//ģ1ίк
+	book.add_order(1001, true, 10.00, 200, fills);
+	EXPECT_TRUE(fills.empty());
+	EXPECT_DOUBLE_EQ(book.queue_ahead(1001), 300);
+
+	book.on_order_detail(make_order(3, BDT_Buy, 10.00, 400));
+	EXPECT_DOUBLE_EQ(book.best_bid(), 10.00);
+	EXPECT_DOUBLE_EQ(book.best_ask(), 10.02);
+
+	//ǰίгһ, ɽһ, ģⶩܳɽ
+	book.on_transaction(make_trans(1, 0, BDT_Unknown, 0, 100, TT_Cancel), fills);
+	book.on_transaction(make_trans(1, 9, BDT_Sell, 10.00, 150), fills);
+	EXPECT_TRUE(fills.empty());
+	EXPECT_DOUBLE_EQ(book.queue_ahead(1001), 50);
+
+	//1ųԺֵ3, ˵ģⶩѾŵ
+	book.on_transaction(make_trans(1, 10, BDT_Sell, 10.00, 50), fills);
+	book.on_transaction(make_trans(3, 11, BDT_Sell, 10.00, 120), fills);
+	ASSERT_EQ(fills.size(), 1);
+	EXPECT_EQ(fills[0]._localid, 1001);
+	EXPECT_DOUBLE_EQ(fills[0]._qty, 120);
+	EXPECT_DOUBLE_EQ(book.level_qty(true, 10.00), 280);
+	fills.clear();
+
+	//ģⶩ۸Ժһɽ
+	book.add_order(1002, false, 9.99, 500, fills);
+	ASSERT_EQ(fills.size(), 1);
+	EXPECT_DOUBLE_EQ(fills[0]._price, 10.00);
+	EXPECT_DOUBLE_EQ(fills[0]._qty, 280);
+	book.remove_order(1002);
+	fills.clear();
+
+	//ͼλɽ, ۸ŵģȳɽ
+	book.on_order_detail(make_order(4, BDT_Sell, 10.03, 100));
+	book.add_order(1003, false, 10.02, 100, fills);
+	book.on_transaction(make_trans(12, 4, BDT_Buy, 10.03, 60), fills);
+	ASSERT_EQ(fills.size(), 1);
+	EXPECT_EQ(fills[0]._localid, 1003);
+	EXPECT_DOUBLE_EQ(fills[0]._qty, 60);
+}
+
+TEST(test_l2orderbook, test_order_types)
+{
+	L2OrderBook book;
+	book.set_price_tick(0.01);
+
+	book.on_order_detail(make_order(1, BDT_Buy, 10.00, 300));
+	book.on_order_detail(make_order(2, BDT_Sell, 10.02, 500, ODT_Add));
+
+	//м۵
+	book.on_order_detail(make_order(3, BDT_Buy, 0, 100, ODT_AnyPrice));
+	EXPECT_EQ(book.order_count(), 2);
+
+	//Źڱż, ûйҵʱ
+	book.on_order_detail(make_order(4, BDT_Buy, 0, 200, ODT_BestPrice));
+	EXPECT_EQ(book.order_count(), 3);
+	EXPECT_DOUBLE_EQ(book.level_qty(true, 10.00), 500);
+
+	L2OrderBook::L2Fills fills;
+	book.on_transaction(make_trans(1, 0, BDT_Unknown, 0, 300, TT_Cancel), fills);
+	book.on_transaction(make_trans(4, 0, BDT_Unknown, 0, 200, TT_Cancel), fills);
+	book.on_order_detail(make_order(5, BDT_Buy, 0, 200, ODT_BestPrice));
+	EXPECT_EQ(book.order_count(), 1);
+	EXPECT_DOUBLE_EQ(book.best_bid(), 0);
+
+	//Ͻĳί
+	book.on_order_detail(make_order(2, BDT_Sell, 10.02, 200, ODT_Delete));
+	EXPECT_DOUBLE_EQ(book.level_qty(false, 10.02), 300);
+	book.on_order_detail(make_order(2, BDT_Sell, 10.02, 300, ODT_Delete));
+	EXPECT_EQ(book.order_count(), 0);
+	EXPECT_DOUBLE_EQ(book.best_ask(), 0);
+}
+
+TEST(test_l2orderbook, test_throughput)
+{
+	/*
+	 *	ģһյ, ۸฽
+	 *	ίкͳɽ/Լһ
+	 */
+	const uint32_t EVENTS = 2000000;
+	std::mt19937_64 rng(20230926);
+
+	L2OrderBook book;
+	book.set_price_tick(0.01);
+	L2OrderBook::L2Fills fills;
+
+	std::vector<uint64_t> alive;
+	alive.reserve(EVENTS);
+
+	//õĶ״̬, ίб
+	std::vector<bool> sides(EVENTS + 1);
+	std::vector<int64_t> prices(EVENTS + 1);
+	std::vector<uint32_t> volumes(EVENTS + 1);
+	uint64_t index = 0;
+	uint32_t localid = 0;
+	double mid = 10.00;
+
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < EVENTS; i++)
+	{
+		uint64_t r = rng();
+		if ((r & 0x1) != 0 || alive.empty())
+		{
+			bool isBuy = (r >> 2) & 1;
+			int32_t offset = (int32_t)((r >> 3) % 10);
+			double price = isBuy ? mid - 0.01 * offset : mid + 0.01 * (offset + 1);
+			index++;
+			uint32_t volume = 100 + (uint32_t)((r >> 8) % 10) * 100;
+			book.on_order_detail(make_order(index, isBuy ? BDT_Buy : BDT_Sell, price, volume));
+			alive.emplace_back(index);
+			sides[index] = isBuy;
+			prices[index] = L2OrderBook::to_px(price);
+			volumes[index] = volume;
+		}
+		else
+		{
+			std::size_t pos = (std::size_t)((r >> 2) % alive.size());
+			uint64_t id = alive[pos];
+			alive[pos] = alive.back();
+			alive.pop_back();
+			if ((r >> 40) & 1)
+				book.on_transaction(make_trans((int64_t)id, 0, BDT_Unknown, 0, 100000, TT_Cancel), fills);
+			else
+				book.on_transaction(make_trans((int64_t)id, 0, BDT_Sell, mid, 100000), fills);
+		}
+
+		if ((r >> 48) % 5000 == 0)
+		{
+			mid += ((r >> 20) & 1) ? 0.01 : -0.01;
+			localid++;
+			book.add_order(localid, (r >> 21) & 1, mid, 100, fills);
+		}
+
+		fills.clear();
+	}
+	int64_t elapse = TimeUtils::getLocalTimeNow() - start;
+
+	fmt::print("{} L2 events processed in {} ms, {} orders left in book\n", EVENTS, elapse, book.order_count());
+
+	//طԺ󶩵ҪͶյ״̬һ
+	std::map<int64_t, double> bids, asks;
+	for (uint64_t id : alive)
+		(sides[id] ? bids : asks)[prices[id]] += volumes[id];
+
+	ASSERT_FALSE(bids.empty());
+	ASSERT_FALSE(asks.empty());
+	EXPECT_EQ(book.order_count(), alive.size());
+	EXPECT_DOUBLE_EQ(book.best_bid(), L2OrderBook::from_px(bids.rbegin()->first));
+	EXPECT_DOUBLE_EQ(book.best_ask(), L2OrderBook::from_px(asks.begin()->first));
+	for (auto& m : bids)
+		EXPECT_DOUBLE_EQ(book.level_qty(true, L2OrderBook::from_px(m.first)), m.second);
+	for (auto& m : asks)
+		EXPECT_DOUBLE_EQ(book.level_qty(false, L2OrderBook::from_px(m.first)), m.second);
+}
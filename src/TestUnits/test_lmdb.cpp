@@ -1,7 +1,11 @@
 #include "../WTSUtils/WtLMDB.hpp"
 #include "../Share/StrUtil.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
 #include "gtest/gtest/gtest.h"
 
+#include <boost/filesystem.hpp>
+
 USING_NS_WTP;
 
 TEST(test_lmdb, test_constructor)
@@ -166,4 +170,242 @@ TEST(test_lmdb, test_endian)
 			}
 		});
 	}
-}
\ No newline at end of file
+}
+
+TEST(test_lmdb, test_batch)
+{
+	struct Record
+	{
+		uint64_t	_id;
+		char		_payload[120];
+	};
+
+	const uint32_t TIMES = 20000;
+	const uint32_t BATCH = 500;
+
+	auto makeKey = [](uint32_t i) {
+		return makeData(i, true);
+	};
+
+	//ύ
+	boost::filesystem::remove_all("./batchdb_single");
+	int64_t elapseSingle = 0;
+	{
+		WtLMDB db(false);
+		EXPECT_TRUE(db.open("./batchdb_single", 64 * 1024 * 1024));
+
+		int64_t start = TimeUtils::getLocalTimeNow();
+		for (uint32_t i = 0; i < TIMES; i++)
+		{
+			Record rec;
+			rec._id = i;
+			std::string key = makeKey(i);
+			WtLMDBQuery query(db);
+			EXPECT_TRUE(query.put_and_commit((void*)key.data(), key.size(), &rec, sizeof(Record)));
+		}
+		elapseSingle = TimeUtils::getLocalTimeNow() - start;
+	}
+
+	//ύ
+	boost::filesystem::remove_all("./batchdb_group");
+	int64_t elapseGroup = 0;
+	{
+		WtLMDB db(false);
+		EXPECT_TRUE(db.open("./batchdb_group", 64 * 1024 * 1024));
+
+		int64_t start = TimeUtils::getLocalTimeNow();
+		WtLMDBBatch batch(db);
+		for (uint32_t i = 0; i < TIMES; i++)
+		{
+			Record rec;
+			rec._id = i;
+			std::string key = makeKey(i);
+			batch.put(key.data(), key.size(), &rec, sizeof(Record));
+			if (batch.count() >= BATCH)
+				EXPECT_EQ(batch.commit(), (int)BATCH);
+		}
+		EXPECT_EQ(batch.commit(), (int)(TIMES % BATCH));
+		EXPECT_TRUE(batch.empty());
+		elapseGroup = TimeUtils::getLocalTimeNow() - start;
+	}
+
+	{
+		//ͬһkeyдĸд
+		WtLMDB db(false);
+		EXPECT_TRUE(db.open("./batchdb_group", 64 * 1024 * 1024));
+		WtLMDBBatch batch(db);
+		batch.put(makeKey(0), std::string("first"));
+		batch.put(makeKey(0), std::string("second"));
+		EXPECT_EQ(batch.commit(), 2);
+	}
+
+	{
+		WtLMDB db(true);
+		EXPECT_TRUE(db.open("./batchdb_group"));
+		WtLMDBQuery query(db);
+		query.get_range(makeKey(0), makeKey(0), [](const ValueArray& ayKeys, const ValueArray& ayVals) {
+			EXPECT_EQ(ayVals.size(), 1);
+			EXPECT_EQ(ayVals[0], "second");
+		});
+
+		query.get_range(makeKey(TIMES - 1), makeKey(TIMES - 1), [TIMES](const ValueArray& ayKeys, const ValueArray& ayVals) {
+			EXPECT_EQ(ayVals.size(), 1);
+			EXPECT_EQ(ayVals[0].size(), sizeof(Record));
+			EXPECT_EQ(((Record*)ayVals[0].data())->_id, TIMES - 1);
+		});
+
+		int cnt = query.get_range(makeKey(0), makeKey(TIMES), [](const ValueArray& ayKeys, const ValueArray& ayVals) {});
+		EXPECT_EQ(cnt, TIMES);
+	}
+
+	fmt::print("{} records written to lmdb, commit per record: {} ms, commit per {} records: {} ms\n", TIMES, elapseSingle, BATCH, elapseGroup);
+}
+
+TEST(test_lmdb, test_batch_failed)
+{
+	//ݿռ䲻, ύʧܵʱݴļ¼Ҫ
+	boost::filesystem::remove_all("./batchdb_full");
+	WtLMDB db(false);
+	EXPECT_TRUE(db.open("./batchdb_full", 256 * 1024));
+
+	std::string val(1024, 'x');
+	WtLMDBBatch batch(db);
+	for (uint32_t i = 0; i < 1000; i++)
+		batch.put(makeData(i, true), val);
+
+	EXPECT_EQ(batch.commit(), -1);
+	EXPECT_TRUE(db.has_error());
+	EXPECT_EQ(batch.count(), 1000);
+
+	batch.discard();
+	EXPECT_TRUE(batch.empty());
+
+	batch.put(makeData(0, true), val);
+	EXPECT_EQ(batch.commit(), 1);
+	EXPECT_TRUE(batch.empty());
+}
+
+TEST(test_lmdb, test_range_as)
+{
+	boost::filesystem::remove_all("./rangedb");
+	WtLMDB db(false);
+	EXPECT_TRUE(db.open("./rangedb"));
+
+	//ȲԵļ¼, 뷵ص
+	{
+		WtLMDBBatch batch(db);
+		for (uint32_t i = 0; i < 100; i++)
+		{
+			uint64_t v = i;
+			if (i % 10 == 0)
+				batch.put(makeData(i, true), std::string("bad"));
+			else
+				batch.put(makeData(i, true), std::string((const char*)&v, sizeof(v)));
+		}
+		EXPECT_EQ(batch.commit(), 100);
+	}
+
+	WtLMDBQuery query(db);
+	std::vector<uint64_t> items(1, 999);
+	int cnt = query.get_range_as(makeData(0, true), makeData(99, true), items);
+	EXPECT_EQ(cnt, 90);
+	ASSERT_EQ(items.size(), 91);
+	EXPECT_EQ(items.front(), 999);
+	EXPECT_EQ(items[1], 1);
+	EXPECT_EQ(items.back(), 99);
+}
+
+TEST(test_lmdb, test_cursor)
+{
+	struct Record
+	{
+		uint64_t	_id;
+		char		_payload[120];
+	};
+
+	const uint32_t TIMES = 200000;
+	boost::filesystem::remove_all("./cursordb");
+	{
+		WtLMDB db(false);
+		EXPECT_TRUE(db.open("./cursordb", 128 * 1024 * 1024));
+		WtLMDBBatch batch(db);
+		for (uint32_t i = 0; i < TIMES; i++)
+		{
+			Record rec;
+			rec._id = i;
+			std::string key = makeData(i, true);
+			batch.put(key.data(), key.size(), &rec, sizeof(Record));
+		}
+		EXPECT_EQ(batch.commit(), (int)TIMES);
+	}
+
+	WtLMDB db(true);
+	EXPECT_TRUE(db.open("./cursordb"));
+	WtLMDBQuery query(db);
+
+	//αֱӱ
+	{
+		std::string lower = makeData(100, true);
+		std::string upper = makeData(199, true);
+		WtLMDBCursor cursor(query);
+		uint64_t expect = 100;
+		for (bool ok = cursor.seek(lower); ok && cursor.key_le(upper); ok = cursor.next())
+		{
+			const Record* rec = cursor.value_as<Record>();
+			EXPECT_TRUE(rec != NULL);
+			EXPECT_EQ(rec->_id, expect);
+			expect++;
+		}
+		EXPECT_EQ(expect, 200);
+
+		EXPECT_TRUE(cursor.last());
+		EXPECT_EQ(cursor.value_as<Record>()->_id, TIMES - 1);
+		EXPECT_FALSE(cursor.next());
+		EXPECT_FALSE(cursor.valid());
+	}
+
+	//, ǰ
+	{
+		std::vector<uint64_t> ids;
+		int cnt = query.scan_lowers(makeData(0, true), makeData(TIMES, true), 5, [&ids](const MDB_val& key, const MDB_val& val) {
+			ids.push_back(((const Record*)val.mv_data)->_id);
+			return true;
+		});
+		EXPECT_EQ(cnt, 5);
+		EXPECT_EQ(ids.front(), TIMES - 1);
+		EXPECT_EQ(ids.back(), TIMES - 5);
+
+		cnt = query.scan_range(makeData(0, true), makeData(TIMES, true), [](const MDB_val& key, const MDB_val& val) {
+			return ((const Record*)val.mv_data)->_id < 9;
+		});
+		EXPECT_EQ(cnt, 10);
+	}
+
+	//ԭĶȡʽͰṹȡĶԱ
+	std::string lower = makeData(0, true);
+	std::string upper = makeData(TIMES, true);
+
+	//Ԥһ, ȱҳӰԱ
+	query.scan_all([](const MDB_val& key, const MDB_val& val) { return true; });
+
+	int64_t start = TimeUtils::getLocalTimeNow();
+	std::vector<Record> oldRecs;
+	query.get_range(lower, upper, [&oldRecs](const ValueArray& ayKeys, const ValueArray& ayVals) {
+		oldRecs.resize(ayVals.size());
+		for (std::size_t i = 0; i < ayVals.size(); i++)
+			memcpy(&oldRecs[i], ayVals[i].data(), ayVals[i].size());
+	});
+	int64_t elapseOld = TimeUtils::getLocalTimeNow() - start;
+
+	start = TimeUtils::getLocalTimeNow();
+	std::vector<Record> newRecs;
+	int cnt = query.get_range_as(lower, upper, newRecs);
+	int64_t elapseNew = TimeUtils::getLocalTimeNow() - start;
+
+	EXPECT_EQ(cnt, TIMES);
+	EXPECT_EQ(oldRecs.size(), newRecs.size());
+	EXPECT_EQ(newRecs.back()._id, TIMES - 1);
+	EXPECT_EQ(memcmp(oldRecs.data(), newRecs.data(), sizeof(Record)*TIMES), 0);
+
+	fmt::print("{} records read from lmdb, get_range: {} ms, get_range_as: {} ms\n", TIMES, elapseOld, elapseNew);
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/LRUDataCache.hpp"
+
+#include <vector>
+
+typedef std::vector<char> Buffer;
+typedef std::shared_ptr<Buffer> BufferPtr;
+
+TEST(test_lrucache, test_eviction)
+{
+	LRUDataCache cache(3000);
+	for (int i = 0; i < 3; i++)
+		cache.put(std::to_string(i), BufferPtr(new Buffer(1000)), 1000);
+
+	//һ0, ̭ʱӦ̭1
+	EXPECT_TRUE(cache.get<Buffer>("0") != NULL);
+	cache.put("3", BufferPtr(new Buffer(1000)), 1000);
+
+	EXPECT_TRUE(cache.get<Buffer>("1") == NULL);
+	EXPECT_TRUE(cache.get<Buffer>("0") != NULL);
+	EXPECT_TRUE(cache.get<Buffer>("2") != NULL);
+	EXPECT_TRUE(cache.get<Buffer>("3") != NULL);
+
+	LRUDataCache::CacheStats stats = cache.stats();
+	EXPECT_EQ(stats._hits, 4);
+	EXPECT_EQ(stats._misses, 1);
+	EXPECT_EQ(stats._evictions, 1);
+	EXPECT_EQ(stats._bytes, 3000);
+	EXPECT_EQ(stats._entries, 3);
+
+	//Ժ, Ҫ̭Ļ
+	cache.resize("3", 2000);
+	stats = cache.stats();
+	EXPECT_EQ(stats._bytes, 3000);
+	EXPECT_EQ(stats._entries, 2);
+	EXPECT_TRUE(cache.get<Buffer>("3") != NULL);
+
+	cache.set_budget(1000);
+	EXPECT_EQ(cache.stats()._entries, 0);
+}
+
+TEST(test_lrucache, test_pinned)
+{
+	LRUDataCache cache(2000);
+	BufferPtr pinned(new Buffer(1000));
+	cache.put("pinned", pinned, 1000);
+
+	//ⲿеĻᱻ̭, ʱԤ
+	for (int i = 0; i < 10; i++)
+		cache.put(std::to_string(i), BufferPtr(new Buffer(1000)), 1000);
+
+	LRUDataCache::CacheStats stats = cache.stats();
+	EXPECT_EQ(stats._entries, 2);
+	EXPECT_EQ(stats._pinned, 1);
+	EXPECT_TRUE(cache.get<Buffer>("pinned") == pinned);
+	EXPECT_TRUE(cache.get<Buffer>("9") != NULL);
+
+	//ԺⲿеȻЧ
+	cache.clear();
+	EXPECT_EQ(cache.stats()._bytes, 0);
+	EXPECT_EQ(pinned.use_count(), 1);
+	EXPECT_EQ(pinned->size(), 1000);
+
+	//ͷԺͿ̭
+	cache.put("pinned", pinned, 1000);
+	pinned.reset();
+	cache.put("a", BufferPtr(new Buffer(1500)), 1500);
+	EXPECT_TRUE(cache.get<Buffer>("pinned") == NULL);
+	EXPECT_TRUE(cache.get<Buffer>("a") != NULL);
+}
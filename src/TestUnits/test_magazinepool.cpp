@@ -0,0 +1,235 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/MagazinePool.hpp"
+#include "../Share/ObjectPool.hpp"
+#include "../Share/SpinMutex.hpp"
+#include "../Share/StdUtils.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+#include <set>
+#include <vector>
+
+struct PoolItem
+{
+	uint64_t	_id;
+	char		_payload[120];
+};
+
+TEST(test_magazinepool, test_reuse)
+{
+	typedef MagazinePool<PoolItem, 8> Pool;
+
+	std::set<PoolItem*> ptrs;
+	std::vector<PoolItem*> items;
+	for (int i = 0; i < 100; i++)
+	{
+		PoolItem* item = Pool::construct();
+		item->_id = i;
+		items.push_back(item);
+		ptrs.insert(item);
+	}
+	EXPECT_EQ(ptrs.size(), 100);
+
+	for (PoolItem* item : items)
+		Pool::destroy(item);
+
+	//ͷԺٷ, Ӧȫԭڴ
+	items.clear();
+	for (int i = 0; i < 100; i++)
+	{
+		PoolItem* item = Pool::construct();
+		EXPECT_TRUE(ptrs.find(item) != ptrs.end());
+		items.push_back(item);
+	}
+	for (PoolItem* item : items)
+		Pool::destroy(item);
+
+	Pool::flush_stats();
+	PoolStats stats = Pool::stats();
+	EXPECT_EQ(stats._allocs, 200);
+	EXPECT_EQ(stats._frees, 200);
+	EXPECT_EQ(stats.in_use(), 0);
+	EXPECT_EQ(stats._capacity, 104);
+}
+
+TEST(test_magazinepool, test_remote_free)
+{
+	typedef MagazinePool<PoolItem, 16> Pool;
+	const uint32_t TIMES = 100000;
+
+	//һ̷߳, һ߳ͷ, ߳˳
+	std::vector<PoolItem*> items(TIMES);
+	StdThread producer([&items, TIMES]() {
+		for (uint32_t i = 0; i < TIMES; i++)
+		{
+			items[i] = Pool::construct();
+			items[i]->_id = i;
+		}
+	});
+	producer.join();
+
+	StdThread consumer([&items, TIMES]() {
+		for (uint32_t i = 0; i < TIMES; i++)
+		{
+			EXPECT_EQ(items[i]->_id, i);
+			Pool::destroy(items[i]);
+		}
+	});
+	consumer.join();
+
+	PoolStats stats = Pool::stats();
+	EXPECT_EQ(stats._allocs, TIMES);
+	EXPECT_EQ(stats._frees, TIMES);
+
+	//ͷ߳˳ʱ򽻻زֿĶ, Ա̼߳ʹ
+	StdThread again([TIMES]() {
+		std::vector<PoolItem*> items;
+		for (uint32_t i = 0; i < TIMES; i++)
+			items.push_back(Pool::construct());
+		for (PoolItem* item : items)
+			Pool::destroy(item);
+	});
+	again.join();
+	EXPECT_EQ(Pool::stats()._capacity, stats._capacity);
+}
+
+TEST(test_magazinepool, test_cross_module)
+{
+	//ͬʵиԵĲֿ, ģWindows²ͬDLLĳ
+	typedef MagazinePool<PoolItem, 4> OwnerPool;
+	typedef MagazinePool<PoolItem, 32> OtherPool;
+
+	std::set<PoolItem*> ptrs;
+	std::vector<PoolItem*> items;
+	for (int i = 0; i < 100; i++)
+	{
+		PoolItem* item = OwnerPool::construct();
+		items.push_back(item);
+		ptrs.insert(item);
+	}
+	uint64_t capacity = OwnerPool::stats()._capacity;
+
+	//һͷ, Ҫصĳ
+	for (PoolItem* item : items)
+		OtherPool::destroy(item);
+
+	OwnerPool::flush_stats();
+	OtherPool::flush_stats();
+	PoolStats stats = OwnerPool::stats();
+	EXPECT_EQ(stats._remote_frees, 100);
+	EXPECT_EQ(stats.in_use(), 0);
+	EXPECT_EQ(OtherPool::stats()._frees, 0);
+	EXPECT_EQ(OtherPool::stats()._capacity, 0);
+
+	//ٷʱûջĶ, ڴ
+	items.clear();
+	for (int i = 0; i < 100; i++)
+	{
+		PoolItem* item = OwnerPool::construct();
+		EXPECT_TRUE(ptrs.find(item) != ptrs.end());
+		items.push_back(item);
+	}
+	EXPECT_EQ(OwnerPool::stats()._capacity, capacity);
+
+	//߳̿ͷ
+	StdThread releaser([&items]() {
+		for (PoolItem* item : items)
+			OtherPool::destroy(item);
+	});
+	releaser.join();
+
+	OwnerPool::flush_stats();
+	EXPECT_EQ(OwnerPool::stats()._remote_frees, 200);
+	EXPECT_EQ(OwnerPool::stats().in_use(), 0);
+}
+
+/*
+ *	ԭWTSPoolObject: ÿ߳һ, , ͷŵʱص̵߳ĳ
+ */
+template<typename T>
+class TlsSpinPool
+{
+public:
+	static T* construct(ObjectPool<T>*& pool, SpinMutex*& mtx)
+	{
+		thread_local static ObjectPool<T>	_pool;
+		thread_local static SpinMutex		_mtx;
+		_mtx.lock();
+		T* ret = _pool.construct();
+		_mtx.unlock();
+		pool = &_pool;
+		mtx = &_mtx;
+		return ret;
+	}
+};
+
+TEST(test_magazinepool, test_performance)
+{
+	//ģ̷߳tick, ߳ͷtick
+	const uint32_t TIMES = 2000000;
+	const uint32_t BATCH = 256;
+
+	struct Holder
+	{
+		PoolItem*				_item;
+		ObjectPool<PoolItem>*	_pool;
+		SpinMutex*				_mtx;
+	};
+
+	auto run = [TIMES, BATCH](std::function<Holder()> alloc, std::function<void(Holder&)> dealloc) {
+		std::vector<Holder> queue(TIMES);
+		std::atomic<uint32_t> produced(0);
+		std::atomic<bool> consumed(false);
+		int64_t start = TimeUtils::getLocalTimeNow();
+		StdThread producer([&]() {
+			for (uint32_t i = 0; i < TIMES; i++)
+			{
+				queue[i] = alloc();
+				if (i % BATCH == BATCH - 1)
+					produced.store(i + 1, std::memory_order_release);
+			}
+			produced.store(TIMES, std::memory_order_release);
+
+			//ԭ߳˳ԺӾ, Ҫͷ
+			while (!consumed)
+				std::this_thread::yield();
+		});
+		StdThread consumer([&]() {
+			uint32_t idx = 0;
+			while (idx < TIMES)
+			{
+				uint32_t end = produced.load(std::memory_order_acquire);
+				for (; idx < end; idx++)
+					dealloc(queue[idx]);
+			}
+			consumed = true;
+		});
+		producer.join();
+		consumer.join();
+		return TimeUtils::getLocalTimeNow() - start;
+	};
+
+	int64_t elapseOld = run([]() {
+		Holder h;
+		h._item = TlsSpinPool<PoolItem>::construct(h._pool, h._mtx);
+		return h;
+	}, [](Holder& h) {
+		h._mtx->lock();
+		h._pool->destroy(h._item);
+		h._mtx->unlock();
+	});
+
+	int64_t elapseNew = run([]() {
+		Holder h;
+		h._item = MagazinePool<PoolItem>::construct();
+		return h;
+	}, [](Holder& h) {
+		MagazinePool<PoolItem>::destroy(h._item);
+	});
+
+	PoolStats stats = MagazinePool<PoolItem>::stats();
+	fmt::print("{} objects allocated on one thread and released on another, thread_local pool with spinlock: {} ms, magazine pool: {} ms\n",
+		TIMES, elapseOld, elapseNew);
+	fmt::print("magazine pool stats: allocs {}, frees {}, capacity {}, depot gets {}, depot puts {}\n",
+		stats._allocs, stats._frees, stats._capacity, stats._depot_gets, stats._depot_puts);
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/RateLimiter.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+#include <algorithm>
+
+TEST(test_ratelimiter, test_windows)
+{
+	//ÿ벻3, ÿӲ5
+	RateLimiter limiter;
+	limiter.add_window(1000, 3);
+	limiter.add_window(60000, 5);
+	limiter.add_window(0, 10);
+	EXPECT_EQ(limiter.size(), 2);
+
+	uint64_t now = 100000;
+	for (int i = 0; i < 4; i++)
+	{
+		EXPECT_EQ(limiter.check(now), -1);
+		limiter.record(now);
+		now += 100;
+	}
+	//14
+	EXPECT_EQ(limiter.check(now), 0);
+	EXPECT_EQ(limiter.window(0).count(now), 4);
+
+	//1, 뼶ڻָ
+	now += 1000;
+	EXPECT_EQ(limiter.check(now), -1);
+	EXPECT_EQ(limiter.window(0).count(now), 0);
+	EXPECT_EQ(limiter.window(1).count(now), 4);
+
+	limiter.record(now);
+	now += 2000;
+	limiter.record(now);
+	//Ӵ6
+	EXPECT_EQ(limiter.check(now), 1);
+
+	//ʱƻ˳
+	limiter.record(now - 500);
+	EXPECT_EQ(limiter.window(0).count(now), 2);
+
+	now += 60000;
+	EXPECT_EQ(limiter.check(now), -1);
+}
+
+TEST(test_ratelimiter, test_performance)
+{
+	/*
+	 *	ÿ5һ, ÿ10000, Աԭʱб
+	 */
+	const uint32_t TIMES = 200000;
+	const uint32_t BOUNDARY = 10000;
+	const uint64_t TIMESPAN = 60000;
+
+	std::vector<uint64_t> cache;
+	uint32_t oldHits = 0;
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+	{
+		uint64_t now = (uint64_t)i * 5;
+		uint32_t cnt = (uint32_t)cache.size();
+		if (cnt >= BOUNDARY)
+		{
+			uint64_t sTime = now > TIMESPAN ? now - TIMESPAN : 0;
+			auto tit = std::lower_bound(cache.begin(), cache.end(), sTime);
+			if (cnt - (tit - cache.begin()) > BOUNDARY)
+				oldHits++;
+
+			if (tit != cache.begin())
+				cache.erase(cache.begin(), tit);
+		}
+		cache.emplace_back(now);
+	}
+	int64_t elapseOld = TimeUtils::getLocalTimeNow() - start;
+
+	RateLimiter limiter;
+	limiter.add_window(1000, BOUNDARY);
+	limiter.add_window(TIMESPAN, BOUNDARY);
+	uint32_t newHits = 0;
+	start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+	{
+		uint64_t now = (uint64_t)i * 5;
+		if (limiter.check(now) >= 0)
+			newHits++;
+		limiter.record(now);
+	}
+	int64_t elapseNew = TimeUtils::getLocalTimeNow() - start;
+
+	fmt::print("{} orders checked, time cache list: {} ms, sliding window(2 windows): {} ms\n", TIMES, elapseOld, elapseNew);
+	EXPECT_GT(newHits, 0);
+	EXPECT_EQ(oldHits, newHits);
+}
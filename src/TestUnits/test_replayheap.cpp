@@ -0,0 +1,134 @@
+#include "gtest/gtest/gtest.h"
+#include "../WtBtCore/HftReplayHeap.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+#include <random>
+
+/*
+ *	һյģ
+ *	ÿԼݶǰʱģʱʽΪyyyyMMddhhmmssmmm
+ *	ʱȷ룬ͬһԼڲͬʱ
+ */
+static void gen_streams(std::vector<std::vector<uint64_t>>& streams, uint32_t symbols, uint32_t items)
+{
+	std::mt19937 rng(20230904);
+	streams.resize(symbols);
+	for (uint32_t i = 0; i < symbols; i++)
+	{
+		auto& dataList = streams[i];
+		dataList.resize(items);
+		uint32_t millis = (9 * 3600 + 30 * 60) * 1000;
+		for (uint32_t j = 0; j < items; j++)
+		{
+			//żʱͬ
+			if (rng() % 8 != 0)
+				millis += rng() % 6000;
+
+			uint32_t secs = millis / 1000;
+			uint32_t hhmmss = (secs / 3600) * 10000 + (secs % 3600 / 60) * 100 + secs % 60;
+			dataList[j] = (uint64_t)20230904 * 1000000000 + (uint64_t)hhmmss * 1000 + millis % 1000;
+		}
+	}
+}
+
+/*
+ *	ǰĻطŷʽÿһɨȷСʱ䣬ɨһλطеСʱ
+ */
+static uint64_t replay_by_scan(const std::vector<std::vector<uint64_t>>& streams, std::vector<uint32_t>& seq)
+{
+	std::vector<std::size_t> cursors(streams.size(), 0);
+	uint64_t checksum = 0;
+	for (;;)
+	{
+		uint64_t nextTime = UINT64_MAX;
+		for (std::size_t i = 0; i < streams.size(); i++)
+		{
+			if (cursors[i] < streams[i].size())
+				nextTime = std::min(nextTime, streams[i][cursors[i]]);
+		}
+
+		if (nextTime == UINT64_MAX)
+			break;
+
+		for (std::size_t i = 0; i < streams.size(); i++)
+		{
+			if (cursors[i] < streams[i].size() && streams[i][cursors[i]] <= nextTime)
+			{
+				checksum += streams[i][cursors[i]] ^ i;
+				seq.emplace_back((uint32_t)i);
+				cursors[i]++;
+			}
+		}
+	}
+
+	return checksum;
+}
+
+static uint64_t replay_by_heap(const std::vector<std::vector<uint64_t>>& streams, std::vector<uint32_t>& seq)
+{
+	std::vector<std::size_t> cursors(streams.size(), 0);
+	HftReplayHeap heap;
+	heap.reserve(streams.size());
+	for (uint32_t i = 0; i < streams.size(); i++)
+	{
+		if (!streams[i].empty())
+			heap.push(HftReplayNode(streams[i][0], 0, i, i));
+	}
+
+	uint64_t checksum = 0;
+	while (!heap.empty())
+	{
+		uint32_t i = heap.top()._stream;
+		checksum += streams[i][cursors[i]] ^ i;
+		seq.emplace_back(i);
+		cursors[i]++;
+
+		if (cursors[i] == streams[i].size())
+			heap.pop();
+		else
+			heap.advance_top(streams[i][cursors[i]]);
+	}
+
+	return checksum;
+}
+
+TEST(test_replayheap, test_order)
+{
+	std::vector<std::vector<uint64_t>> streams;
+	gen_streams(streams, 50, 200);
+
+	std::vector<uint32_t> seqA, seqB;
+	uint64_t a = replay_by_scan(streams, seqA);
+	uint64_t b = replay_by_heap(streams, seqB);
+
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(seqA, seqB);
+}
+
+/*
+ *	ģ500ԼһյĻطţԱɨСַʽĺʱ
+ */
+TEST(test_replayheap, test_perform)
+{
+	std::vector<std::vector<uint64_t>> streams;
+	gen_streams(streams, 500, 2000);
+
+	std::vector<uint32_t> seqA, seqB;
+	seqA.reserve(500 * 2000);
+	seqB.reserve(500 * 2000);
+
+	TimeUtils::Ticker ticker;
+	uint64_t a = replay_by_scan(streams, seqA);
+	uint64_t t1 = ticker.nano_seconds();
+
+	ticker.reset();
+	uint64_t b = replay_by_heap(streams, seqB);
+	uint64_t t2 = ticker.nano_seconds();
+
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(seqA.size(), seqB.size());
+
+	fmt::print("{} events replayed, scan: {} ns/event - heap: {} ns/event\n",
+		seqA.size(), t1 / seqA.size(), t2 / seqB.size());
+}
@@ -0,0 +1,145 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/RingQueue.hpp"
+#include "../Share/StdUtils.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+#include <queue>
+#include <functional>
+
+typedef struct _TestTask
+{
+	uint64_t	_value;
+	uint32_t	_producer;
+	uint32_t	_flag;
+} TestTask;
+
+TEST(test_ringqueue, test_basic)
+{
+	RingQueue<TestTask> q(5);
+	EXPECT_EQ(q.capacity(), 8);
+	EXPECT_TRUE(q.empty());
+
+	for (uint64_t i = 0; i < 8; i++)
+		EXPECT_TRUE(q.try_push({ i, 0, 0 }));
+
+	//
+	EXPECT_FALSE(q.try_push({ 8, 0, 0 }));
+	EXPECT_EQ(q.size(), 8);
+
+	TestTask task;
+	for (uint64_t i = 0; i < 8; i++)
+	{
+		EXPECT_TRUE(q.try_pop(task));
+		EXPECT_EQ(task._value, i);
+	}
+	EXPECT_FALSE(q.try_pop(task));
+}
+
+TEST(test_ringqueue, test_mpsc)
+{
+	const uint32_t producers = 4;
+	const uint64_t items = 50000;
+	RingQueue<TestTask> q(1024);
+
+	std::vector<StdThreadPtr> threads;
+	for (uint32_t p = 0; p < producers; p++)
+	{
+		threads.emplace_back(new StdThread([&q, p, items]() {
+			for (uint64_t i = 0; i < items; i++)
+			{
+				while (!q.try_push({ i, p, 0 }))
+					std::this_thread::yield();
+			}
+		}));
+	}
+
+	//ÿдݣ߶˳д˳һ
+	std::vector<uint64_t> expected(producers, 0);
+	uint64_t total = 0;
+	TestTask task;
+	while (total < producers * items)
+	{
+		if (!q.try_pop(task))
+			continue;
+
+		EXPECT_EQ(task._value, expected[task._producer]);
+		expected[task._producer]++;
+		total++;
+	}
+
+	for (auto& t : threads)
+		t->join();
+
+	EXPECT_TRUE(q.empty());
+}
+
+/*
+ *	ԱWtDataWriterǰʹõļstd::queue<std::function>ζе
+ */
+TEST(test_ringqueue, test_perform)
+{
+	const uint64_t items = 1000000;
+	uint64_t sum = 0;
+
+	TimeUtils::Ticker ticker;
+	{
+		StdUniqueMutex mtx;
+		std::queue<std::function<void()>> tasks;
+		StdThread producer([&]() {
+			for (uint64_t i = 0; i < items; i++)
+			{
+				StdUniqueLock lck(mtx);
+				tasks.push([&sum, i]() { sum += i; });
+			}
+		});
+
+		uint64_t cnt = 0;
+		while (cnt < items)
+		{
+			std::queue<std::function<void()>> tempQueue;
+			{
+				StdUniqueLock lck(mtx);
+				tempQueue.swap(tasks);
+			}
+
+			while (!tempQueue.empty())
+			{
+				tempQueue.front()();
+				tempQueue.pop();
+				cnt++;
+			}
+		}
+		producer.join();
+	}
+	uint64_t t1 = ticker.nano_seconds();
+
+	ticker.reset();
+	{
+		RingQueue<TestTask> q(65536);
+		StdThread producer([&]() {
+			for (uint64_t i = 0; i < items; i++)
+			{
+				while (!q.try_push({ i, 0, 0 }))
+					std::this_thread::yield();
+			}
+		});
+
+		uint64_t cnt = 0;
+		TestTask task;
+		while (cnt < items)
+		{
+			if (!q.try_pop(task))
+				continue;
+
+			sum += task._value;
+			cnt++;
+		}
+		producer.join();
+	}
+	uint64_t t2 = ticker.nano_seconds();
+
+	EXPECT_EQ(sum, items * (items - 1));
+
+	fmt::print("{} items, mutex_queue: {} ns/item - ring_queue: {} ns/item\n", items, t1 / items, t2 / items);
+}
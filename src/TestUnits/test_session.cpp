@@ -1,5 +1,6 @@
 #include "../Includes/WTSSessionInfo.hpp"
 #include "gtest/gtest/gtest.h"
+#include "../Share/fmtlib.h"
 
 USING_NS_WTP;
 
@@ -29,4 +30,104 @@ TEST(test_session, test_allday)
 	EXPECT_EQ(sInfo->offsetTime(0, false), 2400);
 
 	sInfo->release();
-}
\ No newline at end of file
+}
+static WTSSessionInfo* make_future_session()
+{
+	//ҹƷ, ƫ300
+	WTSSessionInfo* sInfo = WTSSessionInfo::create("FN0230", "FN0230", 300);
+	sInfo->setAuctionTime(2059, 2100);
+	sInfo->addTradingSection(2100, 230);
+	sInfo->addTradingSection(900, 1015);
+	sInfo->addTradingSection(1030, 1130);
+	sInfo->addTradingSection(1330, 1500);
+	return sInfo;
+}
+
+static WTSSessionInfo* make_stock_session()
+{
+	WTSSessionInfo* sInfo = WTSSessionInfo::create("SD0930", "SD0930", 0);
+	sInfo->setAuctionTime(915, 925);
+	sInfo->addTradingSection(930, 1130);
+	sInfo->addTradingSection(1300, 1500);
+	return sInfo;
+}
+
+TEST(test_session, test_lookup_tables)
+{
+	WTSSessionInfo* sessions[] = { make_future_session(), make_stock_session(), WTSSessionInfo::create("ALLDAY", "ALLDAY", 0) };
+	sessions[2]->addTradingSection(0, 2400);
+
+	//ұĽҪֱӼȫһ
+	for (WTSSessionInfo* sInfo : sessions)
+	{
+		for (uint32_t idx = 0; idx < 1440; idx++)
+		{
+			uint32_t uTime = idx / 60 * 100 + idx % 60;
+			ASSERT_EQ(sInfo->timeToMinutes(uTime), sInfo->calcTimeToMinutes(uTime)) << sInfo->id() << " " << uTime;
+			ASSERT_EQ(sInfo->timeToMinutes(uTime, true), sInfo->calcTimeToMinutes(uTime, true)) << sInfo->id() << " " << uTime;
+
+			for (uint32_t sec = 0; sec < 60; sec++)
+				ASSERT_EQ(sInfo->timeToSeconds(uTime * 100 + sec), sInfo->calcTimeToSeconds(uTime * 100 + sec)) << sInfo->id() << " " << uTime * 100 + sec;
+		}
+
+		uint32_t totalMins = sInfo->getTradingMins();
+		for (uint32_t uMinutes = 0; uMinutes <= totalMins + 10; uMinutes++)
+		{
+			ASSERT_EQ(sInfo->minuteToTime(uMinutes), sInfo->calcMinuteToTime(uMinutes)) << sInfo->id() << " " << uMinutes;
+			ASSERT_EQ(sInfo->minuteToTime(uMinutes, true), sInfo->calcMinuteToTime(uMinutes, true)) << sInfo->id() << " " << uMinutes;
+		}
+
+		for (uint32_t seconds = 0; seconds <= totalMins * 60 + 100; seconds++)
+			ASSERT_EQ(sInfo->secondsToTime(seconds), sInfo->calcSecondsToTime(seconds)) << sInfo->id() << " " << seconds;
+	}
+
+	EXPECT_EQ(sessions[0]->timeToMinutes(2100), 0);
+	EXPECT_EQ(sessions[0]->minuteToTime(1), 2101);
+	EXPECT_EQ(sessions[0]->getTradingMins(), 555);
+	EXPECT_EQ(sessions[1]->getSecMinList().size(), 2);
+	EXPECT_EQ(sessions[0]->getSecMinList().size(), 4);
+
+	for (WTSSessionInfo* sInfo : sessions)
+		sInfo->release();
+}
+
+TEST(test_session, test_lookup_perf)
+{
+	WTSSessionInfo* sInfo = make_future_session();
+
+	const uint32_t ROUNDS = 200;
+	std::vector<uint32_t> times;
+	for (uint32_t idx = 0; idx < 1440; idx++)
+	{
+		for (uint32_t sec = 0; sec < 60; sec += 3)
+			times.emplace_back((idx / 60 * 100 + idx % 60) * 100 + sec);
+	}
+
+	uint64_t checksum1 = 0, checksum2 = 0;
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t r = 0; r < ROUNDS; r++)
+	{
+		for (uint32_t t : times)
+		{
+			checksum1 += sInfo->calcTimeToMinutes(t / 100);
+			checksum1 += sInfo->calcTimeToSeconds(t);
+		}
+	}
+	int64_t elapse1 = TimeUtils::getLocalTimeNow() - start;
+
+	start = TimeUtils::getLocalTimeNow();
+	for (uint32_t r = 0; r < ROUNDS; r++)
+	{
+		for (uint32_t t : times)
+		{
+			checksum2 += sInfo->timeToMinutes(t / 100);
+			checksum2 += sInfo->timeToSeconds(t);
+		}
+	}
+	int64_t elapse2 = TimeUtils::getLocalTimeNow() - start;
+
+	EXPECT_EQ(checksum1, checksum2);
+	fmt::print("{} conversions, calculating: {} ms, lookup tables: {} ms\n", times.size() * ROUNDS * 2, elapse1, elapse2);
+
+	sInfo->release();
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/ShmTickBus.hpp"
+#include "../Share/StdUtils.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+TEST(test_shmbus, test_basic)
+{
+	ShmTickBus writer;
+	EXPECT_TRUE(writer.create("WtTestBus", 5));
+	EXPECT_EQ(writer.capacity(), 8);
+
+	ShmTickBus reader;
+	EXPECT_TRUE(reader.open("WtTestBus"));
+
+	uint64_t cursor = reader.tail();
+	char buffer[ShmTickBus::MAX_DATA_SIZE];
+	uint32_t type = 0;
+	uint64_t stamp = 0;
+	uint64_t lost = 0;
+	EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_None);
+
+	for (uint64_t i = 0; i < 8; i++)
+		EXPECT_TRUE(writer.publish(SBT_Tick, &i, sizeof(uint64_t)));
+
+	for (uint64_t i = 0; i < 8; i++)
+	{
+		EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_Ok);
+		EXPECT_EQ(type, SBT_Tick);
+		EXPECT_EQ(*(uint64_t*)buffer, i);
+	}
+	EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_None);
+
+	//дȦԺ󣬶ȡ˻µ
+	for (uint64_t i = 8; i < 24; i++)
+		writer.publish(SBT_Tick, &i, sizeof(uint64_t));
+
+	EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_Lost);
+	EXPECT_EQ(lost, 12);
+	EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_Ok);
+	EXPECT_EQ(*(uint64_t*)buffer, 20);
+}
+
+TEST(test_shmbus, test_recreate)
+{
+	ShmTickBus writer;
+	EXPECT_TRUE(writer.create("WtTestBusEpoch", 8));
+
+	ShmTickBus reader;
+	EXPECT_TRUE(reader.open("WtTestBusEpoch"));
+	EXPECT_NE(reader.epoch(), 0);
+	EXPECT_EQ(ShmTickBus::probe_epoch("WtTestBusEpoch"), reader.epoch());
+
+	//д, ɵӳ仹ܶ, epochѾ
+	writer.close();
+	ShmTickBus restarted;
+	EXPECT_TRUE(restarted.create("WtTestBusEpoch", 8));
+	uint64_t value = 42;
+	restarted.publish(SBT_Tick, &value, sizeof(uint64_t));
+
+	EXPECT_NE(ShmTickBus::probe_epoch("WtTestBusEpoch"), reader.epoch());
+	uint64_t cursor = reader.tail();
+	char buffer[ShmTickBus::MAX_DATA_SIZE];
+	uint32_t type = 0;
+	uint64_t stamp = 0;
+	uint64_t lost = 0;
+	EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_None);
+
+	//´Ժͷ
+	reader.close();
+	EXPECT_TRUE(reader.open("WtTestBusEpoch"));
+	EXPECT_EQ(ShmTickBus::probe_epoch("WtTestBusEpoch"), reader.epoch());
+	cursor = 0;
+	EXPECT_EQ(reader.read(cursor, type, buffer, stamp, lost), ShmTickBus::RR_Ok);
+	EXPECT_EQ(*(uint64_t*)buffer, 42);
+
+	EXPECT_EQ(ShmTickBus::probe_epoch("WtTestBusNotExist"), 0);
+}
+
+/*
+ *	һдˡһȡˣдһȶдһͳƵݵĴӳ
+ */
+TEST(test_shmbus, test_latency)
+{
+	const uint32_t items = 100000;
+	ShmTickBus writer;
+	EXPECT_TRUE(writer.create("WtTestBus", 1024));
+
+	ShmTickBus reader;
+	EXPECT_TRUE(reader.open("WtTestBus"));
+
+	std::atomic<uint32_t> handled(0);
+	StdThread producer([&writer, &handled, items]() {
+		for (uint32_t i = 0; i < items; i++)
+		{
+			writer.publish(SBT_Tick, &i, sizeof(uint32_t));
+			while (handled.load(std::memory_order_acquire) <= i)
+				std::this_thread::yield();
+		}
+	});
+
+	uint64_t cursor = 0;
+	char buffer[ShmTickBus::MAX_DATA_SIZE];
+	uint32_t type = 0;
+	uint64_t stamp = 0;
+	uint64_t lost = 0;
+	uint64_t total = 0;
+	uint32_t count = 0;
+	while (count < items)
+	{
+		if (reader.read(cursor, type, buffer, stamp, lost) != ShmTickBus::RR_Ok)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		EXPECT_EQ(*(uint32_t*)buffer, count);
+		total += ShmTickBus::now_nano() - stamp;
+		count++;
+		handled.store(count, std::memory_order_release);
+	}
+	producer.join();
+
+	fmt::print("{} items passed through shm bus, avg latency: {} ns\n", items, total / items);
+}
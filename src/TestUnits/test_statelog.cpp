@@ -0,0 +1,149 @@
+#include "gtest/gtest/gtest.h"
+#include "../Share/StateLog.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+
+TEST(test_statelog, test_replay)
+{
+	const char* filename = "./test_statelog.dat";
+	BoostFile::delete_file(filename);
+
+	{
+		StateLog log;
+		ASSERT_TRUE(log.open(filename, 1));
+		EXPECT_TRUE(log.empty());
+
+		std::string buf;
+		StateWriter(buf).write(1.5).write((uint32_t)20231011).write_str("enter");
+		log.put("pos.SHFE.rb2401", buf);
+		log.put("sig.SHFE.rb2401", "signal");
+		log.put("sig.SHFE.hc2401", "signal");
+		EXPECT_GT(log.commit(), 0);
+
+		//ֵĻд
+		log.put("sig.SHFE.rb2401", "signal");
+		EXPECT_EQ(log.commit(), 0);
+
+		log.remove("sig.SHFE.rb2401");
+		log.put("sig.SHFE.hc2401", "changed");
+		log.commit();
+	}
+
+	{
+		StateLog log;
+		ASSERT_TRUE(log.open(filename, 1));
+		EXPECT_EQ(log.records().size(), 2);
+		EXPECT_EQ(log.records().at("sig.SHFE.hc2401"), "changed");
+
+		StateReader reader(log.records().at("pos.SHFE.rb2401"));
+		double vol = 0;
+		uint32_t tdate = 0;
+		std::string tag;
+		EXPECT_TRUE(reader.read(vol));
+		EXPECT_TRUE(reader.read(tdate));
+		EXPECT_TRUE(reader.read_str(tag));
+		EXPECT_FALSE(reader.read(vol));
+		EXPECT_DOUBLE_EQ(vol, 1.5);
+		EXPECT_EQ(tdate, 20231011);
+		EXPECT_EQ(tag, "enter");
+	}
+
+	//ģдһͱ, ļ¼
+	uint64_t fsize = BoostFile::get_file_size(filename);
+	{
+		BoostFile bf;
+		bf.open_existing_file(filename);
+		bf.seek_to_end();
+		bf.write_file("\x20\x00\x00\x00garbage", 11);
+	}
+	{
+		StateLog log;
+		ASSERT_TRUE(log.open(filename, 1));
+		EXPECT_EQ(log.records().size(), 2);
+		EXPECT_EQ(log.file_size(), fsize);
+	}
+	EXPECT_EQ(BoostFile::get_file_size(filename), fsize);
+
+	//汾һ, ԭļŲһ, ½һ
+	{
+		StateLog log;
+		ASSERT_TRUE(log.open(filename, 2));
+		EXPECT_TRUE(log.empty());
+		EXPECT_EQ(log.bad_file(), std::string(filename) + ".bad");
+	}
+	EXPECT_EQ(BoostFile::get_file_size((std::string(filename) + ".bad").c_str()), fsize);
+	{
+		StateLog log;
+		ASSERT_TRUE(log.open(filename, 2));
+		EXPECT_TRUE(log.bad_file().empty());
+	}
+	BoostFile::delete_file(filename);
+	BoostFile::delete_file((std::string(filename) + ".bad").c_str());
+}
+
+TEST(test_statelog, test_compact)
+{
+	const char* filename = "./test_statelog_compact.dat";
+	BoostFile::delete_file(filename);
+
+	StateLog log;
+	ASSERT_TRUE(log.open(filename, 1));
+	log.set_compact_policy(4, 4096);
+	for (uint32_t i = 0; i < 10000; i++)
+	{
+		log.put("fund", fmt::format("{}", i));
+		log.commit();
+		EXPECT_LE(log.file_size(), 4096 + 64);
+	}
+
+	StateLog other;
+	ASSERT_TRUE(other.open(filename, 1));
+	EXPECT_EQ(other.records().at("fund"), "9999");
+	BoostFile::delete_file(filename);
+}
+
+TEST(test_statelog, test_performance)
+{
+	/*
+	 *	200ֲ, ÿֲ20ϸ, ÿγɽֻıһֲ
+	 *	Աÿдȫ״ֻ̬׷ӱ仯Ĳ
+	 */
+	const uint32_t CODES = 200;
+	const uint32_t TIMES = 2000;
+	const char* filename = "./test_statelog_perf.dat";
+	BoostFile::delete_file(filename);
+
+	std::vector<std::string> states(CODES);
+	for (std::string& state : states)
+		state.assign(20 * 128, 'x');
+
+	int64_t start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+	{
+		states[i % CODES][i % 128] = (char)i;
+		std::string content;
+		for (const std::string& state : states)
+			content.append(state);
+		BoostFile::write_file_contents(filename, content.data(), (uint32_t)content.size());
+	}
+	int64_t elapseFull = TimeUtils::getLocalTimeNow() - start;
+	BoostFile::delete_file(filename);
+
+	StateLog log;
+	log.open(filename, 1);
+	std::vector<std::string> keys;
+	for (uint32_t i = 0; i < CODES; i++)
+		keys.emplace_back(fmt::format("pos.SHFE.rb{}", i));
+	start = TimeUtils::getLocalTimeNow();
+	for (uint32_t i = 0; i < TIMES; i++)
+	{
+		states[i % CODES][i % 128] = (char)(i + 1);
+		for (uint32_t j = 0; j < CODES; j++)
+			log.put(keys[j], states[j]);
+		log.commit();
+	}
+	int64_t elapseLog = TimeUtils::getLocalTimeNow() - start;
+
+	fmt::print("{} saves of {} positions, full rewrite: {} ms, state log: {} ms, log size: {} bytes\n", TIMES, CODES, elapseFull, elapseLog, log.file_size());
+	BoostFile::delete_file(filename);
+}
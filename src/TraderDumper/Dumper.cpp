@@ -40,43 +40,7 @@ bool Dumper::config(const char* cfgfile, bool isFile, const char* modDir)
 
 	//ļ
 	WTSVariant* cfgBF = root->get("basefiles");
-	if (cfgBF->get("session"))
-	{
-		g_bdMgr.loadSessions(cfgBF->getCString("session"));
-		WTSLogger::info("Trading sessions loaded");
-	}
-
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			g_bdMgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				g_bdMgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			g_bdMgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				g_bdMgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
+	g_bdMgr.loadBaseFiles(cfgBF);
 
 	cfg = root->get("traders");
 	for (uint32_t idx = 0; idx < cfg->size(); idx++)
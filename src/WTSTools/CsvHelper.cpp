@@ -1,9 +1,21 @@
 #include "CsvHelper.h"
 
 #include <limits.h>
+#include <atomic>
 
 #include "../Share/StdUtils.hpp"
 #include "../Share/StrUtil.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/BoostMappingFile.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WT_CSV_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 CsvReader::CsvReader(const char* item_splitter /* = "," */)
 	: _item_splitter(item_splitter)
@@ -175,4 +187,444 @@ int32_t CsvReader::get_col_by_filed(const char* field)
 		return INT_MAX;
 
 	return it->second;
-}
\ No newline at end of file
+}
+
+
+static inline uint32_t lowest_bit(uint32_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long idx;
+	_BitScanForward(&idx, mask);
+	return (uint32_t)idx;
+#else
+	return (uint32_t)__builtin_ctz(mask);
+#endif
+}
+
+static inline bool is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+//跳过单元格两端的空格和引号
+static inline void trim_cell(const char*& p, const char*& e)
+{
+	while (p < e && (*p == ' ' || *p == '"' || *p == '\t'))
+		p++;
+	while (e > p && (e[-1] == ' ' || e[-1] == '"' || e[-1] == '\t'))
+		e--;
+}
+
+static double slow_atof(const char* p, const char* e)
+{
+	char buf[64];
+	std::size_t len = std::min<std::size_t>(e - p, sizeof(buf) - 1);
+	memcpy(buf, p, len);
+	buf[len] = '\0';
+	return strtod(buf, NULL);
+}
+
+/*
+ *	尾数不超过2^53、小数位数不超过22位的时候, 尾数和10的幂都能精确表示
+ *	一次除法的结果是正确舍入的, 和strtod结果完全一致, 其他情况交给strtod
+ */
+static double fast_atof(const char* p, const char* e)
+{
+	static const double POW10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	trim_cell(p, e);
+	const char* s = p;
+	bool bNeg = false;
+	if (p < e && (*p == '-' || *p == '+'))
+	{
+		bNeg = (*p == '-');
+		p++;
+	}
+
+	uint64_t mantissa = 0;
+	uint32_t digits = 0;
+	uint32_t fracs = 0;
+	for (; p < e && is_digit(*p); p++, digits++)
+		mantissa = mantissa * 10 + (*p - '0');
+
+	if (p < e && *p == '.')
+	{
+		p++;
+		for (; p < e && is_digit(*p); p++, digits++, fracs++)
+			mantissa = mantissa * 10 + (*p - '0');
+	}
+
+	if (p != e || digits == 0 || digits > 19 || fracs > 22 || mantissa > (1ULL << 53))
+		return slow_atof(s, e);
+
+	double ret = (double)mantissa / POW10[fracs];
+	return bNeg ? -ret : ret;
+}
+
+template<typename T>
+static T fast_atoi(const char* p, const char* e)
+{
+	trim_cell(p, e);
+	bool bNeg = false;
+	if (p < e && (*p == '-' || *p == '+'))
+	{
+		bNeg = (*p == '-');
+		p++;
+	}
+
+	uint64_t ret = 0;
+	for (; p < e && is_digit(*p); p++)
+		ret = ret * 10 + (*p - '0');
+
+	return (T)(bNeg ? (0 - ret) : ret);
+}
+
+CsvFastReader::CsvFastReader(const char* item_splitter /* = "," */)
+	: _mf(NULL), _data(NULL), _size(0), _pos(0), _row_start(0)
+	, _splitter((item_splitter == NULL || item_splitter[0] == '\0') ? ',' : item_splitter[0])
+{
+	_cells.reserve(64);
+}
+
+CsvFastReader::~CsvFastReader()
+{
+	close();
+}
+
+void CsvFastReader::close()
+{
+	if (_mf)
+	{
+		delete _mf;
+		_mf = NULL;
+	}
+
+	_data = NULL;
+	_size = _pos = _row_start = 0;
+	_cells.clear();
+	_fields_map.clear();
+	_fields.clear();
+}
+
+bool CsvFastReader::load_from_file(const char* filename)
+{
+	close();
+
+	if (!StdFile::exists(filename))
+		return false;
+
+	//空文件没法映射, 当作没有数据
+	if (boost::filesystem::file_size(filename) == 0)
+		return true;
+
+	_mf = new BoostMappingFile();
+	if (!_mf->map(filename, boost::interprocess::read_only, boost::interprocess::read_only))
+	{
+		close();
+		return false;
+	}
+
+	_data = (const char*)_mf->addr();
+	_size = _mf->size();
+
+	//判断是不是UTF-8BOM 编码
+	static char flag[] = { (char)0xEF, (char)0xBB, (char)0xBF };
+	if (_size >= 3 && memcmp(_data, flag, sizeof(char) * 3) == 0)
+		_pos = 3;
+
+	if (!next_row())
+		return true;
+
+	//字段名的处理和CsvReader一致, 去掉特殊符号, 转成小写
+	for (uint32_t i = 0; i < _cells.size() / 2; i++)
+	{
+		std::string field(_data + _row_start + _cells[2 * i], _cells[2 * i + 1] - _cells[2 * i]);
+		StrUtil::replace(field, "<", "");
+		StrUtil::replace(field, ">", "");
+		StrUtil::replace(field, "\"", "");
+		StrUtil::replace(field, "'", "");
+		StrUtil::toLowerCase(field);
+		StrUtil::trim(field, " \t\r\n");
+		if (field.empty())
+			break;
+
+		_fields_map[field] = i;
+		if (!_fields.empty())
+			_fields += ",";
+		_fields += field;
+	}
+
+	return true;
+}
+
+uint32_t CsvFastReader::token_mask(std::size_t pos) const
+{
+#ifdef WT_CSV_SSE2
+	if (pos + 16 <= _size)
+	{
+		const __m128i vSplit = _mm_set1_epi8(_splitter);
+		const __m128i vLine = _mm_set1_epi8('\n');
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(_data + pos));
+		__m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, vSplit), _mm_cmpeq_epi8(chunk, vLine));
+		return (uint32_t)_mm_movemask_epi8(hits);
+	}
+#endif
+
+	uint32_t mask = 0;
+	std::size_t cnt = std::min<std::size_t>(16, _size - pos);
+	for (std::size_t i = 0; i < cnt; i++)
+	{
+		char c = _data[pos + i];
+		if (c == _splitter || c == '\n')
+			mask |= (1u << i);
+	}
+	return mask;
+}
+
+bool CsvFastReader::next_row()
+{
+	while (_pos < _size)
+	{
+		_cells.clear();
+		_row_start = _pos;
+
+		std::size_t cellStart = _pos;
+		std::size_t lineEnd = _size;
+		bool bFound = false;
+		for (std::size_t blk = _pos; blk < _size && !bFound; blk += 16)
+		{
+			uint32_t mask = token_mask(blk);
+			while (mask != 0)
+			{
+				std::size_t idx = blk + lowest_bit(mask);
+				mask &= mask - 1;
+
+				push_cell(cellStart, idx);
+				cellStart = idx + 1;
+				if (_data[idx] == '\n')
+				{
+					lineEnd = idx;
+					bFound = true;
+					break;
+				}
+			}
+		}
+
+		if (!bFound)
+			push_cell(cellStart, _size);
+		_pos = bFound ? lineEnd + 1 : _size;
+
+		//跳过空行
+		if (_cells.size() == 2 && _cells[0] == _cells[1])
+			continue;
+
+		return true;
+	}
+
+	_cells.clear();
+	return false;
+}
+
+int32_t CsvFastReader::get_col_by_field(const char* field) const
+{
+	auto it = _fields_map.find(field);
+	if (it == _fields_map.end())
+		return INT_MAX;
+
+	return it->second;
+}
+
+bool CsvFastReader::get_cell(int32_t col, const char*& start, const char*& end) const
+{
+	if (col < 0 || col >= (int32_t)_fields_map.size() || (std::size_t)col * 2 + 1 >= _cells.size())
+		return false;
+
+	start = _data + _row_start + _cells[2 * col];
+	end = _data + _row_start + _cells[2 * col + 1];
+	return true;
+}
+
+int32_t CsvFastReader::get_int32(int32_t col) const
+{
+	const char *s, *e;
+	return get_cell(col, s, e) ? fast_atoi<int32_t>(s, e) : 0;
+}
+
+uint32_t CsvFastReader::get_uint32(int32_t col) const
+{
+	const char *s, *e;
+	return get_cell(col, s, e) ? fast_atoi<uint32_t>(s, e) : 0;
+}
+
+int64_t CsvFastReader::get_int64(int32_t col) const
+{
+	const char *s, *e;
+	return get_cell(col, s, e) ? fast_atoi<int64_t>(s, e) : 0;
+}
+
+uint64_t CsvFastReader::get_uint64(int32_t col) const
+{
+	const char *s, *e;
+	return get_cell(col, s, e) ? fast_atoi<uint64_t>(s, e) : 0;
+}
+
+double CsvFastReader::get_double(int32_t col) const
+{
+	const char *s, *e;
+	return get_cell(col, s, e) ? fast_atof(s, e) : 0;
+}
+
+const char* CsvFastReader::get_string(int32_t col)
+{
+	const char *s, *e;
+	if (!get_cell(col, s, e))
+		return "";
+
+	_cell_buf.assign(s, e - s);
+	return _cell_buf.c_str();
+}
+
+uint32_t CsvFastReader::get_date(int32_t col) const
+{
+	const char *s, *e;
+	if (!get_cell(col, s, e))
+		return 0;
+
+	trim_cell(s, e);
+	uint32_t parts[3] = { 0 };
+	uint32_t idx = 0;
+	for (; s < e; s++)
+	{
+		if (is_digit(*s))
+			parts[idx] = parts[idx] * 10 + (*s - '0');
+		else if ((*s == '/' || *s == '-') && idx < 2)
+			idx++;
+		else
+			break;
+	}
+
+	//只有一段的就是20231018这样的格式
+	if (idx == 0)
+		return parts[0];
+
+	return parts[0] * 10000 + parts[1] * 100 + parts[2];
+}
+
+uint32_t CsvFastReader::get_time(int32_t col, bool bHasSec /* = false */) const
+{
+	const char *s, *e;
+	if (!get_cell(col, s, e))
+		return 0;
+
+	trim_cell(s, e);
+	uint32_t ret = 0;
+	uint32_t digits = 0;
+	for (; s < e; s++)
+	{
+		if (is_digit(*s))
+		{
+			ret = ret * 10 + (*s - '0');
+			digits++;
+		}
+		else if (*s != ':')
+			break;
+	}
+
+	if (digits > 4 && !bHasSec)
+		ret /= 100;
+
+	return ret;
+}
+
+
+bool CsvBarLoader::load_bars(const char* filename, bool isDay, std::vector<wtp::WTSBarStruct>& bars, ProgressCallback cbProgress /* = nullptr */)
+{
+	CsvFastReader reader;
+	if (!reader.load_from_file(filename))
+		return false;
+
+	//字段位置只查一次
+	int32_t cDate = reader.get_col_by_field("date");
+	int32_t cTime = reader.get_col_by_field("time");
+	int32_t cOpen = reader.get_col_by_field("open");
+	int32_t cHigh = reader.get_col_by_field("high");
+	int32_t cLow = reader.get_col_by_field("low");
+	int32_t cClose = reader.get_col_by_field("close");
+	int32_t cVol = reader.get_col_by_field("volume");
+	int32_t cMoney = reader.get_col_by_field("turnover");
+	int32_t cHold = reader.get_col_by_field("open_interest");
+	int32_t cAdd = reader.get_col_by_field("diff_interest");
+	int32_t cSettle = reader.get_col_by_field("settle");
+
+	std::size_t headEnd = reader.position();
+	while (reader.next_row())
+	{
+		//按第一行的长度预估总行数, 避免反复扩容
+		if (bars.empty())
+		{
+			std::size_t rowLen = std::max<std::size_t>(reader.position() - headEnd, 1);
+			bars.reserve((reader.file_size() - headEnd) / rowLen + 16);
+		}
+
+		wtp::WTSBarStruct bs;
+		bs.date = reader.get_date(cDate);
+		if (!isDay)
+			bs.time = TimeUtils::timeToMinBar(bs.date, reader.get_time(cTime));
+		bs.open = reader.get_double(cOpen);
+		bs.high = reader.get_double(cHigh);
+		bs.low = reader.get_double(cLow);
+		bs.close = reader.get_double(cClose);
+		bs.vol = reader.get_double(cVol);
+		bs.money = reader.get_double(cMoney);
+		bs.hold = reader.get_double(cHold);
+		bs.add = reader.get_double(cAdd);
+		bs.settle = reader.get_double(cSettle);
+		bars.emplace_back(bs);
+
+		if (cbProgress && bars.size() % 100000 == 0)
+			cbProgress(bars.size());
+	}
+
+	return true;
+}
+
+void CsvBarLoader::load_files(const std::vector<std::string>& files, bool isDay, FileCallback cb, uint32_t threads /* = 0 */)
+{
+	if (files.empty())
+		return;
+
+	if (threads == 0)
+		threads = std::max<uint32_t>(StdThread::hardware_concurrency(), 1);
+	threads = std::min<uint32_t>(threads, (uint32_t)files.size());
+
+	std::atomic<std::size_t> next(0);
+	auto worker = [&files, &next, &cb, isDay]() {
+		for (;;)
+		{
+			std::size_t idx = next.fetch_add(1);
+			if (idx >= files.size())
+				break;
+
+			std::vector<wtp::WTSBarStruct> bars;
+			bool bSucc = load_bars(files[idx].c_str(), isDay, bars);
+			if (cb)
+				cb(files[idx], bars, bSucc);
+		}
+	};
+
+	if (threads == 1)
+	{
+		worker();
+		return;
+	}
+
+	std::vector<StdThreadPtr> workers;
+	for (uint32_t i = 0; i < threads; i++)
+		workers.emplace_back(new StdThread(worker));
+
+	for (auto& thrd : workers)
+		thrd->join();
+}
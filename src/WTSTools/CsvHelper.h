@@ -6,6 +6,11 @@
 #include <fstream>
 #include <vector>
 #include <sstream>
+#include <functional>
+
+#include "../Includes/WTSStruct.h"
+
+class BoostMappingFile;
 
 class CsvReader
 {
@@ -68,3 +73,119 @@ private:
 	std::unordered_map<std::string, int32_t> _fields_map;
 	std::vector<std::string> _current_cells;
 };
+
+/*
+ *	基于内存映射的csv读取器, 接口和CsvReader保持一致
+ *	用SSE2一次比较16个字节, 同时查找分隔符和换行符, 单元格只记录在映射内存中的位置, 不做拷贝
+ *	数字直接在映射内存上解析, 行情数据的有效位数一般不超过15位, 绝大部分不需要经过strtod
+ *	分隔符只支持单个字符
+ */
+class CsvFastReader
+{
+public:
+	CsvFastReader(const char* item_splitter = ",");
+	~CsvFastReader();
+
+public:
+	bool	load_from_file(const char* filename);
+	void	close();
+
+public:
+	inline uint32_t	col_count() const { return (uint32_t)_fields_map.size(); }
+
+	//文件大小和当前读到的位置, 用于估算行数和进度
+	inline std::size_t	file_size() const { return _size; }
+	inline std::size_t	position() const { return _pos; }
+
+	int32_t		get_col_by_field(const char* field) const;
+
+	int32_t		get_int32(int32_t col) const;
+	uint32_t	get_uint32(int32_t col) const;
+
+	int64_t		get_int64(int32_t col) const;
+	uint64_t	get_uint64(int32_t col) const;
+
+	double		get_double(int32_t col) const;
+
+	/*
+	 *	返回的字符串在下一次调用get_string之前有效
+	 */
+	const char*	get_string(int32_t col);
+
+	/*
+	 *	日期, 支持20231018、2023/10/18、2023-10-18和后面带时间的格式
+	 */
+	uint32_t	get_date(int32_t col) const;
+
+	/*
+	 *	时间, 去掉冒号以后的数字, bHasSec为false的时候如果带了秒就去掉秒
+	 */
+	uint32_t	get_time(int32_t col, bool bHasSec = false) const;
+
+	int32_t		get_int32(const char* field) const { return get_int32(get_col_by_field(field)); }
+	uint32_t	get_uint32(const char* field) const { return get_uint32(get_col_by_field(field)); }
+
+	int64_t		get_int64(const char* field) const { return get_int64(get_col_by_field(field)); }
+	uint64_t	get_uint64(const char* field) const { return get_uint64(get_col_by_field(field)); }
+
+	double		get_double(const char* field) const { return get_double(get_col_by_field(field)); }
+
+	const char*	get_string(const char* field) { return get_string(get_col_by_field(field)); }
+
+	uint32_t	get_date(const char* field) const { return get_date(get_col_by_field(field)); }
+	uint32_t	get_time(const char* field, bool bHasSec = false) const { return get_time(get_col_by_field(field), bHasSec); }
+
+	bool		next_row();
+
+	const char* fields() const { return _fields.c_str(); }
+
+private:
+	bool		get_cell(int32_t col, const char*& start, const char*& end) const;
+	uint32_t	token_mask(std::size_t pos) const;
+
+	inline void	push_cell(std::size_t start, std::size_t end)
+	{
+		if (end > start && _data[end - 1] == '\r')
+			end--;
+
+		_cells.emplace_back((uint32_t)(start - _row_start));
+		_cells.emplace_back((uint32_t)(end - _row_start));
+	}
+
+private:
+	BoostMappingFile*	_mf;
+	const char*			_data;
+	std::size_t			_size;
+	std::size_t			_pos;
+	std::size_t			_row_start;
+	char				_splitter;
+
+	std::unordered_map<std::string, int32_t> _fields_map;
+	std::string				_fields;
+	std::vector<uint32_t>	_cells;		//当前行每个单元格的起止位置, 相对行首
+	std::string				_cell_buf;
+};
+
+/*
+ *	从csv文件读取K线, 字段名和原来HisDataReplayer、WtDtHelper里的一致
+ *	date,time,open,high,low,close,volume,turnover,open_interest,diff_interest,settle
+ */
+class CsvBarLoader
+{
+public:
+	typedef std::function<void(std::size_t)> ProgressCallback;
+	typedef std::function<void(const std::string& filename, std::vector<wtp::WTSBarStruct>& bars, bool bSucc)> FileCallback;
+
+	/*
+	 *	读取单个文件
+	 *	@isDay		是否是日线, 日线不读取time字段
+	 *	@cbProgress	每读取100000条回调一次
+	 */
+	static bool load_bars(const char* filename, bool isDay, std::vector<wtp::WTSBarStruct>& bars, ProgressCallback cbProgress = nullptr);
+
+	/*
+	 *	多线程读取多个文件, 每读完一个文件在工作线程上回调一次
+	 *	@threads	线程数, 0表示按CPU核数
+	 */
+	static void load_files(const std::vector<std::string>& files, bool isDay, FileCallback cb, uint32_t threads = 0);
+};
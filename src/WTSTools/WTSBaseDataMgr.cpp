@@ -17,6 +17,9 @@
 
 #include "../Share/StrUtil.hpp"
 #include "../Share/StdUtils.hpp"
+#include "../Share/BoostMappingFile.hpp"
+
+#include <algorithm>
 
 const char* DEFAULT_HOLIDAY_TPL = "CHINA";
 
@@ -25,6 +28,7 @@ WTSBaseDataMgr::WTSBaseDataMgr()
 	, m_mapSessions(NULL)
 	, m_mapCommodities(NULL)
 	, m_mapContracts(NULL)
+	, m_uSymbolCnt(0)
 {
 	m_mapExchgContract = WTSExchgContract::create();
 	m_mapSessions = WTSSessionMap::create();
@@ -430,6 +434,8 @@ bool WTSBaseDataMgr::loadContracts(const char* filename)
 				pid.c_str());
 
 			cInfo->setCommInfo(commInfo);
+			//˳ԼID
+			cInfo->setSymbolID(++m_uSymbolCnt);
 
 			uint32_t maxMktQty = 1000000;
 			uint32_t maxLmtQty = 1000000;
@@ -805,4 +811,583 @@ const char* WTSBaseDataMgr::getTplIDByPID(const char* pid)
 		return "";
 
 	return commInfo->getTradingTpl();
-}
\ No newline at end of file
+}
+
+bool WTSBaseDataMgr::loadBaseFiles(WTSVariant* cfgBF)
+{
+	if (cfgBF == NULL)
+		return false;
+
+	BaseFileList sources;
+	if (cfgBF->get("session"))
+		sources.emplace_back(BFT_Session, cfgBF->getCString("session"));
+
+	WTSVariant* cfgItem = cfgBF->get("commodity");
+	if (cfgItem)
+	{
+		if (cfgItem->type() == WTSVariant::VT_String)
+		{
+			sources.emplace_back(BFT_Commodity, cfgItem->asCString());
+		}
+		else if (cfgItem->type() == WTSVariant::VT_Array)
+		{
+			for (uint32_t i = 0; i < cfgItem->size(); i++)
+				sources.emplace_back(BFT_Commodity, cfgItem->get(i)->asCString());
+		}
+	}
+
+	cfgItem = cfgBF->get("contract");
+	if (cfgItem)
+	{
+		if (cfgItem->type() == WTSVariant::VT_String)
+		{
+			sources.emplace_back(BFT_Contract, cfgItem->asCString());
+		}
+		else if (cfgItem->type() == WTSVariant::VT_Array)
+		{
+			for (uint32_t i = 0; i < cfgItem->size(); i++)
+				sources.emplace_back(BFT_Contract, cfgItem->get(i)->asCString());
+		}
+	}
+
+	if (cfgBF->get("holiday"))
+		sources.emplace_back(BFT_Holiday, cfgBF->getCString("holiday"));
+
+	std::string snapfile = cfgBF->getCString("snapshot");
+	if (!snapfile.empty() && loadSnapshot(snapfile.c_str(), sources))
+		return true;
+
+	bool bSucc = true;
+	for (const auto& item : sources)
+	{
+		const char* filename = item.second.c_str();
+		switch (item.first)
+		{
+		case BFT_Session: bSucc = loadSessions(filename) && bSucc; break;
+		case BFT_Commodity: bSucc = loadCommodities(filename) && bSucc; break;
+		case BFT_Contract: bSucc = loadContracts(filename) && bSucc; break;
+		case BFT_Holiday: bSucc = loadHolidays(filename) && bSucc; break;
+		default: break;
+		}
+	}
+
+	//Դļмʧܵ, Ͳɿ, Ѳݹ̻
+	if (!snapfile.empty() && bSucc)
+		saveSnapshot(snapfile.c_str(), sources);
+
+	return bSucc;
+}
+
+/*
+ *	ݿյļʽ
+ *	ļͷԺԴļʱʱαƷֱԼڼģڼձַ
+ *	¼ַַֻƫ, ַֻͬһ, ƫ0ǿַ
+ *	ÿű8ֽڶ, صʱֱӳڴ϶ȡ
+ */
+#pragma pack(push, 8)
+
+static const char BDSNAP_MAGIC[8] = { 'W', 'T', 'B', 'D', 'S', 'N', 'P', '\0' };
+static const uint32_t BDSNAP_VERSION = 1;
+
+typedef struct _BDSnapHeader
+{
+	char		_magic[8];
+	uint32_t	_version;
+	uint32_t	_symbol_cnt;	//ѾĺԼID
+	uint32_t	_source_cnt;
+	uint32_t	_session_cnt;
+	uint32_t	_section_cnt;
+	uint32_t	_comm_cnt;
+	uint32_t	_contract_cnt;
+	uint32_t	_exchg_cnt;		//, Ԥ
+	uint32_t	_code_cnt;		//ظĺԼ, Ԥ
+	uint32_t	_tpl_cnt;
+	uint32_t	_holiday_cnt;
+	uint32_t	_reserved;
+	uint64_t	_str_size;
+	uint64_t	_checksum;		//ļͷԺȫݵУ
+} BDSnapHeader;
+
+typedef struct _BDSnapSource
+{
+	uint32_t	_type;
+	uint32_t	_path;
+	uint64_t	_size;
+	uint64_t	_checksum;
+} BDSnapSource;
+
+typedef struct _BDSnapSession
+{
+	uint32_t	_id;
+	uint32_t	_name;
+	int32_t		_offset;
+	uint32_t	_sec_start;		//ʱαʼλ, ȽʱټϾʱ
+	uint32_t	_trading_cnt;
+	uint32_t	_auction_cnt;
+} BDSnapSession;
+
+typedef struct _BDSnapSection
+{
+	uint32_t	_from;
+	uint32_t	_to;
+} BDSnapSection;
+
+typedef struct _BDSnapCommodity
+{
+	uint32_t	_pid;
+	uint32_t	_name;
+	uint32_t	_exchg;
+	uint32_t	_session;
+	uint32_t	_trdtpl;
+	uint32_t	_currency;
+	uint32_t	_volscale;
+	uint32_t	_category;
+	uint32_t	_covermode;
+	uint32_t	_pricemode;
+	uint32_t	_trademode;
+	uint32_t	_reserved;
+	double		_pricetick;
+	double		_lotstick;
+	double		_minlots;
+} BDSnapCommodity;
+
+typedef struct _BDSnapContract
+{
+	uint32_t	_code;
+	uint32_t	_name;
+	uint32_t	_exchg;
+	uint32_t	_product;
+	uint32_t	_comm_idx;		//Ʒֱ
+	uint32_t	_symbol_id;
+	uint32_t	_max_mkt_qty;
+	uint32_t	_max_lmt_qty;
+	uint32_t	_min_mkt_qty;
+	uint32_t	_min_lmt_qty;
+	uint32_t	_open_date;
+	uint32_t	_expire_date;
+	double		_long_margin;
+	double		_short_margin;
+} BDSnapContract;
+
+typedef struct _BDSnapHolidayTpl
+{
+	uint32_t	_id;
+	uint32_t	_start;			//ڽڼձʼλ
+	uint32_t	_count;
+	uint32_t	_reserved;
+} BDSnapHolidayTpl;
+
+#pragma pack(pop)
+
+static inline std::size_t snap_align(std::size_t len)
+{
+	return (len + 7) & ~(std::size_t)7;
+}
+
+//FNV-1a
+static uint64_t snap_checksum(const char* data, std::size_t len)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < len; i++)
+	{
+		hash ^= (uint8_t)data[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+/*
+ *	űļλ, д
+ */
+typedef struct _BDSnapLayout
+{
+	std::size_t	_sources;
+	std::size_t	_sessions;
+	std::size_t	_sections;
+	std::size_t	_comms;
+	std::size_t	_contracts;
+	std::size_t	_tpls;
+	std::size_t	_holidays;
+	std::size_t	_strings;
+	std::size_t	_total;
+
+	_BDSnapLayout(const BDSnapHeader& header)
+	{
+		_sources = sizeof(BDSnapHeader);
+		_sessions = _sources + snap_align(sizeof(BDSnapSource)*header._source_cnt);
+		_sections = _sessions + snap_align(sizeof(BDSnapSession)*header._session_cnt);
+		_comms = _sections + snap_align(sizeof(BDSnapSection)*header._section_cnt);
+		_contracts = _comms + snap_align(sizeof(BDSnapCommodity)*header._comm_cnt);
+		_tpls = _contracts + snap_align(sizeof(BDSnapContract)*header._contract_cnt);
+		_holidays = _tpls + snap_align(sizeof(BDSnapHolidayTpl)*header._tpl_cnt);
+		_strings = _holidays + snap_align(sizeof(uint32_t)*header._holiday_cnt);
+		_total = _strings + (std::size_t)header._str_size;
+	}
+} BDSnapLayout;
+
+/*
+ *	Դļ, ļСУ
+ */
+static bool check_source(const char* filename, uint64_t& size, uint64_t& checksum)
+{
+	if (!StdFile::exists(filename))
+		return false;
+
+	std::string content;
+	StdFile::read_file_content(filename, content);
+	size = content.size();
+	checksum = snap_checksum(content.data(), content.size());
+	return true;
+}
+
+bool WTSBaseDataMgr::saveSnapshot(const char* filename, const BaseFileList& sources)
+{
+	//ַ, ƫ0̶Ϊַ
+	std::string strTable(1, '\0');
+	wt_hashmap<std::string, uint32_t> strIndice;
+	auto add_string = [&strTable, &strIndice](const char* str) -> uint32_t {
+		if (str == NULL || str[0] == '\0')
+			return 0;
+
+		auto it = strIndice.find(str);
+		if (it != strIndice.end())
+			return it->second;
+
+		uint32_t offset = (uint32_t)strTable.size();
+		strTable.append(str, strlen(str) + 1);
+		strIndice[str] = offset;
+		return offset;
+	};
+
+	BDSnapHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header._magic, BDSNAP_MAGIC, sizeof(BDSNAP_MAGIC));
+	header._version = BDSNAP_VERSION;
+	header._symbol_cnt = m_uSymbolCnt;
+
+	std::vector<BDSnapSource> vSources;
+	for (const auto& item : sources)
+	{
+		BDSnapSource src;
+		src._type = item.first;
+		src._path = add_string(item.second.c_str());
+		if (!check_source(item.second.c_str(), src._size, src._checksum))
+		{
+			WTSLogger::warn("Source file {} of base data snapshot not exists", item.second);
+			return false;
+		}
+		vSources.emplace_back(src);
+	}
+
+	std::vector<BDSnapSession> vSessions;
+	std::vector<BDSnapSection> vSections;
+	for (auto it = m_mapSessions->begin(); it != m_mapSessions->end(); it++)
+	{
+		WTSSessionInfo* sInfo = (WTSSessionInfo*)it->second;
+		BDSnapSession sess;
+		sess._id = add_string(sInfo->id());
+		sess._name = add_string(sInfo->name());
+		sess._offset = sInfo->getOffsetMins();
+		sess._sec_start = (uint32_t)vSections.size();
+		sess._trading_cnt = (uint32_t)sInfo->getTradingSections().size();
+		sess._auction_cnt = (uint32_t)sInfo->getAuctionSections().size();
+		for (const auto& sec : sInfo->getTradingSections())
+			vSections.emplace_back(BDSnapSection{ sec.first, sec.second });
+		for (const auto& sec : sInfo->getAuctionSections())
+			vSections.emplace_back(BDSnapSection{ sec.first, sec.second });
+		vSessions.emplace_back(sess);
+	}
+
+	std::vector<BDSnapCommodity> vComms;
+	wt_hashmap<const WTSCommodityInfo*, uint32_t> commIndice;
+	for (auto it = m_mapCommodities->begin(); it != m_mapCommodities->end(); it++)
+	{
+		WTSCommodityInfo* commInfo = (WTSCommodityInfo*)it->second;
+		BDSnapCommodity comm;
+		memset(&comm, 0, sizeof(comm));
+		comm._pid = add_string(commInfo->getProduct());
+		comm._name = add_string(commInfo->getName());
+		comm._exchg = add_string(commInfo->getExchg());
+		comm._session = add_string(commInfo->getSession());
+		comm._trdtpl = add_string(commInfo->getTradingTpl());
+		comm._currency = add_string(commInfo->getCurrency());
+		comm._volscale = commInfo->getVolScale();
+		comm._category = commInfo->getCategoty();
+		comm._covermode = commInfo->getCoverMode();
+		comm._pricemode = commInfo->getPriceMode();
+		comm._trademode = commInfo->getTradingMode();
+		comm._pricetick = commInfo->getPriceTick();
+		comm._lotstick = commInfo->getLotsTick();
+		comm._minlots = commInfo->getMinLots();
+		commIndice[commInfo] = (uint32_t)vComms.size();
+		vComms.emplace_back(comm);
+	}
+
+	//ԼID, Ҳԭļ˳, ָʱͬԼȺ˳򲻱
+	std::vector<WTSContractInfo*> ayContracts;
+	for (auto it = m_mapContracts->begin(); it != m_mapContracts->end(); it++)
+	{
+		WTSArray* ayInst = (WTSArray*)it->second;
+		for (auto cit = ayInst->begin(); cit != ayInst->end(); cit++)
+			ayContracts.emplace_back((WTSContractInfo*)*cit);
+	}
+	std::sort(ayContracts.begin(), ayContracts.end(), [](const WTSContractInfo* a, const WTSContractInfo* b) {
+		return a->getSymbolID() < b->getSymbolID();
+	});
+
+	std::vector<BDSnapContract> vContracts;
+	for (WTSContractInfo* cInfo : ayContracts)
+	{
+		auto it = commIndice.find(cInfo->getCommInfo());
+		if (it == commIndice.end())
+			continue;
+
+		BDSnapContract ct;
+		ct._code = add_string(cInfo->getCode());
+		ct._name = add_string(cInfo->getName());
+		ct._exchg = add_string(cInfo->getExchg());
+		ct._product = add_string(cInfo->getProduct());
+		ct._comm_idx = it->second;
+		ct._symbol_id = cInfo->getSymbolID();
+		ct._max_mkt_qty = cInfo->getMaxMktVol();
+		ct._max_lmt_qty = cInfo->getMaxLmtVol();
+		ct._min_mkt_qty = cInfo->getMinMktVol();
+		ct._min_lmt_qty = cInfo->getMinLmtVol();
+		ct._open_date = cInfo->getOpenDate();
+		ct._expire_date = cInfo->getExpireDate();
+		ct._long_margin = cInfo->getLongMarginRatio();
+		ct._short_margin = cInfo->getShortMarginRatio();
+		vContracts.emplace_back(ct);
+	}
+
+	std::vector<BDSnapHolidayTpl> vTpls;
+	std::vector<uint32_t> vHolidays;
+	for (auto it = m_mapTradingDay.begin(); it != m_mapTradingDay.end(); it++)
+	{
+		BDSnapHolidayTpl tpl;
+		memset(&tpl, 0, sizeof(tpl));
+		tpl._id = add_string(it->first.c_str());
+		tpl._start = (uint32_t)vHolidays.size();
+		tpl._count = (uint32_t)it->second._holidays.size();
+		for (uint32_t uDate : it->second._holidays)
+			vHolidays.emplace_back(uDate);
+		vTpls.emplace_back(tpl);
+	}
+
+	header._source_cnt = (uint32_t)vSources.size();
+	header._session_cnt = (uint32_t)vSessions.size();
+	header._section_cnt = (uint32_t)vSections.size();
+	header._comm_cnt = (uint32_t)vComms.size();
+	header._contract_cnt = (uint32_t)vContracts.size();
+	header._exchg_cnt = m_mapExchgContract->size();
+	header._code_cnt = m_mapContracts->size();
+	header._tpl_cnt = (uint32_t)vTpls.size();
+	header._holiday_cnt = (uint32_t)vHolidays.size();
+	header._str_size = strTable.size();
+
+	BDSnapLayout layout(header);
+	std::string content(layout._total, '\0');
+	char* buf = (char*)content.data();
+	memcpy(buf + layout._sources, vSources.data(), sizeof(BDSnapSource)*vSources.size());
+	memcpy(buf + layout._sessions, vSessions.data(), sizeof(BDSnapSession)*vSessions.size());
+	memcpy(buf + layout._sections, vSections.data(), sizeof(BDSnapSection)*vSections.size());
+	memcpy(buf + layout._comms, vComms.data(), sizeof(BDSnapCommodity)*vComms.size());
+	memcpy(buf + layout._contracts, vContracts.data(), sizeof(BDSnapContract)*vContracts.size());
+	memcpy(buf + layout._tpls, vTpls.data(), sizeof(BDSnapHolidayTpl)*vTpls.size());
+	memcpy(buf + layout._holidays, vHolidays.data(), sizeof(uint32_t)*vHolidays.size());
+	memcpy(buf + layout._strings, strTable.data(), strTable.size());
+
+	header._checksum = snap_checksum(buf + sizeof(BDSnapHeader), layout._total - sizeof(BDSnapHeader));
+	memcpy(buf, &header, sizeof(header));
+
+	//дʱļٸ, ͬʱɿҲдһļ
+	std::string tmpfile = boost::filesystem::unique_path(std::string(filename) + ".%%%%%%%%.tmp").string();
+	StdFile::write_file_content(tmpfile.c_str(), content);
+	try
+	{
+		boost::filesystem::rename(tmpfile, filename);
+	}
+	catch (std::exception& e)
+	{
+		WTSLogger::error("Saving base data snapshot {} failed: {}", filename, e.what());
+		boost::filesystem::remove(tmpfile);
+		return false;
+	}
+
+	WTSLogger::info("Base data snapshot {} saved, {} sessions, {} commodities, {} contracts, {} bytes",
+		filename, header._session_cnt, header._comm_cnt, header._contract_cnt, content.size());
+	return true;
+}
+
+bool WTSBaseDataMgr::loadSnapshot(const char* filename, const BaseFileList& sources)
+{
+	if (!StdFile::exists(filename))
+		return false;
+
+	if (m_mapSessions->size() != 0 || m_mapCommodities->size() != 0 || m_mapContracts->size() != 0 || !m_mapTradingDay.empty())
+	{
+		WTSLogger::warn("Base data already loaded, snapshot {} skipped", filename);
+		return false;
+	}
+
+	BoostMappingFile mf;
+	if (!mf.map(filename, boost::interprocess::read_only, boost::interprocess::read_only))
+		return false;
+
+	const char* data = (const char*)mf.addr();
+	std::size_t size = mf.size();
+	if (size < sizeof(BDSnapHeader))
+	{
+		WTSLogger::warn("Size checking of base data snapshot {} failed", filename);
+		return false;
+	}
+
+	const BDSnapHeader* header = (const BDSnapHeader*)data;
+	if (memcmp(header->_magic, BDSNAP_MAGIC, sizeof(BDSNAP_MAGIC)) != 0 || header->_version != BDSNAP_VERSION)
+	{
+		WTSLogger::warn("Unrecognized base data snapshot {}", filename);
+		return false;
+	}
+
+	BDSnapLayout layout(*header);
+	if (layout._total != size || header->_str_size == 0 || data[size - 1] != '\0'
+		|| snap_checksum(data + sizeof(BDSnapHeader), size - sizeof(BDSnapHeader)) != header->_checksum)
+	{
+		WTSLogger::warn("Base data snapshot {} corrupted", filename);
+		return false;
+	}
+
+	const char* strTable = data + layout._strings;
+	auto get_string = [strTable, header](uint32_t offset) -> const char* {
+		return (offset < header->_str_size) ? strTable + offset : "";
+	};
+
+	//ԴļбݶҪɿյʱһ
+	const BDSnapSource* srcs = (const BDSnapSource*)(data + layout._sources);
+	if (header->_source_cnt != sources.size())
+	{
+		WTSLogger::info("Source files of base data snapshot {} changed", filename);
+		return false;
+	}
+
+	for (uint32_t i = 0; i < header->_source_cnt; i++)
+	{
+		const BDSnapSource& src = srcs[i];
+		uint64_t fsize, checksum;
+		if (src._type != (uint32_t)sources[i].first || sources[i].second != get_string(src._path)
+			|| !check_source(sources[i].second.c_str(), fsize, checksum) || fsize != src._size || checksum != src._checksum)
+		{
+			WTSLogger::info("Source file {} of base data snapshot {} changed", sources[i].second, filename);
+			return false;
+		}
+	}
+
+	const BDSnapSession* sessions = (const BDSnapSession*)(data + layout._sessions);
+	const BDSnapSection* sections = (const BDSnapSection*)(data + layout._sections);
+	for (uint32_t i = 0; i < header->_session_cnt; i++)
+	{
+		const BDSnapSession& sess = sessions[i];
+		if ((uint64_t)sess._sec_start + sess._trading_cnt + sess._auction_cnt > header->_section_cnt)
+			continue;
+
+		WTSSessionInfo::TradingTimes trdTimes, aucTimes;
+		const BDSnapSection* secs = sections + sess._sec_start;
+		for (uint32_t k = 0; k < sess._trading_cnt; k++)
+			trdTimes.emplace_back(secs[k]._from, secs[k]._to);
+		secs += sess._trading_cnt;
+		for (uint32_t k = 0; k < sess._auction_cnt; k++)
+			aucTimes.emplace_back(secs[k]._from, secs[k]._to);
+
+		WTSSessionInfo* sInfo = WTSSessionInfo::create(get_string(sess._id), get_string(sess._name), sess._offset);
+		sInfo->setSections(trdTimes, aucTimes);
+		m_mapSessions->add(sInfo->id(), sInfo, false);
+	}
+
+	std::vector<WTSCommodityInfo*> ayComms;
+	ayComms.reserve(header->_comm_cnt);
+	m_mapCommodities->reserve(header->_comm_cnt);
+	const BDSnapCommodity* comms = (const BDSnapCommodity*)(data + layout._comms);
+	for (uint32_t i = 0; i < header->_comm_cnt; i++)
+	{
+		const BDSnapCommodity& comm = comms[i];
+		WTSCommodityInfo* commInfo = WTSCommodityInfo::create(get_string(comm._pid), get_string(comm._name), get_string(comm._exchg),
+			get_string(comm._session), get_string(comm._trdtpl), get_string(comm._currency));
+		commInfo->setVolScale(comm._volscale);
+		commInfo->setPriceTick(comm._pricetick);
+		commInfo->setCategory((ContractCategory)comm._category);
+		commInfo->setCoverMode((CoverMode)comm._covermode);
+		commInfo->setPriceMode((PriceMode)comm._pricemode);
+		commInfo->setTradingMode((TradingMode)comm._trademode);
+		commInfo->setLotsTick(comm._lotstick);
+		commInfo->setMinLots(comm._minlots);
+		commInfo->setSessionInfo(getSession(commInfo->getSession()));
+
+		m_mapCommodities->add(commInfo->getFullPid(), commInfo, false);
+		m_mapSessionCode[commInfo->getSession()].insert(commInfo->getFullPid());
+		ayComms.emplace_back(commInfo);
+	}
+
+	//ͳÿĺԼ, һԤ
+	const BDSnapContract* contracts = (const BDSnapContract*)(data + layout._contracts);
+	wt_hashmap<uint32_t, uint32_t> exchgCounts;
+	for (uint32_t i = 0; i < header->_contract_cnt; i++)
+		exchgCounts[contracts[i]._exchg]++;
+
+	m_mapExchgContract->reserve(header->_exchg_cnt);
+	m_mapContracts->reserve(header->_code_cnt);
+	for (uint32_t i = 0; i < header->_contract_cnt; i++)
+	{
+		const BDSnapContract& ct = contracts[i];
+		if (ct._comm_idx >= ayComms.size())
+			continue;
+
+		WTSCommodityInfo* commInfo = ayComms[ct._comm_idx];
+		WTSContractInfo* cInfo = WTSContractInfo::create(get_string(ct._code), get_string(ct._name), get_string(ct._exchg), get_string(ct._product));
+		cInfo->setCommInfo(commInfo);
+		cInfo->setSymbolID(ct._symbol_id);
+		cInfo->setVolumeLimits(ct._max_mkt_qty, ct._max_lmt_qty, ct._min_mkt_qty, ct._min_lmt_qty);
+		cInfo->setDates(ct._open_date, ct._expire_date);
+		cInfo->setMarginRatios(ct._long_margin, ct._short_margin);
+
+		std::string exchg = cInfo->getExchg();
+		WTSContractList* contractList = (WTSContractList*)m_mapExchgContract->get(exchg);
+		if (contractList == NULL)
+		{
+			contractList = WTSContractList::create();
+			contractList->reserve(exchgCounts[ct._exchg]);
+			m_mapExchgContract->add(exchg, contractList, false);
+		}
+		contractList->add(std::string(cInfo->getCode()), cInfo, false);
+
+		commInfo->addCode(cInfo->getCode());
+
+		std::string key = std::string(cInfo->getCode());
+		WTSArray* ayInst = (WTSArray*)m_mapContracts->get(key);
+		if (ayInst == NULL)
+		{
+			ayInst = WTSArray::create();
+			m_mapContracts->add(key, ayInst, false);
+		}
+
+		ayInst->append(cInfo, true);
+	}
+	m_uSymbolCnt = header->_symbol_cnt;
+
+	const BDSnapHolidayTpl* tpls = (const BDSnapHolidayTpl*)(data + layout._tpls);
+	const uint32_t* holidays = (const uint32_t*)(data + layout._holidays);
+	for (uint32_t i = 0; i < header->_tpl_cnt; i++)
+	{
+		const BDSnapHolidayTpl& tpl = tpls[i];
+		if ((uint64_t)tpl._start + tpl._count > header->_holiday_cnt)
+			continue;
+
+		TradingDayTpl& trdDayTpl = m_mapTradingDay[get_string(tpl._id)];
+		trdDayTpl._holidays.reserve(tpl._count);
+		for (uint32_t k = 0; k < tpl._count; k++)
+			trdDayTpl._holidays.insert(holidays[tpl._start + k]);
+	}
+
+	WTSLogger::info("Base data loaded from snapshot {}, {} sessions, {} commodities, {} contracts",
+		filename, header->_session_cnt, header->_comm_cnt, header->_contract_cnt);
+	return true;
+}
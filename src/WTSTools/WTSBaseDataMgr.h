@@ -12,6 +12,8 @@
 #include "../Includes/WTSCollection.hpp"
 #include "../Includes/FasterDefs.h"
 
+#include <vector>
+
 USING_NS_WTP;
 
 typedef wt_hashmap<std::string, TradingDayTpl>	TradingDayTplMap;
@@ -25,6 +27,22 @@ typedef WTSHashMap<std::string>		WTSCommodityMap;
 
 typedef wt_hashmap<std::string, CodeSet> SessionCodeMap;
 
+NS_WTP_BEGIN
+class WTSVariant;
+NS_WTP_END
+
+//ļ
+typedef enum tagBaseFileType
+{
+	BFT_Session = 0,
+	BFT_Commodity,
+	BFT_Contract,
+	BFT_Holiday
+} BaseFileType;
+
+//Դļб, ˳
+typedef std::vector<std::pair<BaseFileType, std::string>> BaseFileList;
+
 class WTSBaseDataMgr : public IBaseDataMgr
 {
 public:
@@ -54,6 +72,21 @@ public:
 	bool		loadContracts(const char* filename);
 	bool		loadHolidays(const char* filename);
 
+	/*
+	 *	basefilesüؽʱ䡢Ʒ֡Լͽڼ
+	 *	snapshotʱ, ȳԴӶƿռ
+	 *	ղڻԴļб仯, ʹԴļ, ɿ
+	 */
+	bool		loadBaseFiles(WTSVariant* cfgBF);
+
+	/*
+	 *	ݿ
+	 *	ﱣԴļĴСУ, Դļбκα仯, loadSnapshot᷵false
+	 *	loadSnapshotֻڻûмκλݵʱ
+	 */
+	bool		saveSnapshot(const char* filename, const BaseFileList& sources);
+	bool		loadSnapshot(const char* filename, const BaseFileList& sources);
+
 public:
 	uint32_t	getTradingDate(const char* stdPID, uint32_t uOffDate = 0, uint32_t uOffMinute = 0, bool isTpl = false);
 	uint32_t	getNextTDate(const char* stdPID, uint32_t uDate, int days = 1, bool isTpl = false);
@@ -75,5 +108,7 @@ private:
 	WTSSessionMap*		m_mapSessions;
 	WTSCommodityMap*	m_mapCommodities;
 	WTSContractMap*		m_mapContracts;
+
+	uint32_t			m_uSymbolCnt;	//ѾĺԼID
 };
 
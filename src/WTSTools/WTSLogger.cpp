@@ -33,10 +33,12 @@
 #include <spdlog/async.h>
 
 const char* DYN_PATTERN = "dyn_pattern";
+const char* DEFERRED = "deferred";
 
 ILogHandler*		WTSLogger::m_logHandler	= NULL;
 WTSLogLevel			WTSLogger::m_logLevel	= LL_NONE;
 bool				WTSLogger::m_bStopped = false;
+bool				WTSLogger::m_bDeferred = false;
 bool				WTSLogger::m_bInited = false;
 bool				WTSLogger::m_bTpInited = false;
 SpdLoggerPtr		WTSLogger::m_rootLogger = NULL;
@@ -200,6 +202,57 @@ void WTSLogger::initLogger(const char* catName, WTSVariant* cfgLogger)
 	}
 }
 
+/*
+ *	ӳٸʽ־
+ *	"deferred": {
+ *		"active": true,
+ *		"mode": "text",				//textɺ̸̨߳ʽԺroot߶Ӧ־, binaryֱдԭʼ¼
+ *		"filename": "Logs/Runner.blog",	//binaryģʽļ, WtLogDecoder
+ *		"ringsize": 1048576,		//ÿֽ̻߳
+ *		"limits": {					//, rootʾ־
+ *			"root": {"count": 1000, "window": 1000}
+ *		}
+ *	}
+ */
+void WTSLogger::initDeferred(WTSVariant* cfg)
+{
+	if (!cfg->getBoolean("active"))
+		return;
+
+	uint32_t ringsize = cfg->getUInt32("ringsize");
+	if (ringsize == 0)
+		ringsize = 1024 * 1024;
+
+	WTSVariant* cfgLimits = cfg->get("limits");
+	if (cfgLimits != NULL)
+	{
+		auto cats = cfgLimits->memberNames();
+		for (std::string& cat : cats)
+		{
+			WTSVariant* cfgLimit = cfgLimits->get(cat.c_str());
+			uint32_t window = cfgLimit->has("window") ? cfgLimit->getUInt32("window") : 1000;
+			BinLogger::set_rate_limit(cat == "root" ? "" : cat.c_str(), cfgLimit->getUInt32("count"), window);
+		}
+	}
+
+	const char* mode = cfg->getCString("mode");
+	if (wt_stricmp(mode, "binary") == 0)
+	{
+		std::string filename = cfg->getString("filename");
+		checkDirs(filename.c_str());
+		m_bDeferred = BinLogger::start_binary(filename.c_str(), ringsize);
+	}
+	else
+	{
+		m_bDeferred = BinLogger::start_text([](uint8_t ll, const char* catName, uint64_t stamp, const char* message) {
+			if (catName[0] == '\0')
+				log_raw((WTSLogLevel)ll, message);
+			else
+				log_raw_by_cat(catName, (WTSLogLevel)ll, message);
+		}, ringsize);
+	}
+}
+
 void WTSLogger::init(const char* propFile /* = "logcfg.json" */, bool isFile /* = true */, ILogHandler* handler /* = NULL */)
 {
 	if (m_bInited)
@@ -229,6 +282,11 @@ void WTSLogger::init(const char* propFile /* = "logcfg.json" */, bool isFile /*
 			}
 			continue;
 		}
+		else if (key == DEFERRED)
+		{
+			initDeferred(cfgItem);
+			continue;
+		}
 
 		initLogger(key.c_str(), cfgItem);
 	}
@@ -249,6 +307,13 @@ void WTSLogger::registerHandler(ILogHandler* handler /* = NULL */)
 
 void WTSLogger::stop()
 {
+	//̨ͣ߳, ʣµ־Ҫspdlogر֮ǰ
+	if (m_bDeferred)
+	{
+		m_bDeferred = false;
+		BinLogger::stop();
+	}
+
 	m_bStopped = true;
 	if (m_mapPatterns)
 		m_mapPatterns->release();
@@ -11,6 +11,7 @@
 #include "../Includes/WTSTypes.h"
 #include "../Includes/WTSCollection.hpp"
 #include "../Share/fmtlib.h"
+#include "../Share/BinLogger.hpp"
 
 #include <memory>
 #include <sstream>
@@ -33,6 +34,18 @@ USING_NS_WTP;
 
 #define MAX_LOG_BUF_SIZE 2048
 
+/*
+ *	ӳٸʽ־
+ *	ÿõһ̬BinLogSite, ʽһʱǼ
+ *	ʺ顢ɽصȵ·ʹ, Ҫܱfmtʽ
+ */
+#define WTS_FAST_LOG_CAT(catName, ll, format, ...) do { \
+	static BinLogSite __wts_log_site((uint8_t)(ll), catName, format); \
+	WTSLogger::log_fast(__wts_log_site, ##__VA_ARGS__); \
+} while (false)
+
+#define WTS_FAST_LOG(ll, format, ...) WTS_FAST_LOG_CAT("", ll, format, ##__VA_ARGS__)
+
 
 class WTSLogger
 {
@@ -44,6 +57,7 @@ private:
 	static void fatal_imp(SpdLoggerPtr logger, const char* message);
 
 	static void initLogger(const char* catName, WTSVariant* cfgLogger);
+	static void initDeferred(WTSVariant* cfg);
 	static SpdLoggerPtr getLogger(const char* logger, const char* pattern = "");
 
 	static void print_message(const char* buffer);
@@ -186,6 +200,28 @@ public:
 		log_dyn_raw(patttern, catName, ll, m_buffer);
 	}
 
+	/*
+	 *	ӳٸʽ
+	 *	deferredõʱ, ֻ߳ѸʽźͲд뱾̵߳Ļ, ʽں̨߳
+	 *	ûõʱlog_by_catһֱӸʽ
+	 */
+	template<typename... Args>
+	static void log_fast(BinLogSite& site, const Args& ...args)
+	{
+		if (m_logLevel > site._level || m_bStopped)
+			return;
+
+		if (m_bDeferred && BinLogger::write(site, args...))
+			return;
+
+		fmtutil::format_to(m_buffer, site._format, args...);
+
+		if (site._category[0] == '\0')
+			log_raw((WTSLogLevel)site._level, m_buffer);
+		else
+			log_raw_by_cat(site._category, (WTSLogLevel)site._level, m_buffer);
+	}
+
 public:
 	static void init(const char* propFile = "logcfg.json", bool isFile = true, ILogHandler* handler = NULL);
 
@@ -199,6 +235,7 @@ private:
 	static bool					m_bInited;
 	static bool					m_bTpInited;
 	static bool					m_bStopped;
+	static bool					m_bDeferred;
 	static ILogHandler*			m_logHandler;
 	static WTSLogLevel			m_logLevel;
 
@@ -1,9 +1,11 @@
 #pragma once
 #include <stdint.h>
+#include <string.h>
 #include <string>
 #include <functional>
 #include <vector>
 #include <algorithm>
+#include <chrono>
 
 #if _WIN32
 #include <direct.h>
@@ -22,6 +24,12 @@ NS_WTP_BEGIN
 typedef std::vector<std::string> ValueArray;
 typedef std::function<void(const ValueArray&, const ValueArray&)> LMDBQueryCallback;
 
+/*
+ *	㿽ıص, keyvalֱָLMDBӳڴ, ֻڶڼЧ
+ *	falseֹͣ
+ */
+typedef std::function<bool(const MDB_val& key, const MDB_val& val)> LMDBVisitor;
+
 class WtLMDB
 {
 public:
@@ -203,20 +211,28 @@ public:
 		mKey.mv_data = key;
 		mKey.mv_size = klen;
 
-		_errno = mdb_cursor_get(cursor, &mKey, &mData, MDB_NEXT);
+		//ԭõMDB_NEXT, Դkeyֱӷصһ, ĳɾȷ
+		_errno = mdb_cursor_get(cursor, &mKey, &mData, MDB_SET_KEY);
 		_db.update_errno(_errno);
 		if (_errno != MDB_SUCCESS)
+		{
+			mdb_cursor_close(cursor);
 			return std::move(std::string());
+		}
 
 		auto ret = std::string((char*)mData.mv_data, mData.mv_size);
 		mdb_cursor_close(cursor);
 		return std::move(ret);
 	}
 
+	inline MDB_txn*	txn() const { return _txn; }
+	inline MDB_dbi	dbi() const { return _dbi; }
+
 	/*
-	 *	ȡ
+	 *	, lower_keyֱupper_key
+	 *	صõLMDBӳڴͼ, κο
 	 */
-	int get_range(const std::string& lower_key, const std::string& upper_key, LMDBQueryCallback cb)
+	int scan_range(const std::string& lower_key, const std::string& upper_key, LMDBVisitor visitor)
 	{
 		MDB_cursor* cursor;
 		int _errno = mdb_cursor_open(_txn, _dbi, &cursor);
@@ -224,49 +240,35 @@ public:
 		if (_errno != MDB_SUCCESS)
 			return 0;
 
-		MDB_val lKey, rKey, mData;
+		MDB_val lKey, mData;
 		lKey.mv_data = (void*)lower_key.data();
 		lKey.mv_size = lower_key.size();
 
-		rKey.mv_data = (void*)upper_key.data();
-		rKey.mv_size = upper_key.size();
-		
-		if (_errno != MDB_SUCCESS)
-			return 0;
-
 		int cnt = 0;
 		MDB_cursor_op op = MDB_SET_RANGE;
-		std::vector<std::string> ayKeys, ayVals;
-		for(; (_errno = mdb_cursor_get(cursor, &lKey, &mData, op))==MDB_SUCCESS;)
+		for (; (_errno = mdb_cursor_get(cursor, &lKey, &mData, op)) == MDB_SUCCESS;)
 		{
-			_db.update_errno(_errno);
-			if(_errno == MDB_NOTFOUND)
+			if (memcmp(lKey.mv_data, upper_key.data(), lKey.mv_size) > 0)
 				break;
 
-			if(memcmp(lKey.mv_data, rKey.mv_data, lKey.mv_size) > 0)
+			cnt++;
+			if (!visitor(lKey, mData))
 				break;
 
-			//ص
-			//cb(std::string((char*)lKey.mv_data, lKey.mv_size), std::string((char*)mData.mv_data, mData.mv_size), false);
-			ayKeys.emplace_back(std::string((char*)lKey.mv_data, lKey.mv_size));
-			ayVals.emplace_back(std::string((char*)mData.mv_data, mData.mv_size));
-			cnt++;
 			op = MDB_NEXT;
-		} 
+		}
 
-		cb(ayKeys, ayVals);
 		mdb_cursor_close(cursor);
 		return cnt;
 	}
 
 	/*
-	 *	ȡupper_key֮ǰݣupper_keyǰңҵԺһreverse
+	 *	upper_keyǰ, ص˳Ǵµ
 	 *	@lower_key	±߽磬ҪУΪԼһĻӵĻܻĺԼ
 	 *	@upper_key	ϱ߽
 	 *	@count		Ŀ
-	 *	@cb			ص
 	 */
-	int get_lowers(const std::string& lower_key, const std::string& upper_key, int count, LMDBQueryCallback cb)
+	int scan_lowers(const std::string& lower_key, const std::string& upper_key, int count, LMDBVisitor visitor)
 	{
 		MDB_cursor* cursor;
 		int _errno = mdb_cursor_open(_txn, _dbi, &cursor);
@@ -279,7 +281,6 @@ public:
 		rKey.mv_size = upper_key.size();
 
 		int cnt = 0;
-		std::vector<std::string> ayKeys, ayVals;
 		_errno = mdb_cursor_get(cursor, &rKey, &mData, MDB_SET_RANGE);
 		_db.update_errno(_errno);
 
@@ -289,7 +290,7 @@ public:
 			_db.update_errno(_errno);
 		}
 
-		for (; _errno != MDB_NOTFOUND;)
+		for (; _errno == MDB_SUCCESS;)
 		{
 			//ǰңõkeyұֱ߽ǰ˻һ
 			if (memcmp(rKey.mv_data, upper_key.data(), upper_key.size()) > 0)
@@ -302,38 +303,33 @@ public:
 			if (memcmp(rKey.mv_data, lower_key.data(), lower_key.size()) < 0)
 				break;
 
-			//ص
-			ayKeys.emplace_back(std::string((char*)rKey.mv_data, rKey.mv_size));
-			ayVals.emplace_back(std::string((char*)mData.mv_data, mData.mv_size));
 			cnt++;
+			if (!visitor(rKey, mData))
+				break;
 
 			//ҵĿ˳
-			if(cnt == count)
+			if (cnt == count)
 				break;
-			
+
 			_errno = mdb_cursor_get(cursor, &rKey, &mData, MDB_PREV);
 			_db.update_errno(_errno);
 		}
 
-		//ǰңģҪһreverse
-		std::reverse(ayKeys.begin(), ayKeys.end());
-		std::reverse(ayVals.begin(), ayVals.end());
-		cb(ayKeys, ayVals);
 		mdb_cursor_close(cursor);
 		return cnt;
 	}
 
 	/*
-	 *	ȡlower_key֮ݣlower_key
+	 *	lower_key
 	 *	@lower_key	±߽
 	 *	@upper_key	ϱ߽磬ҪУΪԼһĻӵĻܻĺԼ
 	 *	@count		Ŀ
-	 *	@cb			ص
 	 */
-	int get_uppers(const std::string& lower_key, const std::string& upper_key, int count, LMDBQueryCallback cb)
+	int scan_uppers(const std::string& lower_key, const std::string& upper_key, int count, LMDBVisitor visitor)
 	{
 		MDB_cursor* cursor;
 		int _errno = mdb_cursor_open(_txn, _dbi, &cursor);
+		_db.update_errno(_errno);
 		if (_errno != MDB_SUCCESS)
 			return 0;
 
@@ -342,18 +338,16 @@ public:
 		bKey.mv_size = lower_key.size();
 
 		int cnt = 0;
-		std::vector<std::string> ayKeys, ayVals;
 		_errno = mdb_cursor_get(cursor, &bKey, &mData, MDB_SET_RANGE);
 		_db.update_errno(_errno);
-		for (; _errno != MDB_NOTFOUND;)
+		for (; _errno == MDB_SUCCESS;)
 		{
 			if (memcmp(bKey.mv_data, upper_key.data(), upper_key.size()) > 0)
 				break;
 
-			//ص
-			ayKeys.emplace_back(std::string((char*)bKey.mv_data, bKey.mv_size));
-			ayVals.emplace_back(std::string((char*)mData.mv_data, mData.mv_size));
 			cnt++;
+			if (!visitor(bKey, mData))
+				break;
 
 			//ҵĿ˳
 			if (cnt == count)
@@ -363,28 +357,121 @@ public:
 			_db.update_errno(_errno);
 		}
 
-		cb(ayKeys, ayVals);
 		mdb_cursor_close(cursor);
 		return cnt;
 	}
 
-	inline int get_all(LMDBQueryCallback cb)
+	int scan_all(LMDBVisitor visitor)
 	{
 		MDB_cursor* cursor;
 		int _errno = mdb_cursor_open(_txn, _dbi, &cursor);
+		_db.update_errno(_errno);
 		if (_errno != MDB_SUCCESS)
 			return 0;
 
+		int cnt = 0;
 		MDB_val bKey, mData;
-		std::vector<std::string> ayKeys, ayVals;
-		for (; _errno != MDB_NOTFOUND;)
+		for (; (_errno = mdb_cursor_get(cursor, &bKey, &mData, MDB_NEXT)) == MDB_SUCCESS;)
 		{
-			_errno = mdb_cursor_get(cursor, &bKey, &mData, MDB_NEXT);
-			_db.update_errno(_errno);
-
-			ayKeys.emplace_back(std::string((const char*)bKey.mv_data, bKey.mv_size));
-			ayVals.emplace_back(std::string((const char*)mData.mv_data, mData.mv_size));
+			cnt++;
+			if (!visitor(bKey, mData))
+				break;
 		}
+
+		mdb_cursor_close(cursor);
+		return cnt;
+	}
+
+	/*
+	 *	ṹȡ, ֱ׷ӵ÷
+	 *	get_range, Ϊÿ¼std::string, ¼MDB_valֻһ
+	 *	itemsstd::vectorboost::circular_buffer, ȺԪͲһµļ¼ᱻ, ʵ׷ӵ
+	 */
+	template<typename Container>
+	int get_range_as(const std::string& lower_key, const std::string& upper_key, Container& items)
+	{
+		typedef typename Container::value_type T;
+		int cnt = 0;
+		scan_range(lower_key, upper_key, [&items, &cnt](const MDB_val& key, const MDB_val& val) {
+			if (val.mv_size != sizeof(T))
+				return true;
+
+			items.push_back(T());
+			memcpy(&items.back(), val.mv_data, sizeof(T));
+			cnt++;
+			return true;
+		});
+
+		return cnt;
+	}
+
+	/*
+	 *	ȡ
+	 */
+	int get_range(const std::string& lower_key, const std::string& upper_key, LMDBQueryCallback cb)
+	{
+		std::vector<std::string> ayKeys, ayVals;
+		int cnt = scan_range(lower_key, upper_key, [&ayKeys, &ayVals](const MDB_val& key, const MDB_val& val) {
+			ayKeys.emplace_back(std::string((char*)key.mv_data, key.mv_size));
+			ayVals.emplace_back(std::string((char*)val.mv_data, val.mv_size));
+			return true;
+		});
+
+		cb(ayKeys, ayVals);
+		return cnt;
+	}
+
+	/*
+	 *	ȡupper_key֮ǰݣupper_keyǰңҵԺһreverse
+	 *	@lower_key	±߽磬ҪУΪԼһĻӵĻܻĺԼ
+	 *	@upper_key	ϱ߽
+	 *	@count		Ŀ
+	 *	@cb			ص
+	 */
+	int get_lowers(const std::string& lower_key, const std::string& upper_key, int count, LMDBQueryCallback cb)
+	{
+		std::vector<std::string> ayKeys, ayVals;
+		int cnt = scan_lowers(lower_key, upper_key, count, [&ayKeys, &ayVals](const MDB_val& key, const MDB_val& val) {
+			ayKeys.emplace_back(std::string((char*)key.mv_data, key.mv_size));
+			ayVals.emplace_back(std::string((char*)val.mv_data, val.mv_size));
+			return true;
+		});
+
+		//ǰңģҪһreverse
+		std::reverse(ayKeys.begin(), ayKeys.end());
+		std::reverse(ayVals.begin(), ayVals.end());
+		cb(ayKeys, ayVals);
+		return cnt;
+	}
+
+	/*
+	 *	ȡlower_key֮ݣlower_key
+	 *	@lower_key	±߽
+	 *	@upper_key	ϱ߽磬ҪУΪԼһĻӵĻܻĺԼ
+	 *	@count		Ŀ
+	 *	@cb			ص
+	 */
+	int get_uppers(const std::string& lower_key, const std::string& upper_key, int count, LMDBQueryCallback cb)
+	{
+		std::vector<std::string> ayKeys, ayVals;
+		int cnt = scan_uppers(lower_key, upper_key, count, [&ayKeys, &ayVals](const MDB_val& key, const MDB_val& val) {
+			ayKeys.emplace_back(std::string((char*)key.mv_data, key.mv_size));
+			ayVals.emplace_back(std::string((char*)val.mv_data, val.mv_size));
+			return true;
+		});
+
+		cb(ayKeys, ayVals);
+		return cnt;
+	}
+
+	inline int get_all(LMDBQueryCallback cb)
+	{
+		std::vector<std::string> ayKeys, ayVals;
+		scan_all([&ayKeys, &ayVals](const MDB_val& key, const MDB_val& val) {
+			ayKeys.emplace_back(std::string((const char*)key.mv_data, key.mv_size));
+			ayVals.emplace_back(std::string((const char*)val.mv_data, val.mv_size));
+			return true;
+		});
 		cb(ayKeys, ayVals);
 		return (int)ayVals.size();
 	}
@@ -397,4 +484,219 @@ private:
 	bool		_commited;
 };
 
+/*
+ *	ʽα
+ *	key()value()ֱָLMDBӳڴ, ֻWtLMDBQueryڼЧ
+ *	÷:
+ *	for (bool ok = cursor.seek(lower); ok && cursor.key_le(upper); ok = cursor.next())
+ *		...
+ */
+class WtLMDBCursor
+{
+public:
+	WtLMDBCursor(WtLMDBQuery& query) : _cursor(NULL), _valid(false)
+	{
+		_key.mv_data = _val.mv_data = NULL;
+		_key.mv_size = _val.mv_size = 0;
+		if (mdb_cursor_open(query.txn(), query.dbi(), &_cursor) != MDB_SUCCESS)
+			_cursor = NULL;
+	}
+
+	~WtLMDBCursor()
+	{
+		if (_cursor != NULL)
+			mdb_cursor_close(_cursor);
+	}
+
+public:
+	/*
+	 *	λһСkeyļ¼
+	 */
+	inline bool seek(const void* key, std::size_t klen)
+	{
+		_key.mv_data = (void*)key;
+		_key.mv_size = klen;
+		return move(MDB_SET_RANGE);
+	}
+
+	inline bool seek(const std::string& key) { return seek(key.data(), key.size()); }
+
+	inline bool first() { return move(MDB_FIRST); }
+	inline bool last() { return move(MDB_LAST); }
+	inline bool next() { return move(MDB_NEXT); }
+	inline bool prev() { return move(MDB_PREV); }
+
+	inline bool valid() const { return _valid; }
+
+	inline const MDB_val& key() const { return _key; }
+	inline const MDB_val& value() const { return _val; }
+
+	/*
+	 *	ǰkeyǷ񲻴ڸı߽
+	 */
+	inline bool key_le(const void* bound, std::size_t blen) const
+	{
+		return _valid && memcmp(_key.mv_data, bound, (std::min)(_key.mv_size, blen)) <= 0;
+	}
+
+	inline bool key_le(const std::string& bound) const { return key_le(bound.data(), bound.size()); }
+
+	/*
+	 *	ѵǰֵṹ, Ȳһ·NULL
+	 *	LMDBֻ֤2ֽڶ, Ҫϸƽ̨Ӧÿ
+	 */
+	template<typename T>
+	inline const T* value_as() const
+	{
+		if (!_valid || _val.mv_size != sizeof(T))
+			return NULL;
+
+		return (const T*)_val.mv_data;
+	}
+
+private:
+	inline bool move(MDB_cursor_op op)
+	{
+		if (_cursor == NULL)
+			return _valid = false;
+
+		_valid = (mdb_cursor_get(_cursor, &_key, &_val, op) == MDB_SUCCESS);
+		return _valid;
+	}
+
+private:
+	MDB_cursor*	_cursor;
+	MDB_val		_key;
+	MDB_val		_val;
+	bool		_valid;
+};
+
+/*
+ *	ύ
+ *	¼Ȱ˳ݴڴ, ÷ֽݴʱʲôʱcommit
+ *	commitʱм¼һдύ, ͬһkeyдĸд, ύĽһ
+ *	LMDBдԭӵ, Ժһͣĳһı߽, ְ
+ *	һûύļ¼ᶪʧ, ʧķΧǵ÷õֵ
+ *	, ߳дҪ÷Լ
+ */
+class WtLMDBBatch
+{
+public:
+	WtLMDBBatch(WtLMDB& db) : _db(db), _count(0), _first_stamp(0) {}
+
+	~WtLMDBBatch()
+	{
+		commit();
+	}
+
+public:
+	void put(const void* key, std::size_t klen, const void* val, std::size_t vlen)
+	{
+		if (_count == 0)
+			_first_stamp = now();
+
+		//ÿ¼ĸʽΪ: klen|vlen|key|val
+		uint32_t lens[2] = { (uint32_t)klen, (uint32_t)vlen };
+		_buffer.append((const char*)lens, sizeof(lens));
+		_buffer.append((const char*)key, klen);
+		_buffer.append((const char*)val, vlen);
+		_count++;
+	}
+
+	inline void put(const std::string& key, const std::string& val)
+	{
+		put(key.data(), key.size(), val.data(), val.size());
+	}
+
+	inline uint32_t		count() const { return _count; }
+	inline std::size_t	bytes() const { return _buffer.size(); }
+	inline bool			empty() const { return _count == 0; }
+
+	/*
+	 *	һδύ¼ڵĺ
+	 */
+	inline uint64_t pending_millis() const
+	{
+		if (_count == 0)
+			return 0;
+
+		return now() - _first_stamp;
+	}
+
+	/*
+	 *	һдύȫݴļ¼
+	 *	ʧܵʱع, 屣, ύһλߵdiscard, ϢͨWtLMDB::errmsgȡ
+	 *	ύļ¼, ʧܷ-1
+	 */
+	int commit()
+	{
+		if (_count == 0)
+			return 0;
+
+		int ret = (int)_count;
+		{
+			WtLMDBQuery query(_db);
+			if (_db.has_error())
+			{
+				query.rollback();
+				ret = -1;
+			}
+			else
+			{
+				const char* p = _buffer.data();
+				const char* end = p + _buffer.size();
+				while (p < end)
+				{
+					uint32_t lens[2];
+					memcpy(lens, p, sizeof(lens));
+					uint32_t klen = lens[0];
+					uint32_t vlen = lens[1];
+					p += sizeof(lens);
+					if (!query.put((void*)p, klen, (void*)(p + klen), vlen))
+					{
+						query.rollback();
+						ret = -1;
+						break;
+					}
+					p += klen + vlen;
+				}
+
+				if (ret >= 0)
+				{
+					query.commit();
+					if (_db.has_error())
+						ret = -1;
+				}
+			}
+		}
+
+		if (ret >= 0)
+			discard();
+		return ret;
+	}
+
+	/*
+	 *	ȫݴļ¼
+	 */
+	inline void discard()
+	{
+		_buffer.clear();
+		_count = 0;
+		_first_stamp = 0;
+	}
+
+private:
+	static inline uint64_t now()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+private:
+	WtLMDB&		_db;
+	std::string	_buffer;
+	uint32_t	_count;
+	uint64_t	_first_stamp;
+};
+
 NS_WTP_END
@@ -0,0 +1,268 @@
+/*!
+ * \file BtDataCache.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/21
+ *
+ * \brief زʵֻݻ
+ *
+ * ѰŵʱͬһͬʱܺܶHisDataReplayerȡʷȫһ
+ * ÿݿֻһΣԺ󷢲棬طֱͬһڴ
+ * طԼαȻάֻݱ
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+#include "../Includes/WTSMarcos.h"
+#include "../Includes/FasterDefs.h"
+#include "../Share/StdUtils.hpp"
+
+USING_NS_WTP;
+
+/*
+ *	ü
+ *	ӿںstd::vectorһ£طĴ벻Ҫ޸
+ *	ݿԼ飬Ҳⲿݿ飨ӳ䵽ڴĻļ_holder֤
+ *	ıСĲresizeemplace_backswapݱⲿʱȸһ
+ *	ԪصĶдᴥƣݷԺֻܶԭ޸
+ */
+template<typename T>
+class SharedVector
+{
+public:
+	typedef std::vector<T>	DataArray;
+
+	SharedVector() :_owned(NULL), _ptr(NULL), _size(0) {}
+
+	inline std::size_t size() const { return _size; }
+	inline bool empty() const { return _size == 0; }
+
+	inline T* data() { return _ptr; }
+	inline const T* data() const { return _ptr; }
+
+	inline T& operator[](std::size_t idx) { return _ptr[idx]; }
+	inline const T& operator[](std::size_t idx) const { return _ptr[idx]; }
+
+	inline T* begin() { return _ptr; }
+	inline T* end() { return _ptr + _size; }
+	inline const T* begin() const { return _ptr; }
+	inline const T* end() const { return _ptr + _size; }
+
+	inline void resize(std::size_t count)
+	{
+		make_unique();
+		_owned->resize(count);
+		sync();
+	}
+
+	/*
+	 *	ֱӶԭݣԭ
+	 *	ԭܻõķʽǼ
+	 */
+	inline void clear()
+	{
+		_holder.reset();
+		_owned = NULL;
+		_ptr = NULL;
+		_size = 0;
+	}
+
+	template<typename... Args>
+	inline void emplace_back(Args&&... args)
+	{
+		make_unique();
+		_owned->emplace_back(std::forward<Args>(args)...);
+		sync();
+	}
+
+	inline void swap(DataArray& ay)
+	{
+		if (_owned == NULL || _holder.use_count() > 1)
+			reset_owned();
+		_owned->swap(ay);
+		sync();
+	}
+
+	/*
+	 *	ⲿݿ
+	 *	@holder	ݿĳ
+	 *	@data	ݵַ
+	 *	@count	
+	 *	@owned	holderе飬ⲿݿΪNULL
+	 */
+	inline void attach(const std::shared_ptr<void>& holder, T* data, std::size_t count, DataArray* owned = NULL)
+	{
+		_holder = holder;
+		_owned = owned;
+		_ptr = data;
+		_size = count;
+	}
+
+	inline const std::shared_ptr<void>& holder() const { return _holder; }
+	inline DataArray* owned() const { return _owned; }
+
+	inline bool is_shared() const { return _holder.use_count() > 1; }
+
+private:
+	inline void reset_owned()
+	{
+		std::shared_ptr<DataArray> ay(new DataArray);
+		_owned = ay.get();
+		_holder = ay;
+	}
+
+	inline void make_unique()
+	{
+		if (_owned != NULL && _holder.use_count() == 1)
+			return;
+
+		std::shared_ptr<DataArray> ay(new DataArray(_ptr, _ptr + _size));
+		_owned = ay.get();
+		_holder = ay;
+	}
+
+	inline void sync()
+	{
+		_ptr = _owned->data();
+		_size = _owned->size();
+	}
+
+private:
+	std::shared_ptr<void>	_holder;
+	DataArray*		_owned;
+	T*				_ptr;
+	std::size_t		_size;
+};
+
+class BtDataCache
+{
+public:
+	/*
+	 *	һkeyӦһ
+	 *	֮ǰסͬһͬʱֻһطڼأĵȴֱ
+	 */
+	class Entry
+	{
+		friend class BtDataCache;
+
+	public:
+		Entry(bool bPersist) :_persist(bPersist), _owned(NULL), _ptr(NULL), _count(0), _factor(1.0) {}
+
+		inline StdUniqueMutex& mutex() { return _mtx; }
+
+		/*
+		 *	Ѿ
+		 *	@data	Ŀ
+		 *	@factor	ȨӣK߲õõ
+		 *	falseʾûмع߷ǳפѾȫͷ
+		 */
+		template<typename T>
+		bool fetch(SharedVector<T>& data, double* factor = NULL)
+		{
+			std::shared_ptr<void> holder = _persist ? _data : _weak.lock();
+			if (holder == NULL)
+				return false;
+
+			//ԼڷԺ󱻸ĶͲ
+			typedef typename SharedVector<T>::DataArray DataArray;
+			DataArray* owned = (DataArray*)_owned;
+			if (owned != NULL && (owned->data() != _ptr || owned->size() != _count))
+				return false;
+
+			data.attach(holder, (T*)_ptr, _count, owned);
+			if (factor)
+				*factor = _factor;
+			return true;
+		}
+
+		/*
+		 *	غõ
+		 *	פݣKߣɻУǳפݣtickL2أֻ
+		 *	лط߹һԺ󣬷ǳפݾͻͷŵڴ治ز
+		 */
+		template<typename T>
+		void publish(const SharedVector<T>& data, double factor = 1.0)
+		{
+			if (_persist)
+				_data = data.holder();
+			else
+				_weak = data.holder();
+			_owned = data.owned();
+			_ptr = (void*)data.data();
+			_count = data.size();
+			_factor = factor;
+		}
+
+	private:
+		StdUniqueMutex			_mtx;
+		bool					_persist;
+		std::shared_ptr<void>	_data;
+		std::weak_ptr<void>		_weak;
+		void*					_owned;
+		void*					_ptr;
+		std::size_t				_count;
+		double					_factor;
+	};
+	typedef std::shared_ptr<Entry> EntryPtr;
+
+public:
+	BtDataCache() :_acquire_times(0){}
+
+	/*
+	 *	ȡ½
+	 *	@key		ݵļKΪ##tickΪ#ticks#ڡ
+	 *	@bPersist	Ƿפ
+	 */
+	EntryPtr acquire(const std::string& key, bool bPersist = true)
+	{
+		StdUniqueLock lock(_mtx);
+		_acquire_times++;
+		if (_acquire_times % PURGE_INTERVAL == 0)
+			purge();
+
+		EntryPtr& entry = _entries[key];
+		if (entry == NULL)
+			entry.reset(new Entry(bPersist));
+
+		return entry;
+	}
+
+	void clear()
+	{
+		StdUniqueLock lock(_mtx);
+		_entries.clear();
+	}
+
+	std::size_t size()
+	{
+		StdUniqueLock lock(_mtx);
+		return _entries.size();
+	}
+
+private:
+	//ֻûõġѾͷŵķǳפ
+	void purge()
+	{
+		for (auto it = _entries.begin(); it != _entries.end();)
+		{
+			const EntryPtr& entry = it->second;
+			if (!entry->_persist && entry.use_count() == 1 && entry->_weak.expired())
+				it = _entries.erase(it);
+			else
+				it++;
+		}
+	}
+
+private:
+	//ÿȡôΣһѾʧЧķǳפ
+	static const uint32_t PURGE_INTERVAL = 4096;
+
+private:
+	typedef wt_hashmap<std::string, EntryPtr> EntryMap;
+	EntryMap		_entries;
+	StdUniqueMutex	_mtx;
+	uint32_t		_acquire_times;
+};
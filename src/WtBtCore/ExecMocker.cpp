@@ -11,6 +11,7 @@
 #include "WtHelper.h"
 
 #include "../Includes/WTSVariant.hpp"
+#include "../Includes/WTSContractInfo.hpp"
 #include "../Share/TimeUtils.hpp"
 #include "../Share/decimal.h"
 #include "../WTSTools/WTSLogger.h"
@@ -134,6 +135,16 @@ void ExecMocker::handle_tick(const char* stdCode, WTSTickData* curTick, uint32_t
 		_exec_unit->on_tick(curTick);
 }
 
+void ExecMocker::handle_order_detail(const char* stdCode, WTSOrdDtlData* curOrdDtl)
+{
+	_matcher.handle_order_detail(stdCode, curOrdDtl);
+}
+
+void ExecMocker::handle_transaction(const char* stdCode, WTSTransData* curTrans)
+{
+	_matcher.handle_transaction(stdCode, curTrans);
+}
+
 void ExecMocker::handle_init()
 {
 	thread_local static char basePeriod[2] = { 0 };
@@ -148,6 +159,18 @@ void ExecMocker::handle_init()
 
 	_replayer->sub_tick(0, _code.c_str());
 
+	//ļ۸ݰС䶯λ
+	WTSCommodityInfo* commInfo = _replayer->get_commodity_info(_code.c_str());
+	if (commInfo)
+		_matcher.set_price_tick(_code.c_str(), commInfo->getPriceTick());
+
+	//L2ģʽҪίкʳɽ
+	if (_matcher.is_l2_mode())
+	{
+		_replayer->sub_order_detail(0, _code.c_str());
+		_replayer->sub_transaction(0, _code.c_str());
+	}
+
 	_trade_logs << "localid,signaltime,ordertime,bs,sigprice,ordprice,lmtprice,tradetime,trdprice,qty,sigtimespan,exectime,cancel" << std::endl;
 
 	_exec_unit->on_channel_ready();
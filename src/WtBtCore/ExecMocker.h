@@ -34,6 +34,8 @@ public:
 	//////////////////////////////////////////////////////////////////////////
 	//IDataSink
 	virtual void handle_tick(const char* stdCode, WTSTickData* curTick, uint32_t pxType) override;
+	virtual void handle_order_detail(const char* stdCode, WTSOrdDtlData* curOrdDtl) override;
+	virtual void handle_transaction(const char* stdCode, WTSTransData* curTrans) override;
 	virtual void handle_schedule(uint32_t uDate, uint32_t uTime) override;
 	virtual void handle_init() override;
 
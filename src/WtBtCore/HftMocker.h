@@ -168,6 +168,13 @@ public:
 	void	enable_hook(bool bEnabled = true);
 	void	step_tick();
 
+	/*
+	 *	زʽݣѰʱڻÿһĽ
+	 */
+	inline double	get_close_profit() const { return _fund_info._total_profit; }
+	inline double	get_dyn_profit() const { return _fund_info._total_dynprofit; }
+	inline double	get_fees() const { return _fund_info._total_fees; }
+
 private:
 	typedef std::function<void()> Task;
 	void	postTask(Task task);
@@ -0,0 +1,132 @@
+/*!
+ * \file HftReplayHeap.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/04
+ *
+ * \brief Ƶݶ·鲢طõС
+ *
+ * طʱÿһ·ݣĳԼtickίϸίжлɽϸǰʱ
+ * ǰÿطһݶҪжĵĺԼȷһݵʱ䣬ӶΪO(N)
+ * һСάÿһ·ݵα꣬ÿطһݵĸӶȽΪO(logN)
+ */
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <utility>
+
+/*
+ *	еĽڵ
+ *	Ϊʱ䡢ͬһ·ͬʱš͡
+ *	ԺǰɨĻط˳򱣳һ£
+ *	ͬһʱȰִΣÿһٰίϸɽϸtickίже˳ͬ͵ٰ˳
+ */
+typedef struct _HftReplayNode
+{
+	uint64_t	_time;		//һݵʱ䣬ʽΪyyyyMMddhhmmssmmm
+	uint32_t	_rank;		//ͬһ·Уͬʱ
+	uint32_t	_type;		//
+	uint32_t	_seq;		//
+	uint32_t	_stream;	//
+
+	_HftReplayNode(uint64_t t = 0, uint32_t tp = 0, uint32_t seq = 0, uint32_t stream = 0)
+		: _time(t), _rank(0), _type(tp), _seq(seq), _stream(stream) {}
+
+	inline bool operator < (const _HftReplayNode& b) const
+	{
+		if (_time != b._time)
+			return _time < b._time;
+
+		if (_rank != b._rank)
+			return _rank < b._rank;
+
+		if (_type != b._type)
+			return _type < b._type;
+
+		return _seq < b._seq;
+	}
+} HftReplayNode;
+
+class HftReplayHeap
+{
+public:
+	inline void reserve(std::size_t cnt) { _nodes.reserve(cnt); }
+
+	inline void clear() { _nodes.clear(); }
+
+	inline bool empty() const { return _nodes.empty(); }
+
+	inline std::size_t size() const { return _nodes.size(); }
+
+	inline const HftReplayNode& top() const { return _nodes.front(); }
+
+	inline void push(const HftReplayNode& node)
+	{
+		_nodes.emplace_back(node);
+		sift_up(_nodes.size() - 1);
+	}
+
+	inline void pop()
+	{
+		_nodes.front() = _nodes.back();
+		_nodes.pop_back();
+		if (!_nodes.empty())
+			sift_down(0);
+	}
+
+	/*
+	 *	ƽѶ
+	 *	طһԺһݵʱ¶Ѷµ
+	 *	poppushһε
+	 *
+	 *	@nextTime	һݵʱ
+	 */
+	inline void advance_top(uint64_t nextTime)
+	{
+		HftReplayNode& node = _nodes.front();
+		node._rank = (nextTime == node._time) ? (node._rank + 1) : 0;
+		node._time = nextTime;
+		sift_down(0);
+	}
+
+private:
+	inline void sift_up(std::size_t idx)
+	{
+		HftReplayNode node = _nodes[idx];
+		while (idx > 0)
+		{
+			std::size_t parent = (idx - 1) >> 1;
+			if (!(node < _nodes[parent]))
+				break;
+
+			_nodes[idx] = _nodes[parent];
+			idx = parent;
+		}
+		_nodes[idx] = node;
+	}
+
+	inline void sift_down(std::size_t idx)
+	{
+		std::size_t cnt = _nodes.size();
+		HftReplayNode node = _nodes[idx];
+		for (;;)
+		{
+			std::size_t child = 2 * idx + 1;
+			if (child >= cnt)
+				break;
+
+			if (child + 1 < cnt && _nodes[child + 1] < _nodes[child])
+				child++;
+
+			if (!(_nodes[child] < node))
+				break;
+
+			_nodes[idx] = _nodes[child];
+			idx = child;
+		}
+		_nodes[idx] = node;
+	}
+
+private:
+	std::vector<HftReplayNode>	_nodes;
+};
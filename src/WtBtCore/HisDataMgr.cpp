@@ -74,6 +74,14 @@ bool HisDataMgr::load_raw_ticks(const char* exchg, const char* code, uint32_t uD
 	return bSucc;
 }
 
+bool HisDataMgr::map_raw_ticks(const char* exchg, const char* code, uint32_t uDate, std::shared_ptr<void>& holder, WTSTickStruct*& ticks, std::size_t& count)
+{
+	if (_reader == NULL)
+		return false;
+
+	return _reader->map_raw_ticks(exchg, code, uDate, holder, ticks, count);
+}
+
 bool HisDataMgr::load_raw_trans(const char* exchg, const char* code, uint32_t uDate, FuncLoadDataCallback cb)
 {
 	if (_reader == NULL)
@@ -26,6 +26,11 @@ public:
 
 	bool	load_raw_ticks(const char* exchg, const char* code, uint32_t uDate, FuncLoadDataCallback cb);
 
+	/*
+	 *	ӳtickݣ洢ģ鲻ֻ֧ûпʱfalse
+	 */
+	bool	map_raw_ticks(const char* exchg, const char* code, uint32_t uDate, std::shared_ptr<void>& holder, WTSTickStruct*& ticks, std::size_t& count);
+
 	bool	load_raw_ordque(const char* exchg, const char* code, uint32_t uDate, FuncLoadDataCallback cb);
 
 	bool	load_raw_orddtl(const char* exchg, const char* code, uint32_t uDate, FuncLoadDataCallback cb);
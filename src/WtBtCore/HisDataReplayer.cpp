@@ -154,9 +154,12 @@ HisDataReplayer::HisDataReplayer()
 	, _begin_time(0)
 	, _end_time(0)
 	, _bt_loader(NULL)
+	, _shared_cache(NULL)
 	, _min_period("d")
 	, _cache_clear_days(0)
 	, _align_by_section(false)
+	, _sub_gen(0)
+	, _hft_sub_gen(0)
 {
 }
 
@@ -227,43 +230,7 @@ bool HisDataReplayer::init(WTSVariant* cfg, EventNotifier* notifier /* = NULL */
 
 	//ļ
 	WTSVariant* cfgBF = cfg->get("basefiles");
-	if (cfgBF->get("session"))
-		_bd_mgr.loadSessions(cfgBF->getCString("session"));
-
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for(uint32_t i = 0; i < cfgItem->size(); i ++)
-			{
-				_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	if (cfgBF->get("holiday"))
-		_bd_mgr.loadHolidays(cfgBF->getCString("holiday"));
+	_bd_mgr.loadBaseFiles(cfgBF);
 
 	if (cfgBF->get("hot"))
 		_hot_mgr.loadHots(cfgBF->getCString("hot"));
@@ -445,6 +412,7 @@ void HisDataReplayer::clear_cache()
 	_main_key = "";
 	_main_period = "";
 	_tick_sub_map.clear();
+	_sub_gen++;
 	_min_period = "";
 	_day_cache.clear();
 	_ticker_keys.clear();
@@ -498,6 +466,7 @@ void HisDataReplayer::reset()
 	_ordque_sub_map.clear();
 	_orddtl_sub_map.clear();
 	_trans_sub_map.clear();
+	_sub_gen++;
 
 	_price_map.clear();
 
@@ -1745,136 +1714,238 @@ uint64_t HisDataReplayer::getNextOrdQueTime(uint32_t curTDate, uint64_t stime /*
 	return nextTime;
 }
 
-uint64_t HisDataReplayer::replayHftDatasByDay(uint32_t curTDate)
+uint64_t HisDataReplayer::getNextStreamTime(const HftStream& stream)
 {
-	uint64_t total_ticks = 0;
-	for (;!_terminated;)
+	switch (stream._type)
 	{
-		//ȷһtickʱ
-		uint64_t nextTime = min(UINT64_MAX, getNextTickTime(curTDate));
-		nextTime = min(nextTime, getNextOrdDtlTime(curTDate));
-		nextTime = min(nextTime, getNextOrdQueTime(curTDate));
-		nextTime = min(nextTime, getNextTransTime(curTDate));
+	case HDT_OrdDtl:
+	{
+		auto& itemList = _orddtl_cache[stream._code];
+		if (itemList._cursor == UINT_MAX || itemList._cursor > itemList._count)
+			return UINT64_MAX;
 
-		if(nextTime == UINT64_MAX)
-			break;
+		const auto& nextItem = itemList._items[itemList._cursor - 1];
+		return (uint64_t)nextItem.action_date * 1000000000 + nextItem.action_time;
+	}
+	case HDT_Trans:
+	{
+		auto& itemList = _trans_cache[stream._code];
+		if (itemList._cursor == UINT_MAX || itemList._cursor > itemList._count)
+			return UINT64_MAX;
 
-		/*
-		 *	By Wesley @ 2022.03.06
-		 *	Ļط߼ĳ޸Ĺcursorٴص
-		 *	߼Ҳʵ
-		 */
+		const auto& nextItem = itemList._items[itemList._cursor - 1];
+		return (uint64_t)nextItem.action_date * 1000000000 + nextItem.action_time;
+	}
+	case HDT_Tick:
+	{
+		auto& tickList = _ticks_cache[stream._code];
+		if (tickList._cursor == UINT_MAX || tickList._cursor > tickList._count)
+			return UINT64_MAX;
 
-		//ٸʱطtick
-		_cur_date = (uint32_t)(nextTime / 1000000000);
-		_cur_time = nextTime % 1000000000 / 100000;
-		_cur_secs = nextTime % 100000;
+		const auto& nextTick = tickList._items[tickList._cursor - 1];
+		//ʱtickͲطˣμIssue#104
+		uint32_t nextMinTime = nextTick.action_time / 100000;
+		if (stream._sinfo->offsetTime(nextMinTime, false) > stream._sinfo->getCloseTime(true))
+			return UINT64_MAX;
 
-		//1Ȼطίϸ
-		for (auto& v : _orddtl_sub_map)
-		{
-			const char* stdCode = v.first.c_str();
-			auto& itemList = _orddtl_cache[stdCode];
-			//By Wesley @ 2022.03.06 
-			//һݵж
-			//Ϊգٽлط
-			if (itemList._items.empty() || itemList._cursor > itemList._count)
-				continue;
+		return (uint64_t)nextTick.action_date * 1000000000 + nextTick.action_time;
+	}
+	case HDT_OrdQue:
+	{
+		auto& itemList = _ordque_cache[stream._code];
+		if (itemList._cursor == UINT_MAX || itemList._cursor > itemList._count)
+			return UINT64_MAX;
 
-			auto& nextItem = itemList._items[itemList._cursor - 1];
-			uint64_t lastTime = (uint64_t)nextItem.action_date * 1000000000 + nextItem.action_time;
-			if (lastTime <= nextTime)
-			{
-				itemList._cursor++;
+		const auto& nextItem = itemList._items[itemList._cursor - 1];
+		return (uint64_t)nextItem.action_date * 1000000000 + nextItem.action_time;
+	}
+	default:
+		return UINT64_MAX;
+	}
+}
 
-				WTSOrdDtlData* newData = WTSOrdDtlData::create(nextItem);
-				newData->setCode(stdCode);
-				_listener->handle_order_detail(stdCode, newData);
-				newData->release();
+void HisDataReplayer::replayStreamItem(const HftStream& stream)
+{
+	/*
+	 *	By Wesley @ 2022.03.06
+	 *	ط߼޸Ĺcursorٴص
+	 *	߼Ҳʵ
+	 */
+	const char* stdCode = stream._code.c_str();
+	switch (stream._type)
+	{
+	case HDT_OrdDtl:
+	{
+		auto& itemList = _orddtl_cache[stream._code];
+		auto& nextItem = itemList._items[itemList._cursor - 1];
+		itemList._cursor++;
+
+		WTSOrdDtlData* newData = WTSOrdDtlData::create(nextItem);
+		newData->setCode(stdCode);
+		_listener->handle_order_detail(stdCode, newData);
+		newData->release();
+		break;
+	}
+	case HDT_Trans:
+	{
+		auto& itemList = _trans_cache[stream._code];
+		auto& nextItem = itemList._items[itemList._cursor - 1];
+		itemList._cursor++;
+
+		WTSTransData* newData = WTSTransData::create(nextItem);
+		newData->setCode(stdCode);
+		_listener->handle_transaction(stdCode, newData);
+		newData->release();
+		break;
+	}
+	case HDT_Tick:
+	{
+		auto& tickList = _ticks_cache[stream._code];
+		auto& nextTick = tickList._items[tickList._cursor - 1];
+		tickList._cursor++;
+
+		update_price(stdCode, nextTick.price);
+		WTSTickData* newTick = WTSTickData::create(nextTick);
+		newTick->setCode(stdCode);
+		_listener->handle_tick(stdCode, newTick, 0);
+		newTick->release();
+		break;
+	}
+	case HDT_OrdQue:
+	{
+		auto& itemList = _ordque_cache[stream._code];
+		auto& nextItem = itemList._items[itemList._cursor - 1];
+		itemList._cursor++;
+
+		WTSOrdQueData* newData = WTSOrdQueData::create(nextItem);
+		newData->setCode(stdCode);
+		_listener->handle_order_queue(stdCode, newData);
+		newData->release();
+		break;
+	}
+	default:
+		break;
+	}
+}
 
-				total_ticks++;
-			}
-		}
+void HisDataReplayer::buildHftHeap(uint32_t curTDate)
+{
+	_hft_streams.clear();
+	_hft_heap.clear();
+	_hft_sub_gen = _sub_gen;
+	std::size_t subCnt = _orddtl_sub_map.size() + _trans_sub_map.size() + _tick_sub_map.size() + _ordque_sub_map.size();
+	_hft_streams.reserve(subCnt);
+	_hft_heap.reserve(subCnt);
+
+	for (auto& v : _orddtl_sub_map)
+	{
+		const char* stdCode = v.first.c_str();
+		if (!checkOrderDetails(stdCode, curTDate))
+			continue;
 
-		//2ٻطųɽϸ
-		for (auto& v : _trans_sub_map)
-		{
-			const char* stdCode = v.first.c_str();
-			auto& itemList = _trans_cache[stdCode];
-			//By Wesley @ 2022.03.06 
-			//һݵж
-			//Ϊգٽлط
-			if (itemList._items.empty() || itemList._cursor > itemList._count)
-				continue;
+		auto& itemList = _orddtl_cache[stdCode];
+		if (itemList._cursor == UINT_MAX)
+			itemList._cursor = 1;
 
-			auto& nextItem = itemList._items[itemList._cursor - 1];
-			uint64_t lastTime = (uint64_t)nextItem.action_date * 1000000000 + nextItem.action_time;
-			if (lastTime <= nextTime)
-			{
-				itemList._cursor++;
+		_hft_streams.emplace_back(HftStream(v.first, HDT_OrdDtl));
+	}
 
-				WTSTransData* newData = WTSTransData::create(nextItem);
-				newData->setCode(stdCode);
-				_listener->handle_transaction(stdCode, newData);
-				newData->release();
-				
-				total_ticks++;
-			}
-		}
+	for (auto& v : _trans_sub_map)
+	{
+		const char* stdCode = v.first.c_str();
+		if (!checkTransactions(stdCode, curTDate))
+			continue;
 
-		//3ٻطtick
-		for (auto& v : _tick_sub_map)
-		{
-			//std::string stdCode = v.first;
-			const char* stdCode = v.first.c_str();
-			HftDataList<WTSTickStruct>& tickList = _ticks_cache[stdCode];
-			//By Wesley @ 2022.03.06 
-			//һݵж
-			//Ϊգٽлط
-			if(tickList._items.empty() || tickList._cursor > tickList._count)
-				continue;
+		auto& itemList = _trans_cache[stdCode];
+		if (itemList._cursor == UINT_MAX)
+			itemList._cursor = 1;
 
-			WTSTickStruct& nextTick = tickList._items[tickList._cursor - 1];
-			uint64_t lastTime = (uint64_t)nextTick.action_date * 1000000000 + nextTick.action_time;
-			if (lastTime <= nextTime)
-			{
-				tickList._cursor++;
+		_hft_streams.emplace_back(HftStream(v.first, HDT_Trans));
+	}
 
-				update_price(stdCode, nextTick.price);
-				WTSTickData* newTick = WTSTickData::create(nextTick);
-				newTick->setCode(stdCode);
-				_listener->handle_tick(stdCode, newTick, 0);
-				newTick->release();
-				
-				total_ticks++;
+	for (auto& v : _tick_sub_map)
+	{
+		const char* stdCode = v.first.c_str();
+		if (!checkTicks(stdCode, curTDate))
+			continue;
+
+		WTSSessionInfo* sInfo = get_session_info(stdCode, true);
+		auto& tickList = _ticks_cache[stdCode];
+		if (tickList._cursor == UINT_MAX)
+		{
+			//һλطţǽʱtick
+			for (tickList._cursor = 1; tickList._cursor <= tickList._count; tickList._cursor++)
+			{
+				uint32_t tickMin = tickList._items[tickList._cursor - 1].action_time / 100000;
+				if (sInfo->isInTradingTime(tickMin))
+					break;
 			}
 		}
-		
-		//4طίж
-		for (auto& v : _ordque_sub_map)
-		{
-			const char* stdCode = v.first.c_str();
-			auto& itemList = _ordque_cache[stdCode];
-			//By Wesley @ 2022.03.06 
-			//һݵж
-			//Ϊգٽлط
-			if (itemList._items.empty() || itemList._cursor > itemList._count)
-				continue;
 
-			auto& nextItem = itemList._items[itemList._cursor - 1];
-			uint64_t lastTime = (uint64_t)nextItem.action_date * 1000000000 + nextItem.action_time;
-			if (lastTime <= nextTime)
-			{
-				itemList._cursor++;
+		_hft_streams.emplace_back(HftStream(v.first, HDT_Tick, sInfo));
+	}
 
-				WTSOrdQueData* newData = WTSOrdQueData::create(nextItem);
-				newData->setCode(stdCode);
-				_listener->handle_order_queue(stdCode, newData);
-				newData->release();
-				
-				total_ticks++;
-			}
+	for (auto& v : _ordque_sub_map)
+	{
+		const char* stdCode = v.first.c_str();
+		if (!checkOrderQueues(stdCode, curTDate))
+			continue;
+
+		auto& itemList = _ordque_cache[stdCode];
+		if (itemList._cursor == UINT_MAX)
+			itemList._cursor = 1;
+
+		_hft_streams.emplace_back(HftStream(v.first, HDT_OrdQue));
+	}
+
+	for (uint32_t idx = 0; idx < _hft_streams.size(); idx++)
+	{
+		const HftStream& stream = _hft_streams[idx];
+		uint64_t nextTime = getNextStreamTime(stream);
+		if (nextTime == UINT64_MAX)
+			continue;
+
+		_hft_heap.push(HftReplayNode(nextTime, stream._type, idx, idx));
+	}
+}
+
+uint64_t HisDataReplayer::replayHftDatasByDay(uint32_t curTDate)
+{
+	/*
+	 *	ǰÿطһݣҪжĵݣҵһݵʱ䣬ٱһνлط
+	 *	ĵĺԼ϶ʱ缸ֻƱlevel2ݣ󲿷ʱ䶼˲һ
+	 *	ڸĳСѶж·鲢ÿݵĻطſΪO(logN)
+	 *	ͬһʱݣط˳ǰһ£HftReplayNode
+	 */
+	buildHftHeap(curTDate);
+
+	uint64_t total_ticks = 0;
+	while (!_terminated && !_hft_heap.empty())
+	{
+		const HftReplayNode& node = _hft_heap.top();
+		uint64_t nextTime = node._time;
+
+		_cur_date = (uint32_t)(nextTime / 1000000000);
+		_cur_time = nextTime % 1000000000 / 100000;
+		_cur_secs = nextTime % 100000;
+
+		//صпܻ޸_hft_streamsҪһ
+		HftStream stream = _hft_streams[node._stream];
+		replayStreamItem(stream);
+		total_ticks++;
+
+		//صµĶģҪ¹С
+		if (_sub_gen != _hft_sub_gen)
+		{
+			buildHftHeap(curTDate);
+			continue;
 		}
+
+		uint64_t newTime = getNextStreamTime(stream);
+		if (newTime == UINT64_MAX)
+			_hft_heap.pop();
+		else
+			_hft_heap.advance_top(newTime);
 	}
 
 	return total_ticks;
@@ -2166,6 +2237,33 @@ WTSKlineSlice* HisDataReplayer::get_kline_slice(const char* stdCode, const char*
 	auto it = _bars_cache.find(key);
 	bool bHasHisData = false;
 	bool bHasCache = (it != _bars_cache.end());
+
+	/*
+	 *	ûлĻȿûУоֱ
+	 *	ûеĻסػزԺٷȥͬһֻһ
+	 */
+	BtDataCache::EntryPtr sharedEntry;
+	StdUniqueLock sharedLock;
+	if (!bHasCache && _shared_cache != NULL)
+	{
+		sharedEntry = _shared_cache->acquire(key);
+		sharedLock = StdUniqueLock(sharedEntry->mutex());
+
+		BarsListPtr barsList(new BarsList());
+		if (sharedEntry->fetch(barsList->_bars, &barsList->_factor))
+		{
+			barsList->_code = stdCode;
+			barsList->_period = kp;
+			barsList->_times = realTimes;
+			barsList->_count = barsList->_bars.size();
+			_bars_cache[key] = barsList;
+			bHasCache = true;
+
+			sharedLock.unlock();
+			sharedEntry.reset();
+		}
+	}
+
 	if (!bHasCache)
 	{
 		if (realTimes != 1)
@@ -2275,6 +2373,13 @@ WTSKlineSlice* HisDataReplayer::get_kline_slice(const char* stdCode, const char*
 		return NULL;
 	}
 
+	if (sharedEntry)
+	{
+		sharedEntry->publish(kBlkPair->_bars, kBlkPair->_factor);
+		sharedLock.unlock();
+		sharedEntry.reset();
+	}
+
 	if (kBlkPair->_cursor == UINT_MAX)
 	{
 		//ûоʼλ
@@ -2638,6 +2743,28 @@ bool HisDataReplayer::checkAllTicks(uint32_t uDate)
 	return bHasTick;
 }
 
+template<typename T>
+bool HisDataReplayer::fetchSharedHftData(BtDataCache::EntryPtr& entry, StdUniqueLock& lock, HftDataList<T>& dataList, const char* dType, const char* stdCode, uint32_t uDate)
+{
+	if (_shared_cache == NULL)
+		return false;
+
+	entry = _shared_cache->acquire(StrUtil::printf("%s#%s#%u", stdCode, dType, uDate), false);
+	lock = StdUniqueLock(entry->mutex());
+	if (!entry->fetch(dataList._items))
+	{
+		//֮ǰݿܻطãֱӻһµ飬صʱȸһ
+		dataList._items.clear();
+		return false;
+	}
+
+	dataList._cursor = UINT_MAX;
+	dataList._code = stdCode;
+	dataList._date = uDate;
+	dataList._count = dataList._items.size();
+	return true;
+}
+
 bool HisDataReplayer::checkOrderDetails(const char* stdCode, uint32_t uDate)
 {
 	bool bNeedCache = false;
@@ -2654,6 +2781,11 @@ bool HisDataReplayer::checkOrderDetails(const char* stdCode, uint32_t uDate)
 
 	if (bNeedCache)
 	{
+		BtDataCache::EntryPtr sharedEntry;
+		StdUniqueLock sharedLock;
+		if (fetchSharedHftData(sharedEntry, sharedLock, _orddtl_cache[stdCode], "orddtl", stdCode, uDate))
+			return true;
+
 		bool hasData = false;
 		if (_mode == "csv")
 		{
@@ -2675,6 +2807,9 @@ bool HisDataReplayer::checkOrderDetails(const char* stdCode, uint32_t uDate)
 			dataList._count = 0;
 			return false;
 		}
+
+		if (sharedEntry)
+			sharedEntry->publish(_orddtl_cache[stdCode]._items);
 	}
 
 	return true;
@@ -2696,6 +2831,11 @@ bool HisDataReplayer::checkOrderQueues(const char* stdCode, uint32_t uDate)
 
 	if (bNeedCache)
 	{
+		BtDataCache::EntryPtr sharedEntry;
+		StdUniqueLock sharedLock;
+		if (fetchSharedHftData(sharedEntry, sharedLock, _ordque_cache[stdCode], "ordque", stdCode, uDate))
+			return true;
+
 		bool hasData = false;
 		if (_mode == "csv")
 		{
@@ -2717,6 +2857,9 @@ bool HisDataReplayer::checkOrderQueues(const char* stdCode, uint32_t uDate)
 			dataList._count = 0;
 			return false;
 		}
+
+		if (sharedEntry)
+			sharedEntry->publish(_ordque_cache[stdCode]._items);
 	}
 
 	return true;
@@ -2738,6 +2881,11 @@ bool HisDataReplayer::checkTransactions(const char* stdCode, uint32_t uDate)
 
 	if (bNeedCache)
 	{
+		BtDataCache::EntryPtr sharedEntry;
+		StdUniqueLock sharedLock;
+		if (fetchSharedHftData(sharedEntry, sharedLock, _trans_cache[stdCode], "trans", stdCode, uDate))
+			return true;
+
 		bool hasData = false;
 		if (_mode == "csv")
 		{
@@ -2759,6 +2907,9 @@ bool HisDataReplayer::checkTransactions(const char* stdCode, uint32_t uDate)
 			dataList._count = 0;
 			return false;
 		}
+
+		if (sharedEntry)
+			sharedEntry->publish(_trans_cache[stdCode]._items);
 	}
 
 	return true;
@@ -2787,6 +2938,11 @@ bool HisDataReplayer::checkTicks(const char* stdCode, uint32_t uDate)
 	
 	if (bNeedCache)
 	{
+		BtDataCache::EntryPtr sharedEntry;
+		StdUniqueLock sharedLock;
+		if (fetchSharedHftData(sharedEntry, sharedLock, _ticks_cache[stdCode], "ticks", stdCode, uDate))
+			return true;
+
 		bool hasTicks = false;
 		if (NULL != _bt_loader)
 		{
@@ -2811,6 +2967,9 @@ bool HisDataReplayer::checkTicks(const char* stdCode, uint32_t uDate)
 			ticksList._count = 0;
 			return false;
 		}
+
+		if (sharedEntry)
+			sharedEntry->publish(_ticks_cache[stdCode]._items);
 	}
 
 
@@ -3037,6 +3196,8 @@ void HisDataReplayer::sub_tick(uint32_t sid, const char* stdCode)
 
 	std::string hitCode(stdCode, length);
 	SubList& sids = _tick_sub_map[hitCode];
+	if (sids.empty())
+		_sub_gen++;
 	sids[sid] = std::make_pair(sid, flag);
 
 	if (_tick_enabled)
@@ -3060,6 +3221,8 @@ void HisDataReplayer::sub_order_detail(uint32_t sid, const char* stdCode)
 	}
 
 	SubList& sids = _orddtl_sub_map[std::string(stdCode, length)];
+	if (sids.empty())
+		_sub_gen++;
 	sids[sid] = std::make_pair(sid, flag);
 }
 
@@ -3078,6 +3241,8 @@ void HisDataReplayer::sub_order_queue(uint32_t sid, const char* stdCode)
 	}
 
 	SubList& sids = _ordque_sub_map[std::string(stdCode, length)];
+	if (sids.empty())
+		_sub_gen++;
 	sids[sid] = std::make_pair(sid, flag);
 }
 
@@ -3096,6 +3261,8 @@ void HisDataReplayer::sub_transaction(uint32_t sid, const char* stdCode)
 	}
 
 	SubList& sids = _trans_sub_map[std::string(stdCode, length)];
+	if (sids.empty())
+		_sub_gen++;
 	sids[sid] = std::make_pair(sid, flag);
 }
 
@@ -3208,45 +3375,6 @@ void HisDataReplayer::checkUnbars()
 	}
 }
 
-uint32_t strToTime(const char* strTime, bool bHasSec = false)
-{
-	std::string str;
-	const char *pos = strTime;
-	while (strlen(pos) > 0)
-	{
-		if (pos[0] != ':')
-		{
-			str.append(pos, 1);
-		}
-		pos++;
-	}
-
-	uint32_t ret = strtoul(str.c_str(), NULL, 10);
-	if (str.size() > 4 && !bHasSec)
-		ret /= 100;
-
-	return ret;
-}
-
-uint32_t strToDate(const char* strDate)
-{
-	StringVector ay = StrUtil::split(strDate, "/");
-	if(ay.size() == 1)
-		ay = StrUtil::split(strDate, "-");
-	std::stringstream ss;
-	if (ay.size() > 1)
-	{
-		auto pos = ay[2].find(" ");
-		if (pos != std::string::npos)
-			ay[2] = ay[2].substr(0, pos);
-		ss << ay[0] << (ay[1].size() == 1 ? "0" : "") << ay[1] << (ay[2].size() == 1 ? "0" : "") << ay[2];
-	}
-	else
-		ss << ay[0];
-
-	return strtoul(ss.str().c_str(), NULL, 10);
-}
-
 bool HisDataReplayer::cacheRawTicksFromBin(const std::string& key, const char* stdCode, uint32_t uDate)
 {
 	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, &_hot_mgr);
@@ -3259,6 +3387,35 @@ bool HisDataReplayer::cacheRawTicksFromBin(const std::string& key, const char* s
 	}
 
 
+	/*
+	 *	洢ģ鿪tickĻֱӳѹõĻļҪٽѹ͸
+	 */
+	{
+		std::shared_ptr<void> holder;
+		WTSTickStruct* ticks = NULL;
+		std::size_t tickcnt = 0;
+		bool bMapped = false;
+		if (strlen(cInfo._ruletag) > 0)
+		{
+			std::string wrappCode = StrUtil::printf("%s_%s", cInfo._product, cInfo._ruletag);
+			bMapped = _his_dt_mgr.map_raw_ticks(cInfo._exchg, wrappCode.c_str(), uDate, holder, ticks, tickcnt);
+		}
+
+		if (!bMapped)
+			bMapped = _his_dt_mgr.map_raw_ticks(cInfo._exchg, rawCode.c_str(), uDate, holder, ticks, tickcnt);
+
+		if (bMapped)
+		{
+			auto& ticksList = _ticks_cache[key];
+			ticksList._items.attach(holder, ticks, tickcnt);
+			ticksList._cursor = UINT_MAX;
+			ticksList._code = stdCode;
+			ticksList._date = uDate;
+			ticksList._count = tickcnt;
+			return true;
+		}
+	}
+
 	std::string content;
 	bool bHit = false;
 	//ȼûHOTSNDtickļ
@@ -3775,10 +3932,7 @@ bool HisDataReplayer::cacheRawBarsFromCSV(const std::string& key, const char* st
 			return false;
 		}
 
-		CsvReader reader;
-		reader.load_from_file(csvfile.c_str());
-
-		WTSLogger::info("Reading data from {}, with fields: {}...", csvfile, reader.fields());
+		WTSLogger::info("Reading data from {}...", csvfile);
 
 		if (bSubbed)
 			_bars_cache[key].reset(new BarsList);
@@ -3788,30 +3942,25 @@ bool HisDataReplayer::cacheRawBarsFromCSV(const std::string& key, const char* st
 		BarsListPtr& barsList = bSubbed ? _bars_cache[key] : _unbars_cache[key];
 		barsList->_code = stdCode;
 		barsList->_period = period;
-		while (reader.next_row())
+
+		/*
+		 *	ĳڴӳCsvBarLoaderȡ, ԭgetlineٲַ̫
+		 */
+		std::vector<WTSBarStruct> bars;
+		CsvBarLoader::load_bars(csvfile.c_str(), isDay, bars, [](std::size_t cnt) {
+			WTSLogger::info("{} lines of data loaded", cnt);
+		});
+		barsList->_bars.swap(bars);
+		barsList->_count = barsList->_bars.size();
+		if (barsList->_count == 0)
 		{
-			//жȡ
-			WTSBarStruct bs;
-			bs.date = strToDate(reader.get_string("date"));
-			if (period != KP_DAY)
-				bs.time = TimeUtils::timeToMinBar(bs.date, strToTime(reader.get_string("time")));
-			bs.open = reader.get_double("open");
-			bs.high = reader.get_double("high");
-			bs.low = reader.get_double("low");
-			bs.close = reader.get_double("close");
-			bs.vol = reader.get_double("volume");
-			bs.money = reader.get_double("turnover");
-			bs.hold = reader.get_double("open_interest");
-			bs.add = reader.get_double("diff_interest");
-			bs.settle = reader.get_double("settle");
-			barsList->_bars.emplace_back(bs);
-
-			if (barsList->_bars.size() % 1000 == 0)
-			{
-				WTSLogger::info("{} lines of data loaded", barsList->_bars.size());
-			}
+			WTSLogger::error("No data loaded from {}", csvfile);
+			if (bSubbed)
+				_bars_cache.erase(key);
+			else
+				_unbars_cache.erase(key);
+			return false;
 		}
-		barsList->_count = barsList->_bars.size();
 
 		uint64_t stime = isDay ? barsList->_bars[0].date : barsList->_bars[0].time;
 		uint64_t etime = isDay ? barsList->_bars[barsList->_count - 1].date : barsList->_bars[barsList->_count - 1].time;
@@ -4142,7 +4291,7 @@ bool HisDataReplayer::cacheIntegratedFutBarsFromBin(void* codeInfo, const std::s
 
 const HisDataReplayer::AdjFactorList& HisDataReplayer::getAdjFactors(const char* code, const char* exchg, const char* pid /* = "" */)
 {
-	static char key[20] = { 0 };
+	thread_local static char key[20] = { 0 };
 	fmtutil::format_to(key, "{}.{}.{}", exchg, pid, code);
 
 	auto it = _adj_factors.find(key);
@@ -11,6 +11,8 @@
 #include <string>
 #include <set>
 #include "HisDataMgr.h"
+#include "HftReplayHeap.hpp"
+#include "BtDataCache.hpp"
 #include "../WtDataStorage/DataDefine.h"
 
 #include "../Includes/FasterDefs.h"
@@ -168,7 +170,7 @@ private:
 		std::size_t		_cursor;
 		std::size_t		_count;
 
-		std::vector<T> _items;
+		SharedVector<T> _items;
 
 		HftDataList() :_cursor(UINT_MAX), _count(0), _date(0){}
 	};
@@ -178,6 +180,32 @@ private:
 	typedef wt_hashmap<std::string, HftDataList<WTSOrdQueStruct>>	OrdQueCache;
 	typedef wt_hashmap<std::string, HftDataList<WTSTransStruct>>	TransCache;
 
+	/*
+	 *	Ƶͣͬһʱݣ˳ط
+	 */
+	typedef enum tagHftDataType
+	{
+		HDT_OrdDtl = 0,	//ίϸ
+		HDT_Trans,		//ɽϸ
+		HDT_Tick,		//tick
+		HDT_OrdQue		//ίж
+	} HftDataType;
+
+	/*
+	 *	ƵһԼһݾһ
+	 *	α꣬α껹HftDataList
+	 *	Ϊصпܻµݣĵַܻ䣬ֻ
+	 */
+	typedef struct _HftStream
+	{
+		std::string		_code;
+		HftDataType		_type;
+		WTSSessionInfo*	_sinfo;	//ֻtickõ
+
+		_HftStream(const std::string& code, HftDataType dType, WTSSessionInfo* sInfo = NULL)
+			: _code(code), _type(dType), _sinfo(sInfo){}
+	} HftStream;
+
 
 	typedef struct _BarsList
 	{
@@ -192,7 +220,7 @@ private:
 		uint32_t		_count;
 		uint32_t		_times;
 
-		std::vector<WTSBarStruct>	_bars;
+		SharedVector<WTSBarStruct>	_bars;
 		double			_factor;	//һȨ
 
 		uint32_t		_untouch_days;	//δõ
@@ -320,12 +348,35 @@ private:
 
 	uint64_t	replayHftDatasByDay(uint32_t curTDate);
 
+	/*
+	 *	ƵݻطŵС
+	 *	ÿտʼʱ򣬻߶ķ仯ʱ򹹽
+	 */
+	void		buildHftHeap(uint32_t curTDate);
+
+	/*
+	 *	ȡһݵʱ䣬ѾطˣUINT64_MAX
+	 */
+	inline uint64_t	getNextStreamTime(const HftStream& stream);
+
+	/*
+	 *	طһݣƽα
+	 */
+	inline void		replayStreamItem(const HftStream& stream);
+
 	void		simTickWithUnsubBars(uint64_t stime, uint64_t etime, uint32_t endTDate = 0, int pxType = 0);
 
 	void		simTicks(uint32_t uDate, uint32_t uTime, uint32_t endTDate = 0, int pxType = 0);
 
 	inline bool		checkTicks(const char* stdCode, uint32_t uDate);
 
+	/*
+	 *	ӹĳһĸƵ
+	 *	ʧʱentrylock״̬÷Ժͨentry
+	 */
+	template<typename T>
+	bool		fetchSharedHftData(BtDataCache::EntryPtr& entry, StdUniqueLock& lock, HftDataList<T>& dataList, const char* dType, const char* stdCode, uint32_t uDate);
+
 	inline bool		checkOrderDetails(const char* stdCode, uint32_t uDate);
 
 	inline bool		checkOrderQueues(const char* stdCode, uint32_t uDate);
@@ -403,6 +454,15 @@ public:
 		_tick_enabled = bEnabled;
 	}
 
+	/*
+	 *	ùݻ棬Ѱʱطͬһʷ
+	 *	ɵ÷УҪڻط
+	 */
+	inline void set_shared_cache(BtDataCache* cache)
+	{
+		_shared_cache = cache;
+	}
+
 	inline void register_sink(IDataSink* listener, const char* sinkName) 
 	{
 		_listener = listener; 
@@ -462,6 +522,7 @@ public:
 private:
 	IDataSink*		_listener;
 	IBtDataLoader*	_bt_loader;
+	BtDataCache*	_shared_cache;	//ݻ
 	std::string		_stra_name;
 
 	TickCache		_ticks_cache;	//tick
@@ -552,6 +613,12 @@ private:
 	StraSubMap		_orddtl_sub_map;	//orderdetailݶı
 	StraSubMap		_trans_sub_map;		//transactionݶı
 
+	//ƵݰطʱС
+	std::vector<HftStream>	_hft_streams;
+	HftReplayHeap			_hft_heap;
+	uint64_t				_sub_gen;		//ĵİ汾ţµĴ붩Ļ߶ıյʱ1
+	uint64_t				_hft_sub_gen;	//ʱĶİ汾ţڼ鶩Ƿ˱仯
+
 	//Ȩ
 	typedef struct _AdjFactor
 	{
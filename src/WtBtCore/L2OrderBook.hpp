@@ -0,0 +1,507 @@
+/*!
+ * \file L2OrderBook.hpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/26
+ *
+ * \brief ؽĶ, L2ģʽ
+ *
+ * ίкʳɽؽÿһίеĶ, ģⶩΪڵ뵽ӦλĶβ
+ * Ķⶩɽʱ, ˵ⶩѾŵ, ճɽⶩ
+ * ģⶩı佻Ķ, ģⶩгĳ
+ *
+ * ÿλһʽ˫, λС䶯λƽ, ڵӶط
+ * һڲstd::mapĽڵ, ݻطŵʱÿݵĴO(1)
+ */
+#pragma once
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "../Includes/WTSStruct.h"
+#include "../Includes/FasterDefs.h"
+#include "../Share/ObjectPool.hpp"
+
+USING_NS_WTP;
+
+class L2OrderBook
+{
+public:
+	typedef struct _L2Node
+	{
+		_L2Node*	_prev;
+		_L2Node*	_next;
+		int64_t		_px;		//Ժļ۸
+		uint64_t	_index;		//ίб, ģⶩΪ0
+		uint32_t	_localid;	//ض, ĶΪ0
+		double		_qty;		//ʣ
+		bool		_buy;
+
+		_L2Node() :_prev(NULL), _next(NULL), _px(0), _index(0), _localid(0), _qty(0), _buy(false) {}
+	} L2Node;
+
+	typedef struct _L2Level
+	{
+		L2Node*		_head;
+		L2Node*		_tail;
+		double		_qty;		//, ģⶩ
+		uint32_t	_mine;		//ģⶩĸ
+
+		_L2Level() :_head(NULL), _tail(NULL), _qty(0), _mine(0) {}
+	} L2Level;
+
+	typedef struct _L2Fill
+	{
+		uint32_t	_localid;
+		double		_qty;
+		double		_price;
+	} L2Fill;
+	typedef std::vector<L2Fill> L2Fills;
+
+private:
+	/*
+	 *	ߵļ۸, _levels[0]Ӧļ۸Ϊ_base_px
+	 *	_bestΪżλ±, ûйҵʱΪ-1
+	 */
+	typedef struct _L2Side
+	{
+		std::vector<L2Level>	_levels;
+		int64_t		_base_px;
+		int64_t		_best;
+		bool		_buy;
+
+		_L2Side(bool isBuy = false) :_base_px(0), _best(-1), _buy(isBuy) {}
+	} L2Side;
+
+	//۸ÿչʱ߸ļλ
+	static const int64_t LEVEL_MARGIN = 1024;
+
+public:
+	L2OrderBook() :_tick(0), _bids(true), _asks(false) {}
+
+	~L2OrderBook()
+	{
+		clear();
+	}
+
+	static inline int64_t to_px(double price)
+	{
+		return (int64_t)round(price * 10000.0);
+	}
+
+	static inline double from_px(int64_t px)
+	{
+		return px / 10000.0;
+	}
+
+	/*
+	 *	С䶯λ, Ҫڵһ֮ǰ
+	 *	ûõĻ0.01
+	 */
+	inline void set_price_tick(double priceTick)
+	{
+		_tick = to_px(priceTick);
+	}
+
+	void clear()
+	{
+		for (L2Side* side : { &_bids, &_asks })
+		{
+			for (L2Level& level : side->_levels)
+			{
+				L2Node* node = level._head;
+				while (node)
+				{
+					L2Node* next = node->_next;
+					_pool.destroy(node);
+					node = next;
+				}
+			}
+
+			side->_levels.clear();
+			side->_base_px = 0;
+			side->_best = -1;
+		}
+
+		_nodes.clear();
+		_virtuals.clear();
+	}
+
+	inline std::size_t order_count() const { return _nodes.size(); }
+
+	inline double best_bid() const { return best_price(_bids); }
+
+	inline double best_ask() const { return best_price(_asks); }
+
+	/*
+	 *	λϽ
+	 */
+	double level_qty(bool isBuy, double price) const
+	{
+		const L2Side& side = isBuy ? _bids : _asks;
+		int64_t idx = level_index(side, to_px(price));
+		if (idx < 0 || idx >= (int64_t)side._levels.size())
+			return 0;
+
+		return side._levels[idx]._qty;
+	}
+
+	/*
+	 *	ģⶩǰ滹жٽ
+	 */
+	double queue_ahead(uint32_t localid) const
+	{
+		auto it = _virtuals.find(localid);
+		if (it == _virtuals.end())
+			return 0;
+
+		double ret = 0;
+		for (const L2Node* node = it->second->_prev; node != NULL; node = node->_prev)
+			ret += node->_qty;
+		return ret;
+	}
+
+	/*
+	 *	ί
+	 *	м۵ֱӺͶַɽ, 붩, ĳɽֱҲίж
+	 *	ŵίûм۸, սʱż۹ҵ
+	 *	Ͻĳɾ͵ί, ίбżӦ
+	 */
+	void on_order_detail(const WTSOrdDtlStruct& ordDtl)
+	{
+		if (ordDtl.side != BDT_Buy && ordDtl.side != BDT_Sell)
+			return;
+
+		bool isBuy = (ordDtl.side == BDT_Buy);
+		double price = ordDtl.price;
+		switch (ordDtl.otype)
+		{
+		case ODT_Delete:
+			{
+				L2Node* node = find_node(ordDtl.index);
+				if (node)
+					reduce_node(node, (ordDtl.volume > 0) ? ordDtl.volume : node->_qty);
+			}
+			return;
+		case ODT_AnyPrice:
+			return;
+		case ODT_BestPrice:
+			//ûйҵʱֱӳ
+			if (price <= 0)
+				price = isBuy ? best_bid() : best_ask();
+			break;
+		default:
+			break;
+		}
+
+		if (price <= 0 || ordDtl.volume == 0)
+			return;
+
+		L2Node* node = _pool.construct();
+		node->_px = to_px(price);
+		node->_index = ordDtl.index;
+		node->_qty = ordDtl.volume;
+		node->_buy = isBuy;
+
+		L2Side& side = node->_buy ? _bids : _asks;
+		L2Level& level = append_node(side, node);
+		level._qty += node->_qty;
+		_nodes[node->_index] = node;
+	}
+
+	/*
+	 *	ʳɽ, 
+	 *	Ķɽʱ, ǰģⶩԼ۸ŵģⶩȰɽ
+	 */
+	void on_transaction(const WTSTransStruct& trans, L2Fills& fills)
+	{
+		L2Node* bidNode = find_node(trans.bidorder);
+		L2Node* askNode = find_node(trans.askorder);
+		if (askNode == bidNode)
+			askNode = NULL;
+
+		if (trans.ttype == TT_Cancel)
+		{
+			if (bidNode)
+				reduce_node(bidNode, trans.volume);
+			if (askNode)
+				reduce_node(askNode, trans.volume);
+			return;
+		}
+
+		//ȷ, ȷʱ, СȵĹҵ
+		L2Node* passive = NULL;
+		if (trans.side == BDT_Buy)
+			passive = askNode;
+		else if (trans.side == BDT_Sell)
+			passive = bidNode;
+		else if (bidNode && askNode)
+			passive = (bidNode->_index < askNode->_index) ? bidNode : askNode;
+		else
+			passive = bidNode ? bidNode : askNode;
+
+		if (passive)
+			fill_virtuals(passive, trans.volume, fills);
+
+		if (bidNode)
+			reduce_node(bidNode, trans.volume);
+		if (askNode)
+			reduce_node(askNode, trans.volume);
+	}
+
+	/*
+	 *	ģⶩ
+	 *	ܺͶַĹҵɽĲֱӳɽ, ʣµŵλĶβ
+	 */
+	void add_order(uint32_t localid, bool isBuy, double price, double qty, L2Fills& fills)
+	{
+		int64_t px = to_px(price);
+		double left = qty;
+
+		L2Side& other = isBuy ? _asks : _bids;
+		if (other._best >= 0)
+		{
+			int64_t step = isBuy ? 1 : -1;
+			for (int64_t idx = other._best; idx >= 0 && idx < (int64_t)other._levels.size() && left > 0; idx += step)
+			{
+				int64_t lvlPx = other._base_px + idx * tick();
+				if (isBuy ? (lvlPx > px) : (lvlPx < px))
+					break;
+
+				const L2Level& level = other._levels[idx];
+				if (level._qty <= 0)
+					continue;
+
+				double trdQty = std::min(level._qty, left);
+				fills.emplace_back(L2Fill{ localid, trdQty, from_px(lvlPx) });
+				left -= trdQty;
+			}
+		}
+
+		if (left <= 0)
+			return;
+
+		L2Node* node = _pool.construct();
+		node->_px = px;
+		node->_localid = localid;
+		node->_qty = left;
+		node->_buy = isBuy;
+
+		L2Level& level = append_node(isBuy ? _bids : _asks, node);
+		level._mine++;
+		_virtuals[localid] = node;
+	}
+
+	/*
+	 *	ɾģⶩ, ȫɽԺ
+	 */
+	void remove_order(uint32_t localid)
+	{
+		auto it = _virtuals.find(localid);
+		if (it == _virtuals.end())
+			return;
+
+		L2Node* node = it->second;
+		_virtuals.erase(it);
+
+		L2Side& side = node->_buy ? _bids : _asks;
+		L2Level& level = side._levels[level_index(side, node->_px)];
+		level._mine--;
+		unlink_node(side, node);
+		_pool.destroy(node);
+	}
+
+private:
+	inline int64_t tick() const { return (_tick > 0) ? _tick : 100; }
+
+	inline int64_t level_index(const L2Side& side, int64_t px) const
+	{
+		if (side._levels.empty())
+			return -1;
+
+		int64_t diff = px - side._base_px;
+		if (diff < 0)
+			return -1;
+
+		return diff / tick();
+	}
+
+	inline double best_price(const L2Side& side) const
+	{
+		if (side._best < 0)
+			return 0;
+
+		return from_px(side._base_px + side._best * tick());
+	}
+
+	inline L2Node* find_node(int64_t index)
+	{
+		if (index <= 0)
+			return NULL;
+
+		auto it = _nodes.find((uint64_t)index);
+		if (it == _nodes.end())
+			return NULL;
+
+		return it->second;
+	}
+
+	/*
+	 *	֤۸鷶Χ, ±
+	 *	Χʱչ, ǰչʱе±Ҫƽ
+	 */
+	int64_t ensure_level(L2Side& side, int64_t px)
+	{
+		int64_t t = tick();
+		if (side._levels.empty())
+		{
+			side._base_px = px - LEVEL_MARGIN * t;
+			side._levels.resize(LEVEL_MARGIN * 2 + 1);
+			return LEVEL_MARGIN;
+		}
+
+		if (px < side._base_px)
+		{
+			int64_t count = (side._base_px - px) / t + LEVEL_MARGIN;
+			side._levels.insert(side._levels.begin(), (std::size_t)count, L2Level());
+			side._base_px -= count * t;
+			if (side._best >= 0)
+				side._best += count;
+		}
+
+		int64_t idx = (px - side._base_px) / t;
+		if (idx >= (int64_t)side._levels.size())
+			side._levels.resize((std::size_t)(idx + LEVEL_MARGIN));
+
+		return idx;
+	}
+
+	L2Level& append_node(L2Side& side, L2Node* node)
+	{
+		int64_t idx = ensure_level(side, node->_px);
+		L2Level& level = side._levels[idx];
+		node->_prev = level._tail;
+		node->_next = NULL;
+		if (level._tail)
+			level._tail->_next = node;
+		else
+			level._head = node;
+		level._tail = node;
+
+		if (side._best < 0 || (side._buy ? (idx > side._best) : (idx < side._best)))
+			side._best = idx;
+
+		return level;
+	}
+
+	void unlink_node(L2Side& side, L2Node* node)
+	{
+		int64_t idx = level_index(side, node->_px);
+		L2Level& level = side._levels[idx];
+		if (node->_prev)
+			node->_prev->_next = node->_next;
+		else
+			level._head = node->_next;
+
+		if (node->_next)
+			node->_next->_prev = node->_prev;
+		else
+			level._tail = node->_prev;
+
+		node->_prev = NULL;
+		node->_next = NULL;
+
+		//żλ, Ʒһйҵļλ
+		if (level._head == NULL && idx == side._best)
+		{
+			int64_t step = side._buy ? -1 : 1;
+			int64_t cur = idx + step;
+			while (cur >= 0 && cur < (int64_t)side._levels.size() && side._levels[cur]._head == NULL)
+				cur += step;
+
+			side._best = (cur >= 0 && cur < (int64_t)side._levels.size()) ? cur : -1;
+		}
+	}
+
+	void reduce_node(L2Node* node, double qty)
+	{
+		L2Side& side = node->_buy ? _bids : _asks;
+		L2Level& level = side._levels[level_index(side, node->_px)];
+		double delta = std::min(qty, node->_qty);
+		node->_qty -= delta;
+		level._qty -= delta;
+		if (node->_qty > 0)
+			return;
+
+		_nodes.erase(node->_index);
+		unlink_node(side, node);
+		_pool.destroy(node);
+	}
+
+	/*
+	 *	Ķpassiveɽvolume, ʱȴģⶩ
+	 *	۸ŵģⶩȳɽ, Ȼͬһλpassiveǰ
+	 */
+	void fill_virtuals(L2Node* passive, double volume, L2Fills& fills)
+	{
+		if (_virtuals.empty())
+			return;
+
+		double left = volume;
+		L2Side& side = passive->_buy ? _bids : _asks;
+
+		static thread_local std::vector<L2Node*> to_fill;
+		to_fill.clear();
+		for (auto& v : _virtuals)
+		{
+			L2Node* node = v.second;
+			if (node->_buy == passive->_buy && (node->_buy ? (node->_px > passive->_px) : (node->_px < passive->_px)))
+				to_fill.emplace_back(node);
+		}
+
+		if (to_fill.size() > 1)
+		{
+			bool isBuy = passive->_buy;
+			std::sort(to_fill.begin(), to_fill.end(), [isBuy](const L2Node* a, const L2Node* b) {
+				return isBuy ? (a->_px > b->_px) : (a->_px < b->_px);
+			});
+		}
+
+		L2Level& level = side._levels[level_index(side, passive->_px)];
+		if (level._mine > 0)
+		{
+			for (L2Node* node = level._head; node != passive && node != NULL; node = node->_next)
+			{
+				if (node->_localid != 0)
+					to_fill.emplace_back(node);
+			}
+		}
+
+		for (L2Node* node : to_fill)
+		{
+			if (left <= 0)
+				break;
+
+			double trdQty = std::min(node->_qty, left);
+			fills.emplace_back(L2Fill{ node->_localid, trdQty, from_px(node->_px) });
+			left -= trdQty;
+			node->_qty -= trdQty;
+			if (node->_qty <= 0)
+				remove_order(node->_localid);
+		}
+	}
+
+private:
+	int64_t		_tick;
+	L2Side		_bids;
+	L2Side		_asks;
+
+	ObjectPool<L2Node>	_pool;
+
+	typedef wt_hashmap<uint64_t, L2Node*>	NodeMap;
+	NodeMap		_nodes;		//ίбŵڵ
+
+	typedef wt_hashmap<uint32_t, L2Node*>	VirtualMap;
+	VirtualMap	_virtuals;	//ضŵģⶩڵ
+};
@@ -10,6 +10,12 @@
 #define PRICE_DOUBLE_TO_INT_N(x) ((int32_t)((x)*10000.0 - 0.5))
 #define PRICE_DOUBLE_TO_INT(x) (((x)==DBL_MAX)?0:((x)>0?PRICE_DOUBLE_TO_INT_P(x):PRICE_DOUBLE_TO_INT_N(x)))
 
+//õļ۸, 64λ߼Ʒ, м۵DBL_MAXǰ
+#define PRICE_DOUBLE_TO_KEY(x) (((x)>=DBL_MAX)?INT64_MAX:(((x)<=-DBL_MAX)?INT64_MIN:(int64_t)round((x)*10000.0)))
+
+//۸ݵߵļλ
+#define LOB_HALF_WIDTH	256
+
 extern uint32_t makeLocalOrderID();
 
 void MatchEngine::init(WTSVariant* cfg)
@@ -18,170 +24,325 @@ void MatchEngine::init(WTSVariant* cfg)
 		return;
 
 	_cancelrate = cfg->getDouble("cancelrate");
+	_l2_mode = (strcmp(cfg->getCString("mode"), "l2") == 0);
+	if (_l2_mode)
+		WTSLogger::info("MatchEngine works in L2 mode, queue positions are tracked by order details and transactions");
 }
 
 void MatchEngine::clear()
 {
 	_orders.clear();
+	_code_orders.clear();
+
+	//ίбÿ춼¿ʼ, Ҫһ
+	for (auto& v : _l2_books)
+		v.second->clear();
+}
+
+L2OrderBook* MatchEngine::get_l2_book(const char* stdCode)
+{
+	L2OrderBookPtr& book = _l2_books[stdCode];
+	if (!book)
+	{
+		book.reset(new L2OrderBook());
+		auto it = _lmt_ord_books.find(stdCode);
+		if (it != _lmt_ord_books.end() && it->second._tick > 0)
+			book->set_price_tick(it->second._tick / 10000.0);
+	}
+
+	return book.get();
+}
+
+void MatchEngine::apply_l2_fills(OrderIDs& to_erase)
+{
+	for (const L2OrderBook::L2Fill& fill : _l2_fills)
+	{
+		auto it = _orders.find(fill._localid);
+		if (it == _orders.end())
+			continue;
+
+		OrderInfo& ordInfo = (OrderInfo&)it->second;
+		if (ordInfo._state != 1)
+			continue;
+
+		double qty = min(fill._qty, ordInfo._left);
+		if (decimal::eq(qty, 0.0))
+			continue;
+
+		_sink->handle_trade(fill._localid, ordInfo._code, ordInfo._buy, qty, ordInfo._price, fill._price, ordInfo._time);
+
+		ordInfo._traded += qty;
+		ordInfo._left -= qty;
+
+		_sink->handle_order(fill._localid, ordInfo._code, ordInfo._buy, ordInfo._left, fill._price, false, ordInfo._time);
+
+		if (ordInfo._left == 0)
+			to_erase.emplace_back(fill._localid);
+	}
+
+	_l2_fills.clear();
+}
+
+void MatchEngine::set_price_tick(const char* stdCode, double priceTick)
+{
+	LmtOrdBook& curBook = _lmt_ord_books[stdCode];
+	curBook._tick = max(PRICE_DOUBLE_TO_INT(priceTick), 1);
+	curBook.clear();
+
+	if (_l2_mode)
+		get_l2_book(stdCode)->set_price_tick(priceTick);
+}
+
+void MatchEngine::remove_order(uint32_t localid)
+{
+	auto it = _orders.find(localid);
+	if (it == _orders.end())
+		return;
+
+	const OrderInfo& ordInfo = it->second;
+	if (_l2_mode)
+	{
+		auto bit = _l2_books.find(ordInfo._code);
+		if (bit != _l2_books.end())
+			bit->second->remove_order(localid);
+	}
+
+	auto cit = _code_orders.find(ordInfo._code);
+	if (cit != _code_orders.end())
+	{
+		CodeOrders& codeOrders = (CodeOrders&)cit->second;
+		int64_t key = PRICE_DOUBLE_TO_KEY(ordInfo._limit);
+		if (ordInfo._buy)
+		{
+			auto range = codeOrders._buys.equal_range(key);
+			for (auto qit = range.first; qit != range.second; qit++)
+			{
+				if (qit->second == localid)
+				{
+					codeOrders._buys.erase(qit);
+					break;
+				}
+			}
+		}
+		else
+		{
+			auto range = codeOrders._sells.equal_range(key);
+			for (auto qit = range.first; qit != range.second; qit++)
+			{
+				if (qit->second == localid)
+				{
+					codeOrders._sells.erase(qit);
+					break;
+				}
+			}
+		}
+	}
+
+	_orders.erase(it);
 }
 
 void MatchEngine::fire_orders(const char* stdCode, OrderIDs& to_erase)
 {
-	for (auto& v : _orders)
+	auto cit = _code_orders.find(stdCode);
+	if (cit == _code_orders.end())
+		return;
+
+	CodeOrders& codeOrders = (CodeOrders&)cit->second;
+	if (codeOrders._pending.empty())
+		return;
+
+	//صܻµ, Ȼٴ
+	OrderIDs pending;
+	pending.swap(codeOrders._pending);
+	for (uint32_t localid : pending)
 	{
-		uint32_t localid = v.first;
-		OrderInfo& ordInfo = (OrderInfo&)v.second;
+		auto it = _orders.find(localid);
+		if (it == _orders.end())
+			continue;
 
+		OrderInfo& ordInfo = (OrderInfo&)it->second;
 		if (ordInfo._state == 0)	//Ҫ
 		{
 			_sink->handle_entrust(localid, stdCode, true, "", ordInfo._time);
 			_sink->handle_order(localid, stdCode, ordInfo._buy, ordInfo._left, ordInfo._limit, false, ordInfo._time);
 			ordInfo._state = 1;
+
+			//L2ģʽ¶ʱŵβ, ܺͶ̳ɽĲֱӳɽ
+			if (_l2_mode)
+			{
+				get_l2_book(stdCode)->add_order(localid, ordInfo._buy, ordInfo._limit, ordInfo._left, _l2_fills);
+				apply_l2_fills(to_erase);
+			}
 		}
 	}
 }
 
-void MatchEngine::match_orders(WTSTickData* curTick, OrderIDs& to_erase)
+bool MatchEngine::match_order(uint32_t localid, OrderInfo& ordInfo, WTSTickData* curTick, OrderIDs& to_erase)
 {
-	uint64_t curTime = (uint64_t)curTick->actiondate() * 1000000000 + curTick->actiontime();
-	uint64_t curUnixTime = TimeUtils::makeTime(curTick->actiondate(), curTick->actiontime());
+	double price;
+	double volume;
+
+	//Ͱնּ
+	if (ordInfo._positive)
+	{
+		price = ordInfo._buy ? curTick->askprice(0) : curTick->bidprice(0);
+		volume = ordInfo._buy ? curTick->askqty(0) : curTick->bidqty(0);
+	}
+	else
+	{
+		price = curTick->price();
+		volume = curTick->volume();
+	}
+
+	bool bCanTrade = ordInfo._buy ? decimal::le(price, ordInfo._limit) : decimal::ge(price, ordInfo._limit);
+	if (!bCanTrade)
+		return false;
 
-	for (auto& v : _orders)
+	//۸,ҪȿŶλ,۸񲻵˵Ѿȫ󵥳Ե
+	if (!ordInfo._positive && decimal::eq(price, ordInfo._limit))
 	{
-		uint32_t localid = v.first;
-		OrderInfo& ordInfo = (OrderInfo&)v.second;
+		double& quepos = ordInfo._queue;
 
-		if (ordInfo._state == 9)//Ҫ
+		//ɽСŶλ,ܳɽ
+		if (volume <= quepos)
+		{
+			quepos -= volume;
+			return false;
+		}
+		else if (quepos != 0)
 		{
-			_sink->handle_order(localid, ordInfo._code, ordInfo._buy, 0, ordInfo._limit, true, ordInfo._time);
-			ordInfo._state = 99;
+			//ɽŶλ,Գɽ
+			volume -= quepos;
+			quepos = 0;
+		}
+	}
+	else if (!ordInfo._positive)
+	{
+		volume = ordInfo._left;
+	}
+
+	double qty = min(volume, ordInfo._left);
+	if (decimal::eq(qty, 0.0))
+		qty = 1;
+
+	_sink->handle_trade(localid, ordInfo._code, ordInfo._buy, qty, ordInfo._price, price, ordInfo._time);
 
-			to_erase.emplace_back(localid);
+	ordInfo._traded += qty;
+	ordInfo._left -= qty;
 
-			WTSLogger::info("{}ѳ, ʣ: {}", localid, ordInfo._left*(ordInfo._buy ? 1 : -1));
-			ordInfo._left = 0;
+	_sink->handle_order(localid, ordInfo._code, ordInfo._buy, ordInfo._left, price, false, ordInfo._time);
+
+	if (ordInfo._left == 0)
+		to_erase.emplace_back(localid);
+
+	return true;
+}
+
+void MatchEngine::process_cancels(CodeOrders& codeOrders, OrderIDs& to_erase)
+{
+	if (codeOrders._canceling.empty())
+		return;
+
+	OrderIDs canceling;
+	canceling.swap(codeOrders._canceling);
+	for (uint32_t localid : canceling)
+	{
+		auto it = _orders.find(localid);
+		if (it == _orders.end())
 			continue;
-		}
 
-		if (ordInfo._state != 1 || curTick->volume() == 0)
+		OrderInfo& ordInfo = (OrderInfo&)it->second;
+		if (ordInfo._state != 9)//Ҫ
 			continue;
 
-		if (ordInfo._buy)
-		{
-			double price;
-			double volume;
+		_sink->handle_order(localid, ordInfo._code, ordInfo._buy, 0, ordInfo._limit, true, ordInfo._time);
+		ordInfo._state = 99;
 
-			//Ͱնּ
-			if (ordInfo._positive)
-			{
-				price = curTick->askprice(0);
-				volume = curTick->askqty(0);
-			}
-			else
-			{
-				price = curTick->price();
-				volume = curTick->volume();
-			}
+		to_erase.emplace_back(localid);
 
-			if (decimal::le(price, ordInfo._limit))
-			{
-				//۸,ҪȿŶλ,۸񲻵˵Ѿȫ󵥳Ե
-				if (!ordInfo._positive && decimal::eq(price, ordInfo._limit))
-				{
-					double& quepos = ordInfo._queue;
-
-					//ɽСŶλ,ܳɽ
-					if (volume <= quepos)
-					{
-						quepos -= volume;
-						continue;
-					}
-					else if (quepos != 0)
-					{
-						//ɽŶλ,Գɽ
-						volume -= quepos;
-						quepos = 0;
-					}
-				}
-				else if (!ordInfo._positive)
-				{
-					volume = ordInfo._left;
-				}
+		WTS_FAST_LOG(LL_INFO, "{}ѳ, ʣ: {}", localid, ordInfo._left*(ordInfo._buy ? 1 : -1));
+		ordInfo._left = 0;
+	}
+}
 
-				double qty = min(volume, ordInfo._left);
-				if (decimal::eq(qty, 0.0))
-					qty = 1;
+void MatchEngine::match_orders(const char* stdCode, WTSTickData* curTick, OrderIDs& to_erase)
+{
+	auto cit = _code_orders.find(stdCode);
+	if (cit == _code_orders.end())
+		return;
 
-				_sink->handle_trade(localid, ordInfo._code, ordInfo._buy, qty, ordInfo._price, price, ordInfo._time);
+	CodeOrders& codeOrders = (CodeOrders&)cit->second;
+	process_cancels(codeOrders, to_erase);
 
-				ordInfo._traded += qty;
-				ordInfo._left -= qty;
+	//L2ģʽ, ֻʹ
+	if (_l2_mode || curTick->volume() == 0)
+		return;
 
-				_sink->handle_order(localid, ordInfo._code, ordInfo._buy, ordInfo._left, price, false, ordInfo._time);
+	/*
+	 *	ּ۴, ¼۴
+	 *	ֻίм۲нϵ͵Ǹſܳɽ, ֮
+	 *	о, ߽һλ, match_orderжΪ׼
+	 *	صܻµ, ȰѺѡȡٴ
+	 */
+	OrderIDs candidates;
+	if (!codeOrders._buys.empty())
+	{
+		int64_t thresh = PRICE_DOUBLE_TO_KEY(min(curTick->askprice(0), curTick->price())) - 1;
+		for (auto& v : codeOrders._buys)
+		{
+			if (v.first < thresh)
+				break;
 
-				if (ordInfo._left == 0)
-					to_erase.emplace_back(localid);
-			}
+			candidates.emplace_back(v.second);
 		}
+	}
 
-		if (!ordInfo._buy)
+	if (!codeOrders._sells.empty())
+	{
+		int64_t thresh = PRICE_DOUBLE_TO_KEY(max(curTick->bidprice(0), curTick->price())) + 1;
+		for (auto& v : codeOrders._sells)
 		{
-			double price;
-			double volume;
+			if (v.first > thresh)
+				break;
 
-			//Ͱնּ
-			if (ordInfo._positive)
-			{
-				price = curTick->bidprice(0);
-				volume = curTick->bidqty(0);
-			}
-			else
-			{
-				price = curTick->price();
-				volume = curTick->volume();
-			}
+			candidates.emplace_back(v.second);
+		}
+	}
 
-			if (decimal::ge(price, ordInfo._limit))
-			{
-				//۸,ҪȿŶλ,۸񲻵˵Ѿȫ󵥳Ե
-				if (!ordInfo._positive && decimal::eq(price, ordInfo._limit))
-				{
-					double& quepos = ordInfo._queue;
-
-					//ɽСŶλ,ܳɽ
-					if (volume <= quepos)
-					{
-						quepos -= volume;
-						continue;
-					}
-					else if (quepos != 0)
-					{
-						//ɽŶλ,Գɽ
-						volume -= quepos;
-						quepos = 0;
-					}
-				}
-				else if (!ordInfo._positive)
-				{
-					volume = ordInfo._left;
-				}
+	for (uint32_t localid : candidates)
+	{
+		auto it = _orders.find(localid);
+		if (it == _orders.end())
+			continue;
 
-				double qty = min(volume, ordInfo._left);
-				if (decimal::eq(qty, 0.0))
-					qty = 1;
+		OrderInfo& ordInfo = (OrderInfo&)it->second;
+		if (ordInfo._state != 1)
+			continue;
 
-				_sink->handle_trade(localid, ordInfo._code, ordInfo._buy, qty, ordInfo._price, price, ordInfo._time);
-				ordInfo._traded += qty;
-				ordInfo._left -= qty;
+		match_order(localid, ordInfo, curTick, to_erase);
+	}
+}
 
-				_sink->handle_order(localid, ordInfo._code, ordInfo._buy, ordInfo._left, price, false, ordInfo._time);
+void MatchEngine::_LmtOrdBook::recentre(int32_t px)
+{
+	int32_t newBase = px - LOB_HALF_WIDTH * _tick;
+	std::vector<double> qtys(LOB_HALF_WIDTH * 2 + 1, 0.0);
+	for (std::size_t idx = 0; idx < _qtys.size(); idx++)
+	{
+		if (_qtys[idx] == 0)
+			continue;
 
-				if (ordInfo._left == 0)
-					to_erase.emplace_back(localid);
-			}
+		int32_t oldPx = _base_px + (int32_t)idx * _tick;
+		if (oldPx < newBase)
+			continue;
 
-		}
+		std::size_t newIdx = (std::size_t)((oldPx - newBase) / _tick);
+		if (newIdx < qtys.size())
+			qtys[newIdx] = _qtys[idx];
 	}
+
+	_qtys.swap(qtys);
+	_base_px = newBase;
 }
 
 void MatchEngine::update_lob(WTSTickData* curTick)
@@ -191,37 +352,68 @@ void MatchEngine::update_lob(WTSTickData* curTick)
 	curBook._ask_px = PRICE_DOUBLE_TO_INT(curTick->askprice(0));
 	curBook._bid_px = PRICE_DOUBLE_TO_INT(curTick->bidprice(0));
 
+	//ûС䶯λ, ڵλС۲
+	if (curBook._tick == 0)
+	{
+		int32_t tick = 0;
+		int32_t lastPx = 0;
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			int32_t px = PRICE_DOUBLE_TO_INT(curTick->bidprice(9 - i));
+			if (px == 0)
+				continue;
+			if (lastPx != 0 && px > lastPx && (tick == 0 || px - lastPx < tick))
+				tick = px - lastPx;
+			lastPx = px;
+		}
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			int32_t px = PRICE_DOUBLE_TO_INT(curTick->askprice(i));
+			if (px == 0)
+				continue;
+			if (lastPx != 0 && px > lastPx && (tick == 0 || px - lastPx < tick))
+				tick = px - lastPx;
+			lastPx = px;
+		}
+
+		if (tick == 0)
+			return;
+
+		curBook._tick = tick;
+	}
+
+	int32_t curPx = (int32_t)curBook._cur_px;
+	if (curPx == 0)
+		curPx = (curBook._ask_px != 0) ? (int32_t)curBook._ask_px : (int32_t)curBook._bid_px;
+	if (curPx == 0)
+		return;
+
+	//¼ĳ, ¶
+	if (curBook._qtys.empty() || abs(curPx - (curBook._base_px + LOB_HALF_WIDTH * curBook._tick)) > LOB_HALF_WIDTH * curBook._tick / 2)
+		curBook.recentre(curPx);
+
 	for (uint32_t i = 0; i < 10; i++)
 	{
 		if (PRICE_DOUBLE_TO_INT(curTick->askprice(i)) == 0 && PRICE_DOUBLE_TO_INT(curTick->bidprice(i)) == 0)
 			break;
 
-		uint32_t px = PRICE_DOUBLE_TO_INT(curTick->askprice(i));
-		if (px != 0)
-		{
-			double& volume = curBook._items[px];
-			volume = curTick->askqty(i);
-		}
+		int32_t px = PRICE_DOUBLE_TO_INT(curTick->askprice(i));
+		if (px != 0 && curBook.in_range(px))
+			curBook.qty_at(px) = curTick->askqty(i);
 
 		px = PRICE_DOUBLE_TO_INT(curTick->bidprice(i));
-		if (px != 0)
-		{
-			double& volume = curBook._items[px];
-			volume = curTick->askqty(i);
-		}
+		if (px != 0 && curBook.in_range(px))
+			curBook.qty_at(px) = curTick->bidqty(i);
 	}
 
 	//һһ֮ı۱ȫ
-	if (!curBook._items.empty())
+	if (curBook._bid_px != 0 && curBook._ask_px != 0)
 	{
-		auto sit = curBook._items.lower_bound(curBook._bid_px);
-		if (sit->first == curBook._bid_px)
-			sit++;
-
-		auto eit = curBook._items.lower_bound(curBook._ask_px);
-
-		if (sit->first <= eit->first)
-			curBook._items.erase(sit, eit);
+		for (int32_t px = (int32_t)curBook._bid_px + curBook._tick; px < (int32_t)curBook._ask_px; px += curBook._tick)
+		{
+			if (curBook.in_range(px))
+				curBook.qty_at(px) = 0;
+		}
 	}
 }
 
@@ -256,6 +448,10 @@ OrderIDs MatchEngine::buy(const char* stdCode, double price, double qty, uint64_
 
 	lastTick->release();
 
+	CodeOrders& codeOrders = _code_orders[stdCode];
+	codeOrders._buys.emplace(PRICE_DOUBLE_TO_KEY(price), localid);
+	codeOrders._pending.emplace_back(localid);
+
 	OrderIDs ret;
 	ret.emplace_back(localid);
 	return ret;
@@ -290,6 +486,10 @@ OrderIDs MatchEngine::sell(const char* stdCode, double price, double qty, uint64
 
 	lastTick->release();
 
+	CodeOrders& codeOrders = _code_orders[stdCode];
+	codeOrders._sells.emplace(PRICE_DOUBLE_TO_KEY(price), localid);
+	codeOrders._pending.emplace_back(localid);
+
 	OrderIDs ret;
 	ret.emplace_back(localid);
 	return ret;
@@ -298,27 +498,49 @@ OrderIDs MatchEngine::sell(const char* stdCode, double price, double qty, uint64
 OrderIDs MatchEngine::cancel(const char* stdCode, bool isBuy, double qty, FuncCancelCallback cb)
 {
 	OrderIDs ret;
-	for (auto& v : _orders)
+	auto cit = _code_orders.find(stdCode);
+	if (cit == _code_orders.end())
+		return ret;
+
+	CodeOrders& codeOrders = (CodeOrders&)cit->second;
+
+	//ɽԶĶʼ
+	OrderIDs ids;
+	if (isBuy)
+	{
+		for (auto it = codeOrders._buys.rbegin(); it != codeOrders._buys.rend(); it++)
+			ids.emplace_back(it->second);
+	}
+	else
 	{
-		OrderInfo& ordInfo = (OrderInfo&)v.second;
+		for (auto it = codeOrders._sells.rbegin(); it != codeOrders._sells.rend(); it++)
+			ids.emplace_back(it->second);
+	}
+
+	double left = qty;
+	for (uint32_t localid : ids)
+	{
+		auto it = _orders.find(localid);
+		if (it == _orders.end())
+			continue;
+
+		OrderInfo& ordInfo = (OrderInfo&)it->second;
 		if (ordInfo._state != 1)
 			continue;
 
-		double left = qty;
-		if (ordInfo._buy == isBuy)
-		{
-			uint32_t localid = v.first;
-			ret.emplace_back(localid);
-			ordInfo._state = 9;
-			cb(ordInfo._left*(ordInfo._buy ? 1 : -1));
+		ret.emplace_back(localid);
+		ordInfo._state = 9;
+		codeOrders._canceling.emplace_back(localid);
+		if (_l2_mode)
+			get_l2_book(stdCode)->remove_order(localid);
+		cb(ordInfo._left*(ordInfo._buy ? 1 : -1));
 
-			if (qty != 0)
-			{
-				if ((int32_t)left <= ordInfo._left)
-					break;
+		if (qty != 0)
+		{
+			if (left <= ordInfo._left)
+				break;
 
-				left -= ordInfo._left;
-			}
+			left -= ordInfo._left;
 		}
 	}
 
@@ -332,7 +554,15 @@ double MatchEngine::cancel(uint32_t localid)
 		return 0.0;
 
 	OrderInfo& ordInfo = (OrderInfo&)it->second;
-	ordInfo._state = 9;
+	if (ordInfo._state != 9)
+	{
+		ordInfo._state = 9;
+		_code_orders[ordInfo._code]._canceling.emplace_back(localid);
+
+		//L2ģʽ³ĶϴӶõ, ٲ
+		if (_l2_mode)
+			get_l2_book(ordInfo._code)->remove_order(localid);
+	}
 
 	return ordInfo._left*(ordInfo._buy ? 1 : -1);
 }
@@ -354,14 +584,10 @@ void MatchEngine::handle_tick(const char* stdCode, WTSTickData* curTick)
 	fire_orders(stdCode, to_erase);
 
 	//
-	match_orders(curTick, to_erase);
+	match_orders(stdCode, curTick, to_erase);
 
 	for (uint32_t localid : to_erase)
-	{
-		auto it = _orders.find(localid);
-		if (it != _orders.end())
-			_orders.erase(it);
-	}
+		remove_order(localid);
 }
 
 WTSTickData* MatchEngine::grab_last_tick(const char* stdCode)
@@ -370,4 +596,41 @@ WTSTickData* MatchEngine::grab_last_tick(const char* stdCode)
 		return NULL;
 
 	return (WTSTickData*)_tick_cache->grab(stdCode);
-}
\ No newline at end of file
+}
+void MatchEngine::handle_order_detail(const char* stdCode, WTSOrdDtlData* curOrdDtl)
+{
+	if (!_l2_mode || NULL == curOrdDtl)
+		return;
+
+	OrderIDs to_erase;
+	//ȼ, ģⶩίеǰ
+	fire_orders(stdCode, to_erase);
+
+	auto cit = _code_orders.find(stdCode);
+	if (cit != _code_orders.end())
+		process_cancels((CodeOrders&)cit->second, to_erase);
+
+	get_l2_book(stdCode)->on_order_detail(curOrdDtl->getOrdDtlStruct());
+
+	for (uint32_t localid : to_erase)
+		remove_order(localid);
+}
+
+void MatchEngine::handle_transaction(const char* stdCode, WTSTransData* curTrans)
+{
+	if (!_l2_mode || NULL == curTrans)
+		return;
+
+	OrderIDs to_erase;
+	fire_orders(stdCode, to_erase);
+
+	auto cit = _code_orders.find(stdCode);
+	if (cit != _code_orders.end())
+		process_cancels((CodeOrders&)cit->second, to_erase);
+
+	get_l2_book(stdCode)->on_transaction(curTrans->getTransStruct(), _l2_fills);
+	apply_l2_fills(to_erase);
+
+	for (uint32_t localid : to_erase)
+		remove_order(localid);
+}
@@ -8,9 +8,12 @@
 #include "../Includes/WTSMarcos.h"
 #include "../Includes/WTSCollection.hpp"
 #include "../Includes/FasterDefs.h"
+#include "L2OrderBook.hpp"
 
 NS_WTP_BEGIN
 class WTSTickData;
+class WTSOrdDtlData;
+class WTSTransData;
 class WTSVariant;
 NS_WTP_END
 
@@ -54,13 +57,13 @@ typedef std::function<void(double)> FuncCancelCallback;
 class MatchEngine
 {
 public:
-	MatchEngine() : _tick_cache(NULL),_cancelrate(0), _sink(NULL)
+	MatchEngine() : _tick_cache(NULL),_cancelrate(0), _sink(NULL), _l2_mode(false)
 	{
 
 	}
 private:
 	void	fire_orders(const char* stdCode, OrderIDs& to_erase);
-	void	match_orders(WTSTickData* curTick, OrderIDs& to_erase);
+	void	match_orders(const char* stdCode, WTSTickData* curTick, OrderIDs& to_erase);
 	void	update_lob(WTSTickData* curTick);
 
 	inline WTSTickData*	grab_last_tick(const char* stdCode);
@@ -72,8 +75,26 @@ public:
 
 	void	clear();
 
+	/*
+	 *	úԼС䶯λ, ڼ۸ݵ
+	 *	õĻ, ݵһtick̿ڼ۲
+	 */
+	void	set_price_tick(const char* stdCode, double priceTick);
+
 	void	handle_tick(const char* stdCode, WTSTickData* curTick);
 
+	/*
+	 *	ίкʳɽ, ֻL2ģʽ²Żᴦ
+	 */
+	void	handle_order_detail(const char* stdCode, WTSOrdDtlData* curOrdDtl);
+	void	handle_transaction(const char* stdCode, WTSTransData* curTrans);
+
+	/*
+	 *	ǷL2ģʽ
+	 *	L2ģʽ¸ؽ, ģⶩڶеʵλô, ÿչŶλ
+	 */
+	inline bool	is_l2_mode() const { return _l2_mode; }
+
 	OrderIDs	buy(const char* stdCode, double price, double qty, uint64_t curTime);
 	OrderIDs	sell(const char* stdCode, double price, double qty, uint64_t curTime);
 	double		cancel(uint32_t localid);
@@ -103,18 +124,53 @@ private:
 	typedef wt_hashmap<uint32_t, OrderInfo> Orders;
 	Orders	_orders;
 
-	typedef std::map<uint32_t, double>	LOBItems;
+	/*
+	 *	պԼͷ, ίм
+	 *	򵥰۸Ӹߵ, ۸ӵ͵, ͬ۸İµȺ
+	 *	ϵʱֻҪͷɨ赽ܳɽļ۸Ϊֹ, ٱȫ
+	 */
+	typedef std::multimap<int64_t, uint32_t, std::greater<int64_t>>	BuyQueue;
+	typedef std::multimap<int64_t, uint32_t>	SellQueue;
 
+	typedef struct _CodeOrders
+	{
+		BuyQueue	_buys;
+		SellQueue	_sells;
+		OrderIDs	_pending;	//Ķ
+		OrderIDs	_canceling;	//Ķ
+	} CodeOrders;
+	typedef wt_hashmap<std::string, CodeOrders> CodeOrdersMap;
+	CodeOrdersMap	_code_orders;
+
+	/*
+	 *	۸, С䶯λƽ, ¼Ϊ
+	 *	¼ƫĳһȵʱ¶
+	 */
 	typedef struct _LmtOrdBook
 	{
-		LOBItems	_items;
+		std::vector<double>	_qtys;
+		int32_t		_base_px;	//_qtys[0]Ӧļ۸
+		int32_t		_tick;		//ԺС䶯λ
 		uint32_t	_cur_px;
 		uint32_t	_ask_px;
 		uint32_t	_bid_px;
 
+		inline bool in_range(int32_t px) const
+		{
+			return !_qtys.empty() && px >= _base_px && (std::size_t)((px - _base_px) / _tick) < _qtys.size();
+		}
+
+		inline double& qty_at(int32_t px)
+		{
+			return _qtys[(px - _base_px) / _tick];
+		}
+
+		void	recentre(int32_t px);
+
 		void clear()
 		{
-			_items.clear();
+			_qtys.clear();
+			_base_px = 0;
 			_cur_px = 0;
 			_ask_px = 0;
 			_bid_px = 0;
@@ -122,6 +178,8 @@ private:
 
 		_LmtOrdBook()
 		{
+			_base_px = 0;
+			_tick = 0;
 			_cur_px = 0;
 			_ask_px = 0;
 			_bid_px = 0;
@@ -130,9 +188,37 @@ private:
 	typedef wt_hashmap<std::string, LmtOrdBook> LmtOrdBooks;
 	LmtOrdBooks	_lmt_ord_books;
 
+	typedef std::shared_ptr<L2OrderBook>	L2OrderBookPtr;
+	typedef wt_hashmap<std::string, L2OrderBookPtr> L2OrderBooks;
+	L2OrderBooks	_l2_books;
+	L2OrderBook::L2Fills	_l2_fills;
+
+	L2OrderBook*	get_l2_book(const char* stdCode);
+
+	/*
+	 *	L2ϳĳɽ
+	 */
+	void	apply_l2_fills(OrderIDs& to_erase);
+
+	/*
+	 *	Ķ
+	 */
+	void	process_cancels(CodeOrders& codeOrders, OrderIDs& to_erase);
+
+	/*
+	 *	յǰtickϵ, Ƿгɽ
+	 */
+	bool	match_order(uint32_t localid, OrderInfo& ordInfo, WTSTickData* curTick, OrderIDs& to_erase);
+
+	/*
+	 *	Ӷɾ
+	 */
+	void	remove_order(uint32_t localid);
+
 	IMatchSink*	_sink;
 
 	double			_cancelrate;
+	bool			_l2_mode;
 	WTSTickCache*	_tick_cache;
 };
 
@@ -0,0 +1,288 @@
+/*!
+ * \file ParamSweeper.cpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/21
+ *
+ * \brief
+ */
+#include "ParamSweeper.h"
+#include "HisDataReplayer.h"
+#include "CtaMocker.h"
+#include "HftMocker.h"
+#include "WtHelper.h"
+
+#include <sstream>
+#include <thread>
+
+#include "../Includes/WTSVariant.hpp"
+#include "../Share/StdUtils.hpp"
+#include "../Share/TimeUtils.hpp"
+#include "../Share/fmtlib.h"
+#include "../WTSTools/WTSLogger.h"
+
+/*
+ *	ǳһڵ㣬ָĳԱ
+ *	ӽڵֱãزֻģ̹߳û
+ */
+static WTSVariant* clone_object(WTSVariant* src, const char* skip1 = "", const char* skip2 = "")
+{
+	WTSVariant* ret = WTSVariant::createObject();
+	if (src == NULL)
+		return ret;
+
+	WTSVariant::MemberNames names = src->memberNames();
+	for (const std::string& name : names)
+	{
+		if (name == skip1 || name == skip2)
+			continue;
+
+		ret->append(name.c_str(), src->get(name), true);
+	}
+
+	return ret;
+}
+
+ParamSweeper::ParamSweeper()
+	: _cfg(NULL)
+	, _slippage(0)
+	, _worker_cnt(0)
+	, _point_cnt(0)
+	, _next_idx(0)
+{
+}
+
+ParamSweeper::~ParamSweeper()
+{
+	if (_cfg)
+		_cfg->release();
+}
+
+bool ParamSweeper::init(WTSVariant* cfg)
+{
+	if (cfg == NULL)
+		return false;
+
+	WTSVariant* cfgEnv = cfg->get("env");
+	WTSVariant* cfgSweep = cfg->get("sweep");
+	if (cfgEnv == NULL || cfgSweep == NULL || cfg->get("replayer") == NULL)
+	{
+		WTSLogger::error("Parameter sweeping requires env, replayer and sweep sections");
+		return false;
+	}
+
+	_mode = cfgEnv->getCString("mocker");
+	_slippage = cfgEnv->getInt32("slippage");
+	if (_mode != "cta" && _mode != "hft")
+	{
+		WTSLogger::error("Parameter sweeping only supports cta and hft mocker, {} is not supported", _mode);
+		return false;
+	}
+
+	if (cfg->get(_mode.c_str()) == NULL || cfg->get(_mode.c_str())->get("strategy") == NULL)
+	{
+		WTSLogger::error("Strategy configuration of {} mocker not found", _mode);
+		return false;
+	}
+
+	_axes.clear();
+	_point_cnt = 1;
+	WTSVariant* cfgGrid = cfgSweep->get("grid");
+	if (cfgGrid != NULL)
+	{
+		WTSVariant::MemberNames names = cfgGrid->memberNames();
+		for (const std::string& name : names)
+		{
+			WTSVariant* ayValues = cfgGrid->get(name);
+			if (ayValues == NULL || ayValues->type() != WTSVariant::VT_Array || ayValues->size() == 0)
+			{
+				WTSLogger::error("Values of sweeping parameter {} must be a non-empty array", name);
+				return false;
+			}
+
+			_axes.emplace_back(GridAxis(name, ayValues));
+			_point_cnt *= ayValues->size();
+		}
+	}
+
+	_worker_cnt = cfgSweep->getUInt32("workers");
+	if (_worker_cnt == 0)
+		_worker_cnt = std::thread::hardware_concurrency();
+	if (_worker_cnt == 0)
+		_worker_cnt = 1;
+	if (_worker_cnt > _point_cnt)
+		_worker_cnt = _point_cnt;
+
+	if (_cfg)
+		_cfg->release();
+	_cfg = cfg;
+	_cfg->retain();
+
+	WTSLogger::info("{} parameter points generated, sweeping with {} workers", _point_cnt, _worker_cnt);
+	return true;
+}
+
+WTSVariant* ParamSweeper::make_mocker_cfg(uint32_t idx, std::string& straId, std::string& desc)
+{
+	WTSVariant* cfgMocker = _cfg->get(_mode.c_str());
+	WTSVariant* cfgStra = cfgMocker->get("strategy");
+
+	WTSVariant* params = clone_object(cfgStra->get("params"));
+	//ջϽưŲÿȡֵ±꣬һ仯
+	uint32_t remain = idx;
+	std::vector<uint32_t> indice(_axes.size());
+	for (std::size_t i = _axes.size(); i > 0; i--)
+	{
+		const GridAxis& axis = _axes[i - 1];
+		indice[i - 1] = remain % axis.second->size();
+		remain /= axis.second->size();
+	}
+
+	desc.clear();
+	for (std::size_t i = 0; i < _axes.size(); i++)
+	{
+		const GridAxis& axis = _axes[i];
+		WTSVariant* val = axis.second->get(indice[i]);
+		//ѾеĻҪȥȻappendظ
+		if (params->has(axis.first.c_str()))
+		{
+			WTSVariant* newParams = clone_object(params, axis.first.c_str());
+			params->release();
+			params = newParams;
+		}
+		params->append(axis.first.c_str(), val, true);
+
+		if (!desc.empty())
+			desc += ";";
+		desc += fmtutil::format("{}={}", axis.first, val->asCString());
+	}
+
+	straId = fmtutil::format("{}_{}", cfgStra->getCString("id"), idx);
+
+	WTSVariant* newStra = clone_object(cfgStra, "id", "params");
+	newStra->append("id", straId.c_str());
+	newStra->append("params", params, false);
+
+	WTSVariant* ret = clone_object(cfgMocker, "strategy");
+	ret->append("strategy", newStra, false);
+	return ret;
+}
+
+void ParamSweeper::run_point(uint32_t idx)
+{
+	SweepResult& result = _results[idx];
+	result._index = idx;
+
+	WTSVariant* cfgMocker = make_mocker_cfg(idx, result._stra_id, result._params);
+
+	int64_t start = TimeUtils::getLocalTimeNow();
+
+	HisDataReplayer replayer;
+	replayer.set_shared_cache(&_data_cache);
+	if (!replayer.init(_cfg->get("replayer")))
+	{
+		WTSLogger::error("Initializing replayer of sweeping point {} failed", idx);
+		cfgMocker->release();
+		return;
+	}
+
+	if (_mode == "cta")
+	{
+		CtaMocker* mocker = new CtaMocker(&replayer, "cta", _slippage);
+		if (mocker->init_cta_factory(cfgMocker))
+		{
+			replayer.register_sink(mocker, result._stra_id.c_str());
+			if (replayer.prepare())
+			{
+				replayer.run(false);
+				result._close_profit = mocker->stra_get_fund_data(1);
+				result._dyn_profit = mocker->stra_get_fund_data(2);
+				result._fees = mocker->stra_get_fund_data(3);
+				result._finished = true;
+			}
+		}
+		delete mocker;
+	}
+	else
+	{
+		HftMocker* mocker = new HftMocker(&replayer, "hft");
+		if (mocker->init_hft_factory(cfgMocker))
+		{
+			replayer.register_sink(mocker, result._stra_id.c_str());
+			if (replayer.prepare())
+			{
+				replayer.run(false);
+				result._close_profit = mocker->get_close_profit();
+				result._dyn_profit = mocker->get_dyn_profit();
+				result._fees = mocker->get_fees();
+				result._finished = true;
+			}
+		}
+		delete mocker;
+	}
+
+	cfgMocker->release();
+	result._elapse = (uint64_t)(TimeUtils::getLocalTimeNow() - start);
+
+	WTSLogger::info("Sweeping point {}/{} [{}] done in {} ms, closeprofit: {}, dynprofit: {}, fees: {}",
+		idx + 1, _point_cnt, result._params, result._elapse, result._close_profit, result._dyn_profit, result._fees);
+}
+
+void ParamSweeper::run()
+{
+	if (_cfg == NULL || _point_cnt == 0)
+		return;
+
+	_results.clear();
+	_results.resize(_point_cnt);
+	_next_idx = 0;
+
+	//Ŀ¼Ƚã߳ͬʱ
+	WtHelper::getOutputDir();
+
+	int64_t start = TimeUtils::getLocalTimeNow();
+
+	std::vector<StdThreadPtr> workers;
+	for (uint32_t i = 0; i < _worker_cnt; i++)
+	{
+		workers.emplace_back(new StdThread([this]() {
+			for (;;)
+			{
+				uint32_t idx = _next_idx.fetch_add(1);
+				if (idx >= _point_cnt)
+					break;
+
+				run_point(idx);
+			}
+		}));
+	}
+
+	for (StdThreadPtr& worker : workers)
+		worker->join();
+
+	WTSLogger::info("All {} sweeping points done in {} ms, {} data blocks cached",
+		_point_cnt, TimeUtils::getLocalTimeNow() - start, _data_cache.size());
+
+	dump_results();
+	_data_cache.clear();
+}
+
+void ParamSweeper::dump_results()
+{
+	std::stringstream ss;
+	ss << "index,id,params,closeprofit,dynprofit,fee,total,finished,elapse" << std::endl;
+	for (const SweepResult& result : _results)
+	{
+		ss << result._index << "," << result._stra_id << "," << result._params << ","
+			<< result._close_profit << "," << result._dyn_profit << "," << result._fees << ","
+			<< result._close_profit + result._dyn_profit - result._fees << ","
+			<< (result._finished ? "true" : "false") << "," << result._elapse << std::endl;
+	}
+
+	std::string filename = WtHelper::getOutputDir();
+	filename += "sweep_results.csv";
+	std::string content = ss.str();
+	StdFile::write_file_content(filename.c_str(), (void*)content.c_str(), content.size());
+
+	WTSLogger::info("Sweeping results saved to {}", filename);
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file ParamSweeper.h
+ * \project	WonderTrader
+ *
+ * \date 2023/09/21
+ *
+ * \brief Ѱ
+ *
+ * ղɶԲÿһHisDataReplayerһmockerڹ̳߳ϲлز
+ * лطһBtDataCacheʷֻһ
+ * ÿĲIDΪԭID_šزԵĿ¼ܽsweep_results.csv
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include "BtDataCache.hpp"
+#include "../Includes/WTSMarcos.h"
+
+NS_WTP_BEGIN
+class WTSVariant;
+NS_WTP_END
+
+USING_NS_WTP;
+
+class ParamSweeper
+{
+public:
+	typedef struct _SweepResult
+	{
+		uint32_t	_index;
+		std::string	_stra_id;
+		std::string	_params;		//ʽdays=20;k1=0.1
+		bool		_finished;
+		double		_close_profit;
+		double		_dyn_profit;
+		double		_fees;
+		uint64_t	_elapse;		//ʱλ
+
+		_SweepResult() :_index(0), _finished(false), _close_profit(0), _dyn_profit(0), _fees(0), _elapse(0){}
+	} SweepResult;
+	typedef std::vector<SweepResult> SweepResults;
+
+public:
+	ParamSweeper();
+	~ParamSweeper();
+
+public:
+	/*
+	 *	ʼ
+	 *	@cfg	͵λزһãsweepڵ
+	 *			sweep:
+	 *				workers: 8		#߳0ΪCPU
+	 *				grid:			#ÿһȡֵбѿչ
+	 *					days: [20,30,40]
+	 *					k1: [0.1,0.2]
+	 */
+	bool	init(WTSVariant* cfg);
+
+	/*
+	 *	ȫ飬в鶼Ժŷ
+	 */
+	void	run();
+
+	inline const SweepResults& results() const { return _results; }
+
+	inline uint32_t	point_count() const { return _point_cnt; }
+
+private:
+	/*
+	 *	ɵidxӦmockerãصĶɵ÷ͷ
+	 */
+	WTSVariant*	make_mocker_cfg(uint32_t idx, std::string& straId, std::string& desc);
+
+	void	run_point(uint32_t idx);
+
+	void	dump_results();
+
+private:
+	WTSVariant*		_cfg;
+	std::string		_mode;
+	int32_t			_slippage;
+	uint32_t		_worker_cnt;
+
+	typedef std::pair<std::string, WTSVariant*>	GridAxis;
+	typedef std::vector<GridAxis>	GridAxes;
+	GridAxes		_axes;
+	uint32_t		_point_cnt;
+
+	BtDataCache		_data_cache;
+	SweepResults	_results;
+	std::atomic<uint32_t>	_next_idx;
+};
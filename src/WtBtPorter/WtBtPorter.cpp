@@ -114,6 +114,11 @@ void enable_tick(bool bEnabled /* = true */)
 void run_backtest(bool bNeedDump, bool bAsync)
 {
 	getRunner().run(bNeedDump, bAsync);
+}
+
+void run_param_sweep(const char* cfgfile, bool isFile)
+{
+	getRunner().sweep(cfgfile, isFile);
 }
 
 void stop_backtest()
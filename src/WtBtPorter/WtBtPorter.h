@@ -50,6 +50,8 @@ extern "C"
 	EXPORT_FLAG	CtxHandler	init_sel_mocker(const char* name, WtUInt32 date, WtUInt32 time, const char* period, const char* trdtpl = "CHINA", const char* session = "TRADING", int slippage = 0, bool bRatioSlp = false);
 
 	EXPORT_FLAG	void		run_backtest(bool bNeedDump, bool bAsync);
+
+	EXPORT_FLAG	void		run_param_sweep(const char* cfgfile, bool isFile);
 
 	EXPORT_FLAG	void		write_log(WtUInt32 level, const char* message, const char* catName);
 
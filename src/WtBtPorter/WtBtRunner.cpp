@@ -16,6 +16,7 @@
 
 #include "../WtBtCore/ExecMocker.h"
 #include "../WtBtCore/WtHelper.h"
+#include "../WtBtCore/ParamSweeper.h"
 
 #include "../Share/TimeUtils.hpp"
 #include "../Share/ModuleHelper.hpp"
@@ -453,6 +454,22 @@ void WtBtRunner::init(const char* logProfile /* = "" */, bool isFile /* = true *
 	WtHelper::setOutputDir(outDir);
 }
 
+void WtBtRunner::sweep(const char* cfgFile, bool isFile /* = true */)
+{
+	WTSVariant* cfg = isFile ? WTSCfgLoader::load_from_file(cfgFile) : WTSCfgLoader::load_from_content(cfgFile, false);
+	if (cfg == NULL)
+	{
+		WTSLogger::error("Loading sweeping config failed");
+		return;
+	}
+
+	ParamSweeper sweeper;
+	if (sweeper.init(cfg))
+		sweeper.run();
+
+	cfg->release();
+}
+
 void WtBtRunner::config(const char* cfgFile, bool isFile /* = true */)
 {
 	if(_inited)
@@ -121,6 +121,12 @@ public:
 
 	void	clear_cache();
 
+	/*
+	 *	ѰţеĲлزC++
+	 *	͵λز⻥Ӱ죬Ҫȵconfig
+	 */
+	void	sweep(const char* cfgFile, bool isFile = true);
+
 	const char*	get_raw_stdcode(const char* stdCode);
 
 	inline CtaMocker*		cta_mocker() { return _cta_mocker; }
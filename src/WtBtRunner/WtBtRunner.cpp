@@ -14,6 +14,7 @@
 #include "../WtBtCore/SelMocker.h"
 #include "../WtBtCore/UftMocker.h"
 #include "../WtBtCore/WtHelper.h"
+#include "../WtBtCore/ParamSweeper.h"
 
 #include "../WTSTools/WTSLogger.h"
 #include "../WTSUtils/SignalHook.hpp"
@@ -58,6 +59,22 @@ int main()
 		return -1;
 	}
 
+	/*
+	 *	sweepڵĻͰղлز
+	 */
+	if (cfg->has("sweep"))
+	{
+		ParamSweeper sweeper;
+		if (sweeper.init(cfg))
+			sweeper.run();
+
+		printf("press enter key to exit\r\n");
+		getchar();
+
+		WTSLogger::stop();
+		return 0;
+	}
+
 	HisDataReplayer replayer;
 	replayer.init(cfg->get("replayer"));
 
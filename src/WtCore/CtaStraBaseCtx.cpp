@@ -78,119 +78,20 @@ void CtaStraBaseCtx::init_outputs()
 	folder += "//";
 	BoostFile::create_directories(folder.c_str());	
 
-	std::string filename = folder + "trades.csv";
-	_trade_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_trade_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_trade_logs->write_file("code,time,direct,action,price,qty,tag,fee,barno\n");
-		}
-		else
-		{
-			_trade_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "closes.csv";
-	_close_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_close_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_close_logs->write_file("code,direct,opentime,openprice,closetime,closeprice,qty,profit,totalprofit,entertag,exittag,openbarno,closebarno\n");
-		}
-		else
-		{
-			_close_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "funds.csv";
-	_fund_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_fund_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_fund_logs->write_file("date,closeprofit,positionprofit,dynbalance,fee\n");
-		}
-		else
-		{
-			_fund_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "signals.csv";
-	_sig_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_sig_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_sig_logs->write_file("code,target,sigprice,gentime,usertag\n");
-		}
-		else
-		{
-			_sig_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "positions.csv";
-	_pos_logs.reset(new BoostFile());	
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_pos_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_pos_logs->write_file("date,code,volume,closeprofit,dynprofit\n");
-		}
-		else
-		{
-			_pos_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "indice.csv";
-	_idx_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_idx_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_idx_logs->write_file("bartime,index_name,line_name,value\n");
-		}
-		else
-		{
-			_idx_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "marks.csv";
-	_mark_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_mark_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_mark_logs->write_file("bartime,price,icon,tag\n");
-		}
-		else
-		{
-			_mark_logs->seek_to_end();
-		}
-	}
+	_trade_logs = JournalWriter::instance().open_file((folder + "trades.csv").c_str(), "code,time,direct,action,price,qty,tag,fee,barno\n");
+	_close_logs = JournalWriter::instance().open_file((folder + "closes.csv").c_str(), "code,direct,opentime,openprice,closetime,closeprice,qty,profit,totalprofit,entertag,exittag,openbarno,closebarno\n");
+	_fund_logs = JournalWriter::instance().open_file((folder + "funds.csv").c_str(), "date,closeprofit,positionprofit,dynbalance,fee\n");
+	_sig_logs = JournalWriter::instance().open_file((folder + "signals.csv").c_str(), "code,target,sigprice,gentime,usertag\n");
+	_pos_logs = JournalWriter::instance().open_file((folder + "positions.csv").c_str(), "date,code,volume,closeprofit,dynprofit\n");
+	_idx_logs = JournalWriter::instance().open_file((folder + "indice.csv").c_str(), "bartime,index_name,line_name,value\n");
+	_mark_logs = JournalWriter::instance().open_file((folder + "marks.csv").c_str(), "bartime,price,icon,tag\n");
 }
 
 void CtaStraBaseCtx::log_signal(const char* stdCode, double target, double price, uint64_t gentime, const char* usertag /* = "" */)
 {
 	if (_sig_logs)
 	{
-		std::stringstream ss;
-		ss << stdCode << "," << target << "," << price << "," << gentime << "," << usertag << "\n";
-		_sig_logs->write_file(ss.str());
+		_sig_logs->write("{},{:g},{:g},{},{}\n", stdCode, target, price, gentime, usertag);
 	}
 }
 
@@ -198,9 +99,7 @@ void CtaStraBaseCtx::log_trade(const char* stdCode, bool isLong, bool isOpen, ui
 {
 	if (_trade_logs)
 	{
-		std::stringstream ss;
-		ss << stdCode << "," << curTime << "," << (isLong ? "LONG" : "SHORT") << "," << (isOpen ? "OPEN" : "CLOSE") << "," << price << "," << qty << "," << userTag << "," << fee << "," << barNo << "\n";
-		_trade_logs->write_file(ss.str());
+		_trade_logs->write("{},{},{},{},{:g},{:g},{},{:g},{}\n", stdCode, curTime, isLong ? "LONG" : "SHORT", isOpen ? "OPEN" : "CLOSE", price, qty, userTag, fee, barNo);
 	}
 
 	_engine->notify_trade(this->name(),stdCode, isLong, isOpen, curTime, price, userTag);
@@ -211,11 +110,8 @@ void CtaStraBaseCtx::log_close(const char* stdCode, bool isLong, uint64_t openTi
 {
 	if (_close_logs)
 	{
-		std::stringstream ss;
-		ss << stdCode << "," << (isLong ? "LONG" : "SHORT") << "," << openTime << "," << openpx
-			<< "," << closeTime << "," << closepx << "," << qty << "," << profit << "," 
-			<< totalprofit << "," << enterTag << "," << exitTag << "," << openBarNo << "," << closeBarNo << "\n";
-		_close_logs->write_file(ss.str());
+		_close_logs->write("{},{},{},{:g},{},{:g},{:g},{:g},{:g},{},{},{},{}\n", stdCode, isLong ? "LONG" : "SHORT", openTime, openpx,
+			closeTime, closepx, qty, profit, totalprofit, enterTag, exitTag, openBarNo, closeBarNo);
 	}
 }
 void CtaStraBaseCtx::save_userdata()
@@ -276,8 +172,299 @@ void CtaStraBaseCtx::load_userdata()
 	}
 }
 
+//״̬־ݰ汾, DetailInfoȽṹб仯ʱҪ޸
+const uint32_t CTA_STATE_VERSION = 1;
+
+/*
+ *	jsonļ޸ʱʹС, jsonʱǵ״̬־
+ *	صʱԲ, ˵json汻Ĺ
+ */
+static std::string json_stamp(const std::string& filename)
+{
+	boost::system::error_code ec;
+	int64_t mtime = (int64_t)boost::filesystem::last_write_time(filename, ec);
+	if (ec)
+		return "";
+
+	uint64_t fsize = (uint64_t)boost::filesystem::file_size(filename, ec);
+	if (ec)
+		return "";
+
+	std::string ret;
+	StateWriter(ret).write(mtime).write(fsize);
+	return ret;
+}
+
+bool CtaStraBaseCtx::load_state()
+{
+	std::string filename = WtHelper::getStraDataDir();
+	filename += _name;
+	filename += ".dat";
+
+	if (!_state_log.open(filename.c_str(), CTA_STATE_VERSION))
+	{
+		log_error("Opening state log {} failed", filename);
+		return false;
+	}
+
+	if (!_state_log.bad_file().empty())
+		log_error("State log {} is broken or of another version, moved to {}", filename, _state_log.bad_file());
+
+	if (_state_log.empty())
+		return false;
+
+	const StateLog::RecordMap& records = _state_log.records();
+
+	//json״̬־֮󱻸ĹĻ, jsonΪ׼
+	std::string jsonfile = WtHelper::getStraDataDir();
+	jsonfile += _name;
+	jsonfile += ".json";
+	if (StdFile::exists(jsonfile.c_str()))
+	{
+		auto it = records.find("json");
+		if (it == records.end() || it->second != json_stamp(jsonfile))
+		{
+			log_info("{} is modified after state log {} saved, data will be loaded from json", jsonfile, filename);
+			return false;
+		}
+	}
+
+	auto it = records.find("utils");
+	if (it != records.end())
+	{
+		StateReader reader(it->second);
+		reader.read(_last_barno);
+		reader.read(_last_cond_min);
+	}
+
+	it = records.find("fund");
+	if (it != records.end())
+	{
+		StateReader reader(it->second);
+		reader.read(_fund_info._total_profit);
+		reader.read(_fund_info._total_dynprofit);
+		reader.read(_fund_info._total_fees);
+	}
+
+	double total_profit = 0;
+	double total_dynprofit = 0;
+	uint32_t condCnt = 0;
+	for (auto& m : records)
+	{
+		const std::string& key = m.first;
+		StateReader reader(m.second);
+		if (key.compare(0, 4, "pos.") == 0)
+		{
+			const char* stdCode = key.c_str() + 4;
+			const char* ruleTag = _engine->get_hot_mgr()->getRuleTag(stdCode);
+			bool isExpired = (strlen(ruleTag) == 0 && _engine->get_contract_info(stdCode) == NULL);
+
+			if (isExpired)
+				log_info("{} not exists or expired, position ignored", stdCode);
+
+			PosInfo& pInfo = _pos_map[stdCode];
+			uint32_t cnt = 0;
+			reader.read(pInfo._volume);
+			reader.read(pInfo._closeprofit);
+			reader.read(pInfo._dynprofit);
+			reader.read(pInfo._last_entertime);
+			reader.read(pInfo._last_exittime);
+			reader.read(pInfo._frozen);
+			reader.read(pInfo._frozen_date);
+			reader.read(cnt);
+
+			if (isExpired)
+			{
+				pInfo._volume = 0;
+				pInfo._frozen = 0;
+			}
+
+			//jsonĴһ, ûгֲֻ߹ڵĺԼ, ӯתƽӯ
+			if (pInfo._volume == 0 || isExpired)
+			{
+				pInfo._closeprofit += pInfo._dynprofit;
+				pInfo._dynprofit = 0;
+				pInfo._frozen = 0;
+			}
+
+			total_profit += pInfo._closeprofit;
+			total_dynprofit += pInfo._dynprofit;
+
+			if (cnt == 0 || isExpired)
+				continue;
+
+			for (uint32_t i = 0; i < cnt; i++)
+			{
+				DetailInfo dInfo;
+				if (!reader.read(dInfo))
+					break;
+
+				if (decimal::eq(dInfo._volume, 0))
+					continue;
+
+				pInfo._details.emplace_back(dInfo);
+			}
+
+			log_info("Position confirmed,{} -> {}", stdCode, pInfo._volume);
+			stra_sub_ticks(stdCode);
+		}
+		else if (key.compare(0, 4, "sig.") == 0)
+		{
+			const char* stdCode = key.c_str() + 4;
+			const char* ruleTag = _engine->get_hot_mgr()->getRuleTag(stdCode);
+			if (strlen(ruleTag) == 0 && _engine->get_contract_info(stdCode) == NULL)
+			{
+				log_info("{} not exists or expired, signal ignored", stdCode);
+				continue;
+			}
+
+			SigInfo& sInfo = _sig_map[stdCode];
+			reader.read(sInfo._volume);
+			reader.read(sInfo._sigprice);
+			reader.read(sInfo._gentime);
+			reader.read(sInfo._sigtype);
+			reader.read_str(sInfo._usertag);
+
+			log_info("{} untouched signal recovered, target pos: {}", stdCode, sInfo._volume);
+			stra_sub_ticks(stdCode);
+		}
+		else if (key.compare(0, 5, "cond.") == 0)
+		{
+			const char* stdCode = key.c_str() + 5;
+			const char* ruleTag = _engine->get_hot_mgr()->getRuleTag(stdCode);
+			if (strlen(ruleTag) == 0 && _engine->get_contract_info(stdCode) == NULL)
+			{
+				log_info("{} not exists or expired, condition ignored", stdCode);
+				continue;
+			}
+
+			uint32_t cnt = 0;
+			reader.read(cnt);
+			CondList& condList = _condtions[stdCode];
+			for (uint32_t i = 0; i < cnt; i++)
+			{
+				CondEntrust condInfo;
+				if (!reader.read(condInfo))
+					break;
+
+				condList.emplace_back(condInfo);
+				log_info("{} condition recovered, {} {}, condition: newprice {} {}",
+					stdCode, ACTION_NAMES[condInfo._action], condInfo._qty, CMP_ALG_NAMES[condInfo._alg], condInfo._target);
+				condCnt++;
+			}
+		}
+	}
+
+	_fund_info._total_profit = total_profit;
+	_fund_info._total_dynprofit = total_dynprofit;
+
+	if (condCnt > 0)
+		log_info("{} conditions recovered, setup time: {}", condCnt, _last_cond_min);
+
+	log_info("Strategy state recovered from {}, {} records, {} bytes", filename, records.size(), _state_log.file_size());
+	return true;
+}
+
+void CtaStraBaseCtx::save_state()
+{
+	thread_local static std::string buf;
+
+	for (auto it = _pos_map.begin(); it != _pos_map.end(); it++)
+	{
+		const PosInfo& pInfo = it->second;
+		buf.clear();
+		StateWriter writer(buf);
+		writer.write(pInfo._volume).write(pInfo._closeprofit).write(pInfo._dynprofit)
+			.write(pInfo._last_entertime).write(pInfo._last_exittime)
+			.write(pInfo._frozen).write(pInfo._frozen_date)
+			.write((uint32_t)pInfo._details.size());
+		if (!pInfo._details.empty())
+			writer.write_bytes(pInfo._details.data(), sizeof(DetailInfo)*pInfo._details.size());
+
+		_state_log.put("pos." + it->first, buf);
+	}
+
+	for (auto& m : _sig_map)
+	{
+		const SigInfo& sInfo = m.second;
+		buf.clear();
+		StateWriter writer(buf);
+		writer.write(sInfo._volume).write(sInfo._sigprice).write(sInfo._gentime).write(sInfo._sigtype).write_str(sInfo._usertag);
+
+		_state_log.put("sig." + m.first, buf);
+	}
+
+	for (auto& m : _condtions)
+	{
+		const CondList& condList = m.second;
+		buf.clear();
+		StateWriter writer(buf);
+		writer.write((uint32_t)condList.size());
+		if (!condList.empty())
+			writer.write_bytes(condList.data(), sizeof(CondEntrust)*condList.size());
+
+		_state_log.put("cond." + m.first, buf);
+	}
+
+	{
+		buf.clear();
+		StateWriter writer(buf);
+		writer.write(_fund_info._total_profit).write(_fund_info._total_dynprofit).write(_fund_info._total_fees).write(_engine->get_trading_date());
+		_state_log.put("fund", buf);
+	}
+
+	{
+		buf.clear();
+		StateWriter writer(buf);
+		writer.write(_last_barno).write(_last_cond_min);
+		_state_log.put("utils", buf);
+	}
+
+	//ѾźźҪɾ
+	thread_local static std::vector<std::string> expired;
+	expired.clear();
+	for (auto& m : _state_log.records())
+	{
+		const std::string& key = m.first;
+		if (key.compare(0, 4, "sig.") == 0)
+		{
+			if (_sig_map.find(key.substr(4)) == _sig_map.end())
+				expired.emplace_back(key);
+		}
+		else if (key.compare(0, 5, "cond.") == 0)
+		{
+			if (_condtions.find(key.substr(5)) == _condtions.end())
+				expired.emplace_back(key);
+		}
+		else if (key.compare(0, 4, "pos.") == 0)
+		{
+			if (_pos_map.find(key.substr(4)) == _pos_map.end())
+				expired.emplace_back(key);
+		}
+	}
+
+	for (const std::string& key : expired)
+		_state_log.remove(key);
+
+	_state_log.commit();
+}
+
+void CtaStraBaseCtx::save_data(uint32_t flag /* = 0xFFFFFFFF */)
+{
+	//ȵjson, jsonĴ״̬־һύ
+	if (flag & CTA_SAVE_JSON)
+		export_json();
+
+	if (flag & CTA_SAVE_STATE)
+		save_state();
+}
+
 void CtaStraBaseCtx::load_data(uint32_t flag /* = 0xFFFFFFFF */)
 {
+	//ȴӶ״̬־ָ, ûлjsonĹĻٶjson
+	if (load_state())
+		return;
+
 	std::string filename = WtHelper::getStraDataDir();
 	filename += _name;
 	filename += ".json";
@@ -494,7 +681,7 @@ void CtaStraBaseCtx::load_data(uint32_t flag /* = 0xFFFFFFFF */)
 	}
 }
 
-void CtaStraBaseCtx::save_data(uint32_t flag /* = 0xFFFFFFFF */)
+void CtaStraBaseCtx::export_json()
 {
 	rj::Document root(rj::kObjectType);
 
@@ -640,6 +827,8 @@ void CtaStraBaseCtx::save_data(uint32_t flag /* = 0xFFFFFFFF */)
 			root.Accept(writer);
 			bf.write_file(sb.GetString());
 			bf.close_file();
+
+			_state_log.put("json", json_stamp(filename));
 		}
 	}
 }
@@ -1000,7 +1189,7 @@ bool CtaStraBaseCtx::on_schedule(uint32_t curDate, uint32_t curTime)
 				if(!_condtions.empty())
 				{
 					_last_cond_min = (uint64_t)curDate * 10000 + curTime;
-					save_data();
+					save_data(CTA_SAVE_STATE);
 				}
 			}
 			else
@@ -1089,16 +1278,16 @@ void CtaStraBaseCtx::on_session_end(uint32_t uTDate)
 			continue;
 
 		if(_pos_logs)
-			_pos_logs->write_file(fmt::format("{},{},{},{:.2f},{:.2f}\n", curDate, stdCode,
-				pInfo._volume, pInfo._closeprofit, pInfo._dynprofit));
+			_pos_logs->write("{},{},{},{:.2f},{:.2f}\n", curDate, stdCode,
+				pInfo._volume, pInfo._closeprofit, pInfo._dynprofit);
 	}
 
 	//Ҫѵսд־ļ
 	//زʵдͬ, , 
 	if (_fund_logs)
-		_fund_logs->write_file(fmt::format("{},{:.2f},{:.2f},{:.2f},{:.2f}\n", curDate, 
+		_fund_logs->write("{},{:.2f},{:.2f},{:.2f},{:.2f}\n", curDate, 
 		_fund_info._total_profit, _fund_info._total_dynprofit, 
-		_fund_info._total_profit + _fund_info._total_dynprofit - _fund_info._total_fees, _fund_info._total_fees));
+		_fund_info._total_profit + _fund_info._total_dynprofit - _fund_info._total_fees, _fund_info._total_fees);
 
 	save_data();
 
@@ -1107,6 +1296,10 @@ void CtaStraBaseCtx::on_session_end(uint32_t uTDate)
 		save_userdata();
 		_ud_modified = false;
 	}
+
+	//ս, Ⱥ̨̰߳ˮд, ʱͲ
+	if (!JournalWriter::instance().flush())
+		WTSLogger::warn("[{}] Flushing journals timeout on session end", _name.c_str());
 }
 
 CondList& CtaStraBaseCtx::get_cond_entrusts(const char* stdCode)
@@ -1401,7 +1594,7 @@ void CtaStraBaseCtx::append_signal(const char* stdCode, double qty, const char*
 
 	log_signal(stdCode, qty, curPx, sInfo._gentime, userTag);
 
-	save_data();
+	save_data(CTA_SAVE_STATE);
 }
 
 void CtaStraBaseCtx::do_set_position(const char* stdCode, double qty, const char* userTag /* = "" */, bool bFireAtOnce /* = false */)
@@ -1559,8 +1752,8 @@ void CtaStraBaseCtx::do_set_position(const char* stdCode, double qty, const char
 	}
 
 
-	//洢
-	save_data();
+	//洢, ɽʱֻд״̬, jsonڵȵʱ򵼳
+	save_data(CTA_SAVE_STATE);
 
 	if (bFireAtOnce)	//, ύ仯
 	{
@@ -1963,9 +2156,7 @@ void CtaStraBaseCtx::add_chart_mark(double price, const char* icon, const char*
 
 	if (_mark_logs)
 	{
-		std::stringstream ss;
-		ss << curTime << "," << price << "," << icon << "," << tag << std::endl;;
-		_mark_logs->write_file(ss.str());
+		_mark_logs->write("{},{:g},{},{}\n", curTime, price, icon, tag);
 	}
 
 	_engine->notify_chart_marker(curTime, _name.c_str(), price, icon, tag);
@@ -2036,9 +2227,7 @@ bool CtaStraBaseCtx::set_index_value(const char* idxName, const char* lineName,
 
 	if (_idx_logs)
 	{
-		std::stringstream ss;
-		ss << curTime << "," << idxName << "," << lineName << "," << val << std::endl;;
-		_idx_logs->write_file(ss.str());
+		_idx_logs->write("{},{},{},{:g}\n", curTime, idxName, lineName, val);
 	}
 
 	_engine->notify_chart_index(curTime, _name.c_str(), idxName, lineName, val);
@@ -13,6 +13,8 @@
 #include "../Includes/WTSDataDef.hpp"
 
 #include "../Share/BoostFile.hpp"
+#include "../Share/AsyncJournal.hpp"
+#include "../Share/StateLog.hpp"
 #include "../Share/fmtlib.h"
 #include "../Share/SpinMutex.hpp"
 
@@ -30,6 +32,9 @@ const char COND_ACTION_OS = 2;	//
 const char COND_ACTION_CS = 3;	//ƽ
 const char COND_ACTION_SP = 4;	//ֱòλ
 
+const uint32_t CTA_SAVE_STATE = 0x0001;	//д״̬־
+const uint32_t CTA_SAVE_JSON = 0x0002;	//json, ⲿʹ
+
 typedef struct _CondEntrust
 {
 	WTSCompareField _field;
@@ -71,6 +76,14 @@ private:
 	void	save_data(uint32_t flag = 0xFFFFFFFF);
 	void	load_data(uint32_t flag = 0xFFFFFFFF);
 
+	/*
+	 *	״̬ĳɶƵ׷־, ÿֻд뷢仯Ĳ
+	 *	jsonֻڵȺ̵ʱ򵼳, ⲿʹ
+	 */
+	bool	load_state();
+	void	save_state();
+	void	export_json();
+
 	void	load_userdata();
 	void	save_userdata();
 
@@ -305,13 +318,16 @@ protected:
 	typedef wt_hashmap<std::string, SigInfo>	SignalMap;
 	SignalMap		_sig_map;
 
-	BoostFilePtr	_trade_logs;
-	BoostFilePtr	_close_logs;
-	BoostFilePtr	_fund_logs;
-	BoostFilePtr	_sig_logs;
-	BoostFilePtr	_pos_logs;
-	BoostFilePtr	_idx_logs;
-	BoostFilePtr	_mark_logs;
+	/*
+	 *	ˮļĳɺ̨߳д, Իصֻʽ
+	 */
+	JournalFilePtr	_trade_logs;
+	JournalFilePtr	_close_logs;
+	JournalFilePtr	_fund_logs;
+	JournalFilePtr	_sig_logs;
+	JournalFilePtr	_pos_logs;
+	JournalFilePtr	_idx_logs;
+	JournalFilePtr	_mark_logs;
 
 	CondEntrustMap	_condtions;
 	uint64_t		_last_cond_min;	//ϴʱ
@@ -339,6 +355,8 @@ protected:
 
 	StraFundInfo		_fund_info;
 
+	StateLog			_state_log;		//״̬־
+
 	//tickб
 	wt_hashset<std::string> _tick_subs;
 
@@ -16,6 +16,7 @@
 #include "../Includes/IBaseDataMgr.h"
 
 #include "../Share/CodeHelper.hpp"
+#include "../Share/StdCodeCache.hpp"
 #include "../Share/decimal.h"
 
 #include "../WTSTools/WTSLogger.h"
@@ -67,65 +68,10 @@ void HftStraBaseCtx::init_outputs()
 	folder += "//";
 	BoostFile::create_directories(folder.c_str());
 
-	std::string filename = folder + "trades.csv";
-	_trade_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_trade_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_trade_logs->write_file("code,time,direct,action,price,qty,tag,fee\n");
-		}
-		else
-		{
-			_trade_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "closes.csv";
-	_close_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_close_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_close_logs->write_file("code,direct,opentime,openprice,closetime,closeprice,qty,profit,totalprofit,entertag,exittag\n");
-		}
-		else
-		{
-			_close_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "funds.csv";
-	_fund_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_fund_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_fund_logs->write_file("date,closeprofit,positionprofit,dynbalance,fee\n");
-		}
-		else
-		{
-			_fund_logs->seek_to_end();
-		}
-	}
-
-	filename = folder + "signals.csv";
-	_sig_logs.reset(new BoostFile());
-	{
-		bool isNewFile = !BoostFile::exists(filename.c_str());
-		_sig_logs->create_or_open_file(filename.c_str());
-		if (isNewFile)
-		{
-			_sig_logs->write_file("code,target,sigprice,gentime,usertag\n");
-		}
-		else
-		{
-			_sig_logs->seek_to_end();
-		}
-	}
+	_trade_logs = JournalWriter::instance().open_file((folder + "trades.csv").c_str(), "code,time,direct,action,price,qty,tag,fee\n");
+	_close_logs = JournalWriter::instance().open_file((folder + "closes.csv").c_str(), "code,direct,opentime,openprice,closetime,closeprice,qty,profit,totalprofit,entertag,exittag\n");
+	_fund_logs = JournalWriter::instance().open_file((folder + "funds.csv").c_str(), "date,closeprofit,positionprofit,dynbalance,fee\n");
+	_sig_logs = JournalWriter::instance().open_file((folder + "signals.csv").c_str(), "code,target,sigprice,gentime,usertag\n");
 }
 
 void HftStraBaseCtx::on_init()
@@ -210,11 +156,11 @@ OrderIDs HftStraBaseCtx::stra_buy(const char* stdCode, double price, double qty,
 	 *	ҵƥԶӳ䴦
 	 */
 	 //const char* ruleTag = _engine->get_hot_mgr()->getRuleTag(stdCode);
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		std::string realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code, realCode;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		WTSContractInfo* ct = _engine->get_basedata_mgr()->getContract(code.c_str(), cInfo._exchg);
 
@@ -256,7 +202,7 @@ OrderIDs HftStraBaseCtx::stra_buy(const char* stdCode, double price, double qty,
 
 OrderIDs HftStraBaseCtx::stra_sell(const char* stdCode, double price, double qty, const char* userTag, int flag /* = 0 */, bool bForceClose /* = false */)
 {
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	WTSCommodityInfo* commInfo = _engine->get_basedata_mgr()->getCommodity(cInfo._exchg, cInfo._product);
 
 	//գҪóֲ
@@ -277,8 +223,8 @@ OrderIDs HftStraBaseCtx::stra_sell(const char* stdCode, double price, double qty
 	
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		std::string realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code, realCode;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		WTSContractInfo* ct = _engine->get_basedata_mgr()->getContract(code.c_str(), cInfo._exchg);
 
@@ -320,11 +266,11 @@ OrderIDs HftStraBaseCtx::stra_sell(const char* stdCode, double price, double qty
 uint32_t HftStraBaseCtx::stra_enter_long(const char* stdCode, double price, double qty, const char* userTag, int flag/* = 0*/)
 {
 	std::string realCode = stdCode;
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 		_code_map[realCode] = stdCode;
 	}
 
@@ -334,11 +280,11 @@ uint32_t HftStraBaseCtx::stra_enter_long(const char* stdCode, double price, doub
 uint32_t HftStraBaseCtx::stra_exit_long(const char* stdCode, double price, double qty, const char* userTag, bool isToday/* = false*/, int flag/* = 0*/)
 {
 	std::string realCode = stdCode;
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		_code_map[realCode] = stdCode;
 	}
@@ -349,11 +295,11 @@ uint32_t HftStraBaseCtx::stra_exit_long(const char* stdCode, double price, doubl
 uint32_t HftStraBaseCtx::stra_enter_short(const char* stdCode, double price, double qty, const char* userTag, int flag/* = 0*/)
 {
 	std::string realCode = stdCode;
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		_code_map[realCode] = stdCode;
 	}
@@ -380,11 +326,11 @@ uint32_t HftStraBaseCtx::stra_enter_short(const char* stdCode, double price, dou
 uint32_t HftStraBaseCtx::stra_exit_short(const char* stdCode, double price, double qty, const char* userTag, bool isToday/* = false*/, int flag/* = 0*/)
 {
 	std::string realCode = stdCode;
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		_code_map[realCode] = stdCode;
 	}
@@ -539,7 +485,7 @@ void HftStraBaseCtx::on_trade(uint32_t localid, const char* stdCode, bool isBuy,
 	if(_sig_logs && _data_agent)
 	{
 		double curPos = stra_get_position(stdCode);
-		_sig_logs->write_file(fmt::format("{}.{}.{},{}{},{},{}\n", stra_get_date(), stra_get_time(), stra_get_secs(), isBuy ? "+" : "-", vol, curPos, price));
+		_sig_logs->write("{}.{}.{},{}{},{},{}\n", stra_get_date(), stra_get_time(), stra_get_secs(), isBuy ? "+" : "-", vol, curPos, price);
 	}
 
 	const PosInfo& posInfo = _pos_map[stdCode];
@@ -625,11 +571,11 @@ double HftStraBaseCtx::stra_get_position_avgpx(const char* stdCode)
 
 double HftStraBaseCtx::stra_get_position(const char* stdCode, bool bOnlyValid /* = false */, int flag /* = 3*/)
 {
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		std::string realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code, realCode;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		_code_map[realCode] = stdCode;
 
@@ -643,11 +589,11 @@ double HftStraBaseCtx::stra_get_position(const char* stdCode, bool bOnlyValid /*
 
 double HftStraBaseCtx::stra_get_undone(const char* stdCode)
 {
-	CodeHelper::CodeInfo cInfo = CodeHelper::extractStdCode(stdCode, _engine->get_hot_mgr());
+	const CodeHelper::CodeInfo& cInfo = StdCodeCache::extractStdCode(stdCode, _engine->get_hot_mgr());
 	if (strlen(cInfo._ruletag) > 0)
 	{
-		std::string code = _engine->get_hot_mgr()->getCustomRawCode(cInfo._ruletag, cInfo.stdCommID(), _engine->get_trading_date());
-		std::string realCode = CodeHelper::rawMonthCodeToStdCode(code.c_str(), cInfo._exchg);
+		std::string code, realCode;
+		StdCodeCache::mapRuleCode(stdCode, _engine->get_hot_mgr(), _engine->get_trading_date(), code, realCode);
 
 		_code_map[realCode] = stdCode;
 
@@ -956,19 +902,21 @@ void HftStraBaseCtx::on_session_end(uint32_t uTDate)
 	//Ҫѵսд־ļ
 	//زʵдͬ, , 
 	if (_fund_logs && _data_agent)
-		_fund_logs->write_file(fmt::format("{},{:.2f},{:.2f},{:.2f},{:.2f}\n", curDate,
+		_fund_logs->write("{},{:.2f},{:.2f},{:.2f},{:.2f}\n", curDate,
 			_fund_info._total_profit, _fund_info._total_dynprofit,
-			_fund_info._total_profit + _fund_info._total_dynprofit - _fund_info._total_fees, _fund_info._total_fees));
+			_fund_info._total_profit + _fund_info._total_dynprofit - _fund_info._total_fees, _fund_info._total_fees);
+
+	//ս, Ⱥ̨̰߳ˮд, ʱͲ
+	if (!JournalWriter::instance().flush())
+		WTSLogger::warn("[{}] Flushing journals timeout on session end", _name.c_str());
 }
 
 void HftStraBaseCtx::log_trade(const char* stdCode, bool isLong, bool isOpen, uint64_t curTime, double price, double qty, double fee, const char* userTag/* = ""*/)
 {
 	if(_trade_logs && _data_agent)
 	{
-		std::stringstream ss;
-		ss << stdCode << "," << curTime << "," << (isLong ? "LONG" : "SHORT") << "," << (isOpen ? "OPEN" : "CLOSE")
-			<< "," << price << "," << qty << "," << fee << "," << userTag << "\n";
-		_trade_logs->write_file(ss.str());
+		_trade_logs->write("{},{},{},{},{:g},{:g},{:g},{}\n", stdCode, curTime, isLong ? "LONG" : "SHORT", isOpen ? "OPEN" : "CLOSE",
+			price, qty, fee, userTag);
 	}
 }
 
@@ -977,10 +925,7 @@ void HftStraBaseCtx::log_close(const char* stdCode, bool isLong, uint64_t openTi
 {
 	if (_close_logs && _data_agent)
 	{
-		std::stringstream ss;
-		ss << stdCode << "," << (isLong ? "LONG" : "SHORT") << "," << openTime << "," << openpx
-			<< "," << closeTime << "," << closepx << "," << qty << "," << profit << "," << maxprofit << "," << maxloss << ","
-			<< totalprofit << "," << enterTag << "," << exitTag << "\n";
-		_close_logs->write_file(ss.str());
+		_close_logs->write("{},{},{},{:g},{},{:g},{:g},{:g},{:g},{:g},{:g},{},{}\n", stdCode, isLong ? "LONG" : "SHORT", openTime, openpx,
+			closeTime, closepx, qty, profit, maxprofit, maxloss, totalprofit, enterTag, exitTag);
 	}
 }
@@ -12,6 +12,7 @@
 #include "../Includes/FasterDefs.h"
 #include "../Includes/IHftStraCtx.h"
 #include "../Share/BoostFile.hpp"
+#include "../Share/AsyncJournal.hpp"
 #include "../Share/fmtlib.h"
 
 #include <boost/circular_buffer.hpp>
@@ -253,10 +254,13 @@ protected:
 
 	wt_hashmap<std::string, std::string> _code_map;
 
-	BoostFilePtr	_sig_logs;
-	BoostFilePtr	_close_logs;
-	BoostFilePtr	_trade_logs;
-	BoostFilePtr	_fund_logs;
+	/*
+	 *	ˮļĳɺ̨߳д, Իصֻʽ
+	 */
+	JournalFilePtr	_sig_logs;
+	JournalFilePtr	_close_logs;
+	JournalFilePtr	_trade_logs;
+	JournalFilePtr	_fund_logs;
 
 	//û
 	typedef wt_hashmap<std::string, std::string> StringHashMap;
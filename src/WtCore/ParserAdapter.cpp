@@ -362,6 +362,7 @@ void ParserAdapter::handleOrderQueue(WTSOrdQueData* ordQueData)
 	WTSCommodityInfo* commInfo = cInfo->getCommInfo();
 	std::string stdCode = CodeHelper::rawFlatCodeToStdCode(cInfo->getCode(), cInfo->getExchg(), commInfo->getProduct());
 	ordQueData->setCode(stdCode.c_str());
+	ordQueData->setContractInfo(cInfo);
 
 	if (_stub)
 		_stub->handle_push_order_queue(ordQueData);
@@ -385,6 +386,7 @@ void ParserAdapter::handleOrderDetail(WTSOrdDtlData* ordDtlData)
 	WTSCommodityInfo* commInfo = cInfo->getCommInfo();
 	std::string stdCode = CodeHelper::rawFlatCodeToStdCode(cInfo->getCode(), cInfo->getExchg(), commInfo->getProduct());
 	ordDtlData->setCode(stdCode.c_str());
+	ordDtlData->setContractInfo(cInfo);
 
 	if (_stub)
 		_stub->handle_push_order_detail(ordDtlData);
@@ -408,6 +410,7 @@ void ParserAdapter::handleTransaction(WTSTransData* transData)
 	WTSCommodityInfo* commInfo = cInfo->getCommInfo();
 	std::string stdCode = CodeHelper::rawFlatCodeToStdCode(cInfo->getCode(), cInfo->getExchg(), commInfo->getProduct());
 	transData->setCode(stdCode.c_str());
+	transData->setContractInfo(cInfo);
 
 	if (_stub)
 		_stub->handle_push_transaction(transData);
@@ -30,6 +30,7 @@
 #include "../Includes/WTSContractInfo.hpp"
 #include "../Includes/IBaseDataMgr.h"
 #include "../Share/decimal.h"
+#include "../Share/LatencyHistogram.hpp"
 
 #include <exception>
 #include <rapidjson/document.h>
@@ -82,6 +83,7 @@ TraderAdapter::TraderAdapter(EventNotifier* caster /* = NULL */)
 	, _save_data(false)
 	, _notifier(caster)
 	, _ignore_sefmatch(false)
+	, _probe(NULL)
 {
 }
 
@@ -137,6 +139,27 @@ bool TraderAdapter::init(const char* id, WTSVariant* params, IBaseDataMgr* bdMgr
 				rParam._order_times_boundary = vProdItem->getUInt32("order_times_boundary");
 				rParam._order_stat_timespan = vProdItem->getUInt32("order_stat_timespan");
 
+				/*
+				 *	രڵ, :
+				 *	"order_windows":[{"timespan":1,"boundary":20},{"timespan":60,"boundary":300}]
+				 */
+				auto loadWindows = [vProdItem](const char* key, RateWindows& windows) {
+					WTSVariant* cfgWins = vProdItem->get(key);
+					if (cfgWins == NULL || !cfgWins->isArray())
+						return;
+
+					for (uint32_t i = 0; i < cfgWins->size(); i++)
+					{
+						WTSVariant* cfgWin = cfgWins->get(i);
+						RateWindow win;
+						win._timespan = cfgWin->getUInt32("timespan");
+						win._boundary = cfgWin->getUInt32("boundary");
+						windows.emplace_back(win);
+					}
+				};
+				loadWindows("order_windows", rParam._order_windows);
+				loadWindows("cancel_windows", rParam._cancel_windows);
+
 				WTSLogger::log_dyn("trader", _id.c_str(), LL_INFO, "[{}] Risk control rule {} of trading channel loaded", _id.c_str(), product);
 			}
 
@@ -397,6 +420,35 @@ const TraderAdapter::RiskParams* TraderAdapter::getRiskParams(const char* stdCod
 	return &it->second;
 }
 
+RateLimiter& TraderAdapter::getRateLimiter(const char* stdCode, bool isCancel)
+{
+	CodeRateLimiters& limiters = isCancel ? _cancel_limiters : _order_limiters;
+	auto it = limiters.find(stdCode);
+	if (it != limiters.end())
+		return it->second;
+
+	RateLimiter& limiter = limiters[stdCode];
+	const RiskParams* riskPara = getRiskParams(stdCode);
+	if (riskPara == NULL)
+		return limiter;
+
+	//ԭҲΪһ
+	if (isCancel)
+	{
+		limiter.add_window(riskPara->_cancel_stat_timespan * 1000, riskPara->_cancel_times_boundary);
+		for (const RateWindow& win : riskPara->_cancel_windows)
+			limiter.add_window(win._timespan * 1000, win._boundary);
+	}
+	else
+	{
+		limiter.add_window(riskPara->_order_stat_timespan * 1000, riskPara->_order_times_boundary);
+		for (const RateWindow& win : riskPara->_order_windows)
+			limiter.add_window(win._timespan * 1000, win._boundary);
+	}
+
+	return limiter;
+}
+
 bool TraderAdapter::run()
 {
 	if (_trader_api == NULL)
@@ -496,16 +548,17 @@ uint32_t TraderAdapter::doEntrust(WTSEntrust* entrust)
 	usertag[_order_pattern.size()] =  '.';
 	fmtutil::format_to(usertag + _order_pattern.size() + 1, "{}", localid);
 	
+	if (_probe) _probe->mark(LM_Api);
 	int32_t ret = _trader_api->orderInsert(entrust);
+	if (_probe) _probe->mark(LM_Sent);
 	if(ret < 0)
 	{
 		WTSLogger::log_dyn("trader", _id.c_str(), LL_ERROR, "[{}] Order placing failed: {}", _id.c_str(), ret);
 		return UINT_MAX;
 	}
-	else
+	else if (_risk_mon_enabled)
 	{
-		int64_t now = TimeUtils::getLocalTimeNow();
-		_order_time_cache[entrust->getCode()].emplace_back(now);
+		getRateLimiter(entrust->getCode(), false).record(TimeUtils::getLocalTimeNow());
 	}
 	return localid;
 }
@@ -554,33 +607,16 @@ bool TraderAdapter::checkCancelLimits(const char* stdCode)
 	}
 
 	//Ƶʼ
-	auto it = _cancel_time_cache.find(stdCode);
-	if (it != _cancel_time_cache.end())
-	{
-		TimeCacheList& cache = (TimeCacheList&)it->second;
-		uint32_t cnt = cache.size();
-		if (cnt >= riskPara->_cancel_times_boundary)
-		{
-			uint64_t eTime = cache[cnt - 1];
-			uint64_t sTime = eTime - riskPara->_cancel_stat_timespan * 1000;
-			auto tit = std::lower_bound(cache.begin(), cache.end(), sTime);
-			auto sIdx = tit - cache.begin();
-			auto times = cnt - sIdx - 1;
-			if (times > riskPara->_cancel_times_boundary)
-			{
-				WTSLogger::log_dyn("trader", _id.c_str(), LL_ERROR, "[{}] {} cancel {} times within {} seconds, beyond boundary {} times, adding to excluding list",
-					_id.c_str(), stdCode, times, riskPara->_cancel_stat_timespan, riskPara->_cancel_times_boundary);
-				_exclude_codes.insert(stdCode);
-				return false;
-			}
-
-			//Ҫһ, ûرõİ취
-			//Ȼʱ, vectorȻԽԽ
-			if(tit != cache.begin())
-			{
-				cache.erase(cache.begin(), tit);
-			}
-		}
+	const RateLimiter& limiter = getRateLimiter(stdCode, true);
+	uint64_t now = TimeUtils::getLocalTimeNow();
+	int32_t idx = limiter.check(now);
+	if (idx >= 0)
+	{
+		const SlidingWindow& win = limiter.window(idx);
+		WTSLogger::log_dyn("trader", _id.c_str(), LL_ERROR, "[{}] {} cancel {} times within {} seconds, beyond boundary {} times, adding to excluding list",
+			_id.c_str(), stdCode, win.count(now), win.timespan() / 1000, win.limits());
+		_exclude_codes.insert(stdCode);
+		return false;
 	}
 
 	return true;
@@ -599,6 +635,8 @@ bool TraderAdapter::isTradeEnabled(const char* stdCode) const
 
 bool TraderAdapter::checkOrderLimits(const char* stdCode)
 {
+	LatencyScope scope(_probe, LM_RiskIn, LM_RiskOut);
+
 	if (!_risk_mon_enabled)
 		return true;
 
@@ -618,34 +656,17 @@ bool TraderAdapter::checkOrderLimits(const char* stdCode)
 		return false;
 	}
 
-	//Ƶʼ
-	auto it = _order_time_cache.find(stdCode);
-	if (it != _order_time_cache.end())
+	//µƵʼ
+	const RateLimiter& limiter = getRateLimiter(stdCode, false);
+	uint64_t now = TimeUtils::getLocalTimeNow();
+	int32_t idx = limiter.check(now);
+	if (idx >= 0)
 	{
-		TimeCacheList& cache = (TimeCacheList&)it->second;
-		uint32_t cnt = cache.size();
-		if (cnt >= riskPara->_order_times_boundary)
-		{
-			uint64_t eTime = cache[cnt - 1];
-			uint64_t sTime = eTime - riskPara->_order_stat_timespan * 1000;
-			auto tit = std::lower_bound(cache.begin(), cache.end(), sTime);
-			auto sIdx = tit - cache.begin();
-			auto times = cnt - sIdx - 1;
-			if (times > riskPara->_order_times_boundary)
-			{
-				WTSLogger::log_dyn("trader", _id.c_str(), LL_ERROR, "[{}] {} entrust {} times within {} seconds, beyond boundary {} times, adding to excluding list",
-					_id.c_str(), stdCode, times, riskPara->_order_stat_timespan, riskPara->_order_times_boundary);
-				_exclude_codes.insert(stdCode);
-				return false;
-			}
-
-			//Ҫһ, ûرõİ취
-			//Ȼʱ, vectorȻԽԽ
-			if (tit != cache.begin())
-			{
-				cache.erase(cache.begin(), tit);
-			}
-		}
+		const SlidingWindow& win = limiter.window(idx);
+		WTSLogger::log_dyn("trader", _id.c_str(), LL_ERROR, "[{}] {} entrust {} times within {} seconds, beyond boundary {} times, adding to excluding list",
+			_id.c_str(), stdCode, win.count(now), win.timespan() / 1000, win.limits());
+		_exclude_codes.insert(stdCode);
+		return false;
 	}
 
 	return true;
@@ -1274,7 +1295,8 @@ bool TraderAdapter::cancel(uint32_t localid)
 	
 	bool bRet = doCancel(ordInfo);
 
-	_cancel_time_cache[ordInfo->getCode()].emplace_back(TimeUtils::getLocalTimeNow());
+	if (_risk_mon_enabled)
+		getRateLimiter(ordInfo->getCode(), true).record(TimeUtils::getLocalTimeNow());
 
 	ordInfo->release();
 
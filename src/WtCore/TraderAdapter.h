@@ -14,6 +14,9 @@
 #include "../Includes/ITraderApi.h"
 #include "../Share/BoostFile.hpp"
 #include "../Share/StdUtils.hpp"
+#include "../Share/RateLimiter.hpp"
+
+class LatencyProbe;
 
 NS_WTP_BEGIN
 class WTSVariant;
@@ -82,6 +85,13 @@ public:
 
 	} PosItem;
 
+	typedef struct _RateWindow
+	{
+		uint32_t	_timespan;	//ͳʱ䴰, λ
+		uint32_t	_boundary;	//ڵĴ
+	} RateWindow;
+	typedef std::vector<RateWindow>	RateWindows;
+
 	typedef struct _RiskParams
 	{
 		uint32_t	_order_times_boundary;
@@ -92,9 +102,17 @@ public:
 		uint32_t	_cancel_stat_timespan;
 		uint32_t	_cancel_total_limits;
 
+		/*
+		 *	_xxx_stat_timespan/_xxx_times_boundary, ö
+		 *	ÿ벻20, ÿӲ300
+		 */
+		RateWindows	_order_windows;
+		RateWindows	_cancel_windows;
+
 		_RiskParams()
+			: _order_times_boundary(0), _order_stat_timespan(0), _order_total_limits(0)
+			, _cancel_times_boundary(0), _cancel_stat_timespan(0), _cancel_total_limits(0)
 		{
-			memset(this, 0, sizeof(_RiskParams));
 		}
 	} RiskParams;
 
@@ -130,6 +148,12 @@ private:
 
 	const RiskParams* getRiskParams(const char* stdCode);
 
+	/*
+	 *	ȡ, ûеĻշز
+	 *	@isCancel	Ƿǳ
+	 */
+	RateLimiter&	getRateLimiter(const char* stdCode, bool isCancel);
+
 	void initSaveData();
 
 	inline void	logTrade(uint32_t localid, const char* stdCode, WTSTradeInfo* trdInfo);
@@ -168,6 +192,11 @@ public:
 	bool	checkCancelLimits(const char* stdCode);
 	bool	checkOrderLimits(const char* stdCode);
 
+	/*
+	 *	ӳ̽룬ӳٲԹؼͽ׽ӿڵô
+	 */
+	inline void setLatencyProbe(LatencyProbe* probe) { _probe = probe; }
+
 	bool	checkSelfMatch(const char* stdCode, WTSTradeInfo* tInfo);
 
 	inline	bool isSelfMatched(const char* stdCode)
@@ -247,11 +276,14 @@ private:
 	typedef WTSHashMap<std::string>	TradeStatMap;
 	TradeStatMap*	_stat_map;	//ͳ
 
-	//ʱڵ,ҪΪ˿˲õ
-	typedef std::vector<uint64_t> TimeCacheList;
-	typedef wt_hashmap<std::string, TimeCacheList> CodeTimeCacheMap;
-	CodeTimeCacheMap	_order_time_cache;	//µʱ仺
-	CodeTimeCacheMap	_cancel_time_cache;	//ʱ仺
+	/*
+	 *	ҪΪ˿˲õ
+	 *	ԭÿ뻺ȫʱ, ÿμ鶼Ҫֲٴͷɾ, µƵʱܴ
+	 *	ÿ̶ֻʱ, ¼ͼ鶼O(1)
+	 */
+	typedef wt_hashmap<std::string, RateLimiter> CodeRateLimiters;
+	CodeRateLimiters	_order_limiters;	//µ
+	CodeRateLimiters	_cancel_limiters;	//
 
 	//,ͻ뵽ų
 	wt_hashset<std::string>	_exclude_codes;
@@ -264,6 +296,8 @@ private:
 	BoostFilePtr	_trades_log;		//־
 	BoostFilePtr	_orders_log;		//־
 	std::string		_rt_data_file;		//ʵʱļ
+
+	LatencyProbe*	_probe;				//ӳ̽룬ֻӳٲԹ߻
 };
 
 typedef std::shared_ptr<TraderAdapter>				TraderAdapterPtr;
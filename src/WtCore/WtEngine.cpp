@@ -15,6 +15,8 @@
 #include "../Share/StrUtil.hpp"
 #include "../Share/decimal.h"
 #include "../Share/CodeHelper.hpp"
+#include "../Share/StdCodeCache.hpp"
+#include "../Share/AsyncJournal.hpp"
 
 #include "../Includes/IBaseDataMgr.h"
 #include "../Includes/IHotMgr.h"
@@ -296,6 +298,25 @@ void WtEngine::init(WTSVariant* cfg, IBaseDataMgr* bdMgr, WtDtMgr* dataMgr, IHot
 
 	init_outputs();
 
+	/*
+	 *	ˮļ첽д
+	 *	interval: дļ, fsync: none/batch/session, timeout: սʱȴдĺ
+	 */
+	WTSVariant* cfgJournal = cfg->get("journal");
+	if (cfgJournal)
+	{
+		std::string fsync = cfgJournal->getCString("fsync");
+		JournalSyncPolicy policy = JSP_None;
+		if (fsync == "batch")
+			policy = JSP_Batch;
+		else if (fsync == "session")
+			policy = JSP_Session;
+
+		uint32_t timeout = cfgJournal->has("timeout") ? cfgJournal->getUInt32("timeout") : 1000;
+		JournalWriter::instance().configure(cfgJournal->getUInt32("interval"), policy, timeout);
+		WTSLogger::info("Journal writer configured, interval: {}ms, fsync: {}, timeout: {}ms", cfgJournal->getUInt32("interval"), fsync.empty() ? "none" : fsync.c_str(), timeout);
+	}
+
 	WTSVariant* cfgRisk = cfg->get("riskmon");
 	if(cfgRisk)
 	{
@@ -310,6 +331,12 @@ void WtEngine::init(WTSVariant* cfg, IBaseDataMgr* bdMgr, WtDtMgr* dataMgr, IHot
 	}
 }
 
+void WtEngine::release()
+{
+	//ˮд߳Ҫͣ, ̬
+	JournalWriter::instance().stop();
+}
+
 void WtEngine::on_session_end()
 {
 	//ʽ
@@ -356,7 +383,8 @@ void WtEngine::on_session_end()
 
 void WtEngine::on_session_begin()
 {
-
+	//ԺԼл, ѾӳʵԼҪӳ
+	StdCodeCache::refresh();
 }
 
 void WtEngine::save_datas()
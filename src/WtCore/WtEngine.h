@@ -154,6 +154,11 @@ public:
 public:
 	virtual void init(WTSVariant* cfg, IBaseDataMgr* bdMgr, WtDtMgr* dataMgr, IHotMgr* hotMgr, EventNotifier* notifier);
 
+	/*
+	 *	˳ǰͷ, ֹͣˮд߳
+	 */
+	virtual void release();
+
 	virtual void run(bool bAsync = false) = 0;
 
 	virtual void on_tick(const char* stdCode, WTSTickData* curTick);
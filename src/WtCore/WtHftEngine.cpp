@@ -27,6 +27,7 @@
 #include <rapidjson/prettywriter.h>
 namespace rj = rapidjson;
 
+#include <algorithm>
 #include <boost/asio.hpp>
 
 extern boost::asio::io_service g_asyncIO;
@@ -126,6 +127,14 @@ void WtHftEngine::handle_push_quote(WTSTickData* newTick, uint32_t hotFlag)
 void WtHftEngine::handle_push_order_detail(WTSOrdDtlData* curOrdDtl)
 {
 	const char* stdCode = curOrdDtl->code();
+	const CtxList* ctxs = find_flat_subs(_orddtl_subs, curOrdDtl->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IHftStraCtx* ctx : *ctxs)
+			ctx->on_order_detail(stdCode, curOrdDtl);
+		return;
+	}
+
 	auto sit = _orddtl_sub_map.find(stdCode);
 	if (sit != _orddtl_sub_map.end())
 	{
@@ -149,6 +158,14 @@ void WtHftEngine::handle_push_order_detail(WTSOrdDtlData* curOrdDtl)
 void WtHftEngine::handle_push_order_queue(WTSOrdQueData* curOrdQue)
 {
 	const char* stdCode = curOrdQue->code();
+	const CtxList* ctxs = find_flat_subs(_ordque_subs, curOrdQue->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IHftStraCtx* ctx : *ctxs)
+			ctx->on_order_queue(stdCode, curOrdQue);
+		return;
+	}
+
 	auto sit = _ordque_sub_map.find(stdCode);
 	if (sit != _ordque_sub_map.end())
 	{
@@ -172,6 +189,14 @@ void WtHftEngine::handle_push_order_queue(WTSOrdQueData* curOrdQue)
 void WtHftEngine::handle_push_transaction(WTSTransData* curTrans)
 {
 	const char* stdCode = curTrans->code();
+	const CtxList* ctxs = find_flat_subs(_trans_subs, curTrans->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IHftStraCtx* ctx : *ctxs)
+			ctx->on_transaction(stdCode, curTrans);
+		return;
+	}
+
 	auto sit = _trans_sub_map.find(stdCode);
 	if (sit != _trans_sub_map.end())
 	{
@@ -198,8 +223,11 @@ void WtHftEngine::sub_order_detail(uint32_t sid, const char* stdCode)
 	if (stdCode[length - 1] == SUFFIX_QFQ || stdCode[length - 1] == SUFFIX_HFQ)
 		length--;
 
-	SubList& sids = _orddtl_sub_map[std::string(stdCode, length)];
+	std::string key(stdCode, length);
+	SubList& sids = _orddtl_sub_map[key];
 	sids[sid] = std::make_pair(sid, 0);
+
+	add_flat_sub(_orddtl_subs, key.c_str(), sid);
 }
 
 void WtHftEngine::sub_order_queue(uint32_t sid, const char* stdCode)
@@ -208,8 +236,11 @@ void WtHftEngine::sub_order_queue(uint32_t sid, const char* stdCode)
 	if (stdCode[length - 1] == SUFFIX_QFQ || stdCode[length - 1] == SUFFIX_HFQ)
 		length--;
 
-	SubList& sids = _ordque_sub_map[std::string(stdCode, length)];
+	std::string key(stdCode, length);
+	SubList& sids = _ordque_sub_map[key];
 	sids[sid] = std::make_pair(sid, 0);
+
+	add_flat_sub(_ordque_subs, key.c_str(), sid);
 }
 
 void WtHftEngine::sub_transaction(uint32_t sid, const char* stdCode)
@@ -218,8 +249,11 @@ void WtHftEngine::sub_transaction(uint32_t sid, const char* stdCode)
 	if (stdCode[length - 1] == SUFFIX_QFQ || stdCode[length - 1] == SUFFIX_HFQ)
 		length--;
 
-	SubList& sids = _trans_sub_map[std::string(stdCode, length)];
+	std::string key(stdCode, length);
+	SubList& sids = _trans_sub_map[key];
 	sids[sid] = std::make_pair(sid, 0);
+
+	add_flat_sub(_trans_subs, key.c_str(), sid);
 }
 
 void WtHftEngine::on_tick(const char* stdCode, WTSTickData* curTick)
@@ -352,6 +386,48 @@ void WtHftEngine::addContext(HftContextPtr ctx)
 {
 	uint32_t sid = ctx->id();
 	_ctx_map[sid] = ctx;
+
+	//on_initﶩĵʱܻûмӽؽһ
+	rebuild_flat_subs(_ordque_subs, _ordque_sub_map);
+	rebuild_flat_subs(_orddtl_subs, _orddtl_sub_map);
+	rebuild_flat_subs(_trans_subs, _trans_sub_map);
+}
+
+void WtHftEngine::add_flat_sub(FlatSubTable& table, const char* stdCode, uint32_t sid)
+{
+	auto cit = _ctx_map.find(sid);
+	if (cit == _ctx_map.end())
+		return;
+
+	WTSContractInfo* cInfo = get_contract_info(stdCode);
+	if (cInfo == NULL || cInfo->getSymbolID() == 0)
+		return;
+
+	//Level2ݵĴɺԼתı׼룬ֻȫһµĶĲܰԼIDַ
+	WTSCommodityInfo* commInfo = cInfo->getCommInfo();
+	std::string rawStdCode = CodeHelper::rawFlatCodeToStdCode(cInfo->getCode(), cInfo->getExchg(), commInfo->getProduct());
+	if (rawStdCode != stdCode)
+		return;
+
+	uint32_t symId = cInfo->getSymbolID();
+	if (symId >= table.size())
+		table.resize(symId + 1);
+
+	CtxList& ctxs = table[symId];
+	IHftStraCtx* ctx = cit->second.get();
+	if (std::find(ctxs.begin(), ctxs.end(), ctx) == ctxs.end())
+		ctxs.emplace_back(ctx);
+}
+
+void WtHftEngine::rebuild_flat_subs(FlatSubTable& table, const StraSubMap& subMap)
+{
+	table.clear();
+	for (auto it = subMap.begin(); it != subMap.end(); it++)
+	{
+		const SubList& sids = it->second;
+		for (auto sit = sids.begin(); sit != sids.end(); sit++)
+			add_flat_sub(table, it->first.c_str(), sit->first);
+	}
 }
 
 HftContextPtr WtHftEngine::getContext(uint32_t id)
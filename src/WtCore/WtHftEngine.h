@@ -12,6 +12,7 @@
 #include "WtLocalExecuter.h"
 
 #include "../Includes/IHftStraCtx.h"
+#include "../Includes/WTSContractInfo.hpp"
 
 NS_WTP_BEGIN
 
@@ -73,6 +74,44 @@ private:
 	StraSubMap		_ordque_sub_map;	//ίжжı
 	StraSubMap		_orddtl_sub_map;	//ίϸı
 	StraSubMap		_trans_sub_map;		//ɽϸı
+
+	//պԼIDLevel2ı±ΪԼIDԪΪ˸úԼĲ
+	//tickΪȨȴ빲ͬһԼȻַ
+	typedef std::vector<IHftStraCtx*>	CtxList;
+	typedef std::vector<CtxList>		FlatSubTable;
+
+	FlatSubTable	_ordque_subs;	//ԼIDίжжı
+	FlatSubTable	_orddtl_subs;	//ԼIDίϸı
+	FlatSubTable	_trans_subs;	//ԼIDĳɽϸı
+
+private:
+	/*
+	 *	һļӵԼIDĶı
+	 *	ֻдͺԼı׼һµĶĲŻӽȻַ
+	 */
+	void	add_flat_sub(FlatSubTable& table, const char* stdCode, uint32_t sid);
+
+	/*
+	 *	ַĶıؽԼIDĶı
+	 */
+	void	rebuild_flat_subs(FlatSubTable& table, const StraSubMap& subMap);
+
+	/*
+	 *	ҰԼIDĶб
+	 *	NULL˵ûйԼIDҪ˵
+	 */
+	inline const CtxList* find_flat_subs(const FlatSubTable& table, WTSContractInfo* cInfo) const
+	{
+		static const CtxList EMPTY_LIST;
+		if (cInfo == NULL || cInfo->getSymbolID() == 0)
+			return NULL;
+
+		uint32_t symId = cInfo->getSymbolID();
+		if (symId >= table.size())
+			return &EMPTY_LIST;
+
+		return &table[symId];
+	}
 };
 
 NS_WTP_END
\ No newline at end of file
@@ -32,6 +32,7 @@ typedef enum tagBlockType
 #define BLOCK_VERSION_CMP		0x02	//Ͻṹѹ
 #define BLOCK_VERSION_RAW_V2	0x03	//½ṹδѹ
 #define BLOCK_VERSION_CMP_V2	0x04	//½ṹѹ
+#define BLOCK_VERSION_BTCACHE	0x10	//زõĽѹ棬δѹԴļУϢ
 
 typedef struct _BlockHeader
 {
@@ -138,6 +139,19 @@ typedef struct _HisTickBlockV2 : BlockHeaderV2
 	char			_data[0];
 } HisTickBlockV2;
 
+/*
+ *	زõtickѹ棬ݲֺHisTickBlockһֱӳʹ
+ *	ԴļĴС޸ʱˣʧЧ
+ *	ͷ32ֽڣ֤tick8ֽڶ
+ */
+typedef struct _HisTickCacheBlock : BlockHeader
+{
+	uint32_t		_count;		//tick
+	uint64_t		_src_size;	//ԴļС
+	uint64_t		_src_mtime;	//Դļ޸ʱ
+	WTSTickStruct	_ticks[0];
+} HisTickCacheBlock;
+
 typedef struct _HisTransBlock : BlockHeader
 {
 	WTSTransStruct	_items[0];
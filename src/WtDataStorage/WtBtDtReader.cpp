@@ -2,6 +2,7 @@
 
 #include "../Includes/WTSVariant.hpp"
 #include "../Share/StrUtil.hpp"
+#include "../Share/BoostFile.hpp"
 #include "../WTSUtils/WTSCmpHelper.hpp"
 
 //By Wesley @ 2022.01.05
@@ -42,6 +43,7 @@ extern "C"
 extern bool proc_block_data(std::string& content, bool isBar, bool bKeepHead);
 
 WtBtDtReader::WtBtDtReader()
+	: _tick_cache(false)
 {
 }
 
@@ -61,7 +63,18 @@ void WtBtDtReader::init(WTSVariant* cfg, IBtDtReaderSink* sink)
 	_base_dir = cfg->getCString("path");
 	_base_dir = StrUtil::standardisePath(_base_dir);
 
+	_tick_cache = cfg->getBoolean("tick_cache");
+	if (_tick_cache)
+	{
+		_cache_dir = cfg->getCString("cache_path");
+		if (_cache_dir.empty())
+			_cache_dir = _base_dir + "cache/";
+		_cache_dir = StrUtil::standardisePath(_cache_dir);
+	}
+
 	pipe_btreader_log(_sink, LL_INFO, "WtBtDtReader initialized, root data dir is {}", _base_dir);
+	if (_tick_cache)
+		pipe_btreader_log(_sink, LL_INFO, "Tick cache of backtest enabled, cache dir is {}", _cache_dir);
 }
 
 bool WtBtDtReader::read_raw_bars(const char* exchg, const char* code, WTSKlinePeriod period, std::string& buffer)
@@ -158,4 +171,106 @@ bool WtBtDtReader::read_raw_transactions(const char* exchg, const char* code, ui
 		pipe_btreader_log(_sink, LL_ERROR, "Processing back transaction data from file {} failed", filename);
 
 	return bSucc;
-}
\ No newline at end of file
+}
+
+BoostMFPtr WtBtDtReader::map_tick_cache(const std::string& filename, uint64_t srcSize, uint64_t srcTime)
+{
+	if (!StdFile::exists(filename.c_str()))
+		return BoostMFPtr();
+
+	BoostMFPtr mf(new BoostMappingFile);
+	if (!mf->map(filename.c_str(), boost::interprocess::read_only, boost::interprocess::read_only))
+		return BoostMFPtr();
+
+	if (mf->size() < sizeof(HisTickCacheBlock))
+		return BoostMFPtr();
+
+	HisTickCacheBlock* tBlock = (HisTickCacheBlock*)mf->addr();
+	if (memcmp(tBlock->_blk_flag, BLK_FLAG, FLAG_SIZE) != 0 || tBlock->_version != BLOCK_VERSION_BTCACHE
+		|| tBlock->_src_size != srcSize || tBlock->_src_mtime != srcTime
+		|| mf->size() != sizeof(HisTickCacheBlock) + sizeof(WTSTickStruct)*tBlock->_count)
+	{
+		pipe_btreader_log(_sink, LL_INFO, "Tick cache file {} expired", filename);
+		return BoostMFPtr();
+	}
+
+	return mf;
+}
+
+bool WtBtDtReader::map_raw_ticks(const char* exchg, const char* code, uint32_t uDate, std::shared_ptr<void>& holder, WTSTickStruct*& ticks, std::size_t& count)
+{
+	if (!_tick_cache)
+		return false;
+
+	std::stringstream ss;
+	ss << _base_dir << "his/ticks/" << exchg << "/" << uDate << "/" << code << ".dsb";
+	std::string filename = ss.str();
+	if (!StdFile::exists(filename.c_str()))
+		return false;
+
+	boost::system::error_code ec;
+	uint64_t srcSize = (uint64_t)boost::filesystem::file_size(filename, ec);
+	uint64_t srcTime = (uint64_t)boost::filesystem::last_write_time(filename, ec);
+	if (ec)
+		return false;
+
+	ss.str("");
+	ss << _cache_dir << "ticks/" << exchg << "/" << uDate << "/";
+	std::string folder = ss.str();
+	std::string cacheFile = folder + code + ".dmb";
+
+	BoostMFPtr mf = map_tick_cache(cacheFile, srcSize, srcTime);
+	if (mf == NULL)
+	{
+		//治ڻѾʧЧѹԴļ
+		std::string buffer;
+		StdFile::read_file_content(filename.c_str(), buffer);
+		if (!proc_block_data(buffer, false, false))
+		{
+			pipe_btreader_log(_sink, LL_ERROR, "Processing back tick data from file {} failed", filename);
+			return false;
+		}
+
+		HisTickCacheBlock header;
+		memset(&header, 0, sizeof(HisTickCacheBlock));
+		memcpy(header._blk_flag, BLK_FLAG, FLAG_SIZE);
+		header._type = BT_HIS_Ticks;
+		header._version = BLOCK_VERSION_BTCACHE;
+		header._count = (uint32_t)(buffer.size() / sizeof(WTSTickStruct));
+		header._src_size = srcSize;
+		header._src_mtime = srcTime;
+
+		//дʱļٸͬʱɻʱҲдһļ
+		boost::filesystem::create_directories(folder, ec);
+		std::string tmpFile = boost::filesystem::unique_path(cacheFile + ".%%%%-%%%%.tmp").string();
+		{
+			BoostFile bf;
+			if (!bf.create_new_file(tmpFile.c_str()))
+			{
+				pipe_btreader_log(_sink, LL_ERROR, "Creating tick cache file {} failed", tmpFile);
+				return false;
+			}
+			bf.write_file(&header, sizeof(HisTickCacheBlock));
+			bf.write_file(buffer.data(), header._count*sizeof(WTSTickStruct));
+			bf.close_file();
+		}
+		boost::filesystem::rename(tmpFile, cacheFile, ec);
+		if (ec)
+		{
+			boost::filesystem::remove(tmpFile, ec);
+			return false;
+		}
+
+		pipe_btreader_log(_sink, LL_DEBUG, "{} ticks of {}.{} on {} cached to {}", header._count, exchg, code, uDate, cacheFile);
+
+		mf = map_tick_cache(cacheFile, srcSize, srcTime);
+		if (mf == NULL)
+			return false;
+	}
+
+	HisTickCacheBlock* tBlock = (HisTickCacheBlock*)mf->addr();
+	holder = mf;
+	ticks = tBlock->_ticks;
+	count = tBlock->_count;
+	return true;
+}
@@ -41,8 +41,20 @@ public:
 	virtual bool read_raw_order_queues(const char* exchg, const char* code, uint32_t uDate, std::string& buffer) override;
 	virtual bool read_raw_transactions(const char* exchg, const char* code, uint32_t uDate, std::string& buffer) override;
 
+	virtual bool map_raw_ticks(const char* exchg, const char* code, uint32_t uDate, std::shared_ptr<void>& holder, WTSTickStruct*& ticks, std::size_t& count) override;
+
+private:
+	/*
+	 *	ӳtickѹļǷԴļһ
+	 */
+	BoostMFPtr	map_tick_cache(const std::string& filename, uint64_t srcSize, uint64_t srcTime);
+
 private:
 	std::string		_base_dir;
+
+	//tickѹ棬һζȡʱѽѹдĿ¼ֱ֮ӳ
+	bool			_tick_cache;
+	std::string		_cache_dir;
 };
 
 NS_WTP_END
\ No newline at end of file
@@ -55,8 +55,12 @@ static const uint32_t CACHE_SIZE_STEP = 200;
 static const uint32_t TICK_SIZE_STEP = 2500;
 static const uint32_t KLINE_SIZE_STEP = 200;
 
+//ʱݵڹ̶
+static const uint32_t MAX_GROW_SCALE = 64;
+
 const char CMD_CLEAR_CACHE[] = "CMD_CLEAR_CACHE";
 const char MARKER_FILE[] = "marker.ini";
+const char SIZEHINT_FILE[] = "rtsizes.csv";
 
 
 WtDataWriter::WtDataWriter()
@@ -73,6 +77,13 @@ WtDataWriter::WtDataWriter()
 	, _disable_his(false)
 	, _skip_notrade_tick(false)
 	, _skip_notrade_bar(false)
+	, _task_waiting(false)
+	, _queue_size(65536)
+	, _drop_if_full(false)
+	, _dropped_cnt(0)
+	, _max_depth(0)
+	, _grow_geometric(false)
+	, _presize(false)
 {
 }
 
@@ -108,6 +119,19 @@ bool WtDataWriter::init(WTSVariant* params, IDataWriterSink* sink)
 	_async_proc = params->getBoolean("async");
 	_log_group_size = params->getUInt32("groupsize");
 
+	/*
+	 *	첽еԼԺĴ
+	 *	overflowΪblockʱд̵߳ȴ̣߳ΪdropʱֱӶ
+	 */
+	if (params->has("queuesize"))
+		_queue_size = params->getUInt32("queuesize");
+	_drop_if_full = (strcmp(params->getCString("overflow"), "drop") == 0);
+	if (_async_proc)
+	{
+		_tasks.reset(new TaskQueue(_queue_size));
+		_task_thrd.reset(new StdThread(boost::bind(&WtDataWriter::task_loop, this)));
+	}
+
 	// ûгɽtickЩԴвڸbar,һϸ
 	// ûгɽtickȻһbar۸ǰһbarοڣ
 	_skip_notrade_tick = params->getBoolean("skip_notrade_tick");
@@ -128,6 +152,16 @@ bool WtDataWriter::init(WTSVariant* params, IDataWriterSink* sink)
 
 	_min_price_mode = params->getUInt32("minbar_price_mode");
 
+	/*
+	 *	ʵʱݿݲ
+	 *	growmodeΪfixedʱ̶ݣΪgeometricʱǰݣޣ
+	 *	presizeΪtrueʱ½ʵʱݿᰴһյԤ
+	 */
+	_grow_geometric = (strcmp(params->getCString("growmode"), "geometric") == 0);
+	_presize = params->getBoolean("presize");
+	if (_presize)
+		loadSizeHints();
+
 	{
 		std::string filename = _base_dir + MARKER_FILE;
 		IniHelper iniHelper;
@@ -144,10 +178,12 @@ bool WtDataWriter::init(WTSVariant* params, IDataWriterSink* sink)
 
 	_proc_chk.reset(new StdThread(boost::bind(&WtDataWriter::check_loop, this)));
 
-	pipe_writer_log(sink, LL_INFO, "WtDataWriter initialized, root dir: {}, save_csv_tick: {}, async_mode: {}, log_group_size: {}, disable_history: {}, "
-		"disable_tick: {}, disable_min1: {}, disable_min5: {}, disable_day: {}, disable_trans: {}, disable_ordque: {}, disable_orders: {}, min_price_mode: {}", 
-		_base_dir, _save_tick_log, _async_proc, _log_group_size, _disable_his, _disable_tick, 
-		_disable_min1, _disable_min5, _disable_day, _disable_trans, _disable_ordque, _disable_orddtl, _min_price_mode);
+	pipe_writer_log(sink, LL_INFO, "WtDataWriter initialized, root dir: {}, save_csv_tick: {}, async_mode: {}, queue_size: {}, drop_if_full: {}, log_group_size: {}, disable_history: {}, "
+		"disable_tick: {}, disable_min1: {}, disable_min5: {}, disable_day: {}, disable_trans: {}, disable_ordque: {}, disable_orders: {}, min_price_mode: {}, "
+		"grow_mode: {}, presize: {}", 
+		_base_dir, _save_tick_log, _async_proc, _async_proc ? _tasks->capacity() : 0, _drop_if_full, _log_group_size, _disable_his, _disable_tick, 
+		_disable_min1, _disable_min5, _disable_day, _disable_trans, _disable_ordque, _disable_orddtl, _min_price_mode,
+		_grow_geometric ? "geometric" : "fixed", _presize);
 	return true;
 }
 
@@ -160,6 +196,19 @@ void WtDataWriter::release()
 		_proc_thrd->join();
 	}
 
+	if (_task_thrd)
+	{
+		_task_cond.notify_all();
+		_task_thrd->join();
+
+		//߳˳Ժ󣬶ʣµҪͷŵ
+		TaskInfo task;
+		while (_tasks->try_pop(task))
+			task._data->release();
+
+		pipe_writer_log(_sink, LL_INFO, "Async task queue of WtDataWriter stopped, max depth: {}, dropped: {}", _max_depth, getDroppedCount());
+	}
+
 	for(auto& v : _rt_ticks_blocks)
 	{
 		delete v.second;
@@ -297,16 +346,16 @@ void* WtDataWriter::resizeRTBlock(BoostMFPtr& mfPtr, uint32_t nCount)
 		return mfPtr->addr();
 
 	std::string filename = mfPtr->filename();
-	uint64_t uOldSize = sizeof(HeaderType) + sizeof(T)*tBlock->_capacity;
 	uint64_t uNewSize = sizeof(HeaderType) + sizeof(T)*nCount;
-	std::string data;
-	data.resize((std::size_t)(uNewSize - uOldSize), 0);
 	try
 	{
+		/*
+		 *	ǰļĩβдһȫ0ݣԽдԽ
+		 *	ֱ޸ļСĲɲϵͳ0Ҫʵд
+		 */
 		BoostFile f;
 		f.open_existing_file(filename.c_str());
-		f.seek_to_end();
-		f.write_file(data.c_str(), data.size());
+		f.truncate_file((std::size_t)uNewSize);
 		f.close_file();
 	}
 	catch(std::exception& ex)
@@ -339,49 +388,100 @@ void* WtDataWriter::resizeRTBlock(BoostMFPtr& mfPtr, uint32_t nCount)
 	return mfPtr->addr();
 }
 
-bool WtDataWriter::writeTick(WTSTickData* curTick, uint32_t procFlag)
+uint32_t WtDataWriter::calcGrowCapacity(uint32_t curCap, uint32_t step)
 {
-	if (curTick == NULL)
-		return false;
+	if (!_grow_geometric)
+		return curCap + step;
 
-	curTick->retain();
-	pushTask([this, curTick, procFlag](){
+	//ݣԽ࣬ݴԽ٣ǵݲMAX_GROW_SCALE
+	uint32_t incCap = max(step, min(curCap, step*MAX_GROW_SCALE));
+	return curCap + incCap;
+}
 
-		do
-		{
-			WTSContractInfo* ct = curTick->getContractInfo();
-			if(ct == NULL)
-				break;
+uint32_t WtDataWriter::calcInitCapacity(const char* tag, WTSContractInfo* ct, uint32_t step)
+{
+	if (!_presize)
+		return step;
 
-			WTSCommodityInfo* commInfo = ct->getCommInfo();
+	std::string key = fmt::format("{}.{}", tag, ct->getFullCode());
+	uint32_t count = 0;
+	{
+		SpinLock lock(_mtx_hints);
+		auto it = _size_hints.find(key);
+		if (it == _size_hints.end())
+			return step;
 
-			//ٸ״̬
-			if (!_sink->canSessionReceive(commInfo->getSession()))
-				break;
+		count = it->second;
+	}
 
-			//ȸ»
-			if (!updateCache(ct, curTick, procFlag))
-				break;
+	//һյ϶Ԥ10%ٰȡ
+	uint32_t hint = count + count / 10;
+	uint32_t scale = (hint + step - 1) / step;
+	return max(1U, scale)*step;
+}
 
-			//дtick
-			if(!_disable_tick)
-				pipeToTicks(ct, curTick);
+void WtDataWriter::recordSizeHint(const char* tag, WTSContractInfo* ct, uint32_t count)
+{
+	if (!_presize || count == 0)
+		return;
 
-			//дK߻
-			pipeToKlines(ct, curTick);
+	std::string key = fmt::format("{}.{}", tag, ct->getFullCode());
+	SpinLock lock(_mtx_hints);
+	_size_hints[key] = count;
+}
 
-			_sink->broadcastTick(curTick);
+void WtDataWriter::loadSizeHints()
+{
+	std::string filename = _base_dir + SIZEHINT_FILE;
+	if (!BoostFile::exists(filename.c_str()))
+		return;
 
-			static wt_hashmap<std::string, uint64_t> _tcnt_map;
-			_tcnt_map[curTick->exchg()]++;
-			if (_tcnt_map[curTick->exchg()] % _log_group_size == 0)
-			{
-				pipe_writer_log(_sink, LL_INFO, "{} ticks received from exchange {}", _tcnt_map[curTick->exchg()], curTick->exchg());
-			}
-		} while (false);
+	std::string content;
+	BoostFile::read_file_contents(filename.c_str(), content);
+	const StringVector& lines = StrUtil::split(content, "\n");
+	for (const std::string& line : lines)
+	{
+		const StringVector& ay = StrUtil::split(line, ",");
+		if (ay.size() < 2)
+			continue;
+
+		_size_hints[ay[0]] = strtoul(ay[1].c_str(), NULL, 10);
+	}
+
+	pipe_writer_log(_sink, LL_INFO, "{} size hints of RT blocks loaded from {}", _size_hints.size(), filename);
+}
+
+void WtDataWriter::saveSizeHints()
+{
+	if (!_presize)
+		return;
+
+	std::stringstream ss;
+	{
+		SpinLock lock(_mtx_hints);
+		if (_size_hints.empty())
+			return;
+
+		for (auto& v : _size_hints)
+			ss << v.first << "," << v.second << "\n";
+	}
+
+	std::string filename = _base_dir + SIZEHINT_FILE;
+	BoostFile f;
+	if (f.create_new_file(filename.c_str()))
+	{
+		f.write_file(ss.str());
+		f.close_file();
+	}
+}
+
+bool WtDataWriter::writeTick(WTSTickData* curTick, uint32_t procFlag)
+{
+	if (curTick == NULL)
+		return false;
 
-		curTick->release();
-	});
+	curTick->retain();
+	pushTask(TaskInfo(curTick, TT_Tick, procFlag));
 	return true;
 }
 
@@ -391,205 +491,279 @@ bool WtDataWriter::writeOrderQueue(WTSOrdQueData* curOrdQue)
 		return false;
 
 	curOrdQue->retain();
-	pushTask([this, curOrdQue](){
-
-		do
-		{
-			WTSContractInfo* ct = _bd_mgr->getContract(curOrdQue->code(), curOrdQue->exchg());
-			if (ct == NULL)
-				break;
-
-			WTSCommodityInfo* commInfo = ct->getCommInfo();
-
-			//ٸ״̬
-			if (!_sink->canSessionReceive(commInfo->getSession()))
-				break;
+	pushTask(TaskInfo(curOrdQue, TT_OrdQue));
+	return true;
+}
 
-			OrdQueBlockPair* pBlockPair = getOrdQueBlock(ct, curOrdQue->tradingdate());
-			if (pBlockPair == NULL)
-				break;
+bool WtDataWriter::writeOrderDetail(WTSOrdDtlData* curOrdDtl)
+{
+	if (curOrdDtl == NULL || _disable_orddtl)
+		return false;
 
-			SpinLock lock(pBlockPair->_mutex);
+	curOrdDtl->retain();
+	pushTask(TaskInfo(curOrdDtl, TT_OrdDtl));
+	return true;
+}
 
-			//ȼ,Ҫ
-			RTOrdQueBlock* blk = pBlockPair->_block;
-			if (blk->_size >= blk->_capacity)
-			{
-				pBlockPair->_file->sync();
-				pBlockPair->_block = (RTOrdQueBlock*)resizeRTBlock<RTDayBlockHeader, WTSOrdQueStruct>(pBlockPair->_file, blk->_capacity + TICK_SIZE_STEP);
-				blk = pBlockPair->_block;
-			}
+bool WtDataWriter::writeTransaction(WTSTransData* curTrans)
+{
+	if (curTrans == NULL || _disable_trans)
+		return false;
 
-			memcpy(&blk->_queues[blk->_size], &curOrdQue->getOrdQueStruct(), sizeof(WTSOrdQueStruct));
-			blk->_size += 1;
+	curTrans->retain();
+	pushTask(TaskInfo(curTrans, TT_Trans));
+	return true;
+}
 
-			//TODO: Ҫ㲥
-			//g_udpCaster.broadcast(curTrans);
+void WtDataWriter::pushTask(const TaskInfo& task)
+{
+	if(!_async_proc)
+	{
+		procTask(task);
+		return;
+	}
 
-			static wt_hashmap<std::string, uint64_t> _tcnt_map;
-			_tcnt_map[curOrdQue->exchg()]++;
-			if (_tcnt_map[curOrdQue->exchg()] % _log_group_size == 0)
+	if(!_tasks->try_push(task))
+	{
+		if(_drop_if_full)
+		{
+			task._data->release();
+			uint64_t cnt = _dropped_cnt.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (cnt % _log_group_size == 1)
+				pipe_writer_log(_sink, LL_WARN, "Async task queue of WtDataWriter is full, {} items dropped", cnt);
+		}
+		else
+		{
+			//ˣ͵ȴ߳
+			while (!_tasks->try_push(task))
 			{
-				pipe_writer_log(_sink, LL_INFO, "{} orderques received from exchange {}", _tcnt_map[curOrdQue->exchg()], curOrdQue->exchg());
+				_task_cond.notify_all();
+				std::this_thread::yield();
 			}
-		} while (false);
-		curOrdQue->release();
-	});
-	return true;
-}
+		}
+	}
 
-void WtDataWriter::pushTask(TaskInfo task)
-{
-	if(_async_proc)
+	if (_task_waiting.load())
 	{
 		StdUniqueLock lck(_task_mtx);
-		_tasks.push(task);
 		_task_cond.notify_all();
 	}
-	else
-	{
-		task();
-		return;
-	}
+}
 
-	if(_task_thrd == NULL)
+void WtDataWriter::task_loop()
+{
+	TaskInfo curTask;
+	while (!_terminated)
 	{
-		_task_thrd.reset(new StdThread([this](){
-			while (!_terminated)
-			{
-				if(_tasks.empty())
-				{
-					StdUniqueLock lck(_task_mtx);
-					_task_cond.wait(_task_mtx);
-					continue;
-				}
+		std::size_t depth = _tasks->size();
+		if (depth > _max_depth)
+			_max_depth = depth;
 
-				std::queue<TaskInfo> tempQueue;
-				{
-					StdUniqueLock lck(_task_mtx);
-					tempQueue.swap(_tasks);
-				}
+		uint32_t cnt = 0;
+		while (_tasks->try_pop(curTask))
+		{
+			procTask(curTask);
+			cnt++;
+		}
 
-				while(!tempQueue.empty())
-				{
-					TaskInfo& curTask = tempQueue.front();
-					curTask();
-					tempQueue.pop();
-				}
-			}
-		}));
+		if (cnt > 0)
+			continue;
+
+		//пˣȰѵȴϣټһΣֹʧ֪ͨ
+		StdUniqueLock lck(_task_mtx);
+		_task_waiting.store(true);
+		if (_tasks->empty() && !_terminated)
+			_task_cond.wait_for(lck, std::chrono::milliseconds(10));
+		_task_waiting.store(false);
 	}
 }
 
-bool WtDataWriter::writeOrderDetail(WTSOrdDtlData* curOrdDtl)
+void WtDataWriter::procTask(const TaskInfo& task)
 {
-	if (curOrdDtl == NULL || _disable_orddtl)
-		return false;
+	switch (task._type)
+	{
+	case TT_Tick: procTick((WTSTickData*)task._data, task._flag); break;
+	case TT_OrdQue: procOrdQue((WTSOrdQueData*)task._data); break;
+	case TT_OrdDtl: procOrdDtl((WTSOrdDtlData*)task._data); break;
+	case TT_Trans: procTrans((WTSTransData*)task._data); break;
+	default:
+		task._data->release();
+		break;
+	}
+}
 
-	curOrdDtl->retain();
-	pushTask([this, curOrdDtl](){
+void WtDataWriter::procTick(WTSTickData* curTick, uint32_t procFlag)
+{
+	do
+	{
+		WTSContractInfo* ct = curTick->getContractInfo();
+		if(ct == NULL)
+			break;
+
+		WTSCommodityInfo* commInfo = ct->getCommInfo();
+
+		//ٸ״̬
+		if (!_sink->canSessionReceive(commInfo->getSession()))
+			break;
+
+		//ȸ»
+		if (!updateCache(ct, curTick, procFlag))
+			break;
 
-		do
+		//дtick
+		if(!_disable_tick)
+			pipeToTicks(ct, curTick);
+
+		//дK߻
+		pipeToKlines(ct, curTick);
+
+		_sink->broadcastTick(curTick);
+
+		static wt_hashmap<std::string, uint64_t> _tcnt_map;
+		_tcnt_map[curTick->exchg()]++;
+		if (_tcnt_map[curTick->exchg()] % _log_group_size == 0)
 		{
+			pipe_writer_log(_sink, LL_INFO, "{} ticks received from exchange {}", _tcnt_map[curTick->exchg()], curTick->exchg());
+		}
+	} while (false);
 
-			WTSContractInfo* ct = _bd_mgr->getContract(curOrdDtl->code(), curOrdDtl->exchg());
-			if (ct == NULL)
-				break;
+	curTick->release();
+}
 
-			WTSCommodityInfo* commInfo = ct->getCommInfo();
+void WtDataWriter::procOrdQue(WTSOrdQueData* curOrdQue)
+{
+	do
+	{
+		WTSContractInfo* ct = _bd_mgr->getContract(curOrdQue->code(), curOrdQue->exchg());
+		if (ct == NULL)
+			break;
 
-			//ٸ״̬
-			if (!_sink->canSessionReceive(commInfo->getSession()))
-				break;
+		WTSCommodityInfo* commInfo = ct->getCommInfo();
 
-			OrdDtlBlockPair* pBlockPair = getOrdDtlBlock(ct, curOrdDtl->tradingdate());
-			if (pBlockPair == NULL)
-				break;
+		//ٸ״̬
+		if (!_sink->canSessionReceive(commInfo->getSession()))
+			break;
 
-			SpinLock lock(pBlockPair->_mutex);
+		OrdQueBlockPair* pBlockPair = getOrdQueBlock(ct, curOrdQue->tradingdate());
+		if (pBlockPair == NULL)
+			break;
 
-			//ȼ,Ҫ
-			RTOrdDtlBlock* blk = pBlockPair->_block;
-			if (blk->_size >= blk->_capacity)
-			{
-				pBlockPair->_file->sync();
-				pBlockPair->_block = (RTOrdDtlBlock*)resizeRTBlock<RTDayBlockHeader, WTSOrdDtlStruct>(pBlockPair->_file, blk->_capacity + TICK_SIZE_STEP);
-				blk = pBlockPair->_block;
-			}
+		SpinLock lock(pBlockPair->_mutex);
 
-			memcpy(&blk->_details[blk->_size], &curOrdDtl->getOrdDtlStruct(), sizeof(WTSOrdDtlStruct));
-			blk->_size += 1;
+		//ȼ,Ҫ
+		RTOrdQueBlock* blk = pBlockPair->_block;
+		if (blk->_size >= blk->_capacity)
+		{
+			pBlockPair->_block = (RTOrdQueBlock*)resizeRTBlock<RTDayBlockHeader, WTSOrdQueStruct>(pBlockPair->_file, calcGrowCapacity(blk->_capacity, TICK_SIZE_STEP));
+			blk = pBlockPair->_block;
+		}
 
-			//TODO: Ҫ㲥
-			//g_udpCaster.broadcast(curTrans);
+		memcpy(&blk->_queues[blk->_size], &curOrdQue->getOrdQueStruct(), sizeof(WTSOrdQueStruct));
+		blk->_size += 1;
 
-			static wt_hashmap<std::string, uint64_t> _tcnt_map;
-			_tcnt_map[curOrdDtl->exchg()]++;
-			if (_tcnt_map[curOrdDtl->exchg()] % _log_group_size == 0)
-			{
-				pipe_writer_log(_sink, LL_INFO, "{} orderdetails received from exchange {}", _tcnt_map[curOrdDtl->exchg()], curOrdDtl->exchg());
-			}
-		} while (false);
+		//TODO: Ҫ㲥
+		//g_udpCaster.broadcast(curTrans);
 
-		curOrdDtl->release();
-	});
-	
-	return true;
+		static wt_hashmap<std::string, uint64_t> _tcnt_map;
+		_tcnt_map[curOrdQue->exchg()]++;
+		if (_tcnt_map[curOrdQue->exchg()] % _log_group_size == 0)
+		{
+			pipe_writer_log(_sink, LL_INFO, "{} orderques received from exchange {}", _tcnt_map[curOrdQue->exchg()], curOrdQue->exchg());
+		}
+	} while (false);
+	curOrdQue->release();
 }
 
-bool WtDataWriter::writeTransaction(WTSTransData* curTrans)
+void WtDataWriter::procOrdDtl(WTSOrdDtlData* curOrdDtl)
 {
-	if (curTrans == NULL || _disable_trans)
-		return false;
+	do
+	{
 
-	curTrans->retain();
-	pushTask([this, curTrans](){
+		WTSContractInfo* ct = _bd_mgr->getContract(curOrdDtl->code(), curOrdDtl->exchg());
+		if (ct == NULL)
+			break;
+
+		WTSCommodityInfo* commInfo = ct->getCommInfo();
+
+		//ٸ״̬
+		if (!_sink->canSessionReceive(commInfo->getSession()))
+			break;
+
+		OrdDtlBlockPair* pBlockPair = getOrdDtlBlock(ct, curOrdDtl->tradingdate());
+		if (pBlockPair == NULL)
+			break;
 
-		do
+		SpinLock lock(pBlockPair->_mutex);
+
+		//ȼ,Ҫ
+		RTOrdDtlBlock* blk = pBlockPair->_block;
+		if (blk->_size >= blk->_capacity)
 		{
+			pBlockPair->_block = (RTOrdDtlBlock*)resizeRTBlock<RTDayBlockHeader, WTSOrdDtlStruct>(pBlockPair->_file, calcGrowCapacity(blk->_capacity, TICK_SIZE_STEP));
+			blk = pBlockPair->_block;
+		}
 
-			WTSContractInfo* ct = _bd_mgr->getContract(curTrans->code(), curTrans->exchg());
-			if (ct == NULL)
-				break;
+		memcpy(&blk->_details[blk->_size], &curOrdDtl->getOrdDtlStruct(), sizeof(WTSOrdDtlStruct));
+		blk->_size += 1;
 
-			WTSCommodityInfo* commInfo = ct->getCommInfo();
+		//TODO: Ҫ㲥
+		//g_udpCaster.broadcast(curTrans);
 
-			//ٸ״̬
-			if (!_sink->canSessionReceive(commInfo->getSession()))
-				break;
+		static wt_hashmap<std::string, uint64_t> _tcnt_map;
+		_tcnt_map[curOrdDtl->exchg()]++;
+		if (_tcnt_map[curOrdDtl->exchg()] % _log_group_size == 0)
+		{
+			pipe_writer_log(_sink, LL_INFO, "{} orderdetails received from exchange {}", _tcnt_map[curOrdDtl->exchg()], curOrdDtl->exchg());
+		}
+	} while (false);
 
-			TransBlockPair* pBlockPair = getTransBlock(ct, curTrans->tradingdate());
-			if (pBlockPair == NULL)
-				break;
+	curOrdDtl->release();
+}
 
-			SpinLock lock(pBlockPair->_mutex);
+void WtDataWriter::procTrans(WTSTransData* curTrans)
+{
+	do
+	{
 
-			//ȼ,Ҫ
-			RTTransBlock* blk = pBlockPair->_block;
-			if (blk->_size >= blk->_capacity)
-			{
-				pBlockPair->_file->sync();
-				pBlockPair->_block = (RTTransBlock*)resizeRTBlock<RTDayBlockHeader, WTSTransStruct>(pBlockPair->_file, blk->_capacity + TICK_SIZE_STEP);
-				blk = pBlockPair->_block;
-			}
+		WTSContractInfo* ct = _bd_mgr->getContract(curTrans->code(), curTrans->exchg());
+		if (ct == NULL)
+			break;
 
-			memcpy(&blk->_trans[blk->_size], &curTrans->getTransStruct(), sizeof(WTSTransStruct));
-			blk->_size += 1;
+		WTSCommodityInfo* commInfo = ct->getCommInfo();
 
-			//TODO: Ҫ㲥
-			//g_udpCaster.broadcast(curTrans);
+		//ٸ״̬
+		if (!_sink->canSessionReceive(commInfo->getSession()))
+			break;
 
-			static wt_hashmap<std::string, uint64_t> _tcnt_map;
-			_tcnt_map[curTrans->exchg()]++;
-			if (_tcnt_map[curTrans->exchg()] % _log_group_size == 0)
-			{
-				pipe_writer_log(_sink, LL_INFO, "{} transactions received from exchange {}", _tcnt_map[curTrans->exchg()], curTrans->exchg());
-			}
-		} while (false);
+		TransBlockPair* pBlockPair = getTransBlock(ct, curTrans->tradingdate());
+		if (pBlockPair == NULL)
+			break;
 
-		curTrans->release();
-	});
-	return true;
+		SpinLock lock(pBlockPair->_mutex);
+
+		//ȼ,Ҫ
+		RTTransBlock* blk = pBlockPair->_block;
+		if (blk->_size >= blk->_capacity)
+		{
+			pBlockPair->_block = (RTTransBlock*)resizeRTBlock<RTDayBlockHeader, WTSTransStruct>(pBlockPair->_file, calcGrowCapacity(blk->_capacity, TICK_SIZE_STEP));
+			blk = pBlockPair->_block;
+		}
+
+		memcpy(&blk->_trans[blk->_size], &curTrans->getTransStruct(), sizeof(WTSTransStruct));
+		blk->_size += 1;
+
+		//TODO: Ҫ㲥
+		//g_udpCaster.broadcast(curTrans);
+
+		static wt_hashmap<std::string, uint64_t> _tcnt_map;
+		_tcnt_map[curTrans->exchg()]++;
+		if (_tcnt_map[curTrans->exchg()] % _log_group_size == 0)
+		{
+			pipe_writer_log(_sink, LL_INFO, "{} transactions received from exchange {}", _tcnt_map[curTrans->exchg()], curTrans->exchg());
+		}
+	} while (false);
+
+	curTrans->release();
 }
 
 void WtDataWriter::pipeToTicks(WTSContractInfo* ct, WTSTickData* curTick)
@@ -604,8 +778,7 @@ void WtDataWriter::pipeToTicks(WTSContractInfo* ct, WTSTickData* curTick)
 	RTTickBlock* blk = pBlockPair->_block;
 	if(blk && blk->_size >= blk->_capacity)
 	{
-		pBlockPair->_file->sync();
-		pBlockPair->_block = (RTTickBlock*)resizeRTBlock<RTDayBlockHeader, WTSTickStruct>(pBlockPair->_file, blk->_capacity + TICK_SIZE_STEP);
+		pBlockPair->_block = (RTTickBlock*)resizeRTBlock<RTDayBlockHeader, WTSTickStruct>(pBlockPair->_file, calcGrowCapacity(blk->_capacity, TICK_SIZE_STEP));
 		blk = pBlockPair->_block;
 		if(blk) pipe_writer_log(_sink, LL_DEBUG, "RT tick block of {} resized to {}", ct->getFullCode(), blk->_capacity);
 	}
@@ -659,6 +832,7 @@ WtDataWriter::OrdQueBlockPair* WtDataWriter::getOrdQueBlock(WTSContractInfo* ct,
 		path += ".dmb";
 
 		bool isNew = false;
+		uint32_t initCap = TICK_SIZE_STEP;
 		if (!BoostFile::exists(path.c_str()))
 		{
 			if (!bAutoCreate)
@@ -666,7 +840,8 @@ WtDataWriter::OrdQueBlockPair* WtDataWriter::getOrdQueBlock(WTSContractInfo* ct,
 
 			pipe_writer_log(_sink, LL_INFO, "Data file {} not exists, initializing...", path.c_str());
 
-			uint64_t uSize = sizeof(RTDayBlockHeader) + sizeof(WTSOrdQueStruct) * TICK_SIZE_STEP;
+			initCap = calcInitCapacity("queue", ct, TICK_SIZE_STEP);
+			uint64_t uSize = sizeof(RTDayBlockHeader) + sizeof(WTSOrdQueStruct) * initCap;
 
 			BoostFile bf;
 			bf.create_new_file(path.c_str());
@@ -696,7 +871,7 @@ WtDataWriter::OrdQueBlockPair* WtDataWriter::getOrdQueBlock(WTSContractInfo* ct,
 
 		if (isNew)
 		{
-			pBlock->_block->_capacity = TICK_SIZE_STEP;
+			pBlock->_block->_capacity = initCap;
 			pBlock->_block->_size = 0;
 			pBlock->_block->_version = BLOCK_VERSION_RAW_V2;
 			pBlock->_block->_type = BT_RT_OrdQueue;
@@ -753,6 +928,7 @@ WtDataWriter::OrdDtlBlockPair* WtDataWriter::getOrdDtlBlock(WTSContractInfo* ct,
 		path += ".dmb";
 
 		bool isNew = false;
+		uint32_t initCap = TICK_SIZE_STEP;
 		if (!BoostFile::exists(path.c_str()))
 		{
 			if (!bAutoCreate)
@@ -760,7 +936,8 @@ WtDataWriter::OrdDtlBlockPair* WtDataWriter::getOrdDtlBlock(WTSContractInfo* ct,
 
 			pipe_writer_log(_sink, LL_INFO, "Data file {} not exists, initializing...", path.c_str());
 
-			uint64_t uSize = sizeof(RTDayBlockHeader) + sizeof(WTSOrdDtlStruct) * TICK_SIZE_STEP;
+			initCap = calcInitCapacity("orders", ct, TICK_SIZE_STEP);
+			uint64_t uSize = sizeof(RTDayBlockHeader) + sizeof(WTSOrdDtlStruct) * initCap;
 
 			BoostFile bf;
 			bf.create_new_file(path.c_str());
@@ -790,7 +967,7 @@ WtDataWriter::OrdDtlBlockPair* WtDataWriter::getOrdDtlBlock(WTSContractInfo* ct,
 
 		if (isNew)
 		{
-			pBlock->_block->_capacity = TICK_SIZE_STEP;
+			pBlock->_block->_capacity = initCap;
 			pBlock->_block->_size = 0;
 			pBlock->_block->_version = BLOCK_VERSION_RAW_V2;
 			pBlock->_block->_type = BT_RT_OrdDetail;
@@ -848,6 +1025,7 @@ WtDataWriter::TransBlockPair* WtDataWriter::getTransBlock(WTSContractInfo* ct, u
 		path += ".dmb";
 
 		bool isNew = false;
+		uint32_t initCap = TICK_SIZE_STEP;
 		if (!BoostFile::exists(path.c_str()))
 		{
 			if (!bAutoCreate)
@@ -855,7 +1033,8 @@ WtDataWriter::TransBlockPair* WtDataWriter::getTransBlock(WTSContractInfo* ct, u
 
 			pipe_writer_log(_sink, LL_INFO, "Data file {} not exists, initializing...", path.c_str());
 
-			uint64_t uSize = sizeof(RTDayBlockHeader) + sizeof(WTSTransStruct) * TICK_SIZE_STEP;
+			initCap = calcInitCapacity("trans", ct, TICK_SIZE_STEP);
+			uint64_t uSize = sizeof(RTDayBlockHeader) + sizeof(WTSTransStruct) * initCap;
 
 			BoostFile bf;
 			bf.create_new_file(path.c_str());
@@ -885,7 +1064,7 @@ WtDataWriter::TransBlockPair* WtDataWriter::getTransBlock(WTSContractInfo* ct, u
 
 		if (isNew)
 		{
-			pBlock->_block->_capacity = TICK_SIZE_STEP;
+			pBlock->_block->_capacity = initCap;
 			pBlock->_block->_size = 0;
 			pBlock->_block->_version = BLOCK_VERSION_RAW_V2;
 			pBlock->_block->_type = BT_RT_Trnsctn;
@@ -952,6 +1131,7 @@ WtDataWriter::TickBlockPair* WtDataWriter::getTickBlock(WTSContractInfo* ct, uin
 		path += ".dmb";
 
 		bool isNew = false;
+		uint32_t initCap = TICK_SIZE_STEP;
 		if (!BoostFile::exists(path.c_str()))
 		{
 			if (!bAutoCreate)
@@ -959,7 +1139,8 @@ WtDataWriter::TickBlockPair* WtDataWriter::getTickBlock(WTSContractInfo* ct, uin
 
 			pipe_writer_log(_sink, LL_INFO, "Data file {} not exists, initializing...", path.c_str());
 
-			uint64_t uSize = sizeof(RTTickBlock) + sizeof(WTSTickStruct) * TICK_SIZE_STEP;
+			initCap = calcInitCapacity("ticks", ct, TICK_SIZE_STEP);
+			uint64_t uSize = sizeof(RTTickBlock) + sizeof(WTSTickStruct) * initCap;
 			BoostFile bf;
 			bf.create_new_file(path.c_str());
 			bf.truncate_file((uint32_t)uSize);
@@ -988,7 +1169,7 @@ WtDataWriter::TickBlockPair* WtDataWriter::getTickBlock(WTSContractInfo* ct, uin
 
 		if(isNew)
 		{
-			pBlock->_block->_capacity = TICK_SIZE_STEP;
+			pBlock->_block->_capacity = initCap;
 			pBlock->_block->_size = 0;
 			pBlock->_block->_version = BLOCK_VERSION_RAW_V2;
 			pBlock->_block->_type = BT_RT_Ticks;
@@ -1063,8 +1244,7 @@ void WtDataWriter::pipeToKlines(WTSContractInfo* ct, WTSTickData* curTick)
 			RTKlineBlock* blk = pBlockPair->_block;
 			if (blk->_size == blk->_capacity)
 			{
-				pBlockPair->_file->sync();
-				pBlockPair->_block = (RTKlineBlock*)resizeRTBlock<RTKlineBlock, WTSBarStruct>(pBlockPair->_file, blk->_capacity + KLINE_SIZE_STEP);
+				pBlockPair->_block = (RTKlineBlock*)resizeRTBlock<RTKlineBlock, WTSBarStruct>(pBlockPair->_file, calcGrowCapacity(blk->_capacity, KLINE_SIZE_STEP));
 				blk = pBlockPair->_block;
 			}
 
@@ -1170,8 +1350,7 @@ void WtDataWriter::pipeToKlines(WTSContractInfo* ct, WTSTickData* curTick)
 			RTKlineBlock* blk = pBlockPair->_block;
 			if (blk->_size == blk->_capacity)
 			{
-				pBlockPair->_file->sync();
-				pBlockPair->_block = (RTKlineBlock*)resizeRTBlock<RTKlineBlock, WTSBarStruct>(pBlockPair->_file, blk->_capacity + KLINE_SIZE_STEP);
+				pBlockPair->_block = (RTKlineBlock*)resizeRTBlock<RTKlineBlock, WTSBarStruct>(pBlockPair->_file, calcGrowCapacity(blk->_capacity, KLINE_SIZE_STEP));
 				blk = pBlockPair->_block;
 			}
 
@@ -1422,7 +1601,7 @@ bool WtDataWriter::updateCache(WTSContractInfo* ct, WTSTickData* curTick, uint32
 		_tick_cache_block->_size += 1;
 		if(_tick_cache_block->_size >= _tick_cache_block->_capacity)
 		{
-			_tick_cache_block = (RTTickCache*)resizeRTBlock<RTTickCache, TickCacheItem>(_tick_cache_file, _tick_cache_block->_capacity + CACHE_SIZE_STEP);
+			_tick_cache_block = (RTTickCache*)resizeRTBlock<RTTickCache, TickCacheItem>(_tick_cache_file, calcGrowCapacity(_tick_cache_block->_capacity, CACHE_SIZE_STEP));
 			pipe_writer_log(_sink, LL_INFO, "Tick Cache resized to {} items", _tick_cache_block->_capacity);
 		}
 	}
@@ -2295,6 +2474,9 @@ void WtDataWriter::proc_loop()
 			iniHelper.load(filename.c_str());
 			iniHelper.writeInt("markers", sid.c_str(), curDate);
 			iniHelper.save();
+
+			//˳ʵʱݿʾҲһ£һԤ
+			saveSizeHints();
 			pipe_writer_log(_sink, LL_INFO, "ClosingTask mark of Trading session [{}] updated: {}", sid.c_str(), curDate);
 		}
 
@@ -2324,6 +2506,7 @@ void WtDataWriter::proc_loop()
 					{
 						pipe_writer_log(_sink, LL_INFO, "Transfering tick data of {}...", fullcode.c_str());
 						SpinLock lock(tBlkPair->_mutex);
+						recordSizeHint("ticks", ct, tBlkPair->_block->_size);
 
 						for (auto& item : _dumpers)
 						{
@@ -2392,6 +2575,7 @@ void WtDataWriter::proc_loop()
 				{
 					pipe_writer_log(_sink, LL_INFO, "Transfering transaction data of {}...", fullcode.c_str());
 					SpinLock lock(tBlkPair->_mutex);
+					recordSizeHint("trans", ct, tBlkPair->_block->_size);
 
 					for (auto& item : _dumpers)
 					{
@@ -2458,6 +2642,7 @@ void WtDataWriter::proc_loop()
 				{
 					pipe_writer_log(_sink, LL_INFO, "Transfering order detail data of {}...", fullcode.c_str());
 					SpinLock lock(tBlkPair->_mutex);
+					recordSizeHint("orders", ct, tBlkPair->_block->_size);
 
 					for (auto& item : _dumpers)
 					{
@@ -2524,6 +2709,7 @@ void WtDataWriter::proc_loop()
 				{
 					pipe_writer_log(_sink, LL_INFO, "Transfering order queue data of {}...", fullcode.c_str());
 					SpinLock lock(tBlkPair->_mutex);
+					recordSizeHint("queue", ct, tBlkPair->_block->_size);
 
 					for (auto& item : _dumpers)
 					{
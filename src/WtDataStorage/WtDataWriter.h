@@ -6,6 +6,7 @@
 #include "../Share/StdUtils.hpp"
 #include "../Share/BoostMappingFile.hpp"
 #include "../Share/SpinMutex.hpp"
+#include "../Share/RingQueue.hpp"
 
 #include <queue>
 #include <map>
@@ -14,6 +15,7 @@ typedef std::shared_ptr<BoostMappingFile> BoostMFPtr;
 
 NS_WTP_BEGIN
 class WTSContractInfo;
+class WTSObject;
 NS_WTP_END
 
 USING_NS_WTP;
@@ -28,10 +30,31 @@ private:
 	template<typename HeaderType, typename T>
 	void* resizeRTBlock(BoostMFPtr& mfPtr, uint32_t nCount);
 
+	/*
+	 *	Ժ
+	 *	@curCap	ǰ
+	 *	@step	̶ݲ
+	 */
+	uint32_t calcGrowCapacity(uint32_t curCap, uint32_t step);
+
+	/*
+	 *	½ʵʱݿĳʼ
+	 *	ԤĻһյȷ
+	 */
+	uint32_t calcInitCapacity(const char* tag, WTSContractInfo* ct, uint32_t step);
+
+	void recordSizeHint(const char* tag, WTSContractInfo* ct, uint32_t count);
+
+	void loadSizeHints();
+
+	void saveSizeHints();
+
 	void  proc_loop();
 
 	void  check_loop();
 
+	void  task_loop();
+
 	uint32_t  dump_bars_to_file(WTSContractInfo* ct);
 
 	uint32_t  dump_bars_via_dumper(WTSContractInfo* ct);
@@ -160,11 +183,40 @@ private:
 	BoostMFPtr		_tick_cache_file;
 	RTTickCache*	_tick_cache_block;
 
-	typedef std::function<void()> TaskInfo;
-	std::queue<TaskInfo>	_tasks;
+	/*
+	 *	첽ǰstd::functionŵstd::queue
+	 *	ÿݶҪڶϷһΣʱҲܼ
+	 *	ڸĳɶ¼ŵζ
+	 */
+	typedef enum tagTaskType
+	{
+		TT_Tick = 0,
+		TT_OrdQue,
+		TT_OrdDtl,
+		TT_Trans
+	} TaskType;
+
+	typedef struct _TaskInfo
+	{
+		WTSObject*	_data;		//ݶǰѾretain
+		uint32_t	_type;		//ͣTaskType
+		uint32_t	_flag;		//tickĴ
+
+		_TaskInfo(WTSObject* data = NULL, uint32_t tType = TT_Tick, uint32_t flag = 0)
+			: _data(data), _type(tType), _flag(flag){}
+	} TaskInfo;
+
+	typedef RingQueue<TaskInfo>	TaskQueue;
+	std::unique_ptr<TaskQueue>	_tasks;
 	StdThreadPtr			_task_thrd;
 	StdUniqueMutex			_task_mtx;
 	StdCondVariable			_task_cond;
+	std::atomic<bool>		_task_waiting;	//߳Ƿڵȴֻڴ̵߳ȴʱ֪ͨ
+
+	uint32_t				_queue_size;	//첽
+	bool					_drop_if_full;	//ԺǷĬΪfalseȴ߳
+	std::atomic<uint64_t>	_dropped_cnt;	//
+	uint64_t				_max_depth;		//
 
 	std::string		_base_dir;
 	std::string		_cache_file;
@@ -200,6 +252,12 @@ private:
 	
 	std::map<std::string, uint32_t> _proc_date;
 
+	//ʵʱݿݲ
+	bool			_grow_geometric;	//Ƿ񰴱
+	bool			_presize;			//ǷһյԤ
+	wt_hashmap<std::string, uint32_t>	_size_hints;	//һոݿ
+	SpinMutex		_mtx_hints;		//ҵڴ߳, ̴߳ݿʱȡ
+
 private:
 	void loadCache();
 
@@ -219,6 +277,24 @@ private:
 	template<typename T>
 	void	releaseBlock(T* block);
 
-	void pushTask(TaskInfo task);
+	void pushTask(const TaskInfo& task);
+
+	void procTask(const TaskInfo& task);
+
+	void procTick(WTSTickData* curTick, uint32_t procFlag);
+	void procOrdQue(WTSOrdQueData* curOrdQue);
+	void procOrdDtl(WTSOrdDtlData* curOrdDtl);
+	void procTrans(WTSTransData* curTrans);
+
+public:
+	/*
+	 *	첽еǰ
+	 */
+	inline std::size_t getQueueDepth() const { return _tasks ? _tasks->size() : 0; }
+
+	/*
+	 *	첽Ժ
+	 */
+	inline uint64_t getDroppedCount() const { return _dropped_cnt.load(std::memory_order_relaxed); }
 };
 
@@ -84,6 +84,14 @@ void WtRdmDtReader::init(WTSVariant* cfg, IRdmDtReaderSink* sink)
 	if (!bAdjLoaded && cfg->has("adjfactor"))
 		loadStkAdjFactorsFromFile(cfg->getCString("adjfactor"));
 
+	//ʷݻڴԤ, λMB, 0Ϊ
+	uint64_t budget = cfg->getUInt64("cache_budget");
+	if (budget > 0)
+	{
+		_data_cache.set_budget(budget * 1024 * 1024);
+		pipe_rdmreader_log(_sink, LL_INFO, "History data cache budget set to {} MB", budget);
+	}
+
 	_thrd_check.reset(new StdThread([this]() {
 		while(!_stopped)
 		{
@@ -278,10 +286,10 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByDate(const char* stdCode, uint32_t u
 			//}
 		}
 
-		std::string key = fmt::format("{}-{}", stdCode, uDate);
+		std::string key = fmt::format("tick.{}-{}", stdCode, uDate);
 
-		auto it = _his_tick_map.find(key);
-		bool bHasHisTick = (it != _his_tick_map.end());
+		HisTBlockPtr hisBlock = _data_cache.get<HisTBlockPair>(key);
+		bool bHasHisTick = (hisBlock != NULL);
 		if (!bHasHisTick)
 		{
 			for (;;)
@@ -310,7 +318,8 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByDate(const char* stdCode, uint32_t u
 					}
 				}
 
-				HisTBlockPair& tBlkPair = _his_tick_map[key];
+				hisBlock.reset(new HisTBlockPair());
+				HisTBlockPair& tBlkPair = *hisBlock;
 				StdFile::read_file_content(filename.c_str(), tBlkPair._buffer);
 				if (tBlkPair._buffer.size() < sizeof(HisTickBlock))
 				{
@@ -321,6 +330,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByDate(const char* stdCode, uint32_t u
 
 				proc_block_data(tBlkPair._buffer, false, true);
 				tBlkPair._block = (HisTickBlock*)tBlkPair._buffer.c_str();
+				_data_cache.put(key, hisBlock, tBlkPair._buffer.size());
 				bHasHisTick = true;
 				break;
 			}
@@ -328,7 +338,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByDate(const char* stdCode, uint32_t u
 
 		while (bHasHisTick)
 		{
-			HisTBlockPair& tBlkPair = _his_tick_map[key];
+			HisTBlockPair& tBlkPair = *hisBlock;
 			if (tBlkPair._block == NULL)
 				break;
 
@@ -339,6 +349,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByDate(const char* stdCode, uint32_t u
 				break;
 
 			WTSTickSlice* slice = WTSTickSlice::create(stdCode, tBlock->_ticks, tcnt);
+			slice->pinData(hisBlock);
 			return slice;
 
 			break;
@@ -368,6 +379,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByDate(const char* stdCode, uint32_t u
 		RTTickBlock* tBlock = tPair->_block;
 		
 		WTSTickSlice* slice = WTSTickSlice::create(stdCode, tBlock->_ticks, tBlock->_size);
+		slice->pinData(tPair->_file);
 		return slice;
 	}
 
@@ -427,10 +439,10 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 			}
 		}
 		
-		std::string key = fmt::format("{}-{}", stdCode, nowTDate);
+		std::string key = fmt::format("tick.{}-{}", stdCode, nowTDate);
 
-		auto it = _his_tick_map.find(key);
-		bool bHasHisTick = (it != _his_tick_map.end());
+		HisTBlockPtr hisBlock = _data_cache.get<HisTBlockPair>(key);
+		bool bHasHisTick = (hisBlock != NULL);
 		if(!bHasHisTick)
 		{
 			for(;;)
@@ -460,7 +472,8 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 					}
 				}
 
-				HisTBlockPair& tBlkPair = _his_tick_map[key];
+				hisBlock.reset(new HisTBlockPair());
+				HisTBlockPair& tBlkPair = *hisBlock;
 				StdFile::read_file_content(filename.c_str(), tBlkPair._buffer);
 				if (tBlkPair._buffer.size() < sizeof(HisTickBlock))
 				{
@@ -471,6 +484,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 
 				proc_block_data(tBlkPair._buffer, false, true);
 				tBlkPair._block = (HisTickBlock*)tBlkPair._buffer.c_str();
+				_data_cache.put(key, hisBlock, tBlkPair._buffer.size());
 				bHasHisTick = true;
 				break;
 			}
@@ -491,7 +505,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 				eTick.action_time = sInfo->getCloseTime() * 100000 + 59999;
 			}
 
-			HisTBlockPair& tBlkPair = _his_tick_map[key];
+			HisTBlockPair& tBlkPair = *hisBlock;
 			if (tBlkPair._block == NULL)
 				break;
 
@@ -521,6 +535,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 				//WTSTickSlice* slice = WTSTickSlice::create(stdCode, tBlock->_ticks, eIdx + 1);
 				//ayTicks->append(slice, false);
 				slice->appendBlock(tBlock->_ticks, eIdx + 1);
+				slice->pinData(hisBlock);
 			}
 			else
 			{
@@ -536,6 +551,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 				//WTSTickSlice* slice = WTSTickSlice::create(stdCode, tBlock->_ticks + sIdx, eIdx - sIdx + 1);
 				//ayTicks->append(slice, false);
 				slice->appendBlock(tBlock->_ticks + sIdx, eIdx - sIdx + 1);
+				slice->pinData(hisBlock);
 			}
 
 			break;
@@ -598,6 +614,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 			//WTSTickSlice* slice = WTSTickSlice::create(stdCode, tBlock->_ticks, eIdx + 1);
 			//ayTicks->append(slice, false);
 			slice->appendBlock(tBlock->_ticks, eIdx + 1);
+			slice->pinData(tPair->_file);
 		}
 		else
 		{
@@ -613,6 +630,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByRange(const char* stdCode, uint64_t
 			//WTSTickSlice* slice = WTSTickSlice::create(stdCode, tBlock->_ticks + sIdx, eIdx - sIdx + 1);
 			//ayTicks->append(slice, false);
 			slice->appendBlock(tBlock->_ticks + sIdx, eIdx - sIdx + 1);
+			slice->pinData(tPair->_file);
 		}
 		break;
 	}
@@ -693,6 +711,8 @@ WTSOrdQueSlice* WtRdmDtReader::readOrdQueSliceByRange(const char* stdCode, uint6
 		{
 			//ʼĽպ͵ǰĽղһ£򷵻ȫtick
 			WTSOrdQueSlice* slice = WTSOrdQueSlice::create(stdCode, rtBlock->_queues, eIdx + 1);
+			if (slice)
+				slice->pinData(tPair->_file);
 			return slice;
 		}
 		else
@@ -707,15 +727,17 @@ WTSOrdQueSlice* WtRdmDtReader::readOrdQueSliceByRange(const char* stdCode, uint6
 
 			std::size_t sIdx = pItem - rtBlock->_queues;
 			WTSOrdQueSlice* slice = WTSOrdQueSlice::create(stdCode, rtBlock->_queues + sIdx, eIdx - sIdx + 1);
+			if (slice)
+				slice->pinData(tPair->_file);
 			return slice;
 		}
 	}
 	else
 	{
-		std::string key = fmt::format("{}-{}", stdCode, endTDate);
+		std::string key = fmt::format("ordque.{}-{}", stdCode, endTDate);
 
-		auto it = _his_ordque_map.find(key);
-		if (it == _his_ordque_map.end())
+		HisOrdQueBlockPtr hisBlock = _data_cache.get<HisOrdQueBlockPair>(key);
+		if (hisBlock == NULL)
 		{
 			std::stringstream ss;
 			ss << _base_dir << "his/queue/" << cInfo._exchg << "/" << endTDate << "/" << curCode << ".dsb";
@@ -723,7 +745,8 @@ WTSOrdQueSlice* WtRdmDtReader::readOrdQueSliceByRange(const char* stdCode, uint6
 			if (!StdFile::exists(filename.c_str()))
 				return NULL;
 
-			HisOrdQueBlockPair& hisBlkPair = _his_ordque_map[key];
+			hisBlock.reset(new HisOrdQueBlockPair());
+			HisOrdQueBlockPair& hisBlkPair = *hisBlock;
 			StdFile::read_file_content(filename.c_str(), hisBlkPair._buffer);
 			if (hisBlkPair._buffer.size() < sizeof(HisOrdQueBlockV2))
 			{
@@ -749,9 +772,10 @@ WTSOrdQueSlice* WtRdmDtReader::readOrdQueSliceByRange(const char* stdCode, uint6
 			tBlockV2->_version = BLOCK_VERSION_RAW;
 
 			hisBlkPair._block = (HisOrdQueBlock*)hisBlkPair._buffer.c_str();
+			_data_cache.put(key, hisBlock, hisBlkPair._buffer.size());
 		}
 
-		HisOrdQueBlockPair& tBlkPair = _his_ordque_map[key];
+		HisOrdQueBlockPair& tBlkPair = *hisBlock;
 		if (tBlkPair._block == NULL)
 			return NULL;
 
@@ -780,6 +804,8 @@ WTSOrdQueSlice* WtRdmDtReader::readOrdQueSliceByRange(const char* stdCode, uint6
 		{
 			//ʼĽպ͵ǰĽղһ£򷵻ȫtick
 			WTSOrdQueSlice* slice = WTSOrdQueSlice::create(stdCode, tBlock->_items, eIdx + 1);
+			if (slice)
+				slice->pinData(hisBlock);
 			return slice;
 		}
 		else
@@ -794,6 +820,8 @@ WTSOrdQueSlice* WtRdmDtReader::readOrdQueSliceByRange(const char* stdCode, uint6
 
 			std::size_t sIdx = pItem - tBlock->_items;
 			WTSOrdQueSlice* slice = WTSOrdQueSlice::create(stdCode, tBlock->_items + sIdx, eIdx - sIdx + 1);
+			if (slice)
+				slice->pinData(hisBlock);
 			return slice;
 		}
 	}
@@ -872,6 +900,8 @@ WTSOrdDtlSlice* WtRdmDtReader::readOrdDtlSliceByRange(const char* stdCode, uint6
 		{
 			//ʼĽպ͵ǰĽղһ£򷵻ȫtick
 			WTSOrdDtlSlice* slice = WTSOrdDtlSlice::create(stdCode, rtBlock->_details, eIdx + 1);
+			if (slice)
+				slice->pinData(tPair->_file);
 			return slice;
 		}
 		else
@@ -886,15 +916,17 @@ WTSOrdDtlSlice* WtRdmDtReader::readOrdDtlSliceByRange(const char* stdCode, uint6
 
 			std::size_t sIdx = pItem - rtBlock->_details;
 			WTSOrdDtlSlice* slice = WTSOrdDtlSlice::create(stdCode, rtBlock->_details + sIdx, eIdx - sIdx + 1);
+			if (slice)
+				slice->pinData(tPair->_file);
 			return slice;
 		}
 	}
 	else
 	{
-		std::string key = fmt::format("{}-{}", stdCode, endTDate);
+		std::string key = fmt::format("orddtl.{}-{}", stdCode, endTDate);
 
-		auto it = _his_ordque_map.find(key);
-		if (it == _his_ordque_map.end())
+		HisOrdDtlBlockPtr hisBlock = _data_cache.get<HisOrdDtlBlockPair>(key);
+		if (hisBlock == NULL)
 		{
 			std::stringstream ss;
 			ss << _base_dir << "his/orders/" << cInfo._exchg << "/" << endTDate << "/" << curCode << ".dsb";
@@ -902,7 +934,8 @@ WTSOrdDtlSlice* WtRdmDtReader::readOrdDtlSliceByRange(const char* stdCode, uint6
 			if (!StdFile::exists(filename.c_str()))
 				return NULL;
 
-			HisOrdDtlBlockPair& hisBlkPair = _his_orddtl_map[key];
+			hisBlock.reset(new HisOrdDtlBlockPair());
+			HisOrdDtlBlockPair& hisBlkPair = *hisBlock;
 			StdFile::read_file_content(filename.c_str(), hisBlkPair._buffer);
 			if (hisBlkPair._buffer.size() < sizeof(HisOrdDtlBlockV2))
 			{
@@ -928,9 +961,10 @@ WTSOrdDtlSlice* WtRdmDtReader::readOrdDtlSliceByRange(const char* stdCode, uint6
 			tBlockV2->_version = BLOCK_VERSION_RAW;
 
 			hisBlkPair._block = (HisOrdDtlBlock*)hisBlkPair._buffer.c_str();
+			_data_cache.put(key, hisBlock, hisBlkPair._buffer.size());
 		}
 
-		HisOrdDtlBlockPair& tBlkPair = _his_orddtl_map[key];
+		HisOrdDtlBlockPair& tBlkPair = *hisBlock;
 		if (tBlkPair._block == NULL)
 			return NULL;
 
@@ -958,6 +992,8 @@ WTSOrdDtlSlice* WtRdmDtReader::readOrdDtlSliceByRange(const char* stdCode, uint6
 		{
 			//ʼĽպ͵ǰĽղһ£򷵻ȫtick
 			WTSOrdDtlSlice* slice = WTSOrdDtlSlice::create(stdCode, tBlock->_items, eIdx + 1);
+			if (slice)
+				slice->pinData(hisBlock);
 			return slice;
 		}
 		else
@@ -972,6 +1008,8 @@ WTSOrdDtlSlice* WtRdmDtReader::readOrdDtlSliceByRange(const char* stdCode, uint6
 
 			std::size_t sIdx = pItem - tBlock->_items;
 			WTSOrdDtlSlice* slice = WTSOrdDtlSlice::create(stdCode, tBlock->_items + sIdx, eIdx - sIdx + 1);
+			if (slice)
+				slice->pinData(hisBlock);
 			return slice;
 		}
 	}
@@ -1050,6 +1088,8 @@ WTSTransSlice* WtRdmDtReader::readTransSliceByRange(const char* stdCode, uint64_
 		{
 			//ʼĽպ͵ǰĽղһ£򷵻ȫtick
 			WTSTransSlice* slice = WTSTransSlice::create(stdCode, rtBlock->_trans, eIdx + 1);
+			if (slice)
+				slice->pinData(tPair->_file);
 			return slice;
 		}
 		else
@@ -1064,15 +1104,17 @@ WTSTransSlice* WtRdmDtReader::readTransSliceByRange(const char* stdCode, uint64_
 
 			std::size_t sIdx = pItem - rtBlock->_trans;
 			WTSTransSlice* slice = WTSTransSlice::create(stdCode, rtBlock->_trans + sIdx, eIdx - sIdx + 1);
+			if (slice)
+				slice->pinData(tPair->_file);
 			return slice;
 		}
 	}
 	else
 	{
-		std::string key = fmt::format("{}-{}", stdCode, endTDate);
+		std::string key = fmt::format("trans.{}-{}", stdCode, endTDate);
 
-		auto it = _his_ordque_map.find(key);
-		if (it == _his_ordque_map.end())
+		HisTransBlockPtr hisBlock = _data_cache.get<HisTransBlockPair>(key);
+		if (hisBlock == NULL)
 		{
 			std::stringstream ss;
 			ss << _base_dir << "his/trans/" << cInfo._exchg << "/" << endTDate << "/" << curCode << ".dsb";
@@ -1080,7 +1122,8 @@ WTSTransSlice* WtRdmDtReader::readTransSliceByRange(const char* stdCode, uint64_
 			if (!StdFile::exists(filename.c_str()))
 				return NULL;
 
-			HisTransBlockPair& hisBlkPair = _his_trans_map[key];
+			hisBlock.reset(new HisTransBlockPair());
+			HisTransBlockPair& hisBlkPair = *hisBlock;
 			StdFile::read_file_content(filename.c_str(), hisBlkPair._buffer);
 			if (hisBlkPair._buffer.size() < sizeof(HisTransBlockV2))
 			{
@@ -1106,9 +1149,10 @@ WTSTransSlice* WtRdmDtReader::readTransSliceByRange(const char* stdCode, uint64_
 			tBlockV2->_version = BLOCK_VERSION_RAW;
 
 			hisBlkPair._block = (HisTransBlock*)hisBlkPair._buffer.c_str();
+			_data_cache.put(key, hisBlock, hisBlkPair._buffer.size());
 		}
 
-		HisTransBlockPair& tBlkPair = _his_trans_map[key];
+		HisTransBlockPair& tBlkPair = *hisBlock;
 		if (tBlkPair._block == NULL)
 			return NULL;
 
@@ -1136,6 +1180,8 @@ WTSTransSlice* WtRdmDtReader::readTransSliceByRange(const char* stdCode, uint64_
 		{
 			//ʼĽպ͵ǰĽղһ£򷵻ȫtick
 			WTSTransSlice* slice = WTSTransSlice::create(stdCode, tBlock->_items, eIdx + 1);
+			if (slice)
+				slice->pinData(hisBlock);
 			return slice;
 		}
 		else
@@ -1150,12 +1196,14 @@ WTSTransSlice* WtRdmDtReader::readTransSliceByRange(const char* stdCode, uint64_
 
 			std::size_t sIdx = pItem - tBlock->_items;
 			WTSTransSlice* slice = WTSTransSlice::create(stdCode, tBlock->_items + sIdx, eIdx - sIdx + 1);
+			if (slice)
+				slice->pinData(hisBlock);
 			return slice;
 		}
 	}
 }
 
-bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key, const char* stdCode, WTSKlinePeriod period)
+WtRdmDtReader::BarsListPtr WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key, const char* stdCode, WTSKlinePeriod period)
 {
 	CodeHelper::CodeInfo* cInfo = (CodeHelper::CodeInfo*)codeInfo;
 	WTSCommodityInfo* commInfo = _base_data_mgr->getCommodity(cInfo->_exchg, cInfo->_product);
@@ -1174,7 +1222,10 @@ bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key,
 	default: pname = "day"; break;
 	}
 
-	BarsList& barList = _bars_cache[key];
+	//ȡʧܵĻҲһյĻ, ⷴȡļ
+	BarsListPtr barsPtr(new BarsList());
+	_data_cache.put(key, barsPtr, barsPtr->bytes());
+	BarsList& barList = *barsPtr;
 	barList._code = stdCode;
 	barList._period = period;
 	barList._exchg = cInfo->_exchg;
@@ -1227,11 +1278,11 @@ bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key,
 		if (strlen(ruleTag))
 		{
 			if (!_hot_mgr->splitCustomSections(ruleTag, cInfo->stdCommID(), 19900102, endTDate, secs))
-				return false;
+				return barsPtr;
 		}
 
 		if (secs.empty())
-			return false;
+			return barsPtr;
 
 		//ݸȨȷ
 		//ǰȨʷݻСһȨΪ
@@ -1299,7 +1350,7 @@ bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key,
 				if (content.size() < sizeof(HisKlineBlock))
 				{
 					pipe_rdmreader_log(_sink, LL_ERROR, "Sizechecking of his kline data file {} failed", filename.c_str());
-					return false;
+					return barsPtr;
 				}
 				
 				proc_block_data(content, true, false);
@@ -1493,7 +1544,7 @@ bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key,
 				if (content.size() < sizeof(HisKlineBlock))
 				{
 					pipe_rdmreader_log(_sink, LL_ERROR, "Sizechecking of his kline data file {} failed", filename.c_str());
-					return false;
+					return barsPtr;
 				}
 
 				proc_block_data(content, true, false);
@@ -1600,13 +1651,13 @@ bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key,
 			if (content.size() < sizeof(HisKlineBlock))
 			{
 				pipe_rdmreader_log(_sink, LL_ERROR, "Sizechecking of his kline data file {} failed", filename.c_str());
-				return false;
+				return barsPtr;
 			}
 
 			proc_block_data(content, true, false);
 
 			if (content.empty())
-				return false;
+				return barsPtr;
 
 			uint32_t barcnt = content.size() / sizeof(WTSBarStruct);
 			WTSBarStruct* firstBar = (WTSBarStruct*)content.data();
@@ -1642,11 +1693,12 @@ bool WtRdmDtReader::cacheHisBarsFromFile(void* codeInfo, const std::string& key,
 		barsSections.clear();
 	}
 
+	_data_cache.resize(key, barList.bytes());
 	pipe_rdmreader_log(_sink, LL_INFO, "{} history {} data of {} cached", realCnt, pname.c_str(), stdCode);
-	return true;
+	return barsPtr;
 }
 
-WTSBarStruct* WtRdmDtReader::indexBarFromCacheByRange(const std::string& key, uint64_t stime, uint64_t etime, uint32_t& count, bool isDay /* = false */)
+WTSBarStruct* WtRdmDtReader::indexBarFromCacheByRange(BarsList& barsList, uint64_t stime, uint64_t etime, uint32_t& count, bool isDay /* = false */)
 {
 	uint32_t rDate, rTime, lDate, lTime;
 	rDate = (uint32_t)(etime / 10000);
@@ -1654,7 +1706,6 @@ WTSBarStruct* WtRdmDtReader::indexBarFromCacheByRange(const std::string& key, ui
 	lDate = (uint32_t)(stime / 10000);
 	lTime = (uint32_t)(stime % 10000);
 
-	BarsList& barsList = _bars_cache[key];
 	if (barsList._bars.empty())
 		return NULL;
 	
@@ -1705,13 +1756,12 @@ WTSBarStruct* WtRdmDtReader::indexBarFromCacheByRange(const std::string& key, ui
 	return &barsList._bars[sIdx];
 }
 
-WTSBarStruct* WtRdmDtReader::indexBarFromCacheByCount(const std::string& key, uint64_t etime, uint32_t& count, bool isDay /* = false */)
+WTSBarStruct* WtRdmDtReader::indexBarFromCacheByCount(BarsList& barsList, uint64_t etime, uint32_t& count, bool isDay /* = false */)
 {
 	uint32_t rDate, rTime;
 	rDate = (uint32_t)(etime / 10000);
 	rTime = (uint32_t)(etime % 10000);
 
-	BarsList& barsList = _bars_cache[key];
 	if (barsList._bars.empty())
 		return NULL;
 
@@ -1746,7 +1796,7 @@ WTSBarStruct* WtRdmDtReader::indexBarFromCacheByCount(const std::string& key, ui
 	return &barsList._bars[sIdx];
 }
 
-uint32_t WtRdmDtReader::readBarsFromCacheByRange(const std::string& key, uint64_t stime, uint64_t etime, std::vector<WTSBarStruct>& ayBars, bool isDay /* = false */)
+uint32_t WtRdmDtReader::readBarsFromCacheByRange(BarsList& barsList, uint64_t stime, uint64_t etime, std::vector<WTSBarStruct>& ayBars, bool isDay /* = false */)
 {
 	uint32_t rDate, rTime, lDate, lTime;
 	rDate = (uint32_t)(etime / 10000);
@@ -1754,7 +1804,6 @@ uint32_t WtRdmDtReader::readBarsFromCacheByRange(const std::string& key, uint64_
 	lDate = (uint32_t)(stime / 10000);
 	lTime = (uint32_t)(stime % 10000);
 
-	BarsList& barsList = _bars_cache[key];
 	std::size_t eIdx,sIdx;
 	{
 		WTSBarStruct eBar;
@@ -1812,17 +1861,10 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 	WTSCommodityInfo* commInfo = _base_data_mgr->getCommodity(cInfo._exchg, cInfo._product);
 	std::string stdPID = fmt::format("{}.{}", cInfo._exchg, cInfo._product);
 
-	std::string key = fmt::format("{}#{}", stdCode, period);
-	auto it = _bars_cache.find(key);
-	bool bHasHisData = false;
-	if (it == _bars_cache.end())
-	{
-		bHasHisData = cacheHisBarsFromFile(&cInfo, key, stdCode, period);
-	}
-	else
-	{
-		bHasHisData = true;
-	}
+	std::string key = fmt::format("bars.{}#{}", stdCode, period);
+	BarsListPtr hisBars = _data_cache.get<BarsList>(key);
+	if (hisBars == NULL)
+		hisBars = cacheHisBarsFromFile(&cInfo, key, stdCode, period);
 
 	if (etime == 0)
 		etime = 203012312359;
@@ -1840,6 +1882,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 	WTSBarStruct* rtHead = NULL;
 	uint32_t hisCnt = 0;
 	uint32_t rtCnt = 0;
+	BoostMFPtr rtFile;	//ʵʱݵӳļ, Ƭͷ֮ǰܹر
 
 	std::string pname;
 	switch (period)
@@ -1889,6 +1932,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 			if (kPair != NULL)
 			{
 				StdUniqueLock lock(*kPair->_mtx);
+				rtFile = kPair->_file;
 				//ȡյ
 				WTSBarStruct* pBar = std::lower_bound(kPair->_block->_bars, kPair->_block->_bars + (kPair->_block->_size - 1), eBar, [isDay](const WTSBarStruct& a, const WTSBarStruct& b) {
 					if (isDay)
@@ -1932,7 +1976,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 			if (kPair != NULL)
 			{
 				//ǺȨʵʱҪģﴦܸ
-				BarsList& barsList = _bars_cache[key];
+				BarsList& barsList = *hisBars;
 
 				//1ȼ黺жʵʱ
 				std::size_t oldSize = barsList._rt_bars.size();
@@ -1959,6 +2003,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 						pBar->low *= factor;
 						pBar->close *= factor;
 					}
+					_data_cache.resize(key, barsList.bytes());
 				}
 
 				//һλ
@@ -2004,7 +2049,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 
 	if (bNeedHisData)
 	{
-		hisHead = indexBarFromCacheByRange(key, stime, etime, hisCnt, period == KP_DAY);
+		hisHead = indexBarFromCacheByRange(*hisBars, stime, etime, hisCnt, period == KP_DAY);
 	}
 
 	if (hisCnt + rtCnt > 0)
@@ -2012,6 +2057,8 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByRange(const char* stdCode, WTSKlin
 		WTSKlineSlice* slice = WTSKlineSlice::create(stdCode, period, 1, hisHead, hisCnt);
 		if (rtCnt > 0)
 			slice->appendBlock(rtHead, rtCnt);
+		slice->pinData(hisBars);
+		slice->pinData(rtFile);
 		return slice;
 	}
 
@@ -2243,17 +2290,10 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 	WTSCommodityInfo* commInfo = _base_data_mgr->getCommodity(cInfo._exchg, cInfo._product);
 	std::string stdPID = fmtutil::format("{}.{}", cInfo._exchg, cInfo._product);
 
-	std::string key = fmtutil::format("{}#{}", stdCode, period);
-	auto it = _bars_cache.find(key);
-	bool bHasHisData = false;
-	if (it == _bars_cache.end())
-	{
-		bHasHisData = cacheHisBarsFromFile(&cInfo, key, stdCode, period);
-	}
-	else
-	{
-		bHasHisData = true;
-	}
+	std::string key = fmtutil::format("bars.{}#{}", stdCode, period);
+	BarsListPtr hisBars = _data_cache.get<BarsList>(key);
+	if (hisBars == NULL)
+		hisBars = cacheHisBarsFromFile(&cInfo, key, stdCode, period);
 
 	if (etime == 0)
 		etime = 203012312359;
@@ -2269,6 +2309,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 	WTSBarStruct* rtHead = NULL;
 	uint32_t hisCnt = 0;
 	uint32_t rtCnt = 0;
+	BoostMFPtr rtFile;	//ʵʱݵӳļ, Ƭͷ֮ǰܹر
 
 	std::string pname;
 	switch (period)
@@ -2312,6 +2353,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 			if (kPair != NULL)
 			{
 				StdUniqueLock lock(*(kPair->_mtx));
+				rtFile = kPair->_file;
 				//ȡյ
 				WTSBarStruct* pBar = std::lower_bound(kPair->_block->_bars, kPair->_block->_bars + (kPair->_block->_size - 1), eBar, [isDay](const WTSBarStruct& a, const WTSBarStruct& b) {
 					if (isDay)
@@ -2339,7 +2381,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 			if (kPair != NULL)
 			{
 				//ǺȨʵʱҪģﴦܸ
-				BarsList& barsList = _bars_cache[key];
+				BarsList& barsList = *hisBars;
 
 				//1ȼ黺жʵʱ
 				std::size_t oldSize = barsList._rt_bars.size();
@@ -2366,6 +2408,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 						pBar->low *= factor;
 						pBar->close *= factor;
 					}
+					_data_cache.resize(key, barsList.bytes());
 				}
 
 				//һλ
@@ -2396,7 +2439,7 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 	if (bNeedHisData)
 	{
 		hisCnt = count - rtCnt;
-		hisHead = indexBarFromCacheByCount(key, etime, hisCnt, period == KP_DAY);
+		hisHead = indexBarFromCacheByCount(*hisBars, etime, hisCnt, period == KP_DAY);
 	}
 
 	pipe_rdmreader_log(_sink, LL_DEBUG, "His {} bars of {} loaded, {} from history, {} from realtime", PERIOD_NAME[period], stdCode, hisCnt, rtCnt);
@@ -2406,6 +2449,8 @@ WTSKlineSlice* WtRdmDtReader::readKlineSliceByCount(const char* stdCode, WTSKlin
 		WTSKlineSlice* slice = WTSKlineSlice::create(stdCode, period, 1, hisHead, hisCnt);
 		if (rtCnt > 0)
 			slice->appendBlock(rtHead, rtCnt);
+		slice->pinData(hisBars);
+		slice->pinData(rtFile);
 		return slice;
 	}
 
@@ -2495,6 +2540,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByCount(const char* stdCode, uint32_t
 		uint32_t thisCnt = min((uint32_t)eIdx + 1, left);
 		uint32_t sIdx = eIdx + 1 - thisCnt;
 		slice->insertBlock(0, tBlock->_ticks + sIdx, thisCnt);
+		slice->pinData(tPair->_file);
 		left -= thisCnt;
 		break;
 	}
@@ -2539,10 +2585,10 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByCount(const char* stdCode, uint32_t
 		}
 		
 
-		std::string key = fmt::format("{}-{}", stdCode, nowTDate);
+		std::string key = fmt::format("tick.{}-{}", stdCode, nowTDate);
 
-		auto it = _his_tick_map.find(key);
-		bool bHasHisTick = (it != _his_tick_map.end());
+		HisTBlockPtr hisBlock = _data_cache.get<HisTBlockPair>(key);
+		bool bHasHisTick = (hisBlock != NULL);
 		if (!bHasHisTick)
 		{
 			for (;;)
@@ -2574,7 +2620,8 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByCount(const char* stdCode, uint32_t
 
 				missingCnt = 0;
 
-				HisTBlockPair& tBlkPair = _his_tick_map[key];
+				hisBlock.reset(new HisTBlockPair());
+				HisTBlockPair& tBlkPair = *hisBlock;
 				StdFile::read_file_content(filename.c_str(), tBlkPair._buffer);
 				if (tBlkPair._buffer.size() < sizeof(HisTickBlock))
 				{
@@ -2585,6 +2632,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByCount(const char* stdCode, uint32_t
 
 				proc_block_data(tBlkPair._buffer, false, true);				
 				tBlkPair._block = (HisTickBlock*)tBlkPair._buffer.c_str();
+				_data_cache.put(key, hisBlock, tBlkPair._buffer.size());
 				bHasHisTick = true;
 				break;
 			}
@@ -2605,7 +2653,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByCount(const char* stdCode, uint32_t
 				eTick.action_time = sInfo->getCloseTime() * 100000 + 59999;
 			}
 
-			HisTBlockPair& tBlkPair = _his_tick_map[key];
+			HisTBlockPair& tBlkPair = *hisBlock;
 			if (tBlkPair._block == NULL)
 				break;
 
@@ -2632,6 +2680,7 @@ WTSTickSlice* WtRdmDtReader::readTickSliceByCount(const char* stdCode, uint32_t
 			uint32_t thisCnt = min((uint32_t)eIdx + 1, left);
 			uint32_t sIdx = eIdx + 1 - thisCnt;
 			slice->insertBlock(0, tBlock->_ticks + sIdx, thisCnt);
+			slice->pinData(hisBlock);
 			left -= thisCnt;
 			break;
 		}
@@ -2680,7 +2729,7 @@ double WtRdmDtReader::getAdjFactorByDate(const char* stdCode, uint32_t date /* =
 
 void WtRdmDtReader::clearCache()
 {
-	_bars_cache.clear();
+	_data_cache.clear();
 
 	_rt_min1_map.clear();
 	_rt_min5_map.clear();
@@ -2689,4 +2738,17 @@ void WtRdmDtReader::clearCache()
 	_rt_trans_map.clear();
 	_rt_orddtl_map.clear();
 	_rt_ordque_map.clear();
-}
\ No newline at end of file
+}
+
+bool WtRdmDtReader::getCacheStats(RdmCacheStats& stats)
+{
+	LRUDataCache::CacheStats cs = _data_cache.stats();
+	stats._hits = cs._hits;
+	stats._misses = cs._misses;
+	stats._evictions = cs._evictions;
+	stats._bytes = cs._bytes;
+	stats._budget = cs._budget;
+	stats._entries = cs._entries;
+	stats._pinned = cs._pinned;
+	return true;
+}
@@ -9,6 +9,7 @@
 #include "../Includes/IRdmDtReader.h"
 
 #include "../Share/BoostMappingFile.hpp"
+#include "../Share/LRUDataCache.hpp"
 #include "../Share/StdUtils.hpp"
 #include "../Share/fmtlib.h"
 
@@ -155,7 +156,7 @@ private:
 		}
 	} HisTBlockPair;
 
-	typedef std::unordered_map<std::string, HisTBlockPair>	HisTickBlockMap;
+	typedef std::shared_ptr<HisTBlockPair>	HisTBlockPtr;
 
 	typedef struct _HisTransBlockPair
 	{
@@ -171,7 +172,7 @@ private:
 		}
 	} HisTransBlockPair;
 
-	typedef std::unordered_map<std::string, HisTransBlockPair>	HisTransBlockMap;
+	typedef std::shared_ptr<HisTransBlockPair>	HisTransBlockPtr;
 
 	typedef struct _HisOrdDtlBlockPair
 	{
@@ -187,7 +188,7 @@ private:
 		}
 	} HisOrdDtlBlockPair;
 
-	typedef std::unordered_map<std::string, HisOrdDtlBlockPair>	HisOrdDtlBlockMap;
+	typedef std::shared_ptr<HisOrdDtlBlockPair>	HisOrdDtlBlockPtr;
 
 	typedef struct _HisOrdQueBlockPair
 	{
@@ -203,12 +204,13 @@ private:
 		}
 	} HisOrdQueBlockPair;
 
-	typedef std::unordered_map<std::string, HisOrdQueBlockPair>	HisOrdQueBlockMap;
+	typedef std::shared_ptr<HisOrdQueBlockPair>	HisOrdQueBlockPtr;
 
-	HisTickBlockMap		_his_tick_map;
-	HisOrdDtlBlockMap	_his_orddtl_map;
-	HisOrdQueBlockMap	_his_ordque_map;
-	HisTransBlockMap	_his_trans_map;
+	/*
+	 *	ʷݿʷKͳһŵֽԤ̭Ļ
+	 *	͵ǰ׺, ⲻͬ͵ݳͻ
+	 */
+	LRUDataCache		_data_cache;
 
 private:
 	RTKlineBlockPair* getRTKilneBlock(const char* exchg, const char* code, WTSKlinePeriod period);
@@ -220,12 +222,15 @@ private:
 	/*
 	 *	ʷݷ뻺
 	 */
-	bool		cacheHisBarsFromFile(void* codeInfo, const std::string& key, const char* stdCode, WTSKlinePeriod period);
+	struct _BarsList;
+	typedef _BarsList BarsList;
+	typedef std::shared_ptr<BarsList> BarsListPtr;
+	BarsListPtr		cacheHisBarsFromFile(void* codeInfo, const std::string& key, const char* stdCode, WTSKlinePeriod period);
 
-	uint32_t		readBarsFromCacheByRange(const std::string& key, uint64_t stime, uint64_t etime, std::vector<WTSBarStruct>& ayBars, bool isDay = false);
-	WTSBarStruct*	indexBarFromCacheByRange(const std::string& key, uint64_t stime, uint64_t etime, uint32_t& count, bool isDay = false);
+	uint32_t		readBarsFromCacheByRange(BarsList& barsList, uint64_t stime, uint64_t etime, std::vector<WTSBarStruct>& ayBars, bool isDay = false);
+	WTSBarStruct*	indexBarFromCacheByRange(BarsList& barsList, uint64_t stime, uint64_t etime, uint32_t& count, bool isDay = false);
 
-	WTSBarStruct*	indexBarFromCacheByCount(const std::string& key, uint64_t etime, uint32_t& count, bool isDay = false);
+	WTSBarStruct*	indexBarFromCacheByCount(BarsList& barsList, uint64_t etime, uint32_t& count, bool isDay = false);
 
 	bool	loadStkAdjFactorsFromFile(const char* adjfile);
 	
@@ -251,6 +256,8 @@ public:
 
 	virtual void		clearCache() override;
 
+	virtual bool		getCacheStats(RdmCacheStats& stats) override;
+
 private:
 	std::string		_base_dir;
 	IBaseDataMgr*	_base_data_mgr;
@@ -258,7 +265,7 @@ private:
 	StdThreadPtr	_thrd_check;
 	bool			_stopped;
 
-	typedef struct _BarsList
+	struct _BarsList
 	{
 		std::string		_exchg;
 		std::string		_code;
@@ -270,10 +277,12 @@ private:
 
 		std::vector<WTSBarStruct>	_bars;
 		std::vector<WTSBarStruct>	_rt_bars;	//ǺȨҪʵʱݿ
-	} BarsList;
 
-	typedef std::unordered_map<std::string, BarsList> BarsCache;
-	BarsCache	_bars_cache;
+		inline uint64_t bytes() const
+		{
+			return sizeof(_BarsList) + (_bars.capacity() + _rt_bars.capacity()) * sizeof(WTSBarStruct);
+		}
+	};
 
 	//Ȩ
 	typedef struct _AdjFactor
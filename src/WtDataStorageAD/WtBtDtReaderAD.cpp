@@ -72,20 +72,13 @@ bool WtBtDtReaderAD::read_raw_bars(const char* exchg, const char* code, WTSKline
 	WtLMDBQuery query(*db);
 	LMDBBarKey rKey(exchg, code, 0xffffffff);
 	LMDBBarKey lKey(exchg, code, 0);
-	int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
-		[this, &buffer, &lKey](const ValueArray& ayKeys, const ValueArray& ayVals) {
-		if (ayVals.empty())
-			return;
-
-		std::size_t cnt = ayVals.size();
-		auto szUnit = sizeof(WTSBarStruct);
-		buffer.resize(szUnit*cnt);
-		char* cursor = (char*)buffer.data();
-		for(const std::string& item : ayVals)
-		{
-			memcpy(cursor, item.data(), szUnit);
-			cursor += szUnit;
-		}
+	//ֱӴα׷ӵ, پstd::stringת
+	buffer.clear();
+	int cnt = query.scan_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
+		[&buffer](const MDB_val& key, const MDB_val& val) {
+		if (val.mv_size == sizeof(WTSBarStruct))
+			buffer.append((const char*)val.mv_data, val.mv_size);
+		return true;
 	});
 
 	return true;
@@ -102,20 +95,13 @@ bool WtBtDtReaderAD::read_raw_ticks(const char* exchg, const char* code, uint32_
 	WtLMDBQuery query(*db);
 	LMDBHftKey rKey(exchg, code, uDate, 240000000);
 	LMDBHftKey lKey(exchg, code, uDate, 0);
-	int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
-		[this, &buffer, &lKey](const ValueArray& ayKeys, const ValueArray& ayVals) {
-		if (ayVals.empty())
-			return;
-
-		std::size_t cnt = ayVals.size();
-		auto szUnit = sizeof(WTSTickStruct);
-		buffer.resize(szUnit*cnt);
-		char* cursor = (char*)buffer.data();
-		for (const std::string& item : ayVals)
-		{
-			memcpy(cursor, item.data(), szUnit);
-			cursor += szUnit;
-		}
+	//ֱӴα׷ӵ, پstd::stringת
+	buffer.clear();
+	int cnt = query.scan_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
+		[&buffer](const MDB_val& key, const MDB_val& val) {
+		if (val.mv_size == sizeof(WTSTickStruct))
+			buffer.append((const char*)val.mv_data, val.mv_size);
+		return true;
 	});
 
 	return true;
@@ -148,14 +148,7 @@ WTSTickSlice* WtDataReaderAD::readTickSlice(const char* stdCode, uint32_t count,
 		WtLMDBQuery query(*db);
 		LMDBHftKey lKey(cInfo._exchg, cInfo._code, (uint32_t)(last_access_time / 1000000000), (uint32_t)(last_access_time % 1000000000));
 		LMDBHftKey rKey(cInfo._exchg, cInfo._code, (uint32_t)(etime / 1000000000), (uint32_t)(etime % 1000000000));
-		int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), 
-			std::string((const char*)&rKey, sizeof(rKey)), [this, &tickList](const ValueArray& ayKeys, const ValueArray& ayVals) {
-			for(const std::string& item : ayVals)
-			{
-				WTSTickStruct* curTick = (WTSTickStruct*)item.data();
-				tickList._ticks.push_back(*curTick);
-			}
-		});
+		int cnt = query.get_range_as(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)), tickList._ticks);
 		if(cnt > 0)
 			pipe_reader_log(_sink, LL_DEBUG, "{} ticks after {} of {} append to cache", cnt, last_access_time, stdCode);
 	}
@@ -213,13 +206,12 @@ std::string WtDataReaderAD::read_bars_to_buffer(const char* exchg, const char* c
 	WtLMDBQuery query(*db);
 	LMDBBarKey lKey(exchg, code, 0);
 	LMDBBarKey rKey(exchg, code, 0xffffffff);
-	query.get_range(std::string((const char*)&lKey, sizeof(lKey)),
-		std::string((const char*)&lKey, sizeof(lKey)), [this, &buffer](const ValueArray& ayKeys, const ValueArray& ayVals) {
-		if (ayVals.empty())
-			return;
-
-		buffer.resize(sizeof(WTSBarStruct)*ayVals.size());
-		memcpy((void*)buffer.data(), ayVals.data(), sizeof(WTSBarStruct)*ayVals.size());
+	//ԭϱ߽lKey, Ҳstd::string, ĳֱӴα׷ӵ
+	query.scan_range(std::string((const char*)&lKey, sizeof(lKey)),
+		std::string((const char*)&rKey, sizeof(rKey)), [&buffer](const MDB_val& key, const MDB_val& val) {
+		if (val.mv_size == sizeof(WTSBarStruct))
+			buffer.append((const char*)val.mv_data, val.mv_size);
+		return true;
 	});
 	return std::move(buffer);
 }
@@ -59,6 +59,9 @@ WtDataWriterAD::WtDataWriterAD()
 	, _tick_cache_block(nullptr)
 	, _tick_mapsize(16*1024*1024)
 	, _kline_mapsize(8*1024*1024)
+	, _commit_count(1)
+	, _commit_bytes(1024*1024)
+	, _commit_delay(5)
 {
 }
 
@@ -95,6 +98,34 @@ bool WtDataWriterAD::init(WTSVariant* params, IDataWriterSink* sink)
 	if (params->has("klinemapsize"))
 		_kline_mapsize = params->getUInt32("klinemapsize");
 
+	//ύֵ, commitcountΪ1ύ
+	if (params->has("commitcount"))
+		_commit_count = max(params->getUInt32("commitcount"), 1U);
+
+	if (params->has("commitbytes"))
+		_commit_bytes = params->getUInt32("commitbytes");
+
+	if (params->has("commitdelay"))
+		_commit_delay = max(params->getUInt32("commitdelay"), 1U);
+
+	if (_commit_count > 1)
+	{
+		pipe_writer_log(_sink, LL_INFO, "Group commit enabled, at most {} records or {} bytes per batch, max delay {} ms", _commit_count, _commit_bytes, _commit_delay);
+
+		//ʱѳݴʱύ, ϡʱҲڴ̫ͣ
+		_commit_thrd.reset(new StdThread([this]() {
+			while (!_terminated)
+			{
+				{
+					StdUniqueLock lck(_commit_mtx);
+					_commit_cond.wait_for(lck, std::chrono::milliseconds(_commit_delay));
+				}
+
+				commit_stages(false);
+			}
+		}));
+	}
+
 	loadCache();
 
 	return true;
@@ -108,6 +139,15 @@ void WtDataWriterAD::release()
 		_task_cond.notify_all();
 		_task_thrd->join();
 	}
+
+	if (_commit_thrd)
+	{
+		_commit_cond.notify_all();
+		_commit_thrd->join();
+	}
+
+	//˳֮ǰݴȫύ
+	commit_stages(true);
 }
 
 void WtDataWriterAD::loadCache()
@@ -410,6 +450,87 @@ void WtDataWriterAD::pushTask(TaskInfo task)
 	}
 }
 
+bool WtDataWriterAD::put_to_db(WtLMDBPtr& db, const char* period, const char* name, void* key, std::size_t klen, void* val, std::size_t vlen)
+{
+	if (_commit_count <= 1)
+	{
+		WtLMDBQuery query(*db);
+		return query.put_and_commit(key, klen, val, vlen);
+	}
+
+	CommitStagePtr stage;
+	{
+		StdUniqueLock lock(_mtx_stages);
+		CommitStagePtr& item = _commit_stages[db.get()];
+		if (item == NULL)
+			item.reset(new CommitStage(db, fmt::format("{} db of {}", period, name)));
+		stage = item;
+	}
+
+	StdUniqueLock lock(stage->_mtx);
+	WtLMDBBatch& batch = stage->_batch;
+	batch.put(key, klen, val, vlen);
+
+	//ʧܵڵ, ֻݴ, ύ̵߳ʱύ
+	if (stage->_retry_at != 0)
+		return true;
+
+	if (batch.count() >= _commit_count || batch.bytes() >= _commit_bytes || batch.pending_millis() >= _commit_delay)
+		return commit_stage(*stage);
+
+	return true;
+}
+
+bool WtDataWriterAD::commit_stage(CommitStage& stage)
+{
+	static const uint64_t MAX_RETRY_INTERVAL = 1000;
+
+	uint32_t cnt = stage._batch.count();
+	if (stage._batch.commit() >= 0)
+	{
+		if (stage._failures > 0)
+			pipe_writer_log(_sink, LL_INFO, "{} records committed to {} after {} failed attempts", cnt, stage._name, stage._failures);
+
+		stage._failures = 0;
+		stage._retry_at = 0;
+		return true;
+	}
+
+	stage._failures++;
+	uint64_t interval = min((uint64_t)_commit_delay << min(stage._failures - 1, 10U), MAX_RETRY_INTERVAL);
+	stage._retry_at = TimeUtils::getLocalTimeNow() + interval;
+	pipe_writer_log(_sink, LL_ERROR, "Committing {} records to {} failed: {}, retry #{} in {} ms", cnt, stage._name, stage._db->errmsg(), stage._failures, interval);
+	return false;
+}
+
+void WtDataWriterAD::commit_stages(bool bForce)
+{
+	std::vector<CommitStagePtr> stages;
+	{
+		StdUniqueLock lock(_mtx_stages);
+		stages.reserve(_commit_stages.size());
+		for (auto& item : _commit_stages)
+			stages.emplace_back(item.second);
+	}
+
+	for (CommitStagePtr& stage : stages)
+	{
+		StdUniqueLock lock(stage->_mtx);
+		if (stage->_batch.empty())
+			continue;
+
+		if (stage->_retry_at != 0)
+		{
+			if (bForce || TimeUtils::getLocalTimeNow() >= stage->_retry_at)
+				commit_stage(*stage);
+		}
+		else if (bForce || stage->_batch.pending_millis() >= _commit_delay)
+		{
+			commit_stage(*stage);
+		}
+	}
+}
+
 void WtDataWriterAD::pipeToTicks(WTSContractInfo* ct, WTSTickData* curTick)
 {
 	//ֱ
@@ -422,8 +543,7 @@ void WtDataWriterAD::pipeToTicks(WTSContractInfo* ct, WTSTickData* curTick)
 		uint32_t offTime = ct->getCommInfo()->getSessionInfo()->offsetTime(actTime / 100000, true) + actTime % 100000;
 
 		LMDBHftKey key(ct->getExchg(), ct->getCode(), curTick->tradingdate(), offTime);
-		WtLMDBQuery query(*db);
-		if (!query.put_and_commit((void*)&key, sizeof(key), &curTick->getTickStruct(), sizeof(WTSTickStruct)))
+		if (!put_to_db(db, "tick", ct->getFullCode(), (void*)&key, sizeof(key), &curTick->getTickStruct(), sizeof(WTSTickStruct)))
 		{
 			pipe_writer_log(_sink, LL_ERROR, "pipe tick of {} to db failed: {}", ct->getFullCode(), db->errmsg());
 		}
@@ -451,8 +571,7 @@ void WtDataWriterAD::pipeToDayBars(WTSContractInfo* ct, const WTSBarStruct& bar)
 	if (db)
 	{
 		LMDBBarKey key(ct->getExchg(), ct->getCode(), bar.date);
-		WtLMDBQuery query(*db);
-		if (!query.put_and_commit((void*)&key, sizeof(key), (void*)&bar, sizeof(WTSBarStruct)))
+		if (!put_to_db(db, "d1", ct->getExchg(), (void*)&key, sizeof(key), (void*)&bar, sizeof(WTSBarStruct)))
 		{
 			pipe_writer_log(_sink, LL_ERROR, "pipe day bar @ {} of {} to db failed", bar.date, ct->getFullCode());
 		}
@@ -484,8 +603,7 @@ void WtDataWriterAD::pipeToM1Bars(WTSContractInfo* ct, const WTSBarStruct& bar)
 	if(db)
 	{
 		LMDBBarKey key(ct->getExchg(), ct->getCode(), (uint32_t)bar.time);
-		WtLMDBQuery query(*db);
-		if(!query.put_and_commit((void*)&key, sizeof(key), (void*)&bar, sizeof(WTSBarStruct)))
+		if(!put_to_db(db, "m1", ct->getExchg(), (void*)&key, sizeof(key), (void*)&bar, sizeof(WTSBarStruct)))
 		{
 			pipe_writer_log(_sink, LL_ERROR, "pipe m1 bar @ {} of {} to db failed", bar.time, ct->getFullCode());
 		}
@@ -517,8 +635,7 @@ void WtDataWriterAD::pipeToM5Bars(WTSContractInfo* ct, const WTSBarStruct& bar)
 	if (db)
 	{
 		LMDBBarKey key(ct->getExchg(), ct->getCode(), (uint32_t)bar.time);
-		WtLMDBQuery query(*db);
-		if (!query.put_and_commit((void*)&key, sizeof(key), (void*)&bar, sizeof(bar)))
+		if (!put_to_db(db, "m5", ct->getExchg(), (void*)&key, sizeof(key), (void*)&bar, sizeof(bar)))
 		{
 			pipe_writer_log(_sink, LL_ERROR, "pipe m5 bar @ {} of {} to db failed", bar.time, ct->getFullCode());
 		}
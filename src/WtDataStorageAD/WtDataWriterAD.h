@@ -105,6 +105,56 @@ private:
 
 	WtLMDBPtr	get_t_db(const char* exchg, const char* code);
 
+	/*
+	 *	ύ
+	 *	ÿݿһݴ, ֽݴʱһֵһύ
+	 *	_commit_countΪ1ʱݴ, ԭһύ
+	 *	ʱඪʧÿһûύļ¼, Ѿύ
+	 *	ύʧܵβ, ļ¼ݴں, ύ̵߳ʱύ
+	 *	Լ_commit_delayʼÿη, 1, ֱύɹΪֹ
+	 */
+	typedef struct _CommitStage
+	{
+		StdUniqueMutex	_mtx;
+		WtLMDBPtr		_db;
+		WtLMDBBatch		_batch;
+		std::string		_name;
+		uint32_t		_failures;	//ύʧܵĴ
+		uint64_t		_retry_at;	//һԵʱ, Ϊ0˵ûʧܵ
+
+		_CommitStage(WtLMDBPtr db, const std::string& name) :_db(db), _batch(*db), _name(name), _failures(0), _retry_at(0) {}
+	} CommitStage;
+	typedef std::shared_ptr<CommitStage> CommitStagePtr;
+
+	wt_hashmap<WtLMDB*, CommitStagePtr>	_commit_stages;
+	StdUniqueMutex	_mtx_stages;
+
+	uint32_t		_commit_count;	//ÿ
+	uint32_t		_commit_bytes;	//ÿֽ
+	uint32_t		_commit_delay;	//ݴʱ, λ
+	StdThreadPtr	_commit_thrd;
+	StdUniqueMutex	_commit_mtx;
+	StdCondVariable	_commit_cond;
+
+	/*
+	 *	дһ¼
+	 *	@period	, ֻ־ʹ
+	 *	@name	ݿ, ֻ־ʹ
+	 *	ύʱ򷵻ύ, ύʱ򷵻¼ύǷɹ
+	 */
+	bool	put_to_db(WtLMDBPtr& db, const char* period, const char* name, void* key, std::size_t klen, void* val, std::size_t vlen);
+
+	/*
+	 *	ύݴ
+	 *	@bForce	Ƿݴʱȫύ
+	 */
+	void	commit_stages(bool bForce);
+
+	/*
+	 *	ύһݴ, ʧܵĻʱ, ݴ
+	 */
+	bool	commit_stage(CommitStage& stage);
+
 private:
 	void loadCache();
 
@@ -118,16 +118,8 @@ WTSTickSlice* WtRdmDtReaderAD::readTickSliceByRange(const char* stdCode, uint64_
 		WtLMDBQuery query(*db);
 		LMDBHftKey lKey(cInfo._exchg, cInfo._code, beginTDate, lTime * 100000 + lSecs);
 		LMDBHftKey rKey(cInfo._exchg, cInfo._code, endTDate, rTime * 100000 + rSecs);
-		int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)),
-			std::string((const char*)&rKey, sizeof(rKey)), [this, &tickList](const ValueArray& ayKeys, const ValueArray& ayVals) {
-			tickList._ticks.resize(ayVals.size());
-			std::size_t idx = 0;
-			for (const std::string& item : ayVals)
-			{
-				memcpy(&tickList._ticks[idx], item.data(), item.size());
-				idx++;
-			}
-		});
+		//ֱӰṹ׷ӵ, پstd::stringת
+		int cnt = query.get_range_as(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)), tickList._ticks);
 
 		if (cnt > 0)
 		{
@@ -148,22 +140,15 @@ WTSTickSlice* WtRdmDtReaderAD::readTickSliceByRange(const char* stdCode, uint64_
 			WtLMDBQuery query(*db);
 			LMDBHftKey rKey(cInfo._exchg, cInfo._code, (uint32_t)(tickList._first_tick_time / 1000000000), (uint32_t)(tickList._first_tick_time % 1000000000));
 			LMDBHftKey lKey(cInfo._exchg, cInfo._code, beginTDate, lTime * 100000 + lSecs);
-			int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
-				[this, &tickList](const ValueArray& ayKeys, const ValueArray& ayVals) {
-				std::vector<WTSTickStruct> ayTicks;
-				ayTicks.resize(ayVals.size() + tickList._ticks.size());
-				std::size_t idx = 0;
-				for (const std::string& item : ayVals)
-				{
-					WTSTickStruct* curTick = (WTSTickStruct*)item.data();
-					memcpy(&ayTicks[idx], item.data(), item.size());
-					idx++;
-				}
+			std::vector<WTSTickStruct> ayTicks;
+			int cnt = query.get_range_as(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)), ayTicks);
 
+			if (cnt > 0)
+			{
 				//ԭݿ棬һswap
-				memcpy(&ayTicks[idx], tickList._ticks.data(), sizeof(WTSTickStruct)*tickList._ticks.size());
+				ayTicks.insert(ayTicks.end(), tickList._ticks.begin(), tickList._ticks.end());
 				tickList._ticks.swap(ayTicks);
-			});
+			}
 
 			if(cnt > 0)
 			{
@@ -180,14 +165,7 @@ WTSTickSlice* WtRdmDtReaderAD::readTickSliceByRange(const char* stdCode, uint64_
 			WtLMDBQuery query(*db);
 			LMDBHftKey lKey(cInfo._exchg, cInfo._code, (uint32_t)(tickList._last_tick_time / 1000000000), (uint32_t)(tickList._last_tick_time % 1000000000));
 			LMDBHftKey rKey(cInfo._exchg, cInfo._code, endTDate, rTime * 100000 + rSecs);
-			int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
-				[this, &tickList](const ValueArray& ayKeys, const ValueArray& ayVals) {
-				for (const std::string& item : ayVals)
-				{
-					WTSTickStruct* curTick = (WTSTickStruct*)item.data();
-					tickList._ticks.emplace_back(*curTick);
-				}
-			});
+			int cnt = query.get_range_as(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)), tickList._ticks);
 
 			if (cnt > 0)
 			{
@@ -296,20 +274,11 @@ WTSKlineSlice* WtRdmDtReaderAD::readKlineSliceByRange(const char* stdCode, WTSKl
 		WtLMDBQuery query(*db);
 		LMDBBarKey rKey(cInfo._exchg, cInfo._code, 0xffffffff);
 		LMDBBarKey lKey(cInfo._exchg, cInfo._code, 0);
-		int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
-			[this, &barsList, &lKey](const ValueArray& ayKeys, const ValueArray& ayVals) {
-			if (ayVals.empty())
-				return;
-
-			std::size_t cnt = ayVals.size();
-			barsList._bars.resize(cnt);
-			std::size_t idx = 0;
-			for (const std::string& item : ayVals)
-			{
-				memcpy(&barsList._bars[idx], item.data(), item.size());
-				idx++;
-			}
-		});
+		std::vector<WTSBarStruct> ayBars;
+		int cnt = query.get_range_as(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)), ayBars);
+
+		if (!ayBars.empty())
+			barsList._bars.swap(ayBars);
 	}
 	else if(bNeedNewer)
 	{
@@ -318,20 +287,11 @@ WTSKlineSlice* WtRdmDtReaderAD::readKlineSliceByRange(const char* stdCode, WTSKl
 		WtLMDBQuery query(*db);
 		LMDBBarKey rKey(cInfo._exchg, cInfo._code, 0xffffffff);
 		LMDBBarKey lKey(cInfo._exchg, cInfo._code, (uint32_t)barsList._last_bar_time);
-		int cnt = query.get_range(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)),
-			[this, &barsList, &lKey](const ValueArray& ayKeys, const ValueArray& ayVals) {
-			if (ayVals.empty())
-				return;
-
-			std::size_t cnt = ayVals.size();
-			barsList._bars.resize(cnt);
-			std::size_t idx = 0;
-			for (const std::string& item : ayVals)
-			{
-				memcpy(&barsList._bars[idx], item.data(), item.size());
-				idx++;
-			}
-		});
+		std::vector<WTSBarStruct> ayBars;
+		int cnt = query.get_range_as(std::string((const char*)&lKey, sizeof(lKey)), std::string((const char*)&rKey, sizeof(rKey)), ayBars);
+
+		if (!ayBars.empty())
+			barsList._bars.swap(ayBars);
 	}
 
 	//
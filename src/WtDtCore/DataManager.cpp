@@ -10,6 +10,7 @@
 #include "DataManager.h"
 #include "StateMonitor.h"
 #include "UDPCaster.h"
+#include "ShmCaster.h"
 #include "WtHelper.h"
 
 #include "../Includes/WTSVariant.hpp"
@@ -24,6 +25,7 @@ DataManager::DataManager()
 	, _bd_mgr(NULL)
 	, _state_mon(NULL)
 	, _udp_caster(NULL)
+	, _shm_caster(NULL)
 {
 }
 
@@ -40,11 +42,12 @@ bool DataManager::isSessionProceeded(const char* sid)
 	return _writer->isSessionProceeded(sid);
 }
 
-bool DataManager::init(WTSVariant* params, WTSBaseDataMgr* bdMgr, StateMonitor* stMonitor, UDPCaster* caster /* = NULL */)
+bool DataManager::init(WTSVariant* params, WTSBaseDataMgr* bdMgr, StateMonitor* stMonitor, UDPCaster* caster /* = NULL */, ShmCaster* shmCaster /* = NULL */)
 {
 	_bd_mgr = bdMgr;
 	_state_mon = stMonitor;
 	_udp_caster = caster;
+	_shm_caster = shmCaster;
 
 	std::string module = params->getCString("module");
 	if (module.empty())
@@ -165,24 +168,36 @@ bool DataManager::canSessionReceive(const char* sid)
 
 void DataManager::broadcastTick(WTSTickData* curTick)
 {
+	if (_shm_caster)
+		_shm_caster->broadcast(curTick);
+
 	if (_udp_caster)
 		_udp_caster->broadcast(curTick);
 }
 
 void DataManager::broadcastOrdDtl(WTSOrdDtlData* curOrdDtl)
 {
+	if (_shm_caster)
+		_shm_caster->broadcast(curOrdDtl);
+
 	if (_udp_caster)
 		_udp_caster->broadcast(curOrdDtl);
 }
 
 void DataManager::broadcastOrdQue(WTSOrdQueData* curOrdQue)
 {
+	if (_shm_caster)
+		_shm_caster->broadcast(curOrdQue);
+
 	if (_udp_caster)
 		_udp_caster->broadcast(curOrdQue);
 }
 
 void DataManager::broadcastTrans(WTSTransData* curTrans)
 {
+	if (_shm_caster)
+		_shm_caster->broadcast(curTrans);
+
 	if (_udp_caster)
 		_udp_caster->broadcast(curTrans);
 }
@@ -26,6 +26,7 @@ USING_NS_WTP;
 class WTSBaseDataMgr;
 class StateMonitor;
 class UDPCaster;
+class ShmCaster;
 
 class DataManager : public IDataWriterSink
 {
@@ -34,7 +35,7 @@ public:
 	~DataManager();
 
 public:
-	bool init(WTSVariant* params, WTSBaseDataMgr* bdMgr, StateMonitor* stMonitor, UDPCaster* caster = NULL);
+	bool init(WTSVariant* params, WTSBaseDataMgr* bdMgr, StateMonitor* stMonitor, UDPCaster* caster = NULL, ShmCaster* shmCaster = NULL);
 
 	void add_ext_dumper(const char* id, IHisDataDumper* dumper);
 
@@ -86,5 +87,6 @@ private:
 	WTSBaseDataMgr*		_bd_mgr;
 	StateMonitor*		_state_mon;
 	UDPCaster*			_udp_caster;
+	ShmCaster*			_shm_caster;
 };
 
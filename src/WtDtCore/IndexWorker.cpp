@@ -49,6 +49,10 @@ bool IndexWorker::init(WTSVariant* config)
 	//Ȩ㷨
 	_weight_alg = config->getUInt32("weight_alg");
 
+	//¶ٴԺȫһλֵ
+	if (config->has("resync_ticks"))
+		_resync_ticks = std::max(config->getUInt32("resync_ticks"), (uint32_t)1);
+
 	WTSVariant* cfgComms = config->get("commodities");
 	WTSVariant* cfgCodes = config->get("codes");
 	if (cfgComms != NULL && cfgComms->size() > 0)
@@ -171,6 +175,15 @@ bool IndexWorker::init(WTSVariant* config)
 		}
 	}
 
+	{
+		SpinLock lock(_mtx_data);
+		_total_weight = 0;
+		for (const auto& v : _weight_scales)
+			_total_weight += v.second._weight;
+
+		resync_totals();
+	}
+
 	WTSLogger::info("Block index {}.{} initializedweight algorithm: {}, trigger: {}, timeout: {}", _exchg, _code, WEIGHT_ALGS[_weight_alg], _trigger, _timeout);
 
 	return true;
@@ -186,8 +199,20 @@ void IndexWorker::handle_quote(WTSTickData* newTick)
 		if (it == _weight_scales.end())
 			return;
 
+		//ȼɷֺԼԭĹףټµĹ
 		WeightFactor& wFactor = (WeightFactor&)it->second;
+		accumulate(wFactor._tick, wFactor._weight, -1.0);
 		memcpy(&wFactor._tick, &newTick->getTickStruct(), sizeof(WTSTickStruct));
+		accumulate(wFactor._tick, wFactor._weight, 1.0);
+
+		uint64_t curTime = TimeUtils::makeTime(wFactor._tick.action_date, wFactor._tick.action_time);
+		_totals._max_time = std::max(_totals._max_time, curTime);
+		_totals._trading_date = std::max(_totals._trading_date, wFactor._tick.trading_date);
+
+		//ȫ㣬⸡ۻ
+		_updates++;
+		if (_updates >= _resync_ticks)
+			resync_totals();
 	}
 
 	//ʹtimeôһɷֺԼԺ󣬻ȥָʱ
@@ -239,61 +264,48 @@ void IndexWorker::handle_quote(WTSTickData* newTick)
 	}
 }
 
-void IndexWorker::generate_tick()
+void IndexWorker::resync_totals()
 {
-	//Ȼʼָ
-	double total_base = 0.0;	//Ȩػ
-	double total_value = 0.0;	//ֵۼ
-	double total_vol = 0.0;		//ָܳɽ
-	double total_amt = 0.0;		//ָܳɽ
-	double total_hold = 0.0;	//ָܳ
-	uint64_t maxTime = 0;		//һtickʱ
-	uint32_t tDate = 0;			//
+	_totals = IndexTotals();
+	for (const auto& v : _weight_scales)
+	{
+		const WeightFactor& wFactor = v.second;
+		if (wFactor._tick.action_date == 0)
+			continue;
 
-	double total_weight = 0;
+		accumulate(wFactor._tick, wFactor._weight, 1.0);
 
+		uint64_t curTime = TimeUtils::makeTime(wFactor._tick.action_date, wFactor._tick.action_time);
+		_totals._max_time = std::max(_totals._max_time, curTime);
+		_totals._trading_date = std::max(_totals._trading_date, wFactor._tick.trading_date);
+	}
+	_updates = 0;
+}
+
+void IndexWorker::generate_tick()
+{
+	//ֵάģֻҪһ
+	IndexTotals totals;
 	{
-		//Ȱס
 		SpinLock lock(_mtx_data);
-		for (const auto& v : _weight_scales)
-		{
-			//ݲȫֱ˳
-			const WeightFactor& wFactor = v.second;
-			if (wFactor._tick.action_date == 0)
-				return;
-
-			uint64_t curTime = TimeUtils::makeTime(wFactor._tick.action_date, wFactor._tick.action_time);
-			maxTime = std::max(maxTime, curTime);
-			tDate = std::max(tDate, wFactor._tick.trading_date);
+		totals = _totals;
+	}
 
-			total_vol += wFactor._tick.total_volume;
-			total_amt += wFactor._tick.total_turnover;
-			total_hold += wFactor._tick.open_interest;
+	//ݲȫֱ˳
+	if (totals._ready < _weight_scales.size())
+		return;
 
-			total_weight += wFactor._weight;
+	double total_vol = totals._volume;		//ָܳɽ
+	double total_amt = totals._turnover;	//ָܳɽ
+	double total_hold = totals._interest;	//ָܳ
+	uint64_t maxTime = totals._max_time;	//һtickʱ
+	uint32_t tDate = totals._trading_date;	//
 
-			switch (_weight_alg)
-			{
-			case 0://̶Ȩأֻweight
-				total_base = 1;	//ΪֻweightȨػΪ1
-				total_value += wFactor._tick.price * wFactor._weight;
-				break;
-			case 1:	//̬ܳ
-				total_base += wFactor._tick.open_interest;	//̬ܳΪǰܳ
-				total_value += wFactor._tick.open_interest * wFactor._tick.price * wFactor._weight;
-				break;
-			case 2:	//̬ɽ
-				total_base += wFactor._tick.total_volume;	//̬ɽ
-				total_value += wFactor._tick.total_volume * wFactor._tick.price * wFactor._weight;
-				break;
-			default:
-				break;
-			}
-		}
-	}
+	//̶ȨֻweightȨػΪ1
+	double total_base = (_weight_alg == 0) ? 1.0 : totals._base;
 
 	//׼
-	double index = total_value / total_base / total_weight * _stand_scale;
+	double index = totals._value / total_base / _total_weight * _stand_scale;
 
 	//ʱһ
 	maxTime += _timeout;
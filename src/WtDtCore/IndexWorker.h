@@ -22,7 +22,8 @@ class IndexFactory;
 class IndexWorker
 {
 public:
-	IndexWorker(IndexFactory* factor):_factor(factor), _stopped(false), _process(false) {}
+	IndexWorker(IndexFactory* factor):_factor(factor), _stopped(false), _process(false)
+		, _total_weight(0), _updates(0), _resync_ticks(10000) {}
 
 public:
 	bool	init(WTSVariant* config);
@@ -31,6 +32,12 @@ public:
 private:
 	void	generate_tick();
 
+	/*
+	 *	ȫֵ, ۼӵĸ
+	 *	֮ǰҪס_mtx_data
+	 */
+	void	resync_totals();
+
 protected:
 	IndexFactory*	_factor;
 	std::string		_exchg;
@@ -55,6 +62,62 @@ protected:
 	wt_hashmap<std::string, WeightFactor>	_weight_scales;
 	uint32_t	_weight_alg;
 
+	/*
+	 *	ָĻֵ, ÿʱɷֺԼԭĹ, ټµĹ
+	 *	ָʱֻҪһݻֵ, ٱȫɷֺԼ
+	 */
+	typedef struct _IndexTotals
+	{
+		double		_value;			//ֵۼ
+		double		_base;			//Ȩػ
+		double		_volume;		//ܳɽ
+		double		_turnover;		//ܳɽ
+		double		_interest;		//ܳ
+		uint64_t	_max_time;		//һtickʱ
+		uint32_t	_trading_date;	//
+		uint32_t	_ready;			//ѾյĳɷֺԼ
+
+		_IndexTotals()
+		{
+			memset(this, 0, sizeof(_IndexTotals));
+		}
+	} IndexTotals;
+	IndexTotals	_totals;
+	double		_total_weight;
+	uint32_t	_updates;		//ϴȫԺ´
+	uint32_t	_resync_ticks;	//¶ٴԺȫһ
+
+	inline void	accumulate(const WTSTickStruct& tick, double weight, double sign)
+	{
+		if (tick.action_date == 0)
+			return;
+
+		_totals._volume += sign * tick.total_volume;
+		_totals._turnover += sign * tick.total_turnover;
+		_totals._interest += sign * tick.open_interest;
+		if (sign > 0)
+			_totals._ready++;
+		else
+			_totals._ready--;
+
+		switch (_weight_alg)
+		{
+		case 0://̶ȨأֻweightȨػ̶Ϊ1
+			_totals._value += sign * tick.price * weight;
+			break;
+		case 1:	//̬ܳ
+			_totals._base += sign * tick.open_interest;
+			_totals._value += sign * tick.open_interest * tick.price * weight;
+			break;
+		case 2:	//̬ɽ
+			_totals._base += sign * tick.total_volume;
+			_totals._value += sign * tick.total_volume * tick.price * weight;
+			break;
+		default:
+			break;
+		}
+	}
+
 	StdThreadPtr	_thrd_trigger;
 	StdUniqueMutex	_mtx_trigger;
 	StdCondVariable	_cond_trigger;
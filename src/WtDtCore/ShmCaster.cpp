@@ -0,0 +1,87 @@
+/*!
+ * \file ShmCaster.cpp
+ * \project	WonderTrader
+ *
+ * \date 2023/09/16
+ * 
+ * \brief 
+ */
+#include "ShmCaster.h"
+
+#include "../Includes/WTSDataDef.hpp"
+#include "../Includes/WTSVariant.hpp"
+
+#include "../WTSTools/WTSLogger.h"
+
+ShmCaster::ShmCaster()
+	: _inited(false)
+{
+}
+
+
+ShmCaster::~ShmCaster()
+{
+}
+
+bool ShmCaster::init(WTSVariant* cfg)
+{
+	if (cfg == NULL || !cfg->getBoolean("active"))
+		return false;
+
+	_name = cfg->getCString("name");
+	if (_name.empty())
+		_name = "WtTickBus";
+
+	//λҪɶȡһεӳڵ飬Ĭ64K
+	uint32_t capacity = cfg->getUInt32("capacity");
+	if (capacity == 0)
+		capacity = 65536;
+
+	if (!_bus.create(_name.c_str(), capacity))
+	{
+		WTSLogger::error("Creating shared memory tick bus {} failed", _name);
+		return false;
+	}
+
+	_inited = true;
+	WTSLogger::info("Shared memory tick bus {} created with {} slots", _name, _bus.capacity());
+	return true;
+}
+
+void ShmCaster::stop()
+{
+	_inited = false;
+	_bus.close();
+}
+
+void ShmCaster::broadcast(WTSTickData* curTick)
+{
+	if (!_inited || curTick == NULL)
+		return;
+
+	_bus.publish(SBT_Tick, &curTick->getTickStruct(), sizeof(WTSTickStruct));
+}
+
+void ShmCaster::broadcast(WTSOrdQueData* curOrdQue)
+{
+	if (!_inited || curOrdQue == NULL)
+		return;
+
+	_bus.publish(SBT_OrdQue, &curOrdQue->getOrdQueStruct(), sizeof(WTSOrdQueStruct));
+}
+
+void ShmCaster::broadcast(WTSOrdDtlData* curOrdDtl)
+{
+	if (!_inited || curOrdDtl == NULL)
+		return;
+
+	_bus.publish(SBT_OrdDtl, &curOrdDtl->getOrdDtlStruct(), sizeof(WTSOrdDtlStruct));
+}
+
+void ShmCaster::broadcast(WTSTransData* curTrans)
+{
+	if (!_inited || curTrans == NULL)
+		return;
+
+	_bus.publish(SBT_Trans, &curTrans->getTransStruct(), sizeof(WTSTransStruct));
+}
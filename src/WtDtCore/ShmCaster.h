@@ -0,0 +1,46 @@
+/*!
+ * \file ShmCaster.h
+ * \project	WonderTrader
+ *
+ * \date 2023/09/16
+ * 
+ * \brief ڴ㲥
+ *
+ * UDPCasterУдڴ
+ * ͬһ̨ϵĽ׽ͨParserShmȡҪں
+ */
+#pragma once
+
+#include "../Includes/WTSMarcos.h"
+#include "../Share/ShmTickBus.hpp"
+
+NS_WTP_BEGIN
+	class WTSTickData;
+	class WTSVariant;
+	class WTSOrdDtlData;
+	class WTSOrdQueData;
+	class WTSTransData;
+NS_WTP_END
+
+USING_NS_WTP;
+
+class ShmCaster
+{
+public:
+	ShmCaster();
+	~ShmCaster();
+
+public:
+	bool	init(WTSVariant* cfg);
+	void	stop();
+
+	void	broadcast(WTSTickData* curTick);
+	void	broadcast(WTSOrdQueData* curOrdQue);
+	void	broadcast(WTSOrdDtlData* curOrdDtl);
+	void	broadcast(WTSTransData* curTrans);
+
+private:
+	ShmTickBus		_bus;
+	std::string		_name;
+	bool			_inited;
+};
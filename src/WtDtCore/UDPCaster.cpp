@@ -18,12 +18,18 @@
 #include "../WTSTools/WTSBaseDataMgr.h"
 #include "../WTSTools/WTSLogger.h"
 
+#include <algorithm>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <errno.h>
+#endif
 
 #define UDP_MSG_SUBSCRIBE	0x100
 #define UDP_MSG_PUSHTICK	0x200
 #define UDP_MSG_PUSHORDQUE	0x201	//ίж
 #define UDP_MSG_PUSHORDDTL	0x202	//ίϸ
 #define UDP_MSG_PUSHTRANS	0x203	//ʳɽ
+#define UDP_MSG_PUSHBATCH	0x2FF	//ϲݰ
 
 #pragma pack(push,1)
 //UDP
@@ -40,16 +46,100 @@ struct UDPDataPacket
 	uint32_t	_type;
 	T			_data;
 };
+
+//ϲݰİͷ_countUDPDataPacket
+typedef struct _UDPBatchHead
+{
+	uint32_t	_type;
+	uint32_t	_count;
+} UDPBatchHead;
 #pragma pack(pop)
 typedef UDPDataPacket<WTSTickStruct>	UDPTickPacket;
 typedef UDPDataPacket<WTSOrdQueStruct>	UDPOrdQuePacket;
 typedef UDPDataPacket<WTSOrdDtlStruct>	UDPOrdDtlPacket;
 typedef UDPDataPacket<WTSTransStruct>	UDPTransPacket;
 
+//ϲʱUDPݰĬϳȣ̫MTUȥIPͷUDPͷ
+static const uint32_t DEFAULT_PACK_SIZE = 1472;
+//ϲʱUDPݰ󳤶
+static const uint32_t MAX_PACK_SIZE = 65000;
+//ͻɵݰҲһsendmmsg෢͵ݰ
+static const uint32_t MAX_CACHED_PACKS = 64;
+
+#ifdef __linux__
+/*
+ *	ͨsendmmsgһݰ͵ɸַ
+ *	mmsghdriovecֲ߳̾ģʹò·
+ *
+ *	@fd			socket
+ *	@eps		ն˵ַ
+ *	@buf		ͻ
+ *	@packSize	ÿݰڷͻռõĳ
+ *	@lens		ÿݰʵʳ
+ *	@packCnt	ݰ
+ *	@failed		ʧܵݰ
+ *	@return		ɹ0ʧܵķһʧܵerrno
+ */
+static int send_mmsg(int fd, const std::vector<const UDPCaster::EndPoint*>& eps, const char* buf, uint32_t packSize, const std::vector<uint32_t>& lens, uint32_t packCnt, uint32_t& failed)
+{
+	static thread_local std::vector<mmsghdr> msgs;
+	static thread_local std::vector<iovec> iovs;
+
+	std::size_t total = eps.size()*packCnt;
+	msgs.resize(total);
+	iovs.resize(total);
+
+	std::size_t idx = 0;
+	for (const UDPCaster::EndPoint* ep : eps)
+	{
+		for (uint32_t i = 0; i < packCnt; i++, idx++)
+		{
+			iovs[idx].iov_base = (void*)(buf + i * packSize);
+			iovs[idx].iov_len = lens[i];
+
+			mmsghdr& msg = msgs[idx];
+			memset(&msg, 0, sizeof(mmsghdr));
+			msg.msg_hdr.msg_name = (void*)ep->data();
+			msg.msg_hdr.msg_namelen = (socklen_t)ep->size();
+			msg.msg_hdr.msg_iov = &iovs[idx];
+			msg.msg_hdr.msg_iovlen = 1;
+		}
+	}
+
+	//sendmmsgֻһ֣ʣµҪŷ
+	//ĳն˳(絥ַɴ)һնճ
+	std::size_t sent = 0;
+	int lastErr = 0;
+	failed = 0;
+	while (sent < total)
+	{
+		int ret = sendmmsg(fd, msgs.data() + sent, (unsigned int)(total - sent), 0);
+		if (ret < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			lastErr = errno;
+			failed++;
+			sent++;
+			continue;
+		}
+
+		sent += ret;
+	}
+
+	return lastErr;
+}
+#endif
+
 UDPCaster::UDPCaster()
 	: m_bTerminated(false)
 	, m_bdMgr(NULL)
 	, m_dtMgr(NULL)
+	, m_bBatch(false)
+	, m_uPackSize(DEFAULT_PACK_SIZE)
+	, m_uPackCnt(0)
+	, m_uItemCnt(0)
 {
 	
 }
@@ -87,6 +177,27 @@ bool UDPCaster::init(WTSVariant* cfg, WTSBaseDataMgr* bdMgr, DataManager* dtMgr)
 		}
 	}
 
+	/*
+	 *	batchΪtrueʱݻϲһUDPݰ﷢ͣնҲҪʹֺ֧ϲݰParserUDP
+	 *	packsizeΪϲԺ󵥸ݰ󳤶ȣĬΪ1472˾֡Ļʵ
+	 */
+	m_bBatch = cfg->getBoolean("batch");
+	if (m_bBatch)
+	{
+		uint32_t packSize = cfg->getUInt32("packsize");
+		if (packSize == 0)
+			packSize = DEFAULT_PACK_SIZE;
+		//Ҫܷһtick
+		m_uPackSize = std::min(std::max(packSize, (uint32_t)(sizeof(UDPBatchHead) + sizeof(UDPTickPacket))), MAX_PACK_SIZE);
+	}
+	else
+	{
+		m_uPackSize = sizeof(UDPTickPacket);
+	}
+	m_bufPacks.resize(MAX_CACHED_PACKS*m_uPackSize);
+	m_vecPackLens.resize(MAX_CACHED_PACKS);
+	WTSLogger::info("UDPCaster batch mode: {}, packet size: {}", m_bBatch ? "on" : "off", m_uPackSize);
+
 	//By Wesley @ 2022.01.11
 	//ǶĶ˿ڣǰȫõbportڱ
 	//ֻдһ
@@ -298,105 +409,199 @@ void UDPCaster::broadcast(WTSObject* data, uint32_t dataType)
 	if(m_thrdCast == NULL)
 	{
 		m_thrdCast.reset(new StdThread([this](){
+			cast_loop();
+		}));
+	}
+	else
+	{
+		m_condCast.notify_all();
+	}
+}
+
+void UDPCaster::cast_loop()
+{
+	while (!m_bTerminated)
+	{
+		if(m_dataQue.empty())
+		{
+			StdUniqueLock lock(m_mtxCast);
+			m_condCast.wait(lock);
+			continue;
+		}	
+
+		std::queue<CastData> tmpQue;
+		{
+			StdUniqueLock lock(m_mtxCast);
+			tmpQue.swap(m_dataQue);
+		}
+
+		//ֱֻӹ㲥ĽնˣûеĻͲô
+		bool hasRecver = !m_listRawGroup.empty() || !m_listRawRecver.empty();
+		while(!tmpQue.empty())
+		{
+			const CastData& castData = tmpQue.front();
+
+			if (castData._data == NULL)
+				break;
 
-			while (!m_bTerminated)
+			//ͻˣȷͣ´
+			if (hasRecver && !pack_data(castData._data, castData._datatype))
 			{
-				if(m_dataQue.empty())
-				{
-					StdUniqueLock lock(m_mtxCast);
-					m_condCast.wait(lock);
-					continue;
-				}	
+				send_packs();
+				continue;
+			}
 
-				std::queue<CastData> tmpQue;
-				{
-					StdUniqueLock lock(m_mtxCast);
-					tmpQue.swap(m_dataQue);
-				}
-				
-				while(!tmpQue.empty())
-				{
-					const CastData& castData = tmpQue.front();
+			tmpQue.pop();
+		}
 
-					if (castData._data == NULL)
-						break;
+		send_packs();
+	}
+}
 
-					//ֱӹ㲥
-					if (!m_listRawGroup.empty() || !m_listRawRecver.empty())
-					{
-						std::string buf_raw;
-						if (castData._datatype == UDP_MSG_PUSHTICK)
-						{
-							buf_raw.resize(sizeof(UDPTickPacket));
-							UDPTickPacket* pack = (UDPTickPacket*)buf_raw.data();
-							pack->_type = castData._datatype;
-							WTSTickData* curObj = (WTSTickData*)castData._data;
-							memcpy(&pack->_data, &curObj->getTickStruct(), sizeof(WTSTickStruct));
-						}
-						else if (castData._datatype == UDP_MSG_PUSHORDDTL)
-						{
-							buf_raw.resize(sizeof(UDPOrdDtlPacket));
-							UDPOrdDtlPacket* pack = (UDPOrdDtlPacket*)buf_raw.data();
-							pack->_type = castData._datatype;
-							WTSOrdDtlData* curObj = (WTSOrdDtlData*)castData._data;
-							memcpy(&pack->_data, &curObj->getOrdDtlStruct(), sizeof(WTSOrdDtlStruct));
-						}
-						else if (castData._datatype == UDP_MSG_PUSHORDQUE)
-						{
-							buf_raw.resize(sizeof(UDPOrdQuePacket));
-							UDPOrdQuePacket* pack = (UDPOrdQuePacket*)buf_raw.data();
-							pack->_type = castData._datatype;
-							WTSOrdQueData* curObj = (WTSOrdQueData*)castData._data;
-							memcpy(&pack->_data, &curObj->getOrdQueStruct(), sizeof(WTSOrdQueStruct));
-						}
-						else if (castData._datatype == UDP_MSG_PUSHTRANS)
-						{
-							buf_raw.resize(sizeof(UDPTransPacket));
-							UDPTransPacket* pack = (UDPTransPacket*)buf_raw.data();
-							pack->_type = castData._datatype;
-							WTSTransData* curObj = (WTSTransData*)castData._data;
-							memcpy(&pack->_data, &curObj->getTransStruct(), sizeof(WTSTransStruct));
-						}
-						else
-						{
-							break;
-						}
+bool UDPCaster::pack_data(WTSObject* data, uint32_t dataType)
+{
+	const void* pStruct = NULL;
+	uint32_t len = 0;
+	if (dataType == UDP_MSG_PUSHTICK)
+	{
+		pStruct = &((WTSTickData*)data)->getTickStruct();
+		len = sizeof(WTSTickStruct);
+	}
+	else if (dataType == UDP_MSG_PUSHORDDTL)
+	{
+		pStruct = &((WTSOrdDtlData*)data)->getOrdDtlStruct();
+		len = sizeof(WTSOrdDtlStruct);
+	}
+	else if (dataType == UDP_MSG_PUSHORDQUE)
+	{
+		pStruct = &((WTSOrdQueData*)data)->getOrdQueStruct();
+		len = sizeof(WTSOrdQueStruct);
+	}
+	else if (dataType == UDP_MSG_PUSHTRANS)
+	{
+		pStruct = &((WTSTransData*)data)->getTransStruct();
+		len = sizeof(WTSTransStruct);
+	}
+	else
+	{
+		//ʶֱӶ
+		return true;
+	}
 
-						//㲥
-						boost::system::error_code ec;
-						for (auto it = m_listRawRecver.begin(); it != m_listRawRecver.end(); it++)
-						{
-							const UDPReceiverPtr& receiver = (*it);
-							m_sktBroadcast->send_to(boost::asio::buffer(buf_raw), receiver->_ep, 0, ec);
-							if (ec)
-							{
-								WTSLogger::error("Error occured while sending to ({}:{}): {}({})", 
-									receiver->_ep.address().to_string(), receiver->_ep.port(), ec.value(), ec.message());
-							}
-						}
+	uint32_t pktLen = sizeof(uint32_t) + len;
+	if (m_bBatch)
+	{
+		//ǰݰŲˣ¿һݰ
+		if (m_uItemCnt > 0 && m_vecPackLens[m_uPackCnt - 1] + pktLen > m_uPackSize)
+			m_uItemCnt = 0;
 
-						//鲥
-						for (auto it = m_listRawGroup.begin(); it != m_listRawGroup.end(); it++)
-						{
-							const MulticastPair& item = *it;
-							it->first->send_to(boost::asio::buffer(buf_raw), item.second->_ep, 0, ec);
-							if (ec)
-							{
-								WTSLogger::error("Error occured while sending to ({}:{}): {}({})",
-									item.second->_ep.address().to_string(), item.second->_ep.port(), ec.value(), ec.message());
-							}
-						}
-					}
+		if (m_uItemCnt == 0)
+		{
+			if (m_uPackCnt == MAX_CACHED_PACKS)
+				return false;
+
+			UDPBatchHead* head = (UDPBatchHead*)(m_bufPacks.data() + m_uPackCnt * m_uPackSize);
+			head->_type = UDP_MSG_PUSHBATCH;
+			head->_count = 0;
+			m_vecPackLens[m_uPackCnt] = sizeof(UDPBatchHead);
+			m_uPackCnt++;
+		}
 
-					tmpQue.pop();
-				} 
-			}
-		}));
+		char* buf = m_bufPacks.data() + (m_uPackCnt - 1) * m_uPackSize;
+		uint32_t& packLen = m_vecPackLens[m_uPackCnt - 1];
+		memcpy(buf + packLen, &dataType, sizeof(uint32_t));
+		memcpy(buf + packLen + sizeof(uint32_t), pStruct, len);
+		packLen += pktLen;
+		((UDPBatchHead*)buf)->_count++;
+		m_uItemCnt++;
 	}
 	else
 	{
-		m_condCast.notify_all();
+		if (m_uPackCnt == MAX_CACHED_PACKS)
+			return false;
+
+		char* buf = m_bufPacks.data() + m_uPackCnt * m_uPackSize;
+		memcpy(buf, &dataType, sizeof(uint32_t));
+		memcpy(buf + sizeof(uint32_t), pStruct, len);
+		m_vecPackLens[m_uPackCnt] = pktLen;
+		m_uPackCnt++;
+	}
+
+	return true;
+}
+
+void UDPCaster::send_packs()
+{
+	if (m_uPackCnt == 0)
+		return;
+
+#ifdef __linux__
+	//㲥Ľն˹һsocketһsendmmsgͿԷеĽն
+	if (!m_listRawRecver.empty())
+	{
+		static thread_local std::vector<const EndPoint*> eps;
+		eps.clear();
+		for (const UDPReceiverPtr& receiver : m_listRawRecver)
+			eps.emplace_back(&receiver->_ep);
+
+		uint32_t failed = 0;
+		int ec = send_mmsg(m_sktBroadcast->native_handle(), eps, m_bufPacks.data(), m_uPackSize, m_vecPackLens, m_uPackCnt, failed);
+		if (ec != 0)
+		{
+			WTSLogger::error("Error occured while broadcasting {} packets to {} receivers, {} failed: {}({})",
+				m_uPackCnt, eps.size(), failed, strerror(ec), ec);
+		}
 	}
+
+	//鲥ÿ鶼Լsocket
+	for (const MulticastPair& item : m_listRawGroup)
+	{
+		static thread_local std::vector<const EndPoint*> eps;
+		eps.clear();
+		eps.emplace_back(&item.second->_ep);
+
+		uint32_t failed = 0;
+		int ec = send_mmsg(item.first->native_handle(), eps, m_bufPacks.data(), m_uPackSize, m_vecPackLens, m_uPackCnt, failed);
+		if (ec != 0)
+		{
+			WTSLogger::error("Error occured while sending {} packets to ({}:{}), {} failed: {}({})",
+				m_uPackCnt, item.second->_ep.address().to_string(), item.second->_ep.port(), failed, strerror(ec), ec);
+		}
+	}
+#else
+	for (uint32_t i = 0; i < m_uPackCnt; i++)
+	{
+		auto buf = boost::asio::buffer(m_bufPacks.data() + i * m_uPackSize, m_vecPackLens[i]);
+
+		//㲥
+		boost::system::error_code ec;
+		for (auto it = m_listRawRecver.begin(); it != m_listRawRecver.end(); it++)
+		{
+			const UDPReceiverPtr& receiver = (*it);
+			m_sktBroadcast->send_to(buf, receiver->_ep, 0, ec);
+			if (ec)
+			{
+				WTSLogger::error("Error occured while sending to ({}:{}): {}({})", 
+					receiver->_ep.address().to_string(), receiver->_ep.port(), ec.value(), ec.message());
+			}
+		}
+
+		//鲥
+		for (auto it = m_listRawGroup.begin(); it != m_listRawGroup.end(); it++)
+		{
+			const MulticastPair& item = *it;
+			it->first->send_to(buf, item.second->_ep, 0, ec);
+			if (ec)
+			{
+				WTSLogger::error("Error occured while sending to ({}:{}): {}({})",
+					item.second->_ep.address().to_string(), item.second->_ep.port(), ec.value(), ec.message());
+			}
+		}
+	}
+#endif
+
+	m_uPackCnt = 0;
+	m_uItemCnt = 0;
 }
 
 void UDPCaster::handle_send_broad(const EndPoint& ep, const boost::system::error_code& error, std::size_t bytes_transferred)
@@ -61,6 +61,24 @@ private:
 
 	void broadcast(WTSObject* data, uint32_t dataType);
 
+	/*
+	 *	㲥̵߳ѭ
+	 */
+	void cast_loop();
+
+	/*
+	 *	һݴͻ
+	 *	@data		Ҫ㲥
+	 *	@dataType	
+	 *	@return		falseҪȷٴ
+	 */
+	bool pack_data(WTSObject* data, uint32_t dataType);
+
+	/*
+	 *	ѷͻѾõݰ͸еĽն
+	 */
+	void send_packs();
+
 public:
 	bool	init(WTSVariant* cfg, WTSBaseDataMgr* bdMgr, DataManager* dtMgr);
 	void	start(int bport);
@@ -139,4 +157,16 @@ private:
 	} CastData;
 
 	std::queue<CastData>		m_dataQue;
+
+	/*
+	 *	ͻ涼Ԥõģ㲥ֱ߳Ӱݽṹ忽ȥ
+	 *	˺ϲԺ󣬶ݻϲһUDPݰݰĳȲm_uPackSize
+	 *	linuxһݰͨsendmmsgһԷеĽնˣϵͳô
+	 */
+	bool			m_bBatch;		//Ƿϲ
+	uint32_t		m_uPackSize;	//ϲԺ󵥸UDPݰ󳤶
+	std::vector<char>		m_bufPacks;		//ͻ棬m_uPackSizeзֳɸݰ
+	std::vector<uint32_t>	m_vecPackLens;	//ÿݰʵʳ
+	uint32_t		m_uPackCnt;		//Ѿݰ
+	uint32_t		m_uItemCnt;		//ǰݰе
 };
\ No newline at end of file
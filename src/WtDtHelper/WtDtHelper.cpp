@@ -21,6 +21,7 @@
 #include "../Includes/WTSSessionInfo.hpp"
 
 #include <rapidjson/document.h>
+#include <mutex>
 
 namespace rj = rapidjson;
 
@@ -118,45 +119,6 @@ bool proc_block_data(std::string& content, bool isBar, bool bKeepHead /* = true
 }
 
 
-uint32_t strToTime(const char* strTime, bool bKeepSec = false)
-{
-	std::string str;
-	const char *pos = strTime;
-	while (strlen(pos) > 0)
-	{
-		if (pos[0] != ':')
-		{
-			str.append(pos, 1);
-		}
-		pos++;
-	}
-
-	uint32_t ret = strtoul(str.c_str(), NULL, 10);
-	if (ret > 10000 && !bKeepSec)
-		ret /= 100;
-
-	return ret;
-}
-
-uint32_t strToDate(const char* strDate)
-{
-	StringVector ay = StrUtil::split(strDate, "/");
-	if (ay.size() == 1)
-		ay = StrUtil::split(strDate, "-");
-	std::stringstream ss;
-	if (ay.size() > 1)
-	{
-		auto pos = ay[2].find(" ");
-		if (pos != std::string::npos)
-			ay[2] = ay[2].substr(0, pos);
-		ss << ay[0] << (ay[1].size() == 1 ? "0" : "") << ay[1] << (ay[2].size() == 1 ? "0" : "") << ay[2];
-	}
-	else
-		ss << ay[0];
-
-	return strtoul(ss.str().c_str(), NULL, 10);
-}
-
 void dump_bars(WtString binFolder, WtString csvFolder, WtString strFilter /* = "" */, FuncLogCallback cbLogger /* = NULL */)
 {
 	std::string srcFolder = StrUtil::standardisePath(binFolder);
@@ -384,6 +346,7 @@ void trans_csv_bars(WtString csvFolder, WtString binFolder, WtString period, Fun
 	else
 		kp = KP_DAY;
 
+	std::vector<std::string> files;
 	boost::filesystem::path myPath(csvFolder);
 	boost::filesystem::directory_iterator endIter;
 	for (boost::filesystem::directory_iterator iter(myPath); iter != endIter; iter++)
@@ -394,54 +357,33 @@ void trans_csv_bars(WtString csvFolder, WtString binFolder, WtString period, Fun
 		if (iter->path().extension() != ".csv")
 			continue;
 
-		const std::string& path = iter->path().string();
-
-		if(cbLogger)
-			cbLogger(StrUtil::printf("ڶȡļ%s...", path.c_str()).c_str());
+		files.emplace_back(iter->path().string());
+	}
 
-		CsvReader reader(",");
-		if(!reader.load_from_file(path.c_str()))
-		{
-			if (cbLogger)
-				cbLogger(StrUtil::printf("ȡļ%sʧ...", path.c_str()).c_str());
-			continue;
-		}
+	if (cbLogger)
+		cbLogger(StrUtil::printf("ҵ%uļ, ʼȡ...", (uint32_t)files.size()).c_str());
 
-		std::vector<WTSBarStruct> bars;
+	BlockType btype;
+	switch (kp)
+	{
+	case KP_Minute1: btype = BT_HIS_Minute1; break;
+	case KP_Minute5: btype = BT_HIS_Minute5; break;
+	default: btype = BT_HIS_Day; break;
+	}
 
-		while(reader.next_row())
+	/*
+	 *	ļжȡѹ, صڹִ߳, ־صҪ
+	 */
+	std::mutex mtxLog;
+	CsvBarLoader::load_files(files, kp == KP_DAY, [&](const std::string& path, std::vector<WTSBarStruct>& bars, bool bSucc) {
+		if (!bSucc)
 		{
-			//жȡ
-			WTSBarStruct bs;
-			bs.date = strToDate(reader.get_string("date"));
-			if(kp != KP_DAY)
-				bs.time = TimeUtils::timeToMinBar(bs.date, strToTime(reader.get_string("time")));
-			bs.open = reader.get_double("open");
-			bs.high = reader.get_double("high");
-			bs.low = reader.get_double("low");
-			bs.close = reader.get_double("close");
-			bs.vol = reader.get_double("volume");
-			bs.money = reader.get_double("turnover");
-			bs.hold = reader.get_double("open_interest");
-			bs.add = reader.get_double("diff_interest");
-			bs.settle = reader.get_double("settle");
-			bars.emplace_back(bs);
-
-			if (bars.size() % 1000 == 0)
+			if (cbLogger)
 			{
-				if (cbLogger)
-					cbLogger(StrUtil::printf("Ѷȡ%u", bars.size()).c_str());
+				std::unique_lock<std::mutex> lock(mtxLog);
+				cbLogger(StrUtil::printf("ȡļ%sʧ...", path.c_str()).c_str());
 			}
-		}
-		if (cbLogger)
-			cbLogger(StrUtil::printf("ļ%sȫȡ,%u", path.c_str(), bars.size()).c_str());
-
-		BlockType btype;
-		switch (kp)
-		{
-		case KP_Minute1: btype = BT_HIS_Minute1; break;
-		case KP_Minute5: btype = BT_HIS_Minute5; break;
-		default: btype = BT_HIS_Day; break;
+			return;
 		}
 
 		HisKlineBlockV2 kBlock;
@@ -453,7 +395,7 @@ void trans_csv_bars(WtString csvFolder, WtString binFolder, WtString period, Fun
 		kBlock._size = cmprsData.size();
 
 		std::string filename = StrUtil::standardisePath(binFolder);
-		filename += iter->path().stem().string();
+		filename += boost::filesystem::path(path).stem().string();
 		filename += ".dsb";
 
 		BoostFile bf;
@@ -463,9 +405,13 @@ void trans_csv_bars(WtString csvFolder, WtString binFolder, WtString period, Fun
 		}
 		bf.write_file(cmprsData);
 		bf.close_file();
+
 		if (cbLogger)
-			cbLogger(StrUtil::printf("ת%s", filename.c_str()).c_str());
-	}
+		{
+			std::unique_lock<std::mutex> lock(mtxLog);
+			cbLogger(StrUtil::printf("ļ%sȫȡ,%u,ת%s", path.c_str(), (uint32_t)bars.size(), filename.c_str()).c_str());
+		}
+	});
 }
 
 //bool trans_bars(WtString barFile, FuncGetBarItem getter, int count, WtString period, FuncLogCallback cbLogger /* = NULL */)
@@ -91,49 +91,7 @@ void WtDtRunner::initialize(const char* cfgFile, const char* logCfg, const char*
 
 	//ļ
 	WTSVariant* cfgBF = config->get("basefiles");
-	if (cfgBF->get("session"))
-	{
-		_bd_mgr.loadSessions(cfgBF->getCString("session"));
-		WTSLogger::info("Trading sessions loaded");
-	}
-
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	if (cfgBF->get("holiday"))
-	{
-		_bd_mgr.loadHolidays(cfgBF->getCString("holiday"));
-		WTSLogger::info("Holidays loaded");
-	}
+	_bd_mgr.loadBaseFiles(cfgBF);
 
 
 	if (cfgBF->get("hot"))
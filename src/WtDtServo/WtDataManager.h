@@ -91,6 +91,11 @@ public:
 
 	void	clear_cache();
 
+	/*
+	 *	ȡݻͳϢ
+	 */
+	bool	get_cache_stats(RdmCacheStats& stats);
+
 private:
 	IRdmDtReader*			_reader;
 	FuncDeleteRdmDtReader	_remover;
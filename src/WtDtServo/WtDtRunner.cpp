@@ -79,49 +79,7 @@ void WtDtRunner::initialize(const char* cfgFile, bool isFile /* = true */, const
 	}
 	//ļ
 	WTSVariant* cfgBF = config->get("basefiles");
-	if (cfgBF->get("session"))
-	{
-		_bd_mgr.loadSessions(cfgBF->getCString("session"));
-		WTSLogger::info("Trading sessions loaded");
-	}
-
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	if (cfgBF->get("holiday"))
-	{
-		_bd_mgr.loadHolidays(cfgBF->getCString("holiday"));
-		WTSLogger::info("Holidays loaded");
-	}
+	_bd_mgr.loadBaseFiles(cfgBF);
 
 	if (cfgBF->get("hot"))
 	{
@@ -644,4 +602,19 @@ void WtDtRunner::trigger_bar(const char* stdCode, const char* period, WTSBarStru
 void WtDtRunner::clear_cache()
 {
 	_data_mgr.clear_cache();
+}
+
+const char* WtDtRunner::get_cache_stats()
+{
+	thread_local static std::string ret;
+	RdmCacheStats stats;
+	if (!_data_mgr.get_cache_stats(stats))
+	{
+		ret = "{}";
+		return ret.c_str();
+	}
+
+	ret = fmtutil::format("{{\"hits\":{},\"misses\":{},\"evictions\":{},\"bytes\":{},\"budget\":{},\"entries\":{},\"pinned\":{}}}",
+		stats._hits, stats._misses, stats._evictions, stats._bytes, stats._budget, stats._entries, stats._pinned);
+	return ret.c_str();
 }
\ No newline at end of file
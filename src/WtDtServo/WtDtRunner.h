@@ -46,6 +46,11 @@ public:
 
 	void	clear_cache();
 
+	/*
+	 *	ݻͳϢ, jsonʽ
+	 */
+	const char*	get_cache_stats();
+
 public:
 	WTSKlineSlice*	get_bars_by_range(const char* stdCode, const char* period, uint64_t beginTime, uint64_t endTime = 0);
 
@@ -237,4 +237,9 @@ void subscribe_bar(const char* stdCode, const char* period)
 void clear_cache()
 {
 	getRunner().clear_cache();
+}
+
+const char* get_cache_stats()
+{
+	return getRunner().get_cache_stats();
 }
\ No newline at end of file
@@ -21,6 +21,12 @@
 #include "../Share/StrUtil.hpp"
 #include "../Share/TimeUtils.hpp"
 #include "../Share/CpuHelper.hpp"
+#include "../Share/BoostFile.hpp"
+#include "../Share/LatencyHistogram.hpp"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+namespace rj = rapidjson;
 
 
 USING_NS_WTP;
@@ -60,15 +66,24 @@ namespace hft
 		return strtoul(str, NULL, 10);
 	}
 
+	LatencyProbe g_probe;
+
 	class TestParser : public IParserApi
 	{
 	public:
-		void	run(uint32_t times)
+		void	run(uint32_t times, uint32_t warmup)
 		{
 			srand(time(NULL));
 			TimeUtils::Ticker ticker;
-			for (uint32_t i = 0; i < times; i++)
+			for (uint32_t i = 0; i < warmup + times; i++)
 			{
+				//ԤȽԺٿʼͳ
+				if (i == warmup)
+				{
+					g_probe.reset();
+					ticker.reset();
+				}
+
 				uint32_t actDate = 20220303;// strtoul("20220303", NULL, 10);
 				uint32_t actTime = 100523 * 1000 + 500; //strToTime("10:05:23") * 1000 + 500;
 
@@ -134,7 +149,9 @@ namespace hft
 				quote.bid_qty[3] = 0;
 				quote.bid_qty[4] = 0;
 
+				g_probe.begin();
 				_parser_spi->handleQuote(tick, 0);
+				g_probe.end();
 				tick->release();
 			}
 			auto total = ticker.nano_seconds();
@@ -156,6 +173,33 @@ namespace hft
 
 	TestParser* theParser = NULL;
 
+	/*
+	 *	֮תڼ¼յʱ
+	 */
+	class TestStub : public IParserStub
+	{
+	public:
+		TestStub() : _target(NULL) {}
+
+		void	setTarget(IParserStub* target) { _target = target; }
+
+	public:
+		virtual void handle_push_quote(WTSTickData* curTick, uint32_t hotFlag) override
+		{
+			g_probe.mark(LM_Engine);
+			_target->handle_push_quote(curTick, hotFlag);
+		}
+
+		virtual void handle_push_order_detail(WTSOrdDtlData* curOrdDtl) override { _target->handle_push_order_detail(curOrdDtl); }
+		virtual void handle_push_order_queue(WTSOrdQueData* curOrdQue) override { _target->handle_push_order_queue(curOrdQue); }
+		virtual void handle_push_transaction(WTSTransData* curTrans) override { _target->handle_push_transaction(curTrans); }
+
+	private:
+		IParserStub*	_target;
+	};
+
+	TestStub theStub;
+
 	class TestTrader : public ITraderApi
 	{
 	public:
@@ -204,7 +248,11 @@ namespace hft
 		virtual void on_tick(IHftStraCtx* ctx, const char* code, WTSTickData* newTick)
 		{
 			//ctx->stra_sell("SHFE.rb.2205", 2300, 1, "", HFT_OrderFlag_Nor);
-			ctx->stra_buy("SHFE.rb.2205", 2300, 1, "", HFT_OrderFlag_Nor);
+			g_probe.mark(LM_Callback);
+			//ּµµ۸Ҫ
+			double price = newTick->askprice(0);
+			g_probe.mark(LM_Order);
+			ctx->stra_buy("SHFE.rb.2205", price, 1, "", HFT_OrderFlag_Nor);
 		}
 	};
 
@@ -232,40 +280,7 @@ namespace hft
 		//ļ
 		WTSVariant* cfgBF = _config->get("basefiles");
 		bool isUTF8 = cfgBF->getBoolean("utf-8");
-		if (cfgBF->get("session"))
-			_bd_mgr.loadSessions(cfgBF->getCString("session"));
-
-		WTSVariant* cfgItem = cfgBF->get("commodity");
-		if (cfgItem)
-		{
-			if (cfgItem->type() == WTSVariant::VT_String)
-			{
-				_bd_mgr.loadCommodities(cfgItem->asCString());
-			}
-			else if (cfgItem->type() == WTSVariant::VT_Array)
-			{
-				for (uint32_t i = 0; i < cfgItem->size(); i++)
-				{
-					_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-				}
-			}
-		}
-
-		cfgItem = cfgBF->get("contract");
-		if (cfgItem)
-		{
-			if (cfgItem->type() == WTSVariant::VT_String)
-			{
-				_bd_mgr.loadContracts(cfgItem->asCString());
-			}
-			else if (cfgItem->type() == WTSVariant::VT_Array)
-			{
-				for (uint32_t i = 0; i < cfgItem->size(); i++)
-				{
-					_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-				}
-			}
-		}
+		_bd_mgr.loadBaseFiles(cfgBF);
 
 		if (cfgBF->get("hot"))
 		{
@@ -281,6 +296,13 @@ namespace hft
 		_core = _config->getUInt32("core");
 		WTSLogger::warn("Testing thread will be bind to core {}", _core);
 
+		//ԤȴԤڼݲͳ
+		_warmup = _config->getUInt32("warmup");
+		WTSLogger::warn("{} ticks will be simulated for warming up", _warmup);
+
+		//ӳٱļjsonʽ
+		_output = _config->getCString("output");
+
 		initEngine(_config->get("env"));
 		initModules();
 		initStrategies();
@@ -318,7 +340,8 @@ namespace hft
 		{
 			theParser = new TestParser();
 			ParserAdapterPtr adapter(new ParserAdapter);
-			adapter->initExt("parser", theParser, &_engine, &_bd_mgr, &_hot_mgr);
+			theStub.setTarget(&_engine);
+			adapter->initExt("parser", theParser, &theStub, &_bd_mgr, &_hot_mgr);
 			_parsers.addAdapter("parser", adapter);
 		}
 
@@ -326,6 +349,7 @@ namespace hft
 			TestTrader * tester = new TestTrader();
 			TraderAdapterPtr adapter(new TraderAdapter());
 			adapter->initExt("trader", tester, &_bd_mgr, &_act_mgr);
+			adapter->setLatencyProbe(&g_probe);
 			_traders.addAdapter("trader", adapter);
 		}
 
@@ -342,6 +366,10 @@ namespace hft
 			}
 		}
 
+		//Ժٱ궨궨Ͳڲͬĺ
+		TscClock::calibrate();
+		WTSLogger::warn("TSC calibrated: {:.3f} ticks/ns", TscClock::ticks_per_ns());
+
 		try
 		{
 			_parsers.run();
@@ -349,10 +377,52 @@ namespace hft
 
 			_engine.run(true);
 
-			theParser->run(_times);
+			theParser->run(_times, _warmup);
+
+			report();
 		}
 		catch (...)
 		{
 		}
 	}
-}
\ No newline at end of file
+
+	/*
+	 *	׶εӳٷֲ
+	 *	outputĻͬʱjsonļ㲻ͬ汾֮Ա
+	 */
+	void HftLatencyTool::report()
+	{
+		rj::Document root(rj::kObjectType);
+		rj::Document::AllocatorType &allocator = root.GetAllocator();
+		root.AddMember("engine", "HFT", allocator);
+		root.AddMember("mode", "inner", allocator);
+		root.AddMember("times", _times, allocator);
+		root.AddMember("warmup", _warmup, allocator);
+		root.AddMember("core", _core, allocator);
+		root.AddMember("ticks_per_ns", TscClock::ticks_per_ns(), allocator);
+
+		rj::Value jStages(rj::kObjectType);
+		g_probe.report(jStages, allocator, [](const char* line) {
+			WTSLogger::log_raw(LL_WARN, line);
+		});
+		root.AddMember("stages", jStages, allocator);
+
+		if (_output.empty())
+			return;
+
+		BoostFile bf;
+		if (bf.create_new_file(_output.c_str()))
+		{
+			rj::StringBuffer sb;
+			rj::PrettyWriter<rj::StringBuffer> writer(sb);
+			root.Accept(writer);
+			bf.write_file(sb.GetString());
+			bf.close_file();
+			WTSLogger::warn("Latency report saved to {}", _output);
+		}
+		else
+		{
+			WTSLogger::error("Saving latency report to {} failed", _output);
+		}
+	}
+}
@@ -45,6 +45,8 @@ namespace hft
 
 		bool initEngine(WTSVariant* cfg);
 
+		void report();
+
 	private:
 		TraderAdapterMgr	_traders;
 		ParserAdapterMgr	_parsers;
@@ -59,6 +61,8 @@ namespace hft
 
 		uint32_t			_times;
 		uint32_t			_core;
+		uint32_t			_warmup;
+		std::string			_output;
 	};
 }
 
@@ -21,6 +21,14 @@
 #include "../Share/StrUtil.hpp"
 #include "../Share/TimeUtils.hpp"
 #include "../Share/CpuHelper.hpp"
+#include "../Share/ShmTickBus.hpp"
+#include "../Share/StdUtils.hpp"
+#include "../Share/BoostFile.hpp"
+#include "../Share/LatencyHistogram.hpp"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+namespace rj = rapidjson;
 
 
 USING_NS_WTP;
@@ -60,15 +68,24 @@ namespace uft
 		return strtoul(str, NULL, 10);
 	}
 
+	LatencyProbe g_probe;
+
 	class TestParser : public IParserApi
 	{
 	public:
-		void	run(uint32_t times)
+		void	run(uint32_t times, uint32_t warmup)
 		{
 			srand(time(NULL));
 			TimeUtils::Ticker ticker;
-			for (uint32_t i = 0; i < times; i++)
+			for (uint32_t i = 0; i < warmup + times; i++)
 			{
+				//ԤȽԺٿʼͳ
+				if (i == warmup)
+				{
+					g_probe.reset();
+					ticker.reset();
+				}
+
 				uint32_t actDate = 20220303;// strtoul("20220303", NULL, 10);
 				uint32_t actTime = 100523 * 1000 + 500; //strToTime("10:05:23") * 1000 + 500;
 
@@ -134,7 +151,9 @@ namespace uft
 				quote.bid_qty[3] = 0;
 				quote.bid_qty[4] = 0;
 
+				g_probe.begin();
 				_parser_spi->handleQuote(tick, 0);
+				g_probe.end();
 				tick->release();
 			}
 			auto total = ticker.nano_seconds();
@@ -142,6 +161,109 @@ namespace uft
 			WTSLogger::warn("{} ticks simulated in {:.0f} ns, UftEngine Innner Latency: {:.3f} ns", times, total*1.0, t2t);
 		}
 
+		/*
+		 *	ͨڴ߲Զ˵˵ӳ
+		 *	д߳ÿдһtickȵǰ̴߳дһ
+		 *	ӳٴд߿ʼ㣬µΪֹ
+		 */
+		void	run_shm(uint32_t times, uint32_t warmup)
+		{
+			WTSContractInfo* contract = _bd_mgr->getContract("rb2205", "SHFE");
+			if (contract == NULL)
+				return;
+
+			ShmTickBus writer;
+			if (!writer.create("WtLatencyBus", 1024))
+			{
+				WTSLogger::error("Creating shared memory tick bus failed");
+				return;
+			}
+
+			ShmTickBus reader;
+			if (!reader.open("WtLatencyBus"))
+			{
+				WTSLogger::error("Opening shared memory tick bus failed");
+				return;
+			}
+
+			std::atomic<uint32_t> handled(0);
+			uint32_t loops = warmup + times;
+			StdThread producer([&writer, &handled, contract, loops]() {
+				srand(time(NULL));
+				WTSTickStruct quote;
+				wt_strcpy(quote.exchg, contract->getExchg());
+				wt_strcpy(quote.code, contract->getCode());
+				quote.action_date = 20220303;
+				quote.action_time = 100523 * 1000 + 500;
+				quote.trading_date = 20220303;
+				for (uint32_t i = 0; i < loops; i++)
+				{
+					double x = rand();
+					quote.price = x;
+					quote.open = x;
+					quote.high = x;
+					quote.low = x;
+					quote.settle_price = x;
+					quote.upper_limit = x;
+					quote.lower_limit = x;
+					quote.pre_close = x;
+					quote.pre_settle = x;
+					for (uint32_t j = 0; j < 5; j++)
+					{
+						quote.ask_prices[j] = x;
+						quote.bid_prices[j] = x;
+					}
+
+					writer.publish(SBT_Tick, &quote, sizeof(WTSTickStruct));
+					while (handled.load(std::memory_order_acquire) <= i)
+						;
+				}
+			});
+
+			uint64_t cursor = 0;
+			char buffer[ShmTickBus::MAX_DATA_SIZE];
+			uint32_t type = 0;
+			uint64_t stamp = 0;
+			uint64_t lost = 0;
+			uint64_t total = 0;
+			uint64_t maxLat = 0;
+			uint64_t minLat = UINT64_MAX;
+			uint32_t count = 0;
+			while (count < loops)
+			{
+				if (reader.read(cursor, type, buffer, stamp, lost) != ShmTickBus::RR_Ok)
+					continue;
+
+				if (count == warmup)
+				{
+					g_probe.reset();
+					total = 0;
+					maxLat = 0;
+					minLat = UINT64_MAX;
+				}
+
+				g_probe.record(LS_Bus, ShmTickBus::now_nano() - stamp);
+
+				WTSTickData* tick = WTSTickData::create(*(WTSTickStruct*)buffer);
+				tick->setContractInfo(contract);
+				g_probe.begin();
+				_parser_spi->handleQuote(tick, 0);
+				g_probe.end();
+				tick->release();
+
+				uint64_t lat = ShmTickBus::now_nano() - stamp;
+				total += lat;
+				maxLat = std::max(maxLat, lat);
+				minLat = std::min(minLat, lat);
+				count++;
+				handled.store(count, std::memory_order_release);
+			}
+			producer.join();
+
+			WTSLogger::warn("{} ticks simulated via shared memory bus, End-to-End Latency: avg {:.3f} ns, min {} ns, max {} ns",
+				times, total*1.0 / times, minLat, maxLat);
+		}
+
 	public:
 		virtual void registerSpi(IParserSpi* listener) override
 		{
@@ -156,6 +278,33 @@ namespace uft
 
 	TestParser* theParser = NULL;
 
+	/*
+	 *	֮תڼ¼յʱ
+	 */
+	class TestStub : public IParserStub
+	{
+	public:
+		TestStub() : _target(NULL) {}
+
+		void	setTarget(IParserStub* target) { _target = target; }
+
+	public:
+		virtual void handle_push_quote(WTSTickData* curTick) override
+		{
+			g_probe.mark(LM_Engine);
+			_target->handle_push_quote(curTick);
+		}
+
+		virtual void handle_push_order_detail(WTSOrdDtlData* curOrdDtl) override { _target->handle_push_order_detail(curOrdDtl); }
+		virtual void handle_push_order_queue(WTSOrdQueData* curOrdQue) override { _target->handle_push_order_queue(curOrdQue); }
+		virtual void handle_push_transaction(WTSTransData* curTrans) override { _target->handle_push_transaction(curTrans); }
+
+	private:
+		IParserStub*	_target;
+	};
+
+	TestStub theStub;
+
 	class TestTrader : public ITraderApi
 	{
 	public:
@@ -205,7 +354,11 @@ namespace uft
 		virtual void on_tick(IUftStraCtx* ctx, const char* code, WTSTickData* newTick)
 		{
 			//WTSLogger::debug("{}", __FUNCTION__);
-			ctx->stra_enter_long("SHFE.rb2205", 2300, 1, 0);
+			g_probe.mark(LM_Callback);
+			//ּµµ۸Ҫ
+			double price = newTick->askprice(0);
+			g_probe.mark(LM_Order);
+			ctx->stra_enter_long("SHFE.rb2205", price, 1, 0);
 			//ctx->stra_enter_short("SHFE.rb2205", 2300, 1, 0);
 		}
 	};
@@ -235,47 +388,25 @@ namespace uft
 
 		//ļ
 		WTSVariant* cfgBF = _config->get("basefiles");
-		if (cfgBF->get("session"))
-			_bd_mgr.loadSessions(cfgBF->getCString("session"));
-
-		WTSVariant* cfgItem = cfgBF->get("commodity");
-		if (cfgItem)
-		{
-			if (cfgItem->type() == WTSVariant::VT_String)
-			{
-				_bd_mgr.loadCommodities(cfgItem->asCString());
-			}
-			else if (cfgItem->type() == WTSVariant::VT_Array)
-			{
-				for (uint32_t i = 0; i < cfgItem->size(); i++)
-				{
-					_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-				}
-			}
-		}
-
-		cfgItem = cfgBF->get("contract");
-		if (cfgItem)
-		{
-			if (cfgItem->type() == WTSVariant::VT_String)
-			{
-				_bd_mgr.loadContracts(cfgItem->asCString());
-			}
-			else if (cfgItem->type() == WTSVariant::VT_Array)
-			{
-				for (uint32_t i = 0; i < cfgItem->size(); i++)
-				{
-					_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-				}
-			}
-		}
+		_bd_mgr.loadBaseFiles(cfgBF);
 
 		_times = _config->getUInt32("times");
 		WTSLogger::warn("{} ticks will be simulated", _times);
 
+		//modeΪshmʱͨڴߴݣԶ˵˵ӳ
+		_mode = _config->getCString("mode");
+		WTSLogger::warn("Testing mode: {}", _mode.empty() ? "inner" : _mode);
+
 		_core = _config->getUInt32("core");
 		WTSLogger::warn("Testing thread will be bind to core {}", _core);
 
+		//ԤȴԤڼݲͳ
+		_warmup = _config->getUInt32("warmup");
+		WTSLogger::warn("{} ticks will be simulated for warming up", _warmup);
+
+		//ӳٱļjsonʽ
+		_output = _config->getCString("output");
+
 		initEngine(_config->get("env"));
 		initModules();
 		initStrategies();
@@ -313,7 +444,8 @@ namespace uft
 		{
 			theParser = new TestParser();
 			ParserAdapterPtr adapter(new ParserAdapter);
-			adapter->initExt("parser", theParser, &_engine, &_bd_mgr);
+			theStub.setTarget(&_engine);
+			adapter->initExt("parser", theParser, &theStub, &_bd_mgr);
 			_parsers.addAdapter("parser", adapter);
 		}
 
@@ -321,6 +453,7 @@ namespace uft
 			TestTrader * tester = new TestTrader();
 			TraderAdapterPtr adapter(new TraderAdapter());
 			adapter->initExt("trader", tester, &_bd_mgr, NULL);
+			adapter->setLatencyProbe(&g_probe);
 			_traders.addAdapter("trader", adapter);
 		}
 
@@ -337,6 +470,10 @@ namespace uft
 			}
 		}
 
+		//Ժٱ궨궨Ͳڲͬĺ
+		TscClock::calibrate();
+		WTSLogger::warn("TSC calibrated: {:.3f} ticks/ns", TscClock::ticks_per_ns());
+
 		try
 		{
 			_parsers.run();
@@ -344,10 +481,55 @@ namespace uft
 
 			_engine.run(true);
 
-			theParser->run(_times);
+			if (_mode == "shm")
+				theParser->run_shm(_times, _warmup);
+			else
+				theParser->run(_times, _warmup);
+
+			report();
 		}
 		catch (...)
 		{
 		}
 	}
-}
\ No newline at end of file
+
+	/*
+	 *	׶εӳٷֲ
+	 *	outputĻͬʱjsonļ㲻ͬ汾֮Ա
+	 */
+	void UftLatencyTool::report()
+	{
+		rj::Document root(rj::kObjectType);
+		rj::Document::AllocatorType &allocator = root.GetAllocator();
+		root.AddMember("engine", "UFT", allocator);
+		root.AddMember("mode", rj::Value(_mode.empty() ? "inner" : _mode.c_str(), allocator), allocator);
+		root.AddMember("times", _times, allocator);
+		root.AddMember("warmup", _warmup, allocator);
+		root.AddMember("core", _core, allocator);
+		root.AddMember("ticks_per_ns", TscClock::ticks_per_ns(), allocator);
+
+		rj::Value jStages(rj::kObjectType);
+		g_probe.report(jStages, allocator, [](const char* line) {
+			WTSLogger::log_raw(LL_WARN, line);
+		});
+		root.AddMember("stages", jStages, allocator);
+
+		if (_output.empty())
+			return;
+
+		BoostFile bf;
+		if (bf.create_new_file(_output.c_str()))
+		{
+			rj::StringBuffer sb;
+			rj::PrettyWriter<rj::StringBuffer> writer(sb);
+			root.Accept(writer);
+			bf.write_file(sb.GetString());
+			bf.close_file();
+			WTSLogger::warn("Latency report saved to {}", _output);
+		}
+		else
+		{
+			WTSLogger::error("Saving latency report to {} failed", _output);
+		}
+	}
+}
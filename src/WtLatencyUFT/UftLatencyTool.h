@@ -41,6 +41,8 @@ namespace uft
 
 		bool initEngine(WTSVariant* cfg);
 
+		void report();
+
 	private:
 		TraderAdapterMgr	_traders;
 		ParserAdapterMgr	_parsers;
@@ -52,6 +54,9 @@ namespace uft
 
 		uint32_t			_times;
 		uint32_t			_core;
+		uint32_t			_warmup;
+		std::string			_mode;
+		std::string			_output;
 	};
 }
 
@@ -0,0 +1,76 @@
+/*!
+ * \file main.cpp
+ * \project	WonderTrader
+ *
+ * \date 2023/10/18
+ *
+ * \brief ־빤
+ *
+ * ÷: WtLogDecoder <binlog> [output]
+ * ָļʱֱӴӡ̨
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "../Share/BinLogger.hpp"
+
+USING_NS_WTP;
+
+inline const char* level_name(uint8_t ll)
+{
+	switch (ll)
+	{
+	case LL_DEBUG: return "debug";
+	case LL_INFO: return "info";
+	case LL_WARN: return "warning";
+	case LL_ERROR: return "error";
+	case LL_FATAL: return "fatal";
+	default: return "unknown";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		fmt::print("Usage: WtLogDecoder <binlog> [output]\n");
+		return -1;
+	}
+
+	FILE* out = stdout;
+	if (argc > 2)
+	{
+		out = fopen(argv[2], "w");
+		if (out == NULL)
+		{
+			fmt::print("Cannot open output file {}\n", argv[2]);
+			return -1;
+		}
+	}
+
+	uint64_t count = 0;
+	uint64_t corrupted = 0;
+	bool bSucc = BinLogDecoder::decode_file(argv[1], [out, &count](const BinLogSiteInfo& site, uint64_t stamp, const std::string& message) {
+		time_t t = (time_t)(stamp / 1000000000);
+		uint32_t us = (uint32_t)(stamp % 1000000000 / 1000);
+		tm* tNow = localtime(&t);
+		fmt::print(out, "[{}.{:02d}.{:02d} {:02d}:{:02d}:{:02d}.{:06d}] [{}] ", tNow->tm_year + 1900, tNow->tm_mon + 1, tNow->tm_mday,
+			tNow->tm_hour, tNow->tm_min, tNow->tm_sec, us, level_name(site._level));
+		if (!site._category.empty())
+			fmt::print(out, "[{}] ", site._category);
+		fmt::print(out, "{}\n", message);
+		count++;
+	}, &corrupted);
+
+	if (out != stdout)
+		fclose(out);
+
+	if (!bSucc)
+	{
+		fmt::print("{} is not a valid binary log file\n", argv[1]);
+		return -1;
+	}
+
+	fmt::print(stderr, "{} records decoded, {} corrupted\n", count, corrupted);
+	return 0;
+}
@@ -49,7 +49,8 @@ const char* getModuleName()
 #endif
 
 WtRtRunner::WtRtRunner()
-	: _data_store(NULL)
+	: _engine(NULL)
+	, _data_store(NULL)
 	, _cb_cta_init(NULL)
 	, _cb_cta_tick(NULL)
 	, _cb_cta_calc(NULL)
@@ -494,49 +495,7 @@ bool WtRtRunner::config(const char* cfgFile, bool isFile /* = true */)
 
 	//ļ
 	WTSVariant* cfgBF = _config->get("basefiles");
-	if (cfgBF->get("session"))
-	{
-		_bd_mgr.loadSessions(cfgBF->getCString("session"));
-		WTSLogger::info("Trading sessions loaded");
-	}
-
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	if (cfgBF->get("holiday"))
-	{
-		_bd_mgr.loadHolidays(cfgBF->getCString("holiday"));
-		WTSLogger::log_raw(LL_INFO, "Holidays loaded");
-	}
+	_bd_mgr.loadBaseFiles(cfgBF);
 
 	if (cfgBF->get("hot"))
 	{
@@ -1103,6 +1062,9 @@ void WtRtRunner::handleLogAppend(WTSLogLevel ll, const char* msg)
 
 void WtRtRunner::release()
 {
+	if (_engine)
+		_engine->release();
+
 	WTSLogger::stop();
 }
 
@@ -37,7 +37,8 @@ const char* getBinDir()
 
 
 WtRunner::WtRunner()
-	: _data_store(NULL)
+	: _engine(NULL)
+	, _data_store(NULL)
 	, _is_hft(false)
 	, _is_sel(false)
 {
@@ -54,6 +55,8 @@ WtRunner::WtRunner()
 
 WtRunner::~WtRunner()
 {
+	if (_engine)
+		_engine->release();
 }
 
 bool WtRunner::init()
@@ -83,43 +86,7 @@ bool WtRunner::config()
 
 	//ļ
 	WTSVariant* cfgBF = _config->get("basefiles");
-	if (cfgBF->get("session"))
-		_bd_mgr.loadSessions(cfgBF->getCString("session"));
-
-	WTSVariant* cfgItem = cfgBF->get("commodity");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadCommodities(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadCommodities(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	cfgItem = cfgBF->get("contract");
-	if (cfgItem)
-	{
-		if (cfgItem->type() == WTSVariant::VT_String)
-		{
-			_bd_mgr.loadContracts(cfgItem->asCString());
-		}
-		else if (cfgItem->type() == WTSVariant::VT_Array)
-		{
-			for (uint32_t i = 0; i < cfgItem->size(); i++)
-			{
-				_bd_mgr.loadContracts(cfgItem->get(i)->asCString());
-			}
-		}
-	}
-
-	if (cfgBF->get("holiday"))
-		_bd_mgr.loadHolidays(cfgBF->getCString("holiday"));
+	_bd_mgr.loadBaseFiles(cfgBF);
 
 	if (cfgBF->get("hot"))
 		_hot_mgr.loadHots(cfgBF->getCString("hot"));
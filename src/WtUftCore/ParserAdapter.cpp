@@ -280,6 +280,7 @@ void ParserAdapter::handleQuote(WTSTickData *quote, uint32_t procFlag)
 		return;
 
 	quote->setCode(cInfo->getFullCode());
+	quote->setContractInfo(cInfo);
 
 	_stub->handle_push_quote(quote);
 }
@@ -300,6 +301,7 @@ void ParserAdapter::handleOrderQueue(WTSOrdQueData* ordQueData)
 		return;
 
 	ordQueData->setCode(cInfo->getFullCode());
+	ordQueData->setContractInfo(cInfo);
 
 	if (_stub)
 		_stub->handle_push_order_queue(ordQueData);
@@ -321,6 +323,7 @@ void ParserAdapter::handleOrderDetail(WTSOrdDtlData* ordDtlData)
 		return;
 
 	ordDtlData->setCode(cInfo->getFullCode());
+	ordDtlData->setContractInfo(cInfo);
 
 	if (_stub)
 		_stub->handle_push_order_detail(ordDtlData);
@@ -342,6 +345,7 @@ void ParserAdapter::handleTransaction(WTSTransData* transData)
 		return;
 
 	transData->setCode(cInfo->getFullCode());
+	transData->setContractInfo(cInfo);
 
 	if (_stub)
 		_stub->handle_push_transaction(transData);
@@ -27,6 +27,7 @@
 #include "../Share/decimal.h"
 #include "../Share/DLLHelper.hpp"
 #include "../Share/StrUtil.hpp"
+#include "../Share/LatencyHistogram.hpp"
 
 #include <exception>
 #include <rapidjson/document.h>
@@ -77,6 +78,7 @@ TraderAdapter::TraderAdapter()
 	, _orders(NULL)
 	, _risk_mon_enabled(false)
 	, _stat_map(NULL)
+	, _probe(NULL)
 {
 }
 
@@ -328,7 +330,9 @@ uint32_t TraderAdapter::doEntrust(WTSEntrust* entrust)
 	usertag[_order_pattern.size()] = '.';
 	fmtutil::format_to(usertag + _order_pattern.size() + 1, "{}", localid);
 	
+	if (_probe) _probe->mark(LM_Api);
 	int32_t ret = _trader_api->orderInsert(entrust);
+	if (_probe) _probe->mark(LM_Sent);
 	if(ret < 0)
 	{
 		WTSLogger::log_dyn("trader", _id.c_str(), LL_ERROR, "[{}] Order placing failed: {}", _id, ret);
@@ -1915,6 +1919,8 @@ bool TraderAdapter::isTradeEnabled(const char* stdCode) const
 
 bool TraderAdapter::checkOrderLimits(const char* stdCode)
 {
+	LatencyScope scope(_probe, LM_RiskIn, LM_RiskOut);
+
 	if (_exclude_codes.find(stdCode) != _exclude_codes.end())
 		return false;
 
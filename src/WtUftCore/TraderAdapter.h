@@ -15,6 +15,8 @@
 #include "../Share/StdUtils.hpp"
 #include "../Includes/WTSCollection.hpp"
 
+class LatencyProbe;
+
 NS_WTP_BEGIN
 class WTSVariant;
 class WTSContractInfo;
@@ -194,6 +196,11 @@ public:
 	bool	checkCancelLimits(const char* stdCode);
 	bool	checkOrderLimits(const char* stdCode);
 
+	/*
+	 *	ӳ̽룬ӳٲԹؼͽ׽ӿڵô
+	 */
+	inline void setLatencyProbe(LatencyProbe* probe) { _probe = probe; }
+
 public:
 	//////////////////////////////////////////////////////////////////////////
 	//ITraderSpiӿ
@@ -262,6 +269,8 @@ private:
 	typedef wt_hashmap<std::string, RiskParams>	RiskParamsMap;
 	RiskParamsMap	_risk_params_map;
 	bool			_risk_mon_enabled;
+
+	LatencyProbe*	_probe;		//ӳ̽룬ֻӳٲԹ߻
 };
 
 typedef std::shared_ptr<TraderAdapter>					TraderAdapterPtr;
@@ -25,6 +25,7 @@
 
 #include "../WTSTools/WTSLogger.h"
 
+#include <algorithm>
 #include <boost/asio.hpp>
 
 boost::asio::io_service g_asyncIO;
@@ -157,6 +158,8 @@ void WtUftEngine::sub_tick(uint32_t sid, const char* stdCode)
 {
 	SubList& sids = _tick_sub_map[stdCode];
 	sids.insert(sid);
+
+	add_flat_sub(_tick_subs, stdCode, sid);
 }
 
 double WtUftEngine::get_cur_price(const char* stdCode)
@@ -235,6 +238,14 @@ void WtUftEngine::handle_push_quote(WTSTickData* newTick)
 void WtUftEngine::handle_push_order_detail(WTSOrdDtlData* curOrdDtl)
 {
 	const char* stdCode = curOrdDtl->code();
+	const CtxList* ctxs = find_flat_subs(_orddtl_subs, curOrdDtl->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IUftStraCtx* ctx : *ctxs)
+			ctx->on_order_detail(stdCode, curOrdDtl);
+		return;
+	}
+
 	auto sit = _orddtl_sub_map.find(stdCode);
 	if (sit != _orddtl_sub_map.end())
 	{
@@ -258,6 +269,14 @@ void WtUftEngine::handle_push_order_detail(WTSOrdDtlData* curOrdDtl)
 void WtUftEngine::handle_push_order_queue(WTSOrdQueData* curOrdQue)
 {
 	const char* stdCode = curOrdQue->code();
+	const CtxList* ctxs = find_flat_subs(_ordque_subs, curOrdQue->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IUftStraCtx* ctx : *ctxs)
+			ctx->on_order_queue(stdCode, curOrdQue);
+		return;
+	}
+
 	auto sit = _ordque_sub_map.find(stdCode);
 	if (sit != _ordque_sub_map.end())
 	{
@@ -281,6 +300,14 @@ void WtUftEngine::handle_push_order_queue(WTSOrdQueData* curOrdQue)
 void WtUftEngine::handle_push_transaction(WTSTransData* curTrans)
 {
 	const char* stdCode = curTrans->code();
+	const CtxList* ctxs = find_flat_subs(_trans_subs, curTrans->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IUftStraCtx* ctx : *ctxs)
+			ctx->on_transaction(stdCode, curTrans);
+		return;
+	}
+
 	auto sit = _trans_sub_map.find(stdCode);
 	if (sit != _trans_sub_map.end())
 	{
@@ -305,18 +332,58 @@ void WtUftEngine::sub_order_detail(uint32_t sid, const char* stdCode)
 {
 	SubList& sids = _orddtl_sub_map[stdCode];
 	sids.insert(sid);
+
+	add_flat_sub(_orddtl_subs, stdCode, sid);
 }
 
 void WtUftEngine::sub_order_queue(uint32_t sid, const char* stdCode)
 {
 	SubList& sids = _ordque_sub_map[stdCode];
 	sids.insert(sid);
+
+	add_flat_sub(_ordque_subs, stdCode, sid);
 }
 
 void WtUftEngine::sub_transaction(uint32_t sid, const char* stdCode)
 {
 	SubList& sids = _trans_sub_map[stdCode];
 	sids.insert(sid);
+
+	add_flat_sub(_trans_subs, stdCode, sid);
+}
+
+void WtUftEngine::add_flat_sub(FlatSubTable& table, const char* stdCode, uint32_t sid)
+{
+	auto cit = _ctx_map.find(sid);
+	if (cit == _ctx_map.end())
+		return;
+
+	if (strchr(stdCode, '.') == NULL)
+		return;
+
+	//ֻдͺԼȫһµĶĲܰԼIDַ
+	WTSContractInfo* cInfo = get_contract_info(stdCode);
+	if (cInfo == NULL || cInfo->getSymbolID() == 0 || strcmp(cInfo->getFullCode(), stdCode) != 0)
+		return;
+
+	uint32_t symId = cInfo->getSymbolID();
+	if (symId >= table.size())
+		table.resize(symId + 1);
+
+	CtxList& ctxs = table[symId];
+	IUftStraCtx* ctx = cit->second.get();
+	if (std::find(ctxs.begin(), ctxs.end(), ctx) == ctxs.end())
+		ctxs.emplace_back(ctx);
+}
+
+void WtUftEngine::rebuild_flat_subs(FlatSubTable& table, const StraSubMap& subMap)
+{
+	table.clear();
+	for (auto& v : subMap)
+	{
+		for (uint32_t sid : v.second)
+			add_flat_sub(table, v.first.c_str(), sid);
+	}
 }
 
 void WtUftEngine::on_session_begin()
@@ -346,6 +413,14 @@ void WtUftEngine::on_tick(const char* stdCode, WTSTickData* curTick)
 	if(_data_mgr)
 		_data_mgr->handle_push_quote(stdCode, curTick);
 
+	//ȰԼIDַҪԴϣ
+	const CtxList* ctxs = find_flat_subs(_tick_subs, curTick->getContractInfo());
+	if (ctxs != NULL)
+	{
+		for (IUftStraCtx* ctx : *ctxs)
+			ctx->on_tick(stdCode, curTick);
+	}
+	else
 	{
 		auto sit = _tick_sub_map.find(stdCode);
 		if (sit != _tick_sub_map.end())
@@ -368,8 +443,14 @@ void WtUftEngine::on_tick(const char* stdCode, WTSTickData* curTick)
 
 void WtUftEngine::on_bar(const char* stdCode, const char* period, uint32_t times, WTSBarStruct* newBar)
 {
-	std::string key = fmt::format("{}-{}-{}", stdCode, period, times);
-	const SubList& sids = _bar_sub_map[key];
+	thread_local static char key[64] = { 0 };
+	fmtutil::format_to(key, "{}-{}-{}", stdCode, period, times);
+
+	auto sit = _bar_sub_map.find(key);
+	if (sit == _bar_sub_map.end())
+		return;
+
+	const SubList& sids = sit->second;
 	for (auto it = sids.begin(); it != sids.end(); it++)
 	{
 		uint32_t sid = *it;
@@ -391,6 +472,12 @@ void WtUftEngine::addContext(UftContextPtr ctx)
 {
 	uint32_t sid = ctx->id();
 	_ctx_map[sid] = ctx;
+
+	//ԵĶĿ֮ǰѾǼˣؽһ°ԼIDĶı
+	rebuild_flat_subs(_tick_subs, _tick_sub_map);
+	rebuild_flat_subs(_ordque_subs, _ordque_sub_map);
+	rebuild_flat_subs(_orddtl_subs, _orddtl_sub_map);
+	rebuild_flat_subs(_trans_subs, _trans_sub_map);
 }
 
 UftContextPtr WtUftEngine::getContext(uint32_t id)
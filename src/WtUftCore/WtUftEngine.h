@@ -24,6 +24,7 @@
 #include "../Share/BoostFile.hpp"
 
 #include "../Includes/IUftStraCtx.h"
+#include "../Includes/WTSContractInfo.hpp"
 
 NS_WTP_BEGIN
 class WTSSessionInfo;
@@ -144,6 +145,15 @@ private:
 	StraSubMap		_trans_sub_map;		//ɽϸı
 	StraSubMap		_bar_sub_map;	//Kݶı	
 
+	//պԼIDĶı±ΪԼIDԪΪ˸úԼĲ
+	typedef std::vector<IUftStraCtx*>	CtxList;
+	typedef std::vector<CtxList>		FlatSubTable;
+
+	FlatSubTable	_tick_subs;		//ԼIDtickݶı
+	FlatSubTable	_ordque_subs;	//ԼIDίжжı
+	FlatSubTable	_orddtl_subs;	//ԼIDίϸı
+	FlatSubTable	_trans_subs;	//ԼIDĳɽϸı
+
 	TraderAdapterMgr*	_adapter_mgr;
 
 	typedef wt_hashmap<uint32_t, UftContextPtr> ContextMap;
@@ -153,6 +163,35 @@ private:
 	WTSVariant*		_cfg;
 
 	bool			_dependent;	//ӲԶ
+
+private:
+	/*
+	 *	һļӵԼIDĶı
+	 *	ԼҲ߲ԻûӵʱֱӺԣӲԵʱؽ
+	 */
+	void	add_flat_sub(FlatSubTable& table, const char* stdCode, uint32_t sid);
+
+	/*
+	 *	ַĶıؽԼIDĶı
+	 */
+	void	rebuild_flat_subs(FlatSubTable& table, const StraSubMap& subMap);
+
+	/*
+	 *	ҰԼIDĶб
+	 *	NULL˵ûйԼIDҪ˵
+	 */
+	inline const CtxList* find_flat_subs(const FlatSubTable& table, WTSContractInfo* cInfo) const
+	{
+		static const CtxList EMPTY_LIST;
+		if (cInfo == NULL || cInfo->getSymbolID() == 0)
+			return NULL;
+
+		uint32_t symId = cInfo->getSymbolID();
+		if (symId >= table.size())
+			return &EMPTY_LIST;
+
+		return &table[symId];
+	}
 };
 
 NS_WTP_END
\ No newline at end of file